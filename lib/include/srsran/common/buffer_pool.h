@@ -25,10 +25,17 @@
 #include "byte_buffer.h"
 #include "srsran/adt/bounded_vector.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <pthread.h>
 #include <stack>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "srsran/adt/pool/fixed_size_pool.h"
@@ -43,24 +50,129 @@ namespace srsran {
  * Preallocates a large number of buffer_t and provides allocate and
  * deallocate functions. Provides quick object creation and deletion as well
  * as object reuse.
+ * Each thread keeps a small local cache of free buffers, so that allocations and
+ * deallocations in the hot path take no lock. The local cache is refilled from/returned
+ * to the central free list in batches. When the central free list runs empty, the
+ * buffers parked in the caches of other threads are reclaimed before the allocation
+ * fails or blocks. Each cache slot is an atomic pointer, so the owner thread and a
+ * reclaiming thread take a buffer out of a slot with an atomic exchange, and each
+ * buffer goes to exactly one of them.
  * Singleton class of byte_buffer_t (but other pools of different type can be created)
  *****************************************************************************/
 
 template <class buffer_t>
 class buffer_pool
 {
+  static const uint32_t MAX_BATCH_SIZE = 16;
+
+  struct local_cache_t;
+
+  /// State shared with the thread-local caches. It may outlive the pool while a thread is returning its cache
+  struct central_cache_t {
+    std::mutex                  mutex;
+    std::condition_variable     cv_not_empty;
+    std::vector<buffer_t*>      free_list;
+    std::vector<local_cache_t*> local_caches;
+    std::atomic<uint32_t>       nof_waiters{0};
+  };
+
+  /// Thread-local cache of free buffers. Only the owner thread stores buffers in the slots and moves the top index.
+  /// Other threads may empty any slot while they hold the pool lock, which leaves holes below the top
+  struct local_cache_t {
+    std::weak_ptr<central_cache_t>                         central;
+    std::thread::id                                        id;
+    std::array<std::atomic<buffer_t*>, 2 * MAX_BATCH_SIZE> slots;
+    uint32_t                                               top = 0;
+
+    explicit local_cache_t(const std::shared_ptr<central_cache_t>& central_) :
+      central(central_), id(std::this_thread::get_id())
+    {
+      for (std::atomic<buffer_t*>& slot : slots) {
+        slot.store(nullptr, std::memory_order_relaxed);
+      }
+      std::lock_guard<std::mutex> lock(central_->mutex);
+      central_->local_caches.push_back(this);
+    }
+    ~local_cache_t()
+    {
+      // Return all cached buffers to the pool, if it still exists
+      std::shared_ptr<central_cache_t> c = central.lock();
+      if (c != nullptr) {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        take_all(c->free_list);
+        c->local_caches.erase(std::find(c->local_caches.begin(), c->local_caches.end(), this));
+        c->cv_not_empty.notify_all();
+      }
+    }
+
+    /// Called by the owner thread. Returns nullptr if the cache is empty
+    buffer_t* pop()
+    {
+      while (top > 0) {
+        buffer_t* b = slots[--top].exchange(nullptr, std::memory_order_acquire);
+        if (b != nullptr) {
+          return b;
+        }
+      }
+      return nullptr;
+    }
+
+    /// Called by the owner thread, which must check that the cache is not full
+    void push(buffer_t* b) { slots[top++].store(b, std::memory_order_release); }
+
+    /// Moves all cached buffers to "list". Called by any thread with the pool lock held
+    void take_all(std::vector<buffer_t*>& list)
+    {
+      for (std::atomic<buffer_t*>& slot : slots) {
+        buffer_t* b = slot.exchange(nullptr, std::memory_order_acq_rel);
+        if (b != nullptr) {
+          list.push_back(b);
+        }
+      }
+    }
+
+    uint32_t occupancy() const
+    {
+      uint32_t n = 0;
+      for (const std::atomic<buffer_t*>& slot : slots) {
+        n += slot.load(std::memory_order_relaxed) != nullptr ? 1 : 0;
+      }
+      return n;
+    }
+  };
+
+  /// Caches of the calling thread for all pools of this type, indexed by pool id
+  struct thread_caches_t {
+    uint64_t                                                    last_id    = 0;
+    local_cache_t*                                              last_cache = nullptr;
+    std::unordered_map<uint64_t, std::unique_ptr<local_cache_t> > caches;
+  };
+
 public:
+  /// Occupancy of the thread-local cache of a single thread
+  struct thread_cache_metrics_t {
+    std::thread::id id;
+    uint32_t        nof_cached;
+  };
+
+  struct metrics_t {
+    uint32_t                            capacity;
+    uint32_t                            nof_central_free;
+    std::vector<thread_cache_metrics_t> thread_caches;
+  };
+
   // non-static methods
-  buffer_pool(int capacity_ = -1)
+  buffer_pool(int capacity_ = -1) : central(std::make_shared<central_cache_t>())
   {
+    static std::atomic<uint64_t> pool_id_counter{0};
+    pool_id = ++pool_id_counter;
+
     uint32_t nof_buffers = POOL_SIZE;
     if (capacity_ > 0) {
       nof_buffers = (uint32_t)capacity_;
     }
     pool.reserve(nof_buffers);
-    free_list.reserve(nof_buffers);
-    pthread_mutex_init(&mutex, nullptr);
-    pthread_cond_init(&cv_not_empty, nullptr);
+    central->free_list.reserve(nof_buffers);
     for (uint32_t i = 0; i < nof_buffers; i++) {
       buffer_t* b = new (std::nothrow) buffer_t;
       if (!b) {
@@ -68,28 +180,42 @@ public:
         exit(-1);
       }
       pool.push_back(b);
-      free_list.push_back(b);
+      central->free_list.push_back(b);
     }
     capacity = nof_buffers;
+
+    // Sorted copy of the allocated buffers, to check ownership on deallocation without locking
+    sorted_pool = pool;
+    std::sort(sorted_pool.begin(), sorted_pool.end());
+
+    // Keep the local caches small compared to the pool, as reclaiming buffers from other threads' caches is slow
+    batch_size = std::max(1U, std::min((uint32_t)MAX_BATCH_SIZE, capacity / 32));
   }
 
   ~buffer_pool()
   {
+    // Detach the thread-local caches still pointing to this pool
+    central.reset();
     for (auto* p : pool) {
       delete p;
     }
-    pthread_cond_destroy(&cv_not_empty);
-    pthread_mutex_destroy(&mutex);
   }
 
   void print_all_buffers()
   {
-    printf("%d buffers in queue\n", static_cast<int>(pool.size() - free_list.size()));
+    metrics_t m = get_metrics();
+    printf("%d buffers in queue\n", static_cast<int>(pool.size() - nof_available_pdus()));
+    for (const thread_cache_metrics_t& t : m.thread_caches) {
+      printf(" - thread 0x%zx caches %d buffers\n", std::hash<std::thread::id>{}(t.id), t.nof_cached);
+    }
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     std::map<std::string, uint32_t> buffer_cnt;
-    for (uint32_t i = 0; i < pool.size(); i++) {
-      if (std::find(free_list.cbegin(), free_list.cend(), pool[i]) == free_list.cend()) {
-        buffer_cnt[strlen(pool[i]->debug_name) ? pool[i]->debug_name : "Undefined"]++;
+    {
+      std::lock_guard<std::mutex> lock(central->mutex);
+      for (uint32_t i = 0; i < pool.size(); i++) {
+        if (std::find(central->free_list.cbegin(), central->free_list.cend(), pool[i]) == central->free_list.cend()) {
+          buffer_cnt[strlen(pool[i]->debug_name) ? pool[i]->debug_name : "Undefined"]++;
+        }
       }
     }
     std::map<std::string, uint32_t>::iterator it;
@@ -99,71 +225,175 @@ public:
 #endif
   }
 
-  uint32_t nof_available_pdus() { return free_list.size(); }
+  /// Number of free buffers, either in the central free list or in any thread-local cache
+  uint32_t nof_available_pdus()
+  {
+    std::lock_guard<std::mutex> lock(central->mutex);
+    uint32_t                    n = central->free_list.size();
+    for (local_cache_t* c : central->local_caches) {
+      n += c->occupancy();
+    }
+    return n;
+  }
 
-  bool is_almost_empty() { return free_list.size() < capacity / 20; }
+  bool is_almost_empty() { return nof_available_pdus() < capacity / 20; }
 
-  buffer_t* allocate(const char* debug_name = nullptr, bool blocking = false)
+  /// Snapshot of the central free list and of the occupancy of each thread-local cache
+  metrics_t get_metrics()
   {
-    pthread_mutex_lock(&mutex);
-    buffer_t* b = nullptr;
+    metrics_t                   m = {};
+    std::lock_guard<std::mutex> lock(central->mutex);
+    m.capacity         = capacity;
+    m.nof_central_free = central->free_list.size();
+    for (local_cache_t* c : central->local_caches) {
+      m.thread_caches.push_back({c->id, c->occupancy()});
+    }
+    return m;
+  }
 
-    if (!free_list.empty()) {
-      b = free_list.back();
-      free_list.pop_back();
+  buffer_t* allocate(const char* debug_name = nullptr, bool blocking = false)
+  {
+    local_cache_t* cache = get_local_cache();
 
-      if (is_almost_empty()) {
-        printf("Warning buffer pool capacity is %f %%\n", (float)100 * free_list.size() / capacity);
+    buffer_t*      b     = cache->pop();
+    if (b == nullptr) {
+      b = refill_local_cache(cache, blocking);
+      if (b == nullptr) {
+        return nullptr;
       }
+    }
+
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-      if (debug_name) {
-        strncpy(b->debug_name, debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
-        b->debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN - 1] = 0;
-      }
+    if (debug_name) {
+      strncpy(b->debug_name, debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
+      b->debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN - 1] = 0;
+    }
 #endif
-    } else if (blocking) {
-      // blocking allocation
-      while (free_list.empty()) {
-        pthread_cond_wait(&cv_not_empty, &mutex);
-      }
+    return b;
+  }
 
-      // retrieve the new buffer
-      b = free_list.back();
-      free_list.pop_back();
+  bool deallocate(buffer_t* b)
+  {
+    if (not std::binary_search(sorted_pool.cbegin(), sorted_pool.cend(), b)) {
+      return false;
+    }
 
-      // do not print any warning
-    } else {
-      printf("Error - buffer pool is empty\n");
+    local_cache_t* cache = get_local_cache();
+    cache->push(b);
+    if (cache->top < 2 * batch_size and central->nof_waiters.load(std::memory_order_relaxed) == 0) {
+      return true;
+    }
+
+    // Hand the buffers back right away if some thread is waiting for them, otherwise keep one batch cached
+    return_local_cache(cache);
+    return true;
+  }
+
+private:
+  local_cache_t* get_local_cache()
+  {
+    thread_local thread_caches_t tcaches;
+    if (tcaches.last_id == pool_id) {
+      return tcaches.last_cache;
+    }
 
+    auto it = tcaches.caches.find(pool_id);
+    if (it == tcaches.caches.end()) {
+      // Drop the caches of pools that no longer exist
+      for (auto it2 = tcaches.caches.begin(); it2 != tcaches.caches.end();) {
+        if (it2->second->central.expired()) {
+          it2 = tcaches.caches.erase(it2);
+        } else {
+          ++it2;
+        }
+      }
+      it = tcaches.caches.emplace(pool_id, std::unique_ptr<local_cache_t>(new local_cache_t(central))).first;
+    }
+    tcaches.last_id    = pool_id;
+    tcaches.last_cache = it->second.get();
+    return tcaches.last_cache;
+  }
+
+  /// Moves a batch of buffers from the central free list to the local cache, and returns one of them to the caller.
+  /// Returns nullptr if the pool is empty
+  buffer_t* refill_local_cache(local_cache_t* cache, bool blocking)
+  {
+    std::unique_lock<std::mutex> lock(central->mutex);
+    std::vector<buffer_t*>&      free_list = central->free_list;
+
+    if (free_list.empty()) {
+      reclaim_local_caches();
+    }
+    if (free_list.empty()) {
+      if (not blocking) {
+        lock.unlock();
+        printf("Error - buffer pool is empty\n");
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-      print_all_buffers();
+        print_all_buffers();
 #endif
+        return nullptr;
+      }
+      // blocking allocation. Do not print any warning
+      central->nof_waiters++;
+      central->cv_not_empty.wait(lock, [this, &free_list]() {
+        if (free_list.empty()) {
+          // Buffers may have been parked in other caches before they noticed this waiter
+          reclaim_local_caches();
+        }
+        return not free_list.empty();
+      });
+      central->nof_waiters--;
+    } else if (free_list.size() < capacity / 20) {
+      printf("Warning buffer pool capacity is %f %%\n", (float)100 * free_list.size() / capacity);
     }
 
-    pthread_mutex_unlock(&mutex);
+    buffer_t* b = free_list.back();
+    free_list.pop_back();
+    // The cache is empty, as the owner only refills it when pop() fails
+    size_t n = std::min((size_t)batch_size - 1, free_list.size());
+    for (size_t i = 0; i < n; ++i) {
+      cache->push(free_list.back());
+      free_list.pop_back();
+    }
     return b;
   }
 
-  bool deallocate(buffer_t* b)
+  /// Moves the buffers of the local cache back to the central free list. A batch is kept cached, unless some thread
+  /// is waiting for buffers
+  void return_local_cache(local_cache_t* cache)
   {
-    bool ret = false;
-    pthread_mutex_lock(&mutex);
-    if (std::find(pool.cbegin(), pool.cend(), b) != pool.cend()) {
-      free_list.push_back(b);
-      ret = true;
+    std::lock_guard<std::mutex> lock(central->mutex);
+    std::vector<buffer_t*>&     free_list = central->free_list;
+
+    // Compact the cache, as it may have holes left by reclaims
+    size_t nof_free = free_list.size();
+    cache->take_all(free_list);
+    cache->top = 0;
+    if (central->nof_waiters.load(std::memory_order_relaxed) == 0) {
+      size_t n = std::min((size_t)batch_size, free_list.size() - nof_free);
+      for (size_t i = 0; i < n; ++i) {
+        cache->push(free_list.back());
+        free_list.pop_back();
+      }
     }
-    pthread_cond_signal(&cv_not_empty);
-    pthread_mutex_unlock(&mutex);
-    return ret;
+    central->cv_not_empty.notify_all();
   }
 
-private:
-  static const int       POOL_SIZE = 4096;
-  std::vector<buffer_t*> pool;
-  std::vector<buffer_t*> free_list;
-  pthread_mutex_t        mutex;
-  pthread_cond_t         cv_not_empty;
-  uint32_t               capacity;
+  /// Moves the buffers parked in all thread-local caches to the central free list. The pool lock must be held
+  void reclaim_local_caches()
+  {
+    for (local_cache_t* c : central->local_caches) {
+      c->take_all(central->free_list);
+    }
+  }
+
+  static const int                 POOL_SIZE      = 4096;
+  uint64_t                         pool_id        = 0;
+  uint32_t                         batch_size     = 1;
+  std::vector<buffer_t*>           pool;
+  std::vector<buffer_t*>           sorted_pool;
+  std::shared_ptr<central_cache_t> central;
+  uint32_t                         capacity;
 };
 
 /// Type of global byte buffer pool
@@ -0,0 +1,329 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_BYTE_BUFFER_CHAIN_H
+#define SRSRAN_BYTE_BUFFER_CHAIN_H
+
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/common/buffer_pool.h"
+#include <algorithm>
+#include <atomic>
+
+namespace srsran {
+
+/******************************************************************************
+ * Byte buffer slab
+ *
+ * Reference-counted block of memory holding packet bytes. New slabs are carved
+ * out of the blocks of the global byte buffer pool. A slab can also adopt an
+ * existing byte_buffer_t, in which case no payload bytes are copied and the
+ * slab header is stored in the headroom of the adopted buffer.
+ * The bytes of a slab that is referenced by more than one owner are read-only.
+ *****************************************************************************/
+class byte_buffer_slab
+{
+public:
+  /// Bytes left free in front of the payload of new slabs
+  static const uint32_t DEFAULT_HEADROOM = 32;
+
+  /// Allocates a slab with room for at least "size" bytes.
+  /// Returns nullptr if "size" exceeds max_size() or the pool is depleted.
+  static byte_buffer_slab* create(uint32_t size) noexcept;
+  /// Wraps an existing byte buffer. The buffer payload becomes the slab payload.
+  static byte_buffer_slab* adopt(unique_byte_buffer_t buf) noexcept;
+  /// Usable bytes of a slab
+  static uint32_t max_size();
+
+  byte_buffer_slab(const byte_buffer_slab&) = delete;
+  byte_buffer_slab& operator=(const byte_buffer_slab&) = delete;
+
+  uint8_t*       begin() { return storage; }
+  const uint8_t* begin() const { return storage; }
+  uint8_t*       end() { return storage + storage_len; }
+  const uint8_t* end() const { return storage + storage_len; }
+  uint32_t       capacity() const { return storage_len; }
+  bool           is_adopted() const { return adopted_buf != nullptr; }
+
+  /// True if more than one owner holds a reference to this slab
+  bool is_shared() const { return ref_count.load(std::memory_order_acquire) > 1; }
+
+  void add_ref() { ref_count.fetch_add(1, std::memory_order_relaxed); }
+  void release()
+  {
+    if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      destroy(this);
+    }
+  }
+
+  byte_buffer_t::buffer_metadata_t md;
+
+private:
+  byte_buffer_slab(uint8_t* storage_, uint32_t storage_len_) : storage(storage_), storage_len(storage_len_) {}
+  ~byte_buffer_slab() = default;
+
+  static void destroy(byte_buffer_slab* slab);
+
+  std::atomic<uint32_t> ref_count{1};
+  uint8_t*              storage     = nullptr;
+  uint32_t              storage_len = 0;
+  byte_buffer_t*        adopted_buf = nullptr;
+};
+
+/// Intrusive smart pointer to a byte_buffer_slab
+class byte_buffer_slab_ptr
+{
+public:
+  byte_buffer_slab_ptr() = default;
+  /// Takes ownership of the initial reference of a newly created slab
+  explicit byte_buffer_slab_ptr(byte_buffer_slab* slab_) : slab(slab_) {}
+  byte_buffer_slab_ptr(const byte_buffer_slab_ptr& other) : slab(other.slab)
+  {
+    if (slab != nullptr) {
+      slab->add_ref();
+    }
+  }
+  byte_buffer_slab_ptr(byte_buffer_slab_ptr&& other) noexcept : slab(other.slab) { other.slab = nullptr; }
+  ~byte_buffer_slab_ptr() { reset(); }
+  byte_buffer_slab_ptr& operator=(const byte_buffer_slab_ptr& other)
+  {
+    if (this != &other) {
+      byte_buffer_slab_ptr tmp(other);
+      std::swap(slab, tmp.slab);
+    }
+    return *this;
+  }
+  byte_buffer_slab_ptr& operator=(byte_buffer_slab_ptr&& other) noexcept
+  {
+    std::swap(slab, other.slab);
+    return *this;
+  }
+
+  void reset()
+  {
+    if (slab != nullptr) {
+      slab->release();
+      slab = nullptr;
+    }
+  }
+
+  byte_buffer_slab*       get() { return slab; }
+  const byte_buffer_slab* get() const { return slab; }
+  byte_buffer_slab*       operator->() { return slab; }
+  const byte_buffer_slab* operator->() const { return slab; }
+  explicit                operator bool() const { return slab != nullptr; }
+
+private:
+  byte_buffer_slab* slab = nullptr;
+};
+
+/// Contiguous range of bytes of a slab
+struct byte_buffer_segment {
+  byte_buffer_slab_ptr slab;
+  uint8_t*             data   = nullptr;
+  uint32_t             length = 0;
+
+  uint32_t tailroom() const { return slab->end() - (data + length); }
+  /// The segment is the only user of its slab and may write outside of its byte range
+  bool is_exclusive() const { return not slab->is_shared(); }
+};
+
+/******************************************************************************
+ * Byte buffer chain
+ *
+ * Scatter/gather list of slab segments. Appending another chain, slicing and
+ * trimming only adjust segment boundaries and slab reference counts, so an SDU
+ * can be segmented and concatenated into PDUs without copying its payload.
+ * Bytes are copied once, when the chain is gathered into its destination.
+ * Used by the RLC UM transmitter to segment SDUs. The other layers still pass
+ * unique_byte_buffer_t.
+ *****************************************************************************/
+template <size_t MaxSegments>
+class byte_buffer_chain_t
+{
+  template <size_t N>
+  friend class byte_buffer_chain_t;
+
+  using segment_list = bounded_vector<byte_buffer_segment, MaxSegments>;
+
+public:
+  using const_iterator = typename segment_list::const_iterator;
+
+  byte_buffer_chain_t() = default;
+  /// Adopts the bytes of "buf" without copying them
+  explicit byte_buffer_chain_t(unique_byte_buffer_t buf) { append(std::move(buf)); }
+
+  bool     empty() const { return nof_bytes == 0; }
+  bool     full() const { return segments.full(); }
+  uint32_t length() const { return nof_bytes; }
+  size_t   nof_segments() const { return segments.size(); }
+
+  const byte_buffer_segment& segment(size_t idx) const { return segments[idx]; }
+  const_iterator             begin() const { return segments.begin(); }
+  const_iterator             end() const { return segments.end(); }
+
+  void clear()
+  {
+    segments.clear();
+    nof_bytes = 0;
+  }
+
+  /// Metadata of the first slab of the chain, i.e. of the SDU it was built from
+  const byte_buffer_t::buffer_metadata_t* md() const { return segments.empty() ? nullptr : &segments[0].slab->md; }
+
+  /// Copies "len" bytes to the tail of the chain, reusing the tailroom of the last slab when possible
+  bool append(const uint8_t* src, uint32_t len)
+  {
+    if (not segments.empty() and segments.back().is_exclusive()) {
+      byte_buffer_segment& last = segments.back();
+      uint32_t             n    = std::min(len, last.tailroom());
+      memcpy(last.data + last.length, src, n);
+      last.length += n;
+      nof_bytes += n;
+      src += n;
+      len -= n;
+    }
+    while (len > 0) {
+      uint32_t             n = std::min(len, byte_buffer_slab::max_size() - byte_buffer_slab::DEFAULT_HEADROOM);
+      byte_buffer_slab_ptr slab(byte_buffer_slab::create(byte_buffer_slab::DEFAULT_HEADROOM + n));
+      if (not slab or segments.full()) {
+        return false;
+      }
+      uint8_t* data = slab->begin() + byte_buffer_slab::DEFAULT_HEADROOM;
+      memcpy(data, src, n);
+      push_segment(std::move(slab), data, n);
+      src += n;
+      len -= n;
+    }
+    return true;
+  }
+
+  /// Appends the payload of "buf" without copying it
+  bool append(unique_byte_buffer_t buf)
+  {
+    if (buf == nullptr or segments.full()) {
+      return false;
+    }
+    if (buf->N_bytes == 0) {
+      return true;
+    }
+    uint8_t*             data = buf->msg;
+    uint32_t             len  = buf->N_bytes;
+    byte_buffer_slab_ptr slab(byte_buffer_slab::adopt(std::move(buf)));
+    if (not slab) {
+      return false;
+    }
+    if (not slab->is_adopted()) {
+      // the payload was copied, as the buffer had no headroom left for the slab header
+      data = slab->begin() + byte_buffer_slab::DEFAULT_HEADROOM;
+    }
+    push_segment(std::move(slab), data, len);
+    return true;
+  }
+
+  /// Appends a view of the bytes [offset, offset + len) of "other". The underlying slabs become shared.
+  template <size_t N>
+  bool append(const byte_buffer_chain_t<N>& other, uint32_t offset, uint32_t len)
+  {
+    srsran_assert(offset + len <= other.length(), "Invalid chain slice [%d, %d)", offset, offset + len);
+    for (const byte_buffer_segment& seg : other.segments) {
+      if (len == 0) {
+        break;
+      }
+      if (offset >= seg.length) {
+        offset -= seg.length;
+        continue;
+      }
+      if (segments.full()) {
+        return false;
+      }
+      uint32_t n = std::min(seg.length - offset, len);
+      push_segment(seg.slab, seg.data + offset, n);
+      offset = 0;
+      len -= n;
+    }
+    return true;
+  }
+  template <size_t N>
+  bool append(const byte_buffer_chain_t<N>& other)
+  {
+    return append(other, 0, other.length());
+  }
+
+  /// Zero-copy view of the bytes [offset, offset + len)
+  byte_buffer_chain_t slice(uint32_t offset, uint32_t len) const
+  {
+    byte_buffer_chain_t ret;
+    ret.append(*this, offset, len);
+    return ret;
+  }
+
+  /// Removes the first "len" bytes of the chain
+  void trim_head(uint32_t len)
+  {
+    srsran_assert(len <= nof_bytes, "Trimming %d bytes from a chain of %d bytes", len, nof_bytes);
+    nof_bytes -= len;
+    auto it = segments.begin();
+    for (; it != segments.end() and len >= it->length; ++it) {
+      len -= it->length;
+    }
+    segments.erase(segments.begin(), it);
+    if (len > 0) {
+      segments[0].data += len;
+      segments[0].length -= len;
+    }
+  }
+
+  /// Gathers the chain bytes into "dst". Returns the number of bytes copied.
+  uint32_t copy_to(uint8_t* dst, uint32_t max_len) const
+  {
+    uint32_t count = 0;
+    for (const byte_buffer_segment& seg : segments) {
+      uint32_t n = std::min(seg.length, max_len - count);
+      memcpy(dst + count, seg.data, n);
+      count += n;
+      if (count == max_len) {
+        break;
+      }
+    }
+    return count;
+  }
+
+private:
+  void push_segment(byte_buffer_slab_ptr slab, uint8_t* data, uint32_t len)
+  {
+    segments.emplace_back();
+    byte_buffer_segment& seg = segments.back();
+    seg.slab                 = std::move(slab);
+    seg.data                 = data;
+    seg.length               = len;
+    nof_bytes += len;
+  }
+
+  segment_list segments;
+  uint32_t     nof_bytes = 0;
+};
+
+/// Default chain type, sized for an SDU under segmentation
+using byte_buffer_chain = byte_buffer_chain_t<16>;
+
+} // namespace srsran
+
+#endif // SRSRAN_BYTE_BUFFER_CHAIN_H
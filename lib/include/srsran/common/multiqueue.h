@@ -31,8 +31,12 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <vector>
@@ -40,6 +44,42 @@
 namespace srsran {
 
 #define MULTIQUEUE_DEFAULT_CAPACITY (8192) // Default per-queue capacity
+#define MULTIQUEUE_DEFAULT_NOF_PORTS (64)  // Initial size of the table of input ports, which grows when needed
+
+/// Histogram of the time elapsed between pushing a message to a multiqueue port and popping it.
+/// Bucket 0 counts latencies below 1 usec, and bucket i>0 latencies in [2^(i-1), 2^i) usec. The last bucket also
+/// includes all the longer latencies.
+struct multiqueue_latency_histogram {
+  static const uint32_t nof_buckets = 24;
+
+  std::array<uint64_t, nof_buckets> buckets = {};
+  uint64_t                          count   = 0;
+  uint64_t                          max_us  = 0;
+
+  static uint32_t bucket_idx(uint64_t latency_us)
+  {
+    uint32_t idx = 0;
+    while (latency_us > 0 and idx < nof_buckets - 1) {
+      latency_us >>= 1U;
+      idx++;
+    }
+    return idx;
+  }
+
+  /// Upper bound, in usec, of the bucket where the given percentile (0-100) of the samples falls
+  uint64_t percentile_us(double perc) const
+  {
+    uint64_t target = static_cast<uint64_t>(count * perc / 100.0);
+    uint64_t acc    = 0;
+    for (uint32_t i = 0; i < nof_buckets; ++i) {
+      acc += buckets[i];
+      if (acc > target) {
+        return i == nof_buckets - 1 ? max_us : (1U << i);
+      }
+    }
+    return max_us;
+  }
+};
 
 /**
  * N-to-1 Message-Passing Broker that manages the creation, destruction of input ports, and popping of messages that
@@ -48,6 +88,8 @@ namespace srsran {
  * The class will pop from the several created ports in a round-robin fashion.
  * The popping() interface is not safe-thread. That means, that it is expected that only one thread will
  * be popping tasks.
+ * Each port is a lock-free bounded multi-producer single-consumer ring. Locks are only taken when a producer blocks
+ * on a full port, when the consumer goes to sleep waiting for messages, and when ports are added/removed.
  * @tparam myobj message type
  */
 template <typename myobj>
@@ -56,37 +98,47 @@ class multiqueue_handler
   class input_port_impl
   {
   public:
-    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : buffer(cap), parent(parent_) {}
+    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : parent(parent_), cap_(cap)
+    {
+      size_t ring_size = 1;
+      while (ring_size < cap) {
+        ring_size <<= 1U;
+      }
+      cells.reset(new cell_t[ring_size]);
+      mask = ring_size - 1;
+      for (size_t i = 0; i < ring_size; ++i) {
+        cells[i].seq.store(i, std::memory_order_relaxed);
+      }
+    }
     input_port_impl(const input_port_impl&) = delete;
     input_port_impl(input_port_impl&&)      = delete;
     input_port_impl& operator=(const input_port_impl&) = delete;
     input_port_impl& operator=(input_port_impl&&) = delete;
-    ~input_port_impl() { deactivate_blocking(); }
-
-    size_t capacity() const { return buffer.max_size(); }
-    size_t size() const
+    ~input_port_impl()
     {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return buffer.size();
+      deactivate_blocking();
+      clear();
     }
-    bool active() const
+
+    size_t capacity() const { return cap_; }
+    size_t size() const
     {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return active_;
+      size_t tail = dequeue_pos.load(std::memory_order_acquire);
+      size_t head = enqueue_pos.load(std::memory_order_acquire);
+      return head > tail ? head - tail : 0;
     }
+    bool active() const { return active_.load(std::memory_order_acquire); }
     void set_active(bool val)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (val == active_) {
+      if (active_.exchange(val, std::memory_order_seq_cst) == val) {
         // no-op
         return;
       }
-      active_ = val;
 
-      if (not active_) {
-        buffer.clear();
-        lock.unlock();
+      if (not val) {
+        clear();
         // unlock blocked pushing threads
+        std::lock_guard<std::mutex> lock(q_mutex);
         cv_full.notify_all();
       }
     }
@@ -95,11 +147,12 @@ class multiqueue_handler
     {
       set_active(false);
 
-      // wait for all the pushers to unlock
-      std::unique_lock<std::mutex> lock(q_mutex);
-      while (nof_waiting > 0) {
-        cv_exit.wait(lock);
+      // wait for all the pushers to leave, and discard what they may have pushed in the meantime. Blocked pushers were
+      // already woken up, so this wait is short
+      while (nof_pushing.load(std::memory_order_seq_cst) > 0) {
+        std::this_thread::yield();
       }
+      clear();
     }
 
     template <typename T>
@@ -118,67 +171,126 @@ class multiqueue_handler
       return {std::move(o)};
     }
 
+    /// Only called by the consumer thread. Fails if the port is being cleared by another thread
     bool try_pop(myobj& obj)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
+      if (pop_lock.exchange(true, std::memory_order_acquire)) {
+        return false;
+      }
+      bool ret = pop_(obj);
+      pop_lock.store(false, std::memory_order_release);
+      return ret;
     }
 
-    bool try_pop(myobj& obj, bool& try_lock_success)
+  private:
+    struct cell_t {
+      std::atomic<size_t>                   seq;
+      std::chrono::steady_clock::time_point tp;
+      detail::type_storage<myobj>           obj;
+    };
+
+    template <typename T>
+    bool push_(T* o, bool blocking) noexcept
     {
-      std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
-      try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      nof_pushing.fetch_add(1, std::memory_order_seq_cst);
+      bool ret = active() and enqueue_(o);
+      if (not ret and blocking and active()) {
+        std::unique_lock<std::mutex> lock(q_mutex);
+        nof_waiting.fetch_add(1, std::memory_order_seq_cst);
+        while (active() and not(ret = enqueue_(o))) {
+          cv_full.wait(lock);
+        }
+        nof_waiting.fetch_sub(1, std::memory_order_relaxed);
+      }
+      if (ret) {
+        parent->notify_push_();
+      }
+      // the port may be recycled as soon as the counter is decremented
+      nof_pushing.fetch_sub(1, std::memory_order_seq_cst);
+      return ret;
     }
 
-  private:
     template <typename T>
-    bool push_(T* o, bool blocking) noexcept
+    bool enqueue_(T* o)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (not blocking) {
-        // non-blocking case
-        if (not active_ or buffer.full()) {
+      size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+      while (true) {
+        if (pos - dequeue_pos.load(std::memory_order_acquire) >= cap_) {
           return false;
         }
-      } else {
-        // blocking case
-        while (active_ and buffer.full()) {
-          nof_waiting++;
-          cv_full.wait(lock);
-          nof_waiting--;
-        }
-        if (not active_) {
-          lock.unlock();
-          cv_exit.notify_one();
+        cell_t&  cell = cells[pos & mask];
+        size_t   seq  = cell.seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+          if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            cell.obj.emplace(std::forward<T>(*o));
+            cell.tp = parent->latency_enabled.load(std::memory_order_relaxed) ? std::chrono::steady_clock::now()
+                                                                              : std::chrono::steady_clock::time_point{};
+            cell.seq.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        } else if (diff < 0) {
           return false;
+        } else {
+          pos = enqueue_pos.load(std::memory_order_relaxed);
         }
       }
-      buffer.push(std::forward<T>(*o));
-      return true;
     }
 
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
+    // The latency is only recorded by the consumer thread, clear() may run in other threads
+    bool pop_(myobj& obj, bool record_latency = true)
     {
-      if (buffer.empty()) {
+      size_t  pos  = dequeue_pos.load(std::memory_order_relaxed);
+      cell_t& cell = cells[pos & mask];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
         return false;
       }
-      obj = std::move(buffer.top());
-      buffer.pop();
-      if (nof_waiting > 0) {
-        lock.unlock();
+      obj = std::move(cell.obj.get());
+      cell.obj.destroy();
+      if (record_latency and cell.tp != std::chrono::steady_clock::time_point{}) {
+        parent->record_latency_(cell.tp);
+      }
+      cell.seq.store(pos + mask + 1, std::memory_order_release);
+      dequeue_pos.store(pos + 1, std::memory_order_release);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (nof_waiting.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(q_mutex);
         cv_full.notify_one();
       }
       return true;
     }
 
+    void clear()
+    {
+      while (pop_lock.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      myobj obj;
+      while (pop_(obj, false)) {
+      }
+      pop_lock.store(false, std::memory_order_release);
+    }
+
     multiqueue_handler<myobj>* parent = nullptr;
 
-    mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
-    std::condition_variable            cv_full, cv_exit;
-    bool                               active_     = true;
-    int                                nof_waiting = 0;
+    const size_t              cap_;
+    size_t                    mask = 0;
+    std::unique_ptr<cell_t[]> cells;
+    // Padding keeps the producer and consumer positions in different cache lines (alignas would make the port an
+    // over-aligned type, which can't be heap allocated in C++14)
+    char                pad0[64];
+    std::atomic<size_t> enqueue_pos{0};
+    char                pad1[64];
+    std::atomic<size_t> dequeue_pos{0};
+    char                pad2[64];
+    std::atomic<bool>   pop_lock{false};
+    std::atomic<bool>   active_{true};
+    std::atomic<int>    nof_pushing{0}, nof_waiting{0};
+
+    // slow path, used when the port is full or deactivated
+    mutable std::mutex      q_mutex;
+    std::condition_variable cv_full;
   };
 
 public:
@@ -223,23 +335,26 @@ public:
 
   explicit multiqueue_handler(uint32_t default_capacity_ = MULTIQUEUE_DEFAULT_CAPACITY) :
     default_capacity(default_capacity_)
-  {}
+  {
+    grow_ports_(MULTIQUEUE_DEFAULT_NOF_PORTS);
+  }
   ~multiqueue_handler() { stop(); }
 
   void stop()
   {
     std::unique_lock<std::mutex> lock(mutex);
-    running = false;
+    running.store(false, std::memory_order_seq_cst);
     for (auto& q : queues) {
       // signal deactivation to pushing threads in a non-blocking way
-      q.set_active(false);
-    }
-    while (consumer_state) {
-      cv_exit.wait(lock);
+      q->set_active(false);
     }
+    // wake up the consumer, and wait for it to leave
+    cv_pop.notify_all();
+    cv_exit.wait(lock, [this]() { return not consumer_state.load(std::memory_order_seq_cst); });
+    lock.unlock();
     for (auto& q : queues) {
       // ensure the queues are finished being deactivated
-      q.deactivate_blocking();
+      q->deactivate_blocking();
     }
   }
 
@@ -255,19 +370,23 @@ public:
     if (not running) {
       return queue_handle();
     }
-    while (qidx < queues.size() and (queues[qidx].active() or (queues[qidx].capacity() != capacity_))) {
+    while (qidx < queues.size() and (queues[qidx]->active() or (queues[qidx]->capacity() != capacity_))) {
       ++qidx;
     }
 
     // check if there is a free queue of the required size
     if (qidx == queues.size()) {
-      // create new queue
-      queues.emplace_back(capacity_, this);
-      qidx = queues.size() - 1; // update qidx to the last element
+      if (qidx == ports_capacity) {
+        grow_ports_(2 * ports_capacity);
+      }
+      // create new queue, and publish it to the consumer
+      queues.emplace_back(new input_port_impl(capacity_, this));
+      ports.load(std::memory_order_relaxed)[qidx].store(queues.back().get(), std::memory_order_relaxed);
+      nof_ports.store(qidx + 1, std::memory_order_release);
     } else {
-      queues[qidx].set_active(true);
+      queues[qidx]->set_active(true);
     }
-    return queue_handle(&queues[qidx]);
+    return queue_handle(queues[qidx].get());
   }
 
   /**
@@ -281,65 +400,137 @@ public:
     std::lock_guard<std::mutex> lock(mutex);
     uint32_t                    count = 0;
     for (uint32_t i = 0; i < queues.size(); ++i) {
-      count += queues[i].active() ? 1 : 0;
+      count += queues[i]->active() ? 1 : 0;
     }
     return count;
   }
 
   bool wait_pop(myobj* value)
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    consumer_state = true;
-    while (running) {
+    consumer_state.store(true, std::memory_order_seq_cst);
+    while (running.load(std::memory_order_seq_cst)) {
       if (round_robin_pop_(value)) {
-        consumer_state = false;
+        leave_consumer_();
+        return true;
+      }
+
+      // go to sleep, until a producer signals a new message
+      std::unique_lock<std::mutex> lock(mutex);
+      consumer_sleeping.store(true, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      bool popped = false;
+      if (running.load(std::memory_order_relaxed)) {
+        popped = round_robin_pop_(value);
+        if (not popped) {
+          cv_pop.wait(lock);
+          consumer_sleeping.store(false, std::memory_order_relaxed);
+          continue;
+        }
+      }
+      consumer_sleeping.store(false, std::memory_order_relaxed);
+      if (popped) {
+        // the popped value is returned even if the multiqueue was stopped in the meantime
+        lock.unlock();
+        leave_consumer_();
         return true;
       }
-      lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      lock.lock();
     }
-    consumer_state = false;
-    lock.unlock();
-    cv_exit.notify_one();
+    leave_consumer_();
     return false;
   }
 
-  bool try_pop(myobj* value)
+  bool try_pop(myobj* value) { return running.load(std::memory_order_acquire) and round_robin_pop_(value); }
+
+  /// Enables/disables the collection of the enqueue-to-dequeue latency of the messages
+  void enable_latency_histogram(bool enabled) { latency_enabled.store(enabled, std::memory_order_relaxed); }
+
+  multiqueue_latency_histogram get_latency_histogram() const
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    return running and round_robin_pop_(value);
+    multiqueue_latency_histogram ret;
+    for (uint32_t i = 0; i < multiqueue_latency_histogram::nof_buckets; ++i) {
+      ret.buckets[i] = latency_buckets[i].load(std::memory_order_relaxed);
+      ret.count += ret.buckets[i];
+    }
+    ret.max_us = latency_max_us.load(std::memory_order_relaxed);
+    return ret;
   }
 
 private:
   bool round_robin_pop_(myobj* value)
   {
-    // Round-robin for all queues
-    auto     q_it  = queues.begin() + spin_idx;
-    uint32_t count = 0;
-    for (; count < queues.size(); ++count, ++q_it) {
-      if (q_it == queues.end()) {
-        q_it = queues.begin(); // wrap-around
-      }
-      bool try_lock_success = true;
-      if (q_it->try_pop(*value, try_lock_success)) {
-        spin_idx = (spin_idx + count + 1) % queues.size();
+    // Round-robin for all queues. The port table is loaded after its size, so that it holds at least n ports
+    uint32_t                       n     = nof_ports.load(std::memory_order_acquire);
+    std::atomic<input_port_impl*>* table = ports.load(std::memory_order_acquire);
+    for (uint32_t count = 0; count < n; ++count) {
+      uint32_t idx = (spin_idx + count) % n;
+      if (table[idx].load(std::memory_order_relaxed)->try_pop(*value)) {
+        spin_idx = (idx + 1) % n;
         return true;
       }
-      if (not try_lock_success) {
-        // restart RR search, as there was a collision with a producer
-        count = 0;
-      }
     }
     return false;
   }
 
-  mutable std::mutex          mutex;
-  std::condition_variable     cv_exit;
-  uint32_t                    spin_idx = 0;
-  bool                        running = true, consumer_state = false;
-  std::deque<input_port_impl> queues;
-  uint32_t                    default_capacity = 0;
+  /// Replaces the table of ports by a larger copy. Called with the mutex locked
+  void grow_ports_(uint32_t new_capacity)
+  {
+    std::unique_ptr<std::atomic<input_port_impl*>[]> table(new std::atomic<input_port_impl*>[new_capacity]);
+    for (uint32_t i = 0; i < queues.size(); ++i) {
+      table[i].store(queues[i].get(), std::memory_order_relaxed);
+    }
+    ports.store(table.get(), std::memory_order_release);
+    port_tables.push_back(std::move(table));
+    ports_capacity = new_capacity;
+  }
+
+  void notify_push_()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_sleeping.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cv_pop.notify_one();
+    }
+  }
+
+  void leave_consumer_()
+  {
+    consumer_state.store(false, std::memory_order_seq_cst);
+    if (not running.load(std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cv_exit.notify_all();
+    }
+  }
+
+  // Only called by the consumer thread
+  void record_latency_(std::chrono::steady_clock::time_point tp)
+  {
+    uint64_t latency_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tp).count();
+    std::atomic<uint64_t>& bucket = latency_buckets[multiqueue_latency_histogram::bucket_idx(latency_us)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (latency_us > latency_max_us.load(std::memory_order_relaxed)) {
+      latency_max_us.store(latency_us, std::memory_order_relaxed);
+    }
+  }
+
+  mutable std::mutex      mutex;
+  std::condition_variable cv_exit, cv_pop;
+  uint32_t                spin_idx = 0;
+  std::atomic<bool>       running{true}, consumer_state{false}, consumer_sleeping{false};
+  uint32_t                default_capacity = 0;
+
+  // Ports are only created under the mutex, and published to the consumer through nof_ports. Tables replaced by a
+  // larger one are kept until destruction, as the consumer may still be scanning them
+  std::vector<std::unique_ptr<input_port_impl> >                  queues;
+  std::vector<std::unique_ptr<std::atomic<input_port_impl*>[]> > port_tables;
+  std::atomic<std::atomic<input_port_impl*>*>                     ports{nullptr};
+  uint32_t                                                        ports_capacity = 0;
+  std::atomic<uint32_t>                                           nof_ports{0};
+
+  // Enqueue-to-dequeue latency
+  std::atomic<bool>                                                            latency_enabled{false};
+  std::array<std::atomic<uint64_t>, multiqueue_latency_histogram::nof_buckets> latency_buckets{};
+  std::atomic<uint64_t>                                                        latency_max_us{0};
 };
 
 template <typename T>
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SECURITY_ENGINE_H
+#define SRSRAN_SECURITY_ENGINE_H
+
+#include "srsran/common/ssl.h"
+#include <cstdint>
+
+namespace srsran {
+
+/**
+ * 128-EEA2 (AES-CTR) and 128-EIA2 (AES-CMAC) engine bound to one AES-128 key, e.g. a PDCP bearer key.
+ * The AES key schedule and the CMAC subkeys are derived once in set_key(), instead of once per PDU.
+ * If the target supports AES-NI, the CTR keystream is generated four blocks at a time. Otherwise, the mbedtls AES
+ * is used.
+ * Lengths are in bytes, as in the PDCP.
+ */
+class aes128_security_engine
+{
+public:
+  /// Returns true if the AES-NI implementation was compiled in
+  static bool is_accelerated();
+
+  void set_key(const uint8_t* key);
+  bool is_set() const { return key_set; }
+
+  void eea2(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t len, uint8_t* out) const;
+  void eia2(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t len, uint8_t* mac) const;
+
+private:
+  alignas(16) uint8_t round_keys[11][16] = {};
+  uint8_t             k1[16]             = {};
+  uint8_t             k2[16]             = {};
+  mutable aes_context ctx                = {};
+  bool                key_set            = false;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SECURITY_ENGINE_H
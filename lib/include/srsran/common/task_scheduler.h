@@ -104,6 +104,30 @@ public:
 
   srsran::timer_handler* get_timer_handler() { return &timers; }
 
+  //! Enables measuring the time external tasks wait in their queues before being run
+  void enable_task_latency_histogram(bool enabled) { external_tasks.enable_latency_histogram(enabled); }
+
+  srsran::multiqueue_latency_histogram get_task_latency_histogram() const
+  {
+    return external_tasks.get_latency_histogram();
+  }
+
+  //! Logs the percentiles of the external task queueing latency, if any was measured
+  void print_task_latency(srslog::basic_logger& logger) const
+  {
+    srsran::multiqueue_latency_histogram hist = external_tasks.get_latency_histogram();
+    if (hist.count == 0) {
+      return;
+    }
+    logger.info("Task queue latency: %" PRIu64 " tasks, 50th/90th/99th percentile <%" PRIu64 "/%" PRIu64 "/%" PRIu64
+                " us, max %" PRIu64 " us",
+                hist.count,
+                hist.percentile_us(50),
+                hist.percentile_us(90),
+                hist.percentile_us(99),
+                hist.max_us);
+  }
+
 private:
   // Perform pending stack deferred tasks
   void run_all_internal_tasks()
@@ -34,6 +34,7 @@
 #include "srsran/srslog/srslog.h"
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -153,6 +154,105 @@ private:
   bool                                    running = false;
 };
 
+/**
+ * Task pool with the same interface as task_thread_pool, where each worker owns a lock-free bounded task queue.
+ * Producers distribute tasks round-robin among the worker queues (tasks pushed from inside a worker go to its own
+ * queue), so that they do not contend on a single lock. An idle worker first drains its own queue, then steals from
+ * the queues of the other workers, spins for a short time with exponential backoff and only then goes to sleep.
+ * When all worker queues are full, tasks are kept in a mutex-protected overflow queue instead of being dropped.
+ * Workers can optionally be pinned to specific CPU cores.
+ */
+class work_stealing_thread_pool
+{
+  using task_t = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+  static constexpr uint32_t max_task_shift = 14;
+  static constexpr uint32_t max_task_num   = 1u << max_task_shift;
+
+public:
+  work_stealing_thread_pool(uint32_t nof_workers    = 1,
+                            bool     start_deferred = false,
+                            int32_t  prio_          = -1,
+                            uint32_t mask_          = 255);
+  work_stealing_thread_pool(const work_stealing_thread_pool&) = delete;
+  work_stealing_thread_pool(work_stealing_thread_pool&&)      = delete;
+  work_stealing_thread_pool& operator=(const work_stealing_thread_pool&) = delete;
+  work_stealing_thread_pool& operator=(work_stealing_thread_pool&&) = delete;
+  ~work_stealing_thread_pool();
+
+  void stop();
+  void start(int32_t prio_ = -1, uint32_t mask_ = 255);
+  /// Pins worker i to core cpus[i % cpus.size()]. Takes precedence over the CPU mask. Must be called before start()
+  void set_worker_cpus(std::vector<uint32_t> cpus);
+
+  void     push_task(task_t&& task);
+  uint32_t nof_pending_tasks() const;
+  size_t   nof_workers() const { return workers.size(); }
+
+private:
+  /// Bounded multi-producer multi-consumer queue, based on per-cell sequence numbers
+  class task_queue
+  {
+  public:
+    explicit task_queue(uint32_t capacity);
+
+    bool try_push(task_t& task);
+    bool try_pop(task_t& task);
+
+  private:
+    struct cell_t {
+      std::atomic<size_t> seq;
+      task_t              task;
+    };
+
+    std::unique_ptr<cell_t[]> cells;
+    const size_t              mask;
+    // Padding keeps the producer and consumer positions in different cache lines. It is used instead of alignas, as
+    // over-aligned types can't be heap allocated in C++14
+    char                pad0[64];
+    std::atomic<size_t> enqueue_pos{0};
+    char                pad1[64];
+    std::atomic<size_t> dequeue_pos{0};
+  };
+
+  class worker_t : public thread
+  {
+  public:
+    explicit worker_t(work_stealing_thread_pool* parent_, uint32_t id);
+    void     stop();
+    uint32_t id() const { return id_; }
+
+    void run_thread() override;
+
+  private:
+    bool try_get_task(task_t& task);
+    bool wait_task(task_t& task);
+
+    work_stealing_thread_pool* parent = nullptr;
+    uint32_t                   id_    = 0;
+  };
+
+  int32_t               prio = -1;
+  uint32_t              mask = 255;
+  std::vector<uint32_t> worker_cpus;
+  srslog::basic_logger& logger;
+
+  std::vector<std::unique_ptr<task_queue> > queues;
+  std::vector<std::unique_ptr<worker_t> >   workers;
+  std::atomic<uint32_t>                     next_queue{0};
+  std::atomic<int32_t>                      nof_pending{0};
+  std::atomic<uint32_t>                     nof_sleeping{0};
+  std::atomic<bool>                         running{false};
+
+  // Unbounded queue for the tasks that do not fit in any worker queue
+  std::mutex            overflow_mutex;
+  std::deque<task_t>    overflow_tasks;
+  std::atomic<uint32_t> nof_overflow{0};
+
+  // Only used to put idle workers to sleep
+  std::mutex              sleep_mutex;
+  std::condition_variable cv_sleep;
+};
+
 /// Class used to create a single worker with an input task queue with a single reader
 class task_worker : public thread
 {
@@ -56,20 +56,29 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - A hierarchical time wheel, storing the currently running timers by their respective timeout value. The first
+ *   level has one slot per tic, and each of the next levels has slots 64x coarser than the previous level.
+ *   A timer is inserted in the level that matches the distance to its timeout, so timer start/stop are O(1).
+ *   When the index of a level wraps around, the timers of the current slot of the next level are lazily cascaded down
+ *   to the finer levels. Thus, step_all() only visits the timers that expire in the current tic, plus the occasional
+ *   cascading of coarse timers, independently of the total number of running timers.
+ * The backend lock can be elided by constructing the timer_handler with thread_safe=false, when the timers are only
+ * created, accessed and stepped from the owner thread.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
-  constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
-  constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
-  constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static uint32_t INVALID_ID       = std::numeric_limits<uint32_t>::max();
+  constexpr static size_t   WHEEL_L0_SHIFT   = 8U;
+  constexpr static size_t   WHEEL_L0_SIZE    = 1U << WHEEL_L0_SHIFT;
+  constexpr static size_t   WHEEL_L0_MASK    = WHEEL_L0_SIZE - 1U;
+  constexpr static size_t   WHEEL_LN_SHIFT   = 6U;
+  constexpr static size_t   WHEEL_LN_SIZE    = 1U << WHEEL_LN_SHIFT;
+  constexpr static size_t   WHEEL_LN_MASK    = WHEEL_LN_SIZE - 1U;
+  constexpr static size_t   WHEEL_NOF_LEVELS = 5U; ///< 8 + 4 * 6 bits cover the whole tic_t range
+  constexpr static size_t   WHEEL_SIZE       = WHEEL_L0_SIZE + (WHEEL_NOF_LEVELS - 1U) * WHEEL_LN_SIZE;
+  constexpr static size_t   EXPIRING_LIST    = WHEEL_SIZE; ///< holds timers being expired in the current step_all()
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -91,7 +100,8 @@ class timer_handler
     timer_handler& parent;
     // writes protected by backend lock
     bool                                  allocated = false;
-    std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
+    uint16_t                              wheel_pos = 0; ///< index of the wheel list holding the timer, if running
+    std::atomic<uint64_t>                 state{0};      ///< read can be without lock, thus writes must be atomic
     srsran::move_callback<void(uint32_t)> callback;
 
     explicit timer_impl(timer_handler& parent_, uint32_t id_) : parent(parent_), id(id_) {}
@@ -119,7 +129,7 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       set_(duration_);
     }
 
@@ -129,27 +139,27 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       set_(duration_);
       callback = std::move(callback_);
     }
 
     void run()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       parent.start_run_(*this);
     }
 
     void stop()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       // does not call callback
       parent.stop_timer_(*this, false);
     }
 
     void deallocate()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       parent.dealloc_timer_(*this);
     }
 
@@ -232,9 +242,11 @@ public:
     timer_impl* handle = nullptr;
   };
 
-  explicit timer_handler(uint32_t capacity = 64)
+  /// \param capacity number of timers to pre-allocate
+  /// \param thread_safe_ if false, the backend lock is elided. Only valid if all accesses come from the owner thread
+  explicit timer_handler(uint32_t capacity = 64, bool thread_safe_ = true) : thread_safe(thread_safe_)
   {
-    time_wheel.resize(WHEEL_SIZE);
+    time_wheel.resize(WHEEL_SIZE + 1);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -248,25 +260,42 @@ public:
 
   void step_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
+    std::unique_lock<std::mutex> lock           = lock_();
     uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
-
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
-
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
+
+    // Lazily move the coarse timers of the upper levels down, once the first level index wraps around
+    if ((cur_time_local & WHEEL_L0_MASK) == 0) {
+      cascade_(cur_time_local);
+    }
+
+    // Detach the timers of the current slot. Timers started from within the callbacks are inserted in the wheel
+    // relative to the next tic, so they never end up in the list being expired.
+    auto& wheel_list    = time_wheel[cur_time_local & WHEEL_L0_MASK];
+    auto& expiring_list = time_wheel[EXPIRING_LIST];
+    while (not wheel_list.empty()) {
+      timer_impl& timer = wheel_list.front();
+      wheel_list.pop_front();
+      expiring_list.push_front(&timer);
+      timer.wheel_pos = EXPIRING_LIST;
+    }
+    wheel_base = cur_time_local + 1;
+
+    while (not expiring_list.empty()) {
+      timer_impl& timer = expiring_list.front();
+      // stop timer (callback has to see the timer has already expired)
+      stop_timer_(timer, true);
+
+      // Call callback if configured
+      if (not timer.callback.is_empty()) {
+        // unlock mutex. It can happen that the callback tries to run a timer too
+        if (thread_safe) {
           lock.unlock();
+        }
 
-          timer.callback(timer.id);
+        timer.callback(timer.id);
 
-          // Lock again to keep protecting the wheel
+        // Lock again to keep protecting the wheel
+        if (thread_safe) {
           lock.lock();
         }
       }
@@ -277,7 +306,7 @@ public:
 
   void stop_all()
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    auto lock = lock_();
     // does not call callback
     for (timer_impl& timer : timer_list) {
       stop_timer_(timer, false);
@@ -288,13 +317,13 @@ public:
 
   uint32_t nof_timers() const
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    auto lock = lock_();
     return timer_list.size() - nof_free_timers;
   }
 
   uint32_t nof_running_timers() const
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    auto lock = lock_();
     return nof_timers_running_;
   }
 
@@ -313,14 +342,19 @@ public:
     timer.run();
   }
 
-  // useful for testing
-  static size_t get_wheel_size() { return WHEEL_SIZE; }
+  // useful for testing. Returns the number of tics covered by the first level of the wheel
+  static size_t get_wheel_size() { return WHEEL_L0_SIZE; }
 
 private:
+  std::unique_lock<std::mutex> lock_() const
+  {
+    return thread_safe ? std::unique_lock<std::mutex>(mutex) : std::unique_lock<std::mutex>(mutex, std::defer_lock);
+  }
+
   timer_impl& alloc_timer()
   {
-    std::lock_guard<std::mutex> lock(mutex);
-    timer_impl*                 t;
+    auto        lock = lock_();
+    timer_impl* t;
     if (not free_list.empty()) {
       t = &free_list.front();
       srsran_assert(not t->allocated, "Invalid timer id=%d state", t->id);
@@ -355,28 +389,57 @@ private:
     uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
     duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
     uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-      return;
-    }
 
     // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+    if (decode_is_running(timer_old_state)) {
+      time_wheel[timer.wheel_pos].pop(&timer);
       nof_timers_running_--;
     }
 
     // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
+    wheel_insert_(timer, new_timeout);
     timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
     nof_timers_running_++;
   }
 
+  /// Inserts timer in the wheel level that matches the distance between its timeout and the next tic to be processed
+  void wheel_insert_(timer_impl& timer, tic_t timeout)
+  {
+    // Timeouts already reached (e.g. timer restarted from within an expiry callback) are processed in the next tic
+    tic_t      pos_time = static_cast<int32_t>(timeout - wheel_base) < 0 ? wheel_base : timeout;
+    tic_diff_t delta    = pos_time - wheel_base;
+    size_t     pos      = pos_time & WHEEL_L0_MASK;
+    if (delta >= WHEEL_L0_SIZE) {
+      size_t offset = WHEEL_L0_SIZE, shift = WHEEL_L0_SHIFT;
+      while (offset + WHEEL_LN_SIZE < WHEEL_SIZE and (delta >> (shift + WHEEL_LN_SHIFT)) != 0) {
+        offset += WHEEL_LN_SIZE;
+        shift += WHEEL_LN_SHIFT;
+      }
+      pos = offset + ((pos_time >> shift) & WHEEL_LN_MASK);
+    }
+    time_wheel[pos].push_front(&timer);
+    timer.wheel_pos = pos;
+  }
+
+  /// Re-inserts the timers of the current slot of the upper levels, starting from the second level, and moving up
+  /// while the index of the level below wraps around
+  void cascade_(tic_t base)
+  {
+    size_t shift = WHEEL_L0_SHIFT;
+    for (size_t offset = WHEEL_L0_SIZE; offset < WHEEL_SIZE; offset += WHEEL_LN_SIZE, shift += WHEEL_LN_SHIFT) {
+      size_t idx        = (base >> shift) & WHEEL_LN_MASK;
+      auto&  wheel_list = time_wheel[offset + idx];
+      while (not wheel_list.empty()) {
+        timer_impl& timer = wheel_list.front();
+        wheel_list.pop_front();
+        wheel_insert_(timer, decode_timeout(timer.state.load(std::memory_order_relaxed)));
+      }
+      if (idx != 0) {
+        break;
+      }
+    }
+  }
+
   /// called when user manually stops timer (as an alternative to expiry)
   void stop_timer_(timer_impl& timer, bool expiry)
   {
@@ -387,19 +450,21 @@ private:
 
     // If already running, need to disconnect it from previous wheel
     uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+    time_wheel[timer.wheel_pos].pop(&timer);
     uint64_t new_state =
         encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
     timer.state.store(new_state, std::memory_order_relaxed);
     nof_timers_running_--;
   }
 
+  const bool         thread_safe = true;
   std::atomic<tic_t> cur_time{0};
+  tic_t              wheel_base          = 1; ///< next tic to be processed by the wheel
   size_t             nof_timers_running_ = 0, nof_free_timers = 0;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
   std::deque<timer_impl>                                         timer_list;
   srsran::intrusive_forward_list<timer_impl>                     free_list;
-  std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel;
+  std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel; ///< all levels, plus the expiring list
   mutable std::mutex                                             mutex; // Protect priority queue
 };
 
@@ -104,6 +104,8 @@ struct phy_args_t {
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  uint32_t    nof_search_threads           = 0;
+  uint32_t    cell_search_cache_ms         = 0;
 
   bool nr_store_pdsch_ko = false;
 
@@ -29,8 +29,12 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -41,6 +45,10 @@ public:
     // General
     bool enable = false;
 
+    // Number of threads processing the channels in parallel, the caller thread included. Channel i is processed by
+    // thread i % nof_threads
+    uint32_t nof_threads = 1;
+
     // AWGN options
     bool  awgn_enable            = false;
     float awgn_signal_power_dBfs = 0.0f;
@@ -76,18 +84,37 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  void run_channel(uint32_t i);
+  void run_worker(uint32_t worker_idx);
+  void worker_thread(uint32_t worker_idx);
+
   srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  float                    hst_init_phase                  = 0.0f;
+  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS]     = {};
+  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_awgn_t*   awgn[SRSRAN_MAX_CHANNELS]       = {};
+  srsran_channel_hst_t*    hst[SRSRAN_MAX_CHANNELS]        = {};
+  srsran_channel_rlf_t*    rlf                             = nullptr;
+  cf_t*                    buffer_in[SRSRAN_MAX_CHANNELS]  = {};
+  cf_t*                    buffer_out[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                 nof_channels                    = 0;
+  uint32_t                 current_srate                   = 0;
+  args_t                   args                            = {};
+
+  // Current run() call, shared with the workers
+  cf_t**                    job_in  = nullptr;
+  cf_t**                    job_out = nullptr;
+  uint32_t                  job_len = 0;
+  const srsran_timestamp_t* job_t   = nullptr;
+
+  // Workers processing the channels that are not assigned to the caller thread
+  std::vector<std::thread> workers;
+  std::mutex               workers_mutex;
+  std::condition_variable  cvar_start;
+  std::condition_variable  cvar_done;
+  uint64_t                 job_count   = 0;
+  uint32_t                 nof_pending = 0;
+  bool                     running     = true;
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
@@ -67,6 +67,17 @@ typedef struct SRSRAN_API {
   srsran_dft_mode_t mode;    // Complex/Real
 } srsran_dft_plan_t;
 
+#define SRSRAN_DFT_MAX_BATCH_DIMS 4
+
+/**
+ * Batch dimension of a Guru DFT plan: n transforms whose input and output are separated by idist and odist samples.
+ */
+typedef struct SRSRAN_API {
+  int n;     // Number of transforms
+  int idist; // Input distance between consecutive transforms
+  int odist; // Output distance between consecutive transforms
+} srsran_dft_batch_dim_t;
+
 SRSRAN_API int srsran_dft_plan(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t type);
 
 SRSRAN_API int srsran_dft_plan_c(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
@@ -82,6 +93,18 @@ SRSRAN_API int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
                                       int                idist,
                                       int                odist);
 
+/**
+ * @brief Creates a Guru DFT plan that runs, with a single execution, a batch of contiguous transforms described by up
+ * to SRSRAN_DFT_MAX_BATCH_DIMS nested dimensions (for example symbols, slots and antenna ports).
+ */
+SRSRAN_API int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t*            plan,
+                                            int                           dft_points,
+                                            srsran_dft_dir_t              dir,
+                                            cf_t*                         in_buffer,
+                                            cf_t*                         out_buffer,
+                                            int                           nof_dims,
+                                            const srsran_dft_batch_dim_t* dims);
+
 SRSRAN_API int srsran_dft_plan_r(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
 
 SRSRAN_API int srsran_dft_replan(srsran_dft_plan_t* plan, const int new_dft_points);
@@ -112,6 +135,26 @@ SRSRAN_API void srsran_dft_plan_set_norm(srsran_dft_plan_t* plan, bool val);
 
 SRSRAN_API void srsran_dft_plan_set_dc(srsran_dft_plan_t* plan, bool val);
 
+/* Wisdom */
+
+/**
+ * @brief Path of the system wide FFTW wisdom file, imported when the library is loaded. It is given by the
+ * SRSRAN_FFTW_WISDOM environment variable or, if not set, by the FFTW_SYSTEM_WISDOM_FILE build option
+ */
+SRSRAN_API const char* srsran_dft_system_wisdom_file();
+
+/**
+ * @brief Imports the FFTW wisdom of a file, so that the following plans of the same problems are created instantly
+ * @return 0 on success, -1 otherwise
+ */
+SRSRAN_API int srsran_dft_import_wisdom(const char* path);
+
+/**
+ * @brief Exports all the accumulated FFTW wisdom into a file. The file is replaced atomically
+ * @return 0 on success, -1 otherwise
+ */
+SRSRAN_API int srsran_dft_export_wisdom(const char* path);
+
 /* Compute DFT */
 
 SRSRAN_API void srsran_dft_run(srsran_dft_plan_t* plan, const void* in, void* out);
@@ -45,6 +45,11 @@
  *
  * This structure must be used with init functions srsran_ofdm_rx_init_cfg and srsran_ofdm_tx_init_cfg. These provide
  * more flexible options.
+ *
+ * If nof_ports is greater than one, the input and output buffers of port p start at in_buffer + p * in_port_stride and
+ * out_buffer + p * out_port_stride, and srsran_ofdm_rx_sf/srsran_ofdm_tx_sf transform the normal subframes of all the
+ * ports with a single DFT plan execution. The default strides are the maximum subframe length of the buffer, in time
+ * or frequency domain. The number of ports and the strides are set in the first initialization only.
  */
 typedef struct SRSRAN_API {
   // Compulsory parameters
@@ -62,6 +67,9 @@ typedef struct SRSRAN_API {
   bool             keep_dc;          ///< If true, it does not remove the DC
   double           phase_compensation_hz; ///< Carrier frequency in Hz for phase compensation, set to 0 to disable
   srsran_cfr_cfg_t cfr_tx_cfg;            ///< Tx CFR configuration
+  uint32_t         nof_ports;       ///< Number of ports transformed with a single batched DFT, 0 or 1 disables it
+  uint32_t         in_port_stride;  ///< Samples between the input buffers of consecutive ports, 0 for default
+  uint32_t         out_port_stride; ///< Samples between the output buffers of consecutive ports, 0 for default
 } srsran_ofdm_cfg_t;
 
 /**
@@ -72,6 +80,7 @@ typedef struct SRSRAN_API {
   srsran_ofdm_cfg_t cfg;
   srsran_dft_plan_t fft_plan;
   srsran_dft_plan_t fft_plan_sf[2];
+  srsran_dft_plan_t fft_plan_batch; ///< Whole subframe of all ports, only if nof_ports > 1
   uint32_t          max_prb;
   uint32_t          nof_symbols;
   uint32_t          nof_guards;
@@ -88,6 +97,8 @@ typedef struct SRSRAN_API {
   cf_t*             window_offset_buffer;
   cf_t              phase_compensation[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF];
   srsran_cfr_t      tx_cfr; ///< Tx CFR object
+  /// Tx CFR objects of ports 1 and above, only used by the batched Tx
+  srsran_cfr_t      tx_cfr_port[SRSRAN_MAX_PORTS - 1];
 } srsran_ofdm_t;
 
 /**
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         fec_pool.h
+ *
+ *  Description:  Pool of FEC threads for decoding the codeblocks of a transport
+ *                block in parallel. The calling thread takes part in the
+ *                decoding and returns once all the codeblocks are processed.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_FEC_POOL_H
+#define SRSRAN_FEC_POOL_H
+
+#include "srsran/config.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Task executed for every codeblock
+ * @param arg Opaque pointer given to srsran_fec_pool_run()
+ * @param worker_idx Index of the worker executing the task, 0 is the calling thread
+ * @param task_idx Index of the task, from 0 to nof_tasks - 1
+ */
+typedef void (*srsran_fec_pool_task_t)(void* arg, uint32_t worker_idx, uint32_t task_idx);
+
+typedef struct SRSRAN_API {
+  uint32_t nof_workers; ///< Number of workers including the calling thread
+  void*    ptr;         ///< Threads and synchronization, private
+} srsran_fec_pool_t;
+
+/**
+ * @brief Initialises a FEC pool and launches its threads
+ * @param q FEC pool object
+ * @param nof_threads Number of additional threads, 0 runs every task in the calling thread
+ * @param prio Real-time priority of the threads, negative keeps the default scheduling
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_fec_pool_init(srsran_fec_pool_t* q, uint32_t nof_threads, int prio);
+
+/**
+ * @brief Stops the threads and frees the FEC pool resources
+ * @param q FEC pool object
+ */
+SRSRAN_API void srsran_fec_pool_free(srsran_fec_pool_t* q);
+
+/**
+ * @brief Runs nof_tasks tasks across the pool and blocks until all of them have finished
+ *
+ * Tasks are picked in increasing index order. Each worker index is used by one thread at a time, so it can be used to
+ * select per-worker decoder resources.
+ *
+ * @param q FEC pool object
+ * @param task Task function
+ * @param arg Opaque pointer given to the task
+ * @param nof_tasks Number of tasks
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_fec_pool_run(srsran_fec_pool_t* q, srsran_fec_pool_task_t task, void* arg, uint32_t nof_tasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_FEC_POOL_H
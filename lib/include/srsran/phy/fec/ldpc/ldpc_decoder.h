@@ -35,6 +35,11 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 
+/*!
+ * \brief Maximum number of codeblocks that a batched decoder implementation processes in parallel.
+ */
+#define SRSRAN_LDPC_DECODER_MAX_BATCH 16
+
 /*!
  * \brief Types of LDPC decoder.
  */
@@ -82,6 +87,9 @@ typedef struct SRSRAN_API {
 
   float scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum algorithm. */
 
+  void*    batch_ptr;        /*!< \brief Registers used by the batched decoder, NULL if not available. */
+  uint32_t batch_max_nof_cb; /*!< \brief Number of codeblocks decoded in parallel by the batched decoder. */
+
   void (*free)(void*); /*!< \brief Pointer to a "destructor". */
 
   int (*decode_f)(void*,
@@ -179,4 +187,28 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Decodes several codewords encoded with the same base graph and lifting size, for instance the codeblocks of one or
+ * more transport blocks, using 8-bit integer-valued LLRs. When the decoder type and lifting size allow it
+ * (see srsran_ldpc_decoder_t::batch_max_nof_cb), up to \ref SRSRAN_LDPC_DECODER_MAX_BATCH codewords are interleaved
+ * across the SIMD lanes and decoded together. Otherwise, codewords are decoded one by one.
+ * \param[in] q A pointer to the LDPC decoder (a srsran_ldpc_decoder_t structure
+ *    instance) that carries out the decoding.
+ * \param[in] llrs The LLRs of each of the codewords to be decoded.
+ * \param[out] messages The messages (uncoded bits) resulting from the decoding operation, one per codeword.
+ * \param[in] cdwd_rm_length The number of bits forming each codeword (after rate matching).
+ * \param[in,out] crc Code-block CRC objects for early stop, one per codeword. Set to NULL (or set an entry to NULL)
+ *    to disable the check.
+ * \param[out] ret For each codeword, the number of used iterations, and 0 if CRC is provided and did not match.
+ * \param[in] nof_cb The number of codewords.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_decoder_decode_batch_c(srsran_ldpc_decoder_t* q,
+                                                  const int8_t* const*   llrs,
+                                                  uint8_t* const*        messages,
+                                                  const uint32_t*        cdwd_rm_length,
+                                                  srsran_crc_t* const*   crc,
+                                                  int*                   ret,
+                                                  uint32_t               nof_cb);
+
 #endif // SRSRAN_LDPCDECODER_H
@@ -36,6 +36,7 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/fec/cbsegm.h"
+#include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/turbo/tc_interl.h"
 
 #define SRSRAN_TCOD_RATE 3
@@ -56,7 +57,10 @@
 #undef LLR_IS_16BIT
 
 #define SRSRAN_TDEC_NOF_AUTO_MODES_8 2
-#define SRSRAN_TDEC_NOF_AUTO_MODES_16 3
+#define SRSRAN_TDEC_NOF_AUTO_MODES_16 4
+
+// One interleaver for each possible number of sub-blocks (1, 8, 16, 32 or 64)
+#define SRSRAN_TDEC_NOF_INTERLEAVERS 5
 
 typedef enum { SRSRAN_TDEC_8, SRSRAN_TDEC_16 } srsran_tdec_llr_type_t;
 
@@ -90,7 +94,7 @@ typedef struct SRSRAN_API {
   uint32_t               current_long_cb;
   uint32_t               current_inter_idx;
   int                    current_cbidx;
-  srsran_tc_interl_t     interleaver[4][SRSRAN_NOF_TC_CB_SIZES];
+  srsran_tc_interl_t     interleaver[SRSRAN_TDEC_NOF_INTERLEAVERS][SRSRAN_NOF_TC_CB_SIZES];
   int                    n_iter;
 } srsran_tdec_t;
 
@@ -120,4 +124,28 @@ SRSRAN_API void srsran_tdec_iteration_8bit(srsran_tdec_t* h, int8_t* input, uint
 SRSRAN_API int
 srsran_tdec_run_all_8bit(srsran_tdec_t* h, int8_t* input, uint8_t* output, uint32_t nof_iterations, uint32_t long_cb);
 
+/**
+ * Runs decoder iterations until the CRC attached to the code block checks or max_iterations is reached. The CRC is
+ * computed over the first crc_len decoded bits after every iteration once min_iterations have been run.
+ * @return 1 if the CRC matched, 0 if it did not, SRSRAN_ERROR if the code block length is invalid. The number of
+ * iterations run can be retrieved with srsran_tdec_get_nof_iterations()
+ */
+SRSRAN_API int srsran_tdec_run_all_crc(srsran_tdec_t* h,
+                                       int16_t*       input,
+                                       uint8_t*       output,
+                                       uint32_t       min_iterations,
+                                       uint32_t       max_iterations,
+                                       uint32_t       long_cb,
+                                       srsran_crc_t*  crc,
+                                       uint32_t       crc_len);
+
+SRSRAN_API int srsran_tdec_run_all_crc_8bit(srsran_tdec_t* h,
+                                            int8_t*        input,
+                                            uint8_t*       output,
+                                            uint32_t       min_iterations,
+                                            uint32_t       max_iterations,
+                                            uint32_t       long_cb,
+                                            srsran_crc_t*  crc,
+                                            uint32_t       crc_len);
+
 #endif // SRSRAN_TURBODECODER_H
@@ -47,8 +47,19 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_res_t chest_pusch;
   srsran_chest_ul_res_t chest_pucch;
   float                 pusch_min_snr_dB; ///< Minimum measured DMRS SNR, below this threshold PUSCH is not decoded
+  int8_t*               pusch_llr[SRSRAN_SCH_NR_MAX_NOF_TB_BATCH]; ///< UL-SCH LLR of the PUSCH decoded together
 } srsran_gnb_ul_t;
 
+/**
+ * @brief PUSCH transmission decoded together with the other PUSCH transmissions of a slot
+ */
+typedef struct {
+  const srsran_sch_cfg_nr_t*    cfg;   ///< PUSCH configuration
+  const srsran_sch_grant_nr_t*  grant; ///< PUSCH grant
+  srsran_pusch_res_nr_t*        data;  ///< PUSCH reception result
+  srsran_csi_trs_measurements_t csi;   ///< DMRS channel state information, written by the decoder
+} srsran_gnb_ul_pusch_t;
+
 SRSRAN_API int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args);
 
 SRSRAN_API void srsran_gnb_ul_free(srsran_gnb_ul_t* q);
@@ -63,6 +74,24 @@ SRSRAN_API int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                                        const srsran_sch_grant_nr_t* grant,
                                        srsran_pusch_res_nr_t*       data);
 
+/**
+ * @brief Decodes all the PUSCH transmissions of a slot
+ *
+ * Every PUSCH is estimated and demodulated first, then their transport blocks are decoded together with
+ * srsran_sch_nr_decode_multi(), so the code blocks of different UEs sharing the LDPC lifting size fill the batched
+ * decoder.
+ *
+ * @param q gNb UL object
+ * @param slot_cfg Slot configuration
+ * @param pusch PUSCH transmissions
+ * @param nof_pusch Number of PUSCH transmissions
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_gnb_ul_get_pusch_multi(srsran_gnb_ul_t*         q,
+                                             const srsran_slot_cfg_t* slot_cfg,
+                                             srsran_gnb_ul_pusch_t*   pusch,
+                                             uint32_t                 nof_pusch);
+
 SRSRAN_API int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
@@ -78,10 +107,11 @@ SRSRAN_API uint32_t srsran_gnb_ul_pucch_info(srsran_gnb_ul_t*
                                              char*                                str,
                                              uint32_t                             str_len);
 
-SRSRAN_API uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*             q,
-                                             const srsran_sch_cfg_nr_t*   cfg,
-                                             const srsran_pusch_res_nr_t* res,
-                                             char*                        str,
-                                             uint32_t                     str_len);
+SRSRAN_API uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*                     q,
+                                             const srsran_sch_cfg_nr_t*           cfg,
+                                             const srsran_pusch_res_nr_t*         res,
+                                             const srsran_csi_trs_measurements_t* csi,
+                                             char*                                str,
+                                             uint32_t                             str_len);
 
 #endif // SRSRAN_GNB_UL_H
@@ -59,6 +59,16 @@ typedef struct {
   cf_t  phase_array[2 * SRSRAN_PRACH_N_ZC_LONG];
 } srsran_prach_cancellation_t;
 
+/**
+ * Detection metrics of a single preamble, refreshed by every call to srsran_prach_detect_offset() for all the preambles
+ * of the searched root sequences, whether they are detected or not.
+ */
+typedef struct SRSRAN_API {
+  float peak_to_avg; // Highest correlation peak in the preamble window over the average correlation power of its root
+  float t_offset;    // Time offset in seconds of the peak, estimated in the time domain
+  bool  detected;    // Whether the peak exceeded the detection threshold
+} srsran_prach_preamble_metrics_t;
+
 typedef struct SRSRAN_API {
   // Parameters from higher layers (extracted from SIB2)
   bool     is_nr;
@@ -86,6 +96,8 @@ typedef struct SRSRAN_API {
   uint64_t dft_gen_bitmap;    // Bitmap where each bit Indicates if the dft has been generated for sequence i.
   uint32_t root_seqs_idx[64]; // Indices of root seqs in seqs table
   uint32_t N_roots;           // Number of root sequences used in this configuration
+  uint32_t seqs_shift[64];    // Cyclic shift C_v of every preamble sequence
+  uint32_t root_d_u[64];      // Restricted set cyclic shift d_u of every root, 0 if its aliases are not searched
   cf_t*    td_signals[64];
   // Containers
   cf_t*  ifft_in;
@@ -93,6 +105,12 @@ typedef struct SRSRAN_API {
   cf_t*  prach_bins;
   cf_t*  corr_spec;
   float* corr;
+  float* corr_hs;         // Correlation power combined with its restricted set aliases
+  cf_t*  corr_spec_batch; // Correlation spectra of all the searched roots, N_zc samples each
+  cf_t*  corr_batch;      // Correlation of all the searched roots in the time domain
+
+  // Batched IFFT of the correlation of all the searched roots
+  srsran_dft_plan_t zc_ifft_batch;
 
   // PRACH IFFT
   srsran_dft_plan_t fft;
@@ -105,19 +123,19 @@ typedef struct SRSRAN_API {
   cf_t* signal_fft;
   float detect_factor;
 
-  uint32_t                    deadzone;
-  float                       peak_values[65];
-  uint32_t                    peak_offsets[65];
-  uint32_t                    num_ra_preambles;
-  bool                        successive_cancellation;
-  bool                        freq_domain_offset_calc;
-  srsran_tdd_config_t         tdd_config;
-  uint32_t                    current_prach_idx;
-  cf_t*                       cross;
-  cf_t*                       corr_freq;
-  srsran_prach_cancellation_t prach_cancel;
-  cf_t                        sub[839 * 2];
-  float                       phase[839];
+  uint32_t                        deadzone;
+  float                           peak_values[65];
+  uint32_t                        peak_offsets[65];
+  uint32_t                        num_ra_preambles;
+  bool                            successive_cancellation;
+  bool                            freq_domain_offset_calc;
+  srsran_tdd_config_t             tdd_config;
+  uint32_t                        current_prach_idx;
+  cf_t*                           cross;
+  srsran_prach_cancellation_t     prach_cancel;
+  srsran_prach_preamble_metrics_t metrics[64];
+  cf_t                            sub[839 * 2];
+  float                           phase[839];
 
 } srsran_prach_t;
 
@@ -236,6 +254,11 @@ SRSRAN_API int srsran_prach_detect_offset(srsran_prach_t* p,
 
 SRSRAN_API void srsran_prach_set_detect_factor(srsran_prach_t* p, float factor);
 
+/**
+ * @brief Returns the detection metrics of the 64 preambles from the last call to srsran_prach_detect_offset()
+ */
+SRSRAN_API const srsran_prach_preamble_metrics_t* srsran_prach_get_preamble_metrics(const srsran_prach_t* p);
+
 SRSRAN_API int srsran_prach_free(srsran_prach_t* p);
 
 SRSRAN_API int srsran_prach_print_seqs(srsran_prach_t* p);
@@ -115,6 +115,32 @@ SRSRAN_API int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
                                       cf_t*                        sf_symbols[SRSRAN_MAX_PORTS],
                                       srsran_pusch_res_nr_t*       data);
 
+/**
+ * @brief Demodulates a PUSCH transmission and decodes its UCI, leaving the UL-SCH decoding to the caller
+ *
+ * The UL-SCH LLR of every enabled transport block are written in the buffer of its codeword and described in rx, so
+ * the transport blocks of all the PUSCH transmissions of a slot can be decoded together with
+ * srsran_sch_nr_decode_multi(). The decoded transport blocks are written in data.
+ *
+ * @param q PUSCH object
+ * @param cfg PUSCH configuration
+ * @param grant PUSCH grant
+ * @param channel Channel estimates of the PUSCH transmission
+ * @param sf_symbols Received resource grid
+ * @param ulsch_llr UL-SCH LLR buffer for each codeword, each of them fitting the bits of the codeword
+ * @param data PUSCH reception result, the UCI is decoded here
+ * @param rx Transport blocks to decode, it must fit SRSRAN_MAX_TB entries
+ * @return The number of transport blocks written in rx if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pusch_nr_demodulate(srsran_pusch_nr_t*           q,
+                                          const srsran_sch_cfg_nr_t*   cfg,
+                                          const srsran_sch_grant_nr_t* grant,
+                                          srsran_chest_dl_res_t*       channel,
+                                          cf_t*                        sf_symbols[SRSRAN_MAX_PORTS],
+                                          int8_t*                      ulsch_llr[SRSRAN_MAX_CODEWORDS],
+                                          srsran_pusch_res_nr_t*       data,
+                                          srsran_sch_nr_rx_tb_t        rx[SRSRAN_MAX_TB]);
+
 SRSRAN_API uint32_t srsran_pusch_nr_rx_info(const srsran_pusch_nr_t*     q,
                                             const srsran_sch_cfg_nr_t*   cfg,
                                             const srsran_sch_grant_nr_t* grant,
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/fec_pool.h"
 #include "srsran/phy/fec/turbo/rm_turbo.h"
 #include "srsran/phy/fec/turbo/turbocoder.h"
 #include "srsran/phy/fec/turbo/turbodecoder.h"
@@ -71,6 +72,11 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Parallel codeblock decoding, disabled by default */
+  srsran_fec_pool_t fec_pool;
+  void*             cb_workers;
+  uint32_t          nof_cb_workers;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +87,18 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/**
+ * @brief Sets the number of FEC threads decoding the codeblocks of a transport block in parallel with the calling thread
+ *
+ * Every thread owns a turbo decoder. Setting zero threads (default) decodes all codeblocks in the calling thread.
+ *
+ * @param q SCH object
+ * @param nof_threads Number of additional FEC threads
+ * @param prio Real-time priority of the FEC threads, negative for default scheduling
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_set_fec_threads(srsran_sch_t* q, uint32_t nof_threads, int prio);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/fec_pool.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
@@ -54,6 +55,21 @@ typedef struct {
   float    avg_iter; ///< Average iterations
 } srsran_sch_tb_res_nr_t;
 
+/**
+ * @brief Maximum number of transport blocks whose code blocks are rate dematched before decoding them in batches
+ */
+#define SRSRAN_SCH_NR_MAX_NOF_TB_BATCH 16
+
+/**
+ * @brief Describes a transport block to decode together with other transport blocks of the same slot
+ */
+typedef struct {
+  const srsran_sch_cfg_t* sch_cfg; ///< Higher layers configuration
+  const srsran_sch_tb_t*  tb;      ///< Transport block configuration, including the softbuffer
+  int8_t*                 e_bits;  ///< Demodulated LLR
+  srsran_sch_tb_res_nr_t* res;     ///< Decoding result
+} srsran_sch_nr_rx_tb_t;
+
 typedef struct SRSRAN_API {
   srsran_carrier_nr_t carrier;
 
@@ -76,6 +92,11 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// Parallel code block decoding, disabled by default
+  srsran_fec_pool_t fec_pool;
+  void*             cb_workers;     ///< Decoders of the FEC threads
+  uint32_t          nof_cb_workers; ///< Number of FEC thread decoders
 } srsran_sch_nr_t;
 
 /**
@@ -85,7 +106,9 @@ typedef struct SRSRAN_API {
   bool     disable_simd;
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t max_nof_iter;    ///< Maximum number of LDPC iterations
+  uint32_t nof_fec_threads; ///< Number of threads decoding code blocks in parallel with the caller, 0 disables them
+  int      fec_prio;        ///< Real-time priority of the FEC threads, negative for default scheduling
 } srsran_sch_nr_args_t;
 
 /**
@@ -189,6 +212,19 @@ SRSRAN_API int srsran_ulsch_nr_decode(srsran_sch_nr_t*        q,
                                       int8_t*                 e_bits,
                                       srsran_sch_tb_res_nr_t* res);
 
+/**
+ * @brief Decodes several transport blocks of the same slot, for example from different UEs, in a single call
+ *
+ * Code blocks that share LDPC base graph and lifting size are decoded together, filling the SIMD lanes of the batched
+ * LDPC decoder even when every transport block carries a single small code block.
+ *
+ * @param q Points at the SCH object
+ * @param tbs Transport blocks to decode
+ * @param nof_tb Number of transport blocks
+ * @return SRSRAN_SUCCESS if all transport blocks are processed, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_nr_decode_multi(srsran_sch_nr_t* q, srsran_sch_nr_rx_tb_t* tbs, uint32_t nof_tb);
+
 SRSRAN_API int
 srsran_sch_nr_tb_info(const srsran_sch_tb_t* tb, const srsran_sch_tb_res_nr_t* res, char* str, uint32_t str_len);
 
@@ -127,6 +127,9 @@ SRSRAN_API void srsran_pss_filter(srsran_pss_t* q, const cf_t* input, cf_t* outp
 
 SRSRAN_API int srsran_pss_generate(cf_t* signal, uint32_t N_id_2);
 
+SRSRAN_API int
+srsran_pss_init_N_id_2(cf_t* pss_signal_freq, cf_t* pss_signal_time, uint32_t N_id_2, uint32_t fft_size, int cfo_i);
+
 SRSRAN_API void srsran_pss_get_slot(cf_t* slot, cf_t* pss_signal, uint32_t nof_prb, srsran_cp_t cp);
 
 SRSRAN_API void srsran_pss_put_slot(cf_t* pss_signal, cf_t* slot, uint32_t nof_prb, srsran_cp_t cp);
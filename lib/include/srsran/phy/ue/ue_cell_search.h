@@ -50,6 +50,7 @@
 
 #define SRSRAN_CS_NOF_PRB      6
 #define SRSRAN_CS_SAMP_FREQ    1920000.0
+#define SRSRAN_CS_PSS_DECIMATE 2
 
 typedef struct SRSRAN_API {
   uint32_t cell_id;
@@ -61,6 +62,38 @@ typedef struct SRSRAN_API {
   float               cfo;
 } srsran_ue_cellsearch_result_t;
 
+/* Detects the cells present in a capture sampled at SRSRAN_CS_SAMP_FREQ, without driving a radio.
+ *
+ * Each 5 ms half-frame is transformed with a single FFT and decimated in the frequency domain; the three PSS sequences
+ * are correlated against it with one batched IFFT and the correlation power is accumulated across half-frames. The
+ * strongest position of each N_id_2 is then refined at full rate by a srsran_sync_t object, which also detects SSS, CP
+ * and frame type. Detectors share no state, so captures of several EARFCNs can be processed in parallel, one detector
+ * per thread.
+ */
+typedef struct SRSRAN_API {
+  uint32_t max_frames;
+  uint32_t decimate;
+  uint32_t corr_len; // correlation length after decimation
+  uint32_t nof_lags; // valid correlation lags, one 5 ms half-frame after decimation
+  float    pfa;      // probability of reporting noise as a cell
+
+  cf_t*             input_fft;
+  cf_t*             input_decim;
+  cf_t*             pss_fft;  // conjugated spectrum of the three PSS, corr_len samples each
+  cf_t*             corr_fft; // products for the three PSS, input of the batched IFFT
+  cf_t*             corr;
+  float*            corr_pwr;
+  float*            corr_acc; // accumulated correlation power, nof_lags samples per N_id_2
+  srsran_dft_plan_t fft;
+  srsran_dft_plan_t ifft_batch;
+
+  srsran_sync_t sfind;
+
+  srsran_ue_cellsearch_result_t* candidates;
+  uint32_t*                      mode_ntimes;
+  uint8_t*                       mode_counted;
+} srsran_ue_cellsearch_detector_t;
+
 typedef struct SRSRAN_API {
   srsran_ue_sync_t ue_sync;
 
@@ -74,6 +107,9 @@ typedef struct SRSRAN_API {
   uint8_t*  mode_counted;
 
   srsran_ue_cellsearch_result_t* candidates;
+
+  srsran_ue_cellsearch_detector_t detector;
+  cf_t*                           capture[SRSRAN_MAX_CHANNELS];
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -97,6 +133,22 @@ SRSRAN_API int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                                          srsran_ue_cellsearch_result_t found_cells[3],
                                          uint32_t*                     max_N_id_2);
 
+SRSRAN_API int srsran_ue_cellsearch_detector_init(srsran_ue_cellsearch_detector_t* q,
+                                                  uint32_t                         max_frames,
+                                                  uint32_t                         decimate);
+
+SRSRAN_API void srsran_ue_cellsearch_detector_free(srsran_ue_cellsearch_detector_t* q);
+
+SRSRAN_API void srsran_ue_cellsearch_detector_set_pfa(srsran_ue_cellsearch_detector_t* q, float pfa);
+
+SRSRAN_API uint32_t srsran_ue_cellsearch_detector_nof_samples(uint32_t nof_frames);
+
+SRSRAN_API int srsran_ue_cellsearch_detect(srsran_ue_cellsearch_detector_t* q,
+                                           const cf_t*                      input,
+                                           uint32_t                         nof_frames,
+                                           srsran_ue_cellsearch_result_t    found_cells[3],
+                                           uint32_t*                        max_N_id_2);
+
 SRSRAN_API int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_t nof_frames);
 
 SRSRAN_API void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable);
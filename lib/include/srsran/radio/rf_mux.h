@@ -0,0 +1,107 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_MUX_H
+#define SRSRAN_RF_MUX_H
+
+#include "srsran/phy/channel/channel.h"
+#include "srsran/srslog/srslog.h"
+#include <memory>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Baseband combiner between one eNB and N emulated UEs, used by the srsran_rf_mux tool to run many srsUE instances
+ * against one srsENB without an external broker.
+ *
+ * The eNB downlink is fanned out to every UE and the uplinks of all UEs are summed into the eNB uplink. Every UE has
+ * its own propagation conditions: the delay and the gain apply to both directions, and the frequency offset applies
+ * to the uplink only (the UE tracks the downlink carrier, so what the eNB sees is its residual transmit error).
+ * Delays and any fading model of the channel arguments are applied with an srsran::channel instance per UE and
+ * direction, which is only created when it has something to do.
+ *
+ * The buffers are arrays of SRSRAN_MAX_CHANNELS pointers of which the first nof_ports are used.
+ */
+class rf_mux
+{
+public:
+  struct ue_args_t {
+    float delay_us = 0.0f; ///< Fixed one-way propagation delay
+    float gain_dB  = 0.0f; ///< Path gain, applied to both directions
+    float cfo_hz   = 0.0f; ///< Uplink carrier frequency offset
+  };
+
+  struct args_t {
+    uint32_t               nof_ports = 1;
+    uint32_t               srate_hz  = 23040000;
+    channel::args_t        dl_channel; ///< Template for the downlink channel of every UE (fading, HST, ...)
+    channel::args_t        ul_channel; ///< Template for the uplink channel of every UE
+    std::vector<ue_args_t> ues;
+  };
+
+  rf_mux(const args_t& args_, srslog::basic_logger& logger_);
+
+  uint32_t nof_ues() const { return ues.size(); }
+
+  /**
+   * Applies the downlink channel of a UE to the eNB downlink samples
+   * @param ue_idx UE index
+   * @param enb_dl eNB downlink samples, not modified
+   * @param ue_dl Output samples for the UE, it can point to the same buffers as enb_dl
+   * @param nof_samples Number of samples per port
+   * @param t Timestamp of the first sample
+   */
+  void run_dl(uint32_t                  ue_idx,
+              cf_t*                     enb_dl[SRSRAN_MAX_CHANNELS],
+              cf_t*                     ue_dl[SRSRAN_MAX_CHANNELS],
+              uint32_t                  nof_samples,
+              const srsran_timestamp_t& t);
+
+  /**
+   * Applies the uplink channel of every UE and sums all of them into the eNB uplink
+   * @param ue_ul Uplink samples of every UE, modified in place. A NULL entry excludes the UE from the sum
+   * @param enb_ul Output eNB uplink samples
+   * @param nof_samples Number of samples per port
+   * @param t Timestamp of the first sample
+   */
+  void run_ul(cf_t** ue_ul[], cf_t* enb_ul[SRSRAN_MAX_CHANNELS], uint32_t nof_samples, const srsran_timestamp_t& t);
+
+private:
+  struct ue_t {
+    channel_ptr dl_channel;
+    channel_ptr ul_channel;
+    float       gain     = 1.0f;
+    float       cfo_norm = 0.0f; ///< Uplink frequency offset normalised to the sampling rate
+    float       ul_phase = 0.0f; ///< Phase of the uplink frequency offset at the beginning of the next call
+  };
+
+  channel_ptr make_channel(const channel::args_t& channel_args, float delay_us);
+
+  srslog::basic_logger& logger;
+  uint32_t              nof_ports = 1;
+  uint32_t              srate_hz  = 0;
+  std::vector<ue_t>     ues;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RF_MUX_H
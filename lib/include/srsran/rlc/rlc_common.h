@@ -42,6 +42,7 @@ namespace srsran {
 #define RLC_AM_WINDOW_SIZE 512
 #define RLC_MAX_SDU_SIZE ((1 << 11) - 1) // Length of LI field is 11bits
 #define RLC_AM_MIN_DATA_PDU_SIZE (3)     // AMD PDU with 10 bit SN (length of LI field is 11 bits) (No LI)
+#define RLC_UM_MAX_SDUS_PER_PDU 128      // Max. SDUs (or SDU segments) concatenated in one LTE UMD PDU
 
 #define RLC_AM_NR_TYP_NACKS 512  // Expected number of NACKs in status PDU before expanding space by alloc
 #define RLC_AM_NR_MAX_NACKS 2048 // Maximum number of NACKs in status PDU
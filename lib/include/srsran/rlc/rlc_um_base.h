@@ -24,6 +24,7 @@
 
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/rlc/rlc_common.h"
@@ -110,9 +111,9 @@ protected:
 
     rlc_config_t cfg = {};
 
-    // TX SDU buffers
-    byte_buffer_queue    tx_sdu_queue;
-    unique_byte_buffer_t tx_sdu;
+    // TX SDU buffers. The SDU being segmented is held as a chain, so PDUs can reference its bytes without copies
+    byte_buffer_queue tx_sdu_queue;
+    byte_buffer_chain tx_sdu;
 
     // Mutexes
     std::mutex mutex;
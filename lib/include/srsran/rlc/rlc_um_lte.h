@@ -71,6 +71,9 @@ private:
      ***************************************************************************/
     uint32_t vt_us = 0; // Send state. SN to be assigned for next PDU.
 
+    // Views of the SDU bytes carried by the PDU under construction. Further SDUs are left for the next PDU
+    byte_buffer_chain_t<RLC_UM_MAX_SDUS_PER_PDU> pdu_payload;
+
     // Metrics
     void debug_state();
   };
@@ -27,4 +27,16 @@
 #define SRSLOG_QUEUE_CAPACITY 8192
 #endif
 
+/// Capacity of the backend queue of each thread that generates log entries. Must be a power of two. Entries that do not
+/// fit in the queue of their thread go to a queue of SRSLOG_QUEUE_CAPACITY entries shared by all threads.
+#ifndef SRSLOG_THREAD_QUEUE_CAPACITY
+#define SRSLOG_THREAD_QUEUE_CAPACITY 512
+#endif
+
+/// Maximum number of threads with a dedicated backend queue at the same time. The queue of a thread is reused by a new
+/// thread once the former exits, further threads use the shared queue.
+#ifndef SRSLOG_MAX_PRODUCER_THREADS
+#define SRSLOG_MAX_PRODUCER_THREADS 64
+#endif
+
 #endif // SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
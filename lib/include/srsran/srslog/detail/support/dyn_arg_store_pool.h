@@ -24,6 +24,8 @@
 
 #include "srsran/srslog/bundled/fmt/printf.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
+#include <atomic>
+#include <vector>
 
 namespace srslog {
 
@@ -32,52 +34,107 @@ namespace detail {
 /// Keeps a pool of dynamic_format_arg_store objects. The main reason for this class is that the arg store objects are
 /// implemented with std::vectors, so we want to avoid allocating memory each time we create a new object. Instead,
 /// reserve memory for each vector during initialization and recycle the objects.
+/// The free objects are kept in a lock-free bounded queue, so that threads generating log entries never block.
 class dyn_arg_store_pool
 {
+  using store_type = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
 public:
-  dyn_arg_store_pool()
+  dyn_arg_store_pool() :
+    pool(SRSLOG_QUEUE_CAPACITY), free_list(round_up_pow2(SRSLOG_QUEUE_CAPACITY)), mask(free_list.size() - 1)
   {
-    pool.resize(SRSLOG_QUEUE_CAPACITY);
+    for (size_t i = 0; i != free_list.size(); ++i) {
+      free_list[i].seq.store(i, std::memory_order_relaxed);
+    }
     for (auto& elem : pool) {
       // Reserve for 10 normal and 2 named arguments.
       elem.reserve(10, 2);
-    }
-    free_list.reserve(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
-      free_list.push_back(&elem);
+      push(&elem);
     }
   }
 
+  dyn_arg_store_pool(const dyn_arg_store_pool&) = delete;
+  dyn_arg_store_pool& operator=(const dyn_arg_store_pool&) = delete;
+
   /// Returns a pointer to a free dyn arg store object, otherwise returns nullptr.
-  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc()
+  store_type* alloc()
   {
-    scoped_lock lock(m);
-    if (free_list.empty()) {
-      return nullptr;
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t&  cell = free_list[pos & mask];
+      size_t   seq  = cell.seq.load(std::memory_order_acquire);
+      intptr_t dif  = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          store_type* p = cell.store;
+          cell.seq.store(pos + mask + 1, std::memory_order_release);
+          return p;
+        }
+      } else if (dif < 0) {
+        // Empty pool.
+        nof_alloc_failures.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
     }
-
-    auto* p = free_list.back();
-    free_list.pop_back();
-
-    return p;
   }
 
   /// Deallocate the given dyn arg store object returning it to the pool.
-  void dealloc(fmt::dynamic_format_arg_store<fmt::printf_context>* p)
+  void dealloc(store_type* p)
   {
     if (!p) {
       return;
     }
 
     p->clear();
-    scoped_lock lock(m);
-    free_list.push_back(p);
+    push(p);
   }
 
+  /// Returns the number of failed allocations because the pool was empty.
+  uint64_t get_nof_alloc_failures() const { return nof_alloc_failures.load(std::memory_order_relaxed); }
+
 private:
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context> > pool;
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context>*> free_list;
-  mutable mutex                                                    m;
+  struct cell_t {
+    std::atomic<size_t> seq;
+    store_type*         store;
+  };
+
+  static size_t round_up_pow2(size_t n)
+  {
+    size_t ret = 1;
+    while (ret < n) {
+      ret <<= 1;
+    }
+    return ret;
+  }
+
+  /// The free list has room for every object of the pool, so this never fails.
+  void push(store_type* p)
+  {
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t&  cell = free_list[pos & mask];
+      size_t   seq  = cell.seq.load(std::memory_order_acquire);
+      intptr_t dif  = (intptr_t)seq - (intptr_t)pos;
+      if (dif == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.store = p;
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return;
+        }
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::vector<store_type> pool;
+  std::vector<cell_t>     free_list;
+  const size_t            mask;
+  alignas(64) std::atomic<size_t> enqueue_pos{0};
+  alignas(64) std::atomic<size_t> dequeue_pos{0};
+  std::atomic<uint64_t>           nof_alloc_failures{0};
 };
 
 } // namespace detail
@@ -22,91 +22,256 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 #define SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
 #include "srsran/srslog/detail/support/thread_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace srslog {
 
 namespace detail {
 
-//: TODO: this is a temp work queue.
+/// Returns a unique identifier for each work queue instance.
+inline uint64_t next_work_queue_id()
+{
+  static std::atomic<uint64_t> id{0};
+  return ++id;
+}
 
-/// Thread safe generic data type work queue.
-template <typename T, size_t capacity = SRSLOG_QUEUE_CAPACITY>
+/// Thread safe generic data type work queue with multiple producers and a
+/// single consumer.
+/// Each producer thread pushes into its own small lock-free single producer
+/// ring, claimed the first time the thread pushes an element, so producers
+/// never block each other nor the consumer. When the ring of a producer is
+/// full, or no ring is left for it, elements go to a larger ring shared by all
+/// threads and guarded by a mutex. Elements are only discarded, and accounted
+/// in a counter, when the shared ring is full too.
+/// The ring of a thread is released when the thread exits and claimed again by
+/// the next new thread, with the elements still pending in it, so at most
+/// max_producers rings are allocated at any time.
+/// NOTE: An element that overflows to the shared ring may be extracted before
+/// older elements of the same thread that are still in its own ring.
+template <typename T,
+          size_t ring_capacity   = SRSLOG_THREAD_QUEUE_CAPACITY,
+          size_t shared_capacity = SRSLOG_QUEUE_CAPACITY,
+          size_t max_producers   = SRSLOG_MAX_PRODUCER_THREADS>
 class work_queue
 {
-  srsran::dyn_circular_buffer<T> queue;
-  mutable mutex                  m;
-  static constexpr size_t        threshold = capacity * 0.98;
+  static_assert(ring_capacity > 0 && (ring_capacity & (ring_capacity - 1)) == 0,
+                "The ring capacity must be a power of two");
+  static_assert(shared_capacity > 0 && (shared_capacity & (shared_capacity - 1)) == 0,
+                "The shared ring capacity must be a power of two");
+
+  /// Single producer single consumer ring buffer.
+  struct ring {
+    ring(uint64_t queue_id, size_t capacity) : queue_id(queue_id), mask(capacity - 1), slots(new T[capacity]) {}
+
+    /// Inserts the element when there is room for it, otherwise the element is
+    /// left untouched and false is returned.
+    bool push(T&& value)
+    {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h - cached_tail > mask) {
+        cached_tail = tail.load(std::memory_order_acquire);
+        if (h - cached_tail > mask) {
+          return false;
+        }
+      }
+      slots[h & mask] = std::move(value);
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+    size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed); }
+
+    const uint64_t       queue_id;
+    const size_t         mask;
+    std::unique_ptr<T[]> slots;
+    /// Set while a live thread owns the producer side of the ring.
+    std::atomic<bool> in_use{false};
+    // Producer and consumer indexes are kept in separate cache lines.
+    char                pad0[64];
+    std::atomic<size_t> head{0};
+    size_t              cached_tail = 0;
+    char                pad1[64];
+    std::atomic<size_t> tail{0};
+  };
+
+  /// Rings claimed by a thread, which are released when the thread exits.
+  /// Rings are shared with their queues, so a ring outlives whichever of the
+  /// thread and the queue ends last.
+  struct thread_rings {
+    ~thread_rings()
+    {
+      for (auto& r : claimed) {
+        r->in_use.store(false, std::memory_order_release);
+      }
+    }
+
+    /// Last queue the thread pushed to and its ring in that queue.
+    uint64_t                           cached_queue_id = 0;
+    ring*                              cached_ring     = nullptr;
+    std::vector<std::shared_ptr<ring>> claimed;
+  };
+
+  const uint64_t          id = next_work_queue_id();
+  std::shared_ptr<ring>   rings[max_producers];
+  std::atomic<size_t>     nof_rings{0};
+  mutex                   register_mutex;
+  ring                    shared_ring{id, shared_capacity};
+  mutex                   shared_ring_mutex;
+  std::atomic<uint64_t>   nof_dropped{0};
+  static constexpr size_t threshold = shared_capacity * 0.98;
 
 public:
-  work_queue() : queue(capacity) {}
+  work_queue() = default;
 
   work_queue(const work_queue&) = delete;
   work_queue& operator=(const work_queue&) = delete;
 
-  /// Inserts a new element into the back of the queue. Returns false when the
-  /// queue is full, otherwise true.
-  bool push(const T& value)
+  /// Inserts a new element into the back of the queue of the calling thread.
+  /// Returns false when the queue is full, otherwise true.
+  bool push(T&& value)
   {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
+    ring* r = get_thread_ring();
+    if (r && r->push(std::move(value))) {
+      return true;
     }
-    queue.push(value);
-    m.unlock();
 
+    scoped_lock lock(shared_ring_mutex);
+    if (!shared_ring.push(std::move(value))) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
     return true;
   }
 
-  /// Inserts a new element into the back of the queue. Returns false when the
-  /// queue is full, otherwise true.
-  bool push(T&& value)
+  /// Extracts up to max_per_ring elements from the queue of each producer and
+  /// from the shared queue, passing them in order to the provided function
+  /// with signature bool(T&&). When the function returns false, no more
+  /// elements are extracted from the current queue in this call.
+  /// Returns the number of extracted elements.
+  /// NOTE: Only one thread may extract elements from the queue.
+  template <typename F>
+  size_t pop_batch(F&& func, size_t max_per_ring)
   {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
+    size_t count = pop_batch(shared_ring, func, max_per_ring);
+    size_t n     = nof_rings.load(std::memory_order_acquire);
+    for (size_t i = 0; i != n; ++i) {
+      count += pop_batch(*rings[i], func, max_per_ring);
     }
-    queue.push(std::move(value));
-    m.unlock();
-
-    return true;
+    return count;
   }
 
-  /// Extracts the top most element from the queue if it exists.
-  /// Returns a pair with a bool indicating if the pop has been successful.
-  std::pair<bool, T> try_pop()
+  /// Extracts all the elements pushed to the queue of every producer and to
+  /// the shared queue before this call, passing them to the provided function
+  /// with signature void(T&&), in order for each queue. Elements pushed during
+  /// the call may be extracted too.
+  /// Returns the number of extracted elements.
+  /// NOTE: Only one thread may extract elements from the queue.
+  template <typename F>
+  size_t pop_all(F&& func)
   {
-    m.lock();
+    auto all = [&func](T&& item) {
+      func(std::move(item));
+      return true;
+    };
 
-    if (queue.empty()) {
-      m.unlock();
-      return {false, T()};
+    size_t count = pop_batch(shared_ring, all, shared_capacity);
+    size_t n     = nof_rings.load(std::memory_order_acquire);
+    for (size_t i = 0; i != n; ++i) {
+      count += pop_batch(*rings[i], all, ring_capacity);
     }
+    return count;
+  }
 
-    // Here we have been woken up normally.
-    T Item = std::move(queue.top());
-    queue.pop();
+  /// Capacity of the shared queue, where elements go when the queue of their
+  /// producer is full.
+  size_t get_capacity() const { return shared_capacity; }
 
-    m.unlock();
+  /// Returns true when the shared queue is almost full, so new elements are
+  /// about to be discarded, otherwise returns false.
+  bool is_almost_full() const { return shared_ring.size() > threshold; }
 
-    return {true, std::move(Item)};
-  }
+  /// Returns the number of elements discarded so far because the queue was
+  /// full.
+  uint64_t get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
 
-  /// Capacity of the queue.
-  size_t get_capacity() const { return capacity; }
+private:
+  template <typename F>
+  static size_t pop_batch(ring& r, F& func, size_t max_count)
+  {
+    size_t t     = r.tail.load(std::memory_order_relaxed);
+    size_t h     = r.head.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (t != h && count != max_count) {
+      T item = std::move(r.slots[t & r.mask]);
+      r.tail.store(++t, std::memory_order_release);
+      ++count;
+      if (!func(std::move(item))) {
+        break;
+      }
+    }
+    return count;
+  }
 
-  /// Returns true when the queue is almost full, otherwise returns false.
-  bool is_almost_full() const
+  /// Returns the ring of the calling thread, claiming one if needed. Returns
+  /// nullptr when all the rings are in use by other threads.
+  ring* get_thread_ring()
   {
-    scoped_lock lock(m);
+    static thread_local thread_rings local;
+    if (local.cached_queue_id == id) {
+      return local.cached_ring;
+    }
 
-    return queue.size() > threshold;
+    // Slow path, the thread pushes to this queue for the first time or it
+    // has been pushing to other queues.
+    ring* r = nullptr;
+    for (auto& claimed : local.claimed) {
+      if (claimed->queue_id == id) {
+        r = claimed.get();
+        break;
+      }
+    }
+    if (!r) {
+      // Release the rings of queues that no longer exist.
+      local.claimed.erase(std::remove_if(local.claimed.begin(),
+                                         local.claimed.end(),
+                                         [](const std::shared_ptr<ring>& c) { return c.use_count() == 1; }),
+                          local.claimed.end());
+      std::shared_ptr<ring> c = claim_ring();
+      if (c) {
+        r = c.get();
+        local.claimed.push_back(std::move(c));
+      }
+    }
+    local.cached_queue_id = id;
+    local.cached_ring     = r;
+    return r;
+  }
+
+  /// Claims a ring released by an exited thread, or allocates a new one when
+  /// there are less than max_producers rings. Returns nullptr when all the
+  /// rings are in use.
+  std::shared_ptr<ring> claim_ring()
+  {
+    scoped_lock lock(register_mutex);
+    size_t      n = nof_rings.load(std::memory_order_relaxed);
+    for (size_t i = 0; i != n; ++i) {
+      bool expected = false;
+      if (rings[i]->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return rings[i];
+      }
+    }
+    if (n == max_producers) {
+      return nullptr;
+    }
+    rings[n] = std::make_shared<ring>(id, ring_capacity);
+    rings[n]->in_use.store(true, std::memory_order_relaxed);
+    nof_rings.store(n + 1, std::memory_order_release);
+    return rings[n];
   }
 };
 
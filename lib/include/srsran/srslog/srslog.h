@@ -156,6 +156,11 @@ std::unique_ptr<log_formatter> create_text_formatter();
 /// Creates a new instance of a JSON formatter.
 std::unique_ptr<log_formatter> create_json_formatter();
 
+/// Creates a new instance of a binary formatter. Log entries are stored with
+/// their raw arguments and a format string id, rendering them to text is
+/// deferred to the srslog_decoder tool.
+std::unique_ptr<log_formatter> create_binary_formatter();
+
 ///
 /// Sink management functions.
 ///
@@ -195,6 +200,11 @@ sink& fetch_file_sink(const std::string&             path,
                       bool                           force_flush = false,
                       std::unique_ptr<log_formatter> f           = get_default_log_formatter());
 
+/// Returns an instance of a sink that writes log entries in binary format into
+/// a memory-mapped file in the specified path, see create_binary_formatter.
+/// The file is grown and mapped in chunks of chunk_size bytes.
+sink& fetch_binary_file_sink(const std::string& path, size_t chunk_size = 16 * 1024 * 1024);
+
 /// Returns an instance of a sink that writes into syslog
 /// preamble: The string  prepended to every message, If ident is "", the program name is used.
 /// log_local: custom unused facilities that syslog provides which can be used by the user
@@ -249,6 +259,11 @@ void init(backend_priority priority = backend_priority::normal);
 /// NOTE: This function does nothing if init() has not been called.
 void flush();
 
+/// Returns the number of log entries discarded so far because the backend could
+/// not keep up with the rate of incoming entries. Threads generating log entries
+/// never block, new entries are discarded instead when their queue is full.
+uint64_t get_nof_dropped_log_entries();
+
 /// Installs the specified error handler to receive any error messages generated
 /// by the framework.
 /// NOTE: This function should be called before init() and is NOT thread safe.
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_DISCARD_QUEUE_H
+#define SRSRAN_PDCP_DISCARD_QUEUE_H
+
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/task_scheduler.h"
+#include <limits>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Discard timers (discardTimer) of the PDCP SDUs in flight of a bearer.
+ * All the SDUs of a bearer use the same discard timeout, so their expiry order matches their arrival order. Instead
+ * of one timer per SDU, the SDUs are stored in a SN-indexed ring, linked in arrival order and stamped with their
+ * arrival time. A single bearer timer is armed for the oldest SDU and, once it fires, all the SDUs whose discard
+ * timeout has been reached are expired in one batch. Starting and stopping the discard timer of an SDU is O(1) and
+ * does not allocate, except when the ring has to grow. Stopping the oldest SDU leaves the bearer timer armed, and it
+ * is re-armed for the new oldest SDU on expiry.
+ */
+class pdcp_discard_queue
+{
+public:
+  using discard_callback_t = srsran::move_callback<void(uint32_t)>;
+
+  explicit pdcp_discard_queue(srsran::task_sched_handle task_sched);
+  pdcp_discard_queue(const pdcp_discard_queue&) = delete;
+  pdcp_discard_queue(pdcp_discard_queue&&)      = delete;
+  pdcp_discard_queue& operator=(const pdcp_discard_queue&) = delete;
+  pdcp_discard_queue& operator=(pdcp_discard_queue&&) = delete;
+
+  /// \param capacity maximum number of SNs tracked simultaneously. Must be a power of two. The ring only grows up to it
+  /// when SDUs in flight collide in it
+  /// \param discard_timeout_ discard timeout in ms. Zero disables the discard timers
+  /// \param callback_ called with the SN of each discarded SDU
+  void configure(uint32_t capacity, uint32_t discard_timeout_, discard_callback_t callback_);
+
+  /// Starts the discard timer of an SDU. If the ring position is taken by an older SDU, the older SDU is discarded
+  void start(uint32_t sn);
+  /// Stops the discard timer of an SDU. Returns false if it was not running
+  bool stop(uint32_t sn);
+  void clear();
+
+  bool     is_running(uint32_t sn) const;
+  uint32_t nof_running() const { return count; }
+  uint32_t get_discard_timeout() const { return discard_timeout; }
+
+private:
+  static const uint32_t nil              = std::numeric_limits<uint32_t>::max();
+  static const uint32_t initial_capacity = 64;
+
+  struct entry_t {
+    uint32_t sn      = 0;
+    uint32_t arrival = 0;
+    uint32_t prev    = nil;
+    uint32_t next    = nil;
+    bool     running = false;
+  };
+
+  uint32_t now() const { return clock_base + timer.time_elapsed(); }
+  void     resize(uint32_t new_capacity);
+  void     unlink(uint32_t idx);
+  void     handle_expiry();
+
+  uint32_t             discard_timeout = 0;
+  uint32_t             max_capacity    = 0;
+  uint32_t             mask            = 0;
+  uint32_t             count           = 0;
+  uint32_t             head = nil, tail = nil;
+  uint32_t             clock_base = 0; ///< time when the bearer timer was last armed
+  std::vector<entry_t> entries;
+  discard_callback_t   callback;
+  srsran::unique_timer timer;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_DISCARD_QUEUE_H
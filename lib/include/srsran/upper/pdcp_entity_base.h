@@ -27,6 +27,7 @@
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/security.h"
+#include "srsran/common/security_engine.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/timers.h"
@@ -169,6 +170,11 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // EEA2/EIA2 engines, keyed in config_security()
+  aes128_security_engine rrc_enc_engine, rrc_int_engine, up_enc_engine, up_int_engine;
+  aes128_security_engine& enc_engine() { return is_srb() ? rrc_enc_engine : up_enc_engine; }
+  aes128_security_engine& int_engine() { return is_srb() ? rrc_int_engine : up_int_engine; }
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
@@ -28,6 +28,7 @@
 #include "srsran/common/security.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/upper/pdcp_discard_queue.h"
 #include "srsran/upper/pdcp_entity_base.h"
 
 namespace srsue {
@@ -42,7 +43,10 @@ namespace srsran {
 class undelivered_sdus_queue
 {
 public:
-  explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod);
+  explicit undelivered_sdus_queue(srsran::task_sched_handle              task_sched,
+                                  uint32_t                               sn_mod,
+                                  uint32_t                               discard_timeout,
+                                  pdcp_discard_queue::discard_callback_t discard_callback);
 
   bool            empty() const { return count == 0; }
   bool            is_full() const { return count >= capacity; }
@@ -54,12 +58,9 @@ public:
     return sdus[sn].sdu != nullptr and sdus[sn].sdu->md.pdcp_sn == sn;
   }
   // Getter for the number of discard timers. Used for debugging.
-  size_t nof_discard_timers() const;
+  size_t nof_discard_timers() const { return discard_timers.nof_running(); }
 
-  bool add_sdu(uint32_t                              sn,
-               const srsran::unique_byte_buffer_t&   sdu,
-               uint32_t                              discard_timeout,
-               srsran::move_callback<void(uint32_t)> callback);
+  bool add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu);
 
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
@@ -88,7 +89,6 @@ private:
 
   struct sdu_data {
     srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
   };
 
   uint32_t                                   count = 0;
@@ -96,6 +96,7 @@ private:
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
   uint32_t                                   lms   = 0;
   srsran::circular_array<sdu_data, capacity> sdus;
+  pdcp_discard_queue                         discard_timers;
 };
 
 /****************************************************************************
@@ -206,16 +207,11 @@ private:
 class pdcp_entity_lte::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_lte* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  explicit discard_callback(pdcp_entity_lte* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_lte* parent;
-  uint32_t         discard_sn;
 };
 
 } // namespace srsran
@@ -32,6 +32,7 @@
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
+#include "srsran/upper/pdcp_discard_queue.h"
 #include <map>
 
 namespace srsran {
@@ -71,7 +72,7 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
-  uint32_t nof_discard_timers() { return discard_timers_map.size(); }
+  uint32_t nof_discard_timers() { return discard_timers.nof_running(); }
   bool     is_reordering_timer_running() { return reordering_timer.is_running(); }
 
   // State variable setters (should be used only for testing)
@@ -112,7 +113,7 @@ private:
 
   // Discard callback (discardTimer)
   class discard_callback;
-  std::map<uint32_t, timer_handler::unique_timer> discard_timers_map;
+  pdcp_discard_queue discard_timers;
 
   // COUNT overflow protection
   bool tx_overflow = false;
@@ -142,16 +143,11 @@ private:
 class pdcp_entity_nr::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_nr* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  explicit discard_callback(pdcp_entity_nr* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_nr* parent;
-  uint32_t        discard_sn;
 };
 
 /*
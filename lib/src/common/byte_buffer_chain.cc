@@ -0,0 +1,92 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/byte_buffer_chain.h"
+
+namespace srsran {
+
+namespace {
+
+// Slabs share the memory blocks of the global byte buffer pool
+using slab_pool = byte_buffer_pool;
+
+/// Offset of the slab payload within its memory block
+const size_t slab_header_size = (sizeof(byte_buffer_slab) + alignof(detail::max_alignment_t) - 1) /
+                                alignof(detail::max_alignment_t) * alignof(detail::max_alignment_t);
+
+} // namespace
+
+uint32_t byte_buffer_slab::max_size()
+{
+  return slab_pool::BLOCK_SIZE - slab_header_size;
+}
+
+byte_buffer_slab* byte_buffer_slab::create(uint32_t size) noexcept
+{
+  if (size > max_size()) {
+    return nullptr;
+  }
+  void* block = slab_pool::get_instance()->allocate_node(slab_pool::BLOCK_SIZE);
+  if (block == nullptr) {
+    return nullptr;
+  }
+  return new (block) byte_buffer_slab(static_cast<uint8_t*>(block) + slab_header_size, max_size());
+}
+
+byte_buffer_slab* byte_buffer_slab::adopt(unique_byte_buffer_t buf) noexcept
+{
+  if (buf == nullptr) {
+    return nullptr;
+  }
+
+  // The slab header is placed in the unused headroom of the buffer, so no extra memory is allocated
+  uintptr_t hdr_addr = reinterpret_cast<uintptr_t>(buf->buffer);
+  hdr_addr = (hdr_addr + alignof(byte_buffer_slab) - 1) / alignof(byte_buffer_slab) * alignof(byte_buffer_slab);
+  uint8_t* storage = reinterpret_cast<uint8_t*>(hdr_addr) + sizeof(byte_buffer_slab);
+  if (storage > buf->msg) {
+    // Not enough headroom left. Fall back to a copy of the payload, placed after the default headroom
+    byte_buffer_slab* slab = create(DEFAULT_HEADROOM + buf->N_bytes);
+    if (slab != nullptr) {
+      memcpy(slab->begin() + DEFAULT_HEADROOM, buf->msg, buf->N_bytes);
+      slab->md = buf->md;
+    }
+    return slab;
+  }
+
+  uint32_t          len  = buf->buffer + sizeof(buf->buffer) - storage;
+  byte_buffer_slab* slab = new (reinterpret_cast<void*>(hdr_addr)) byte_buffer_slab(storage, len);
+  slab->md               = buf->md;
+  slab->adopted_buf      = buf.release();
+  return slab;
+}
+
+void byte_buffer_slab::destroy(byte_buffer_slab* slab)
+{
+  byte_buffer_t* adopted_buf = slab->adopted_buf;
+  slab->~byte_buffer_slab();
+  if (adopted_buf != nullptr) {
+    delete adopted_buf;
+  } else {
+    slab_pool::get_instance()->deallocate_node(slab);
+  }
+}
+
+} // namespace srsran
@@ -21,6 +21,10 @@
 
 #include "srsran/common/s3g.h"
 
+#ifdef __PCLMUL__
+#include <immintrin.h>
+#endif
+
 /* S-box SQ */
 static const uint8_t SQ[256] = {
     0x25, 0x24, 0x73, 0x67, 0xD7, 0xAE, 0x5C, 0x30, 0xA4, 0xEE, 0x6E, 0xCB, 0x7D, 0xB5, 0x82, 0xDB, 0xE4, 0x8E, 0x48,
@@ -451,12 +455,24 @@ uint64_t s3g_MUL64xPOW(uint64_t V, uint8_t i, uint64_t c)
  */
 uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
 {
+#ifdef __PCLMUL__
+  // Carry-less product, reduced twice with x^64 = c. Valid while deg(c) < 32, as the reduction polynomial of UIA2
+  if ((c >> 32) == 0) {
+    __m128i cc   = _mm_set_epi64x(0, (long long)c);
+    __m128i prod = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)V), _mm_set_epi64x(0, (long long)P), 0x00);
+    __m128i red  = _mm_clmulepi64_si128(prod, cc, 0x01);
+    __m128i red2 = _mm_clmulepi64_si128(red, cc, 0x01);
+    return (uint64_t)_mm_cvtsi128_si64(_mm_xor_si128(_mm_xor_si128(prod, red), red2));
+  }
+#endif
+  // Accumulate V * x^i for each bit i of P
   uint64_t result = 0;
   int      i      = 0;
 
   for (i = 0; i < 64; i++) {
     if ((P >> i) & 0x1)
-      result ^= s3g_MUL64xPOW(V, i, c);
+      result ^= V;
+    V = s3g_MUL64x(V, c);
   }
   return result;
 }
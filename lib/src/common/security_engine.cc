@@ -0,0 +1,269 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security_engine.h"
+#include <algorithm>
+#include <string.h>
+
+#if defined(__AES__) && defined(__SSSE3__)
+#define HAVE_AESNI
+#include <immintrin.h>
+#endif
+
+namespace srsran {
+
+namespace {
+
+/// First 8 bytes of the EEA2 counter block and of the EIA2 message. TS 33.401 B.1.3 and B.2.3
+void build_header(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t hdr[8])
+{
+  hdr[0] = (count >> 24) & 0xFF;
+  hdr[1] = (count >> 16) & 0xFF;
+  hdr[2] = (count >> 8) & 0xFF;
+  hdr[3] = count & 0xFF;
+  hdr[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+  hdr[5] = 0;
+  hdr[6] = 0;
+  hdr[7] = 0;
+}
+
+uint32_t cmac_nof_blocks(uint32_t len)
+{
+  return (len + 8 + 15) / 16;
+}
+
+/// Returns block i of the CMAC input M = header | msg. The first and the last block are assembled in buf, the last one
+/// with its padding and subkey applied (RFC 4493). The other blocks are read in place from msg.
+const uint8_t* cmac_block(const uint8_t  hdr[8],
+                          const uint8_t* msg,
+                          uint32_t       len,
+                          uint32_t       i,
+                          uint32_t       n,
+                          const uint8_t* k1,
+                          const uint8_t* k2,
+                          uint8_t        buf[16])
+{
+  if (i != 0 and i != n - 1) {
+    return msg + 16 * i - 8;
+  }
+  uint32_t nbytes = std::min(16U, len + 8 - 16 * i);
+  memset(buf, 0, 16);
+  if (i == 0) {
+    memcpy(buf, hdr, 8);
+    memcpy(buf + 8, msg, nbytes - 8);
+  } else {
+    memcpy(buf, msg + 16 * i - 8, nbytes);
+  }
+  if (i == n - 1) {
+    const uint8_t* k = k1;
+    if (nbytes < 16) {
+      buf[nbytes] = 0x80;
+      k           = k2;
+    }
+    for (uint32_t j = 0; j < 16; ++j) {
+      buf[j] ^= k[j];
+    }
+  }
+  return buf;
+}
+
+/// Subkey derivation, RFC 4493 section 2.3
+void cmac_subkey(const uint8_t in[16], uint8_t out[16])
+{
+  for (uint32_t i = 0; i < 15; i++) {
+    out[i] = (in[i] << 1) | ((in[i + 1] >> 7) & 0x01);
+  }
+  out[15] = in[15] << 1;
+  if (in[0] & 0x80) {
+    out[15] ^= 0x87;
+  }
+}
+
+#ifdef HAVE_AESNI
+
+inline __m128i aes128_key_assist(__m128i key, __m128i keygened)
+{
+  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, keygened);
+}
+
+#define AES128_KEY_EXPAND(k, rcon) aes128_key_assist(k, _mm_aeskeygenassist_si128(k, rcon))
+
+inline __m128i aes128_encrypt(const __m128i* rk, __m128i b)
+{
+  b = _mm_xor_si128(b, rk[0]);
+  for (uint32_t r = 1; r < 10; ++r) {
+    b = _mm_aesenc_si128(b, rk[r]);
+  }
+  return _mm_aesenclast_si128(b, rk[10]);
+}
+
+/// Encrypts four independent blocks, interleaving the rounds so that they overlap in the AES unit
+inline void aes128_encrypt4(const __m128i* rk, __m128i b[4])
+{
+  for (uint32_t j = 0; j < 4; ++j) {
+    b[j] = _mm_xor_si128(b[j], rk[0]);
+  }
+  for (uint32_t r = 1; r < 10; ++r) {
+    for (uint32_t j = 0; j < 4; ++j) {
+      b[j] = _mm_aesenc_si128(b[j], rk[r]);
+    }
+  }
+  for (uint32_t j = 0; j < 4; ++j) {
+    b[j] = _mm_aesenclast_si128(b[j], rk[10]);
+  }
+}
+
+inline __m128i ctr_block(uint64_t nonce, uint64_t ctr)
+{
+  return _mm_set_epi64x((long long)__builtin_bswap64(ctr), (long long)nonce);
+}
+
+#endif // HAVE_AESNI
+
+} // namespace
+
+bool aes128_security_engine::is_accelerated()
+{
+#ifdef HAVE_AESNI
+  return true;
+#else
+  return false;
+#endif
+}
+
+void aes128_security_engine::set_key(const uint8_t* key)
+{
+  uint8_t zero[16] = {};
+  uint8_t L[16];
+
+  aes_setkey_enc(&ctx, key, 128);
+#ifdef HAVE_AESNI
+  __m128i rk[11];
+  rk[0]  = _mm_loadu_si128((const __m128i*)key);
+  rk[1]  = AES128_KEY_EXPAND(rk[0], 0x01);
+  rk[2]  = AES128_KEY_EXPAND(rk[1], 0x02);
+  rk[3]  = AES128_KEY_EXPAND(rk[2], 0x04);
+  rk[4]  = AES128_KEY_EXPAND(rk[3], 0x08);
+  rk[5]  = AES128_KEY_EXPAND(rk[4], 0x10);
+  rk[6]  = AES128_KEY_EXPAND(rk[5], 0x20);
+  rk[7]  = AES128_KEY_EXPAND(rk[6], 0x40);
+  rk[8]  = AES128_KEY_EXPAND(rk[7], 0x80);
+  rk[9]  = AES128_KEY_EXPAND(rk[8], 0x1B);
+  rk[10] = AES128_KEY_EXPAND(rk[9], 0x36);
+  for (uint32_t r = 0; r < 11; ++r) {
+    _mm_store_si128((__m128i*)round_keys[r], rk[r]);
+  }
+  _mm_storeu_si128((__m128i*)L, aes128_encrypt(rk, _mm_setzero_si128()));
+#else
+  aes_crypt_ecb(&ctx, AES_ENCRYPT, zero, L);
+#endif
+  cmac_subkey(L, k1);
+  cmac_subkey(k1, k2);
+  key_set = true;
+}
+
+void aes128_security_engine::eea2(uint32_t       count,
+                                  uint8_t        bearer,
+                                  uint8_t        direction,
+                                  const uint8_t* msg,
+                                  uint32_t       len,
+                                  uint8_t*       out) const
+{
+  uint8_t hdr[8];
+  build_header(count, bearer, direction, hdr);
+
+#ifdef HAVE_AESNI
+  const __m128i* rk = (const __m128i*)round_keys;
+  uint64_t       nonce;
+  memcpy(&nonce, hdr, sizeof(nonce));
+  uint64_t ctr = 0;
+  uint32_t i   = 0;
+  for (; i + 64 <= len; i += 64, ctr += 4) {
+    __m128i b[4] = {
+        ctr_block(nonce, ctr), ctr_block(nonce, ctr + 1), ctr_block(nonce, ctr + 2), ctr_block(nonce, ctr + 3)};
+    aes128_encrypt4(rk, b);
+    for (uint32_t j = 0; j < 4; ++j) {
+      __m128i m = _mm_loadu_si128((const __m128i*)(msg + i + 16 * j));
+      _mm_storeu_si128((__m128i*)(out + i + 16 * j), _mm_xor_si128(m, b[j]));
+    }
+  }
+  for (; i < len; i += 16, ++ctr) {
+    __m128i ks = aes128_encrypt(rk, ctr_block(nonce, ctr));
+    if (len - i >= 16) {
+      __m128i m = _mm_loadu_si128((const __m128i*)(msg + i));
+      _mm_storeu_si128((__m128i*)(out + i), _mm_xor_si128(m, ks));
+    } else {
+      uint8_t ks_bytes[16];
+      _mm_storeu_si128((__m128i*)ks_bytes, ks);
+      for (uint32_t j = 0; j < len - i; ++j) {
+        out[i + j] = msg[i + j] ^ ks_bytes[j];
+      }
+    }
+  }
+#else
+  uint8_t nonce_cnt[16] = {};
+  uint8_t stream_blk[16];
+  size_t  nc_off = 0;
+  memcpy(nonce_cnt, hdr, sizeof(hdr));
+  aes_crypt_ctr(&ctx, len, &nc_off, nonce_cnt, stream_blk, msg, out);
+#endif
+}
+
+void aes128_security_engine::eia2(uint32_t       count,
+                                  uint8_t        bearer,
+                                  uint8_t        direction,
+                                  const uint8_t* msg,
+                                  uint32_t       len,
+                                  uint8_t*       mac) const
+{
+  uint8_t  hdr[8];
+  uint8_t  buf[16];
+  uint32_t n = cmac_nof_blocks(len);
+  build_header(count, bearer, direction, hdr);
+
+#ifdef HAVE_AESNI
+  const __m128i* rk = (const __m128i*)round_keys;
+  __m128i        T  = _mm_setzero_si128();
+  for (uint32_t i = 0; i < n; ++i) {
+    __m128i b = _mm_loadu_si128((const __m128i*)cmac_block(hdr, msg, len, i, n, k1, k2, buf));
+    T         = aes128_encrypt(rk, _mm_xor_si128(T, b));
+  }
+  _mm_storeu_si128((__m128i*)buf, T);
+  memcpy(mac, buf, 4);
+#else
+  uint8_t T[16] = {};
+  uint8_t tmp[16];
+  for (uint32_t i = 0; i < n; ++i) {
+    const uint8_t* b = cmac_block(hdr, msg, len, i, n, k1, k2, buf);
+    for (uint32_t j = 0; j < 16; ++j) {
+      tmp[j] = T[j] ^ b[j];
+    }
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
+  }
+  memcpy(mac, T, 4);
+#endif
+}
+
+} // namespace srsran
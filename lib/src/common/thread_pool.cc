@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <chrono>
 #include <stdio.h>
+#include <thread>
 
 #define DEBUG 0
 #define debug_thread(fmt, ...)                                                                                         \
@@ -401,6 +402,252 @@ void task_thread_pool::worker_t::run_thread()
   running = false;
 }
 
+/**************************************************************************
+ *  work_stealing_thread_pool - per-worker lock-free task queues, with
+ *  idle workers stealing from the queues of other workers
+ *************************************************************************/
+
+namespace {
+
+/// Number of empty polls of the task queues before an idle worker goes to sleep
+const uint32_t ws_max_idle_spins = 64;
+
+/// Pool and worker index of the calling thread, when it is a work-stealing pool worker
+thread_local const void* ws_current_pool   = nullptr;
+thread_local uint32_t    ws_current_worker = 0;
+
+void ws_backoff(uint32_t spin)
+{
+  if (spin < 16) {
+    for (uint32_t i = 0; i < (1u << (spin / 2)); ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#endif
+    }
+  } else {
+    std::this_thread::yield();
+  }
+}
+
+} // namespace
+
+work_stealing_thread_pool::task_queue::task_queue(uint32_t capacity) :
+  cells(new cell_t[capacity]), mask(capacity - 1)
+{
+  assert((capacity & mask) == 0 && "Queue capacity must be a power of 2");
+  for (size_t i = 0; i < capacity; ++i) {
+    cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool work_stealing_thread_pool::task_queue::try_push(task_t& task)
+{
+  size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+  while (true) {
+    cell_t&  cell = cells[pos & mask];
+    size_t   seq  = cell.seq.load(std::memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0) {
+      if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.task = std::move(task);
+        cell.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // full
+      return false;
+    } else {
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool work_stealing_thread_pool::task_queue::try_pop(task_t& task)
+{
+  size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+  while (true) {
+    cell_t&  cell = cells[pos & mask];
+    size_t   seq  = cell.seq.load(std::memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        task = std::move(cell.task);
+        cell.seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // empty
+      return false;
+    } else {
+      pos = dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+work_stealing_thread_pool::work_stealing_thread_pool(uint32_t nof_workers,
+                                                     bool     start_deferred,
+                                                     int32_t  prio_,
+                                                     uint32_t mask_) :
+  logger(srslog::fetch_basic_logger("POOL")), workers(std::max(1u, nof_workers))
+{
+  // split the task capacity of task_thread_pool among the worker queues
+  uint32_t queue_capacity = 1024;
+  while (queue_capacity * workers.size() < max_task_num) {
+    queue_capacity *= 2;
+  }
+  for (uint32_t i = 0; i < workers.size(); ++i) {
+    queues.emplace_back(new task_queue(queue_capacity));
+  }
+  if (not start_deferred) {
+    start(prio_, mask_);
+  }
+}
+
+work_stealing_thread_pool::~work_stealing_thread_pool()
+{
+  stop();
+}
+
+void work_stealing_thread_pool::set_worker_cpus(std::vector<uint32_t> cpus)
+{
+  if (running) {
+    logger.error("Worker CPUs must be set before the thread pool is started");
+    return;
+  }
+  worker_cpus = std::move(cpus);
+}
+
+void work_stealing_thread_pool::start(int32_t prio_, uint32_t mask_)
+{
+  if (running.exchange(true)) {
+    logger.error("Starting thread pool that has already started");
+    return;
+  }
+  prio = prio_;
+  mask = mask_;
+  for (uint32_t i = 0; i < workers.size(); ++i) {
+    workers[i].reset(new worker_t(this, i));
+  }
+}
+
+void work_stealing_thread_pool::stop()
+{
+  if (not running.exchange(false)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    cv_sleep.notify_all();
+  }
+  for (std::unique_ptr<worker_t>& w : workers) {
+    w->stop();
+  }
+}
+
+void work_stealing_thread_pool::push_task(task_t&& task)
+{
+  // tasks pushed by a worker stay in its own queue, while external producers spread them among all queues
+  uint32_t start_idx = (ws_current_pool == this) ? ws_current_worker
+                                                 : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+  nof_pending.fetch_add(1, std::memory_order_seq_cst);
+  bool pushed = false;
+  for (uint32_t i = 0; i < queues.size() and not pushed; ++i) {
+    pushed = queues[(start_idx + i) % queues.size()]->try_push(task);
+  }
+  if (not pushed) {
+    std::lock_guard<std::mutex> lock(overflow_mutex);
+    if (overflow_tasks.empty()) {
+      logger.warning("Task queues are full (maximum size is %u). Using the overflow queue", uint32_t(max_task_num));
+    }
+    overflow_tasks.push_back(std::move(task));
+    nof_overflow.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  // wake up a sleeping worker, if any, so that it can steal the task
+  if (nof_sleeping.load(std::memory_order_seq_cst) > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    cv_sleep.notify_one();
+  }
+}
+
+uint32_t work_stealing_thread_pool::nof_pending_tasks() const
+{
+  return std::max(0, nof_pending.load(std::memory_order_relaxed));
+}
+
+work_stealing_thread_pool::worker_t::worker_t(work_stealing_thread_pool* parent_, uint32_t my_id) :
+  thread(std::string("WSWORKER") + std::to_string(my_id)), parent(parent_), id_(my_id)
+{
+  if (not parent->worker_cpus.empty()) {
+    start_cpu(parent->prio, parent->worker_cpus[id_ % parent->worker_cpus.size()]);
+  } else if (parent->mask == 255) {
+    start(parent->prio);
+  } else {
+    start_cpu_mask(parent->prio, parent->mask);
+  }
+}
+
+void work_stealing_thread_pool::worker_t::stop()
+{
+  wait_thread_finish();
+}
+
+bool work_stealing_thread_pool::worker_t::try_get_task(task_t& task)
+{
+  size_t nof_queues = parent->queues.size();
+  for (size_t i = 0; i < nof_queues; ++i) {
+    // own queue first, then steal from the others
+    if (parent->queues[(id_ + i) % nof_queues]->try_pop(task)) {
+      parent->nof_pending.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  if (parent->nof_overflow.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(parent->overflow_mutex);
+    if (not parent->overflow_tasks.empty()) {
+      task = std::move(parent->overflow_tasks.front());
+      parent->overflow_tasks.pop_front();
+      parent->nof_overflow.fetch_sub(1, std::memory_order_relaxed);
+      parent->nof_pending.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool work_stealing_thread_pool::worker_t::wait_task(task_t& task)
+{
+  while (parent->running.load(std::memory_order_relaxed)) {
+    for (uint32_t spin = 0; spin < ws_max_idle_spins; ++spin) {
+      if (try_get_task(task)) {
+        return true;
+      }
+      ws_backoff(spin);
+    }
+
+    std::unique_lock<std::mutex> lock(parent->sleep_mutex);
+    parent->nof_sleeping.fetch_add(1, std::memory_order_seq_cst);
+    parent->cv_sleep.wait(lock, [this]() {
+      return parent->nof_pending.load(std::memory_order_seq_cst) > 0 or not parent->running.load();
+    });
+    parent->nof_sleeping.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return false;
+}
+
+void work_stealing_thread_pool::worker_t::run_thread()
+{
+  ws_current_pool   = parent;
+  ws_current_worker = id_;
+
+  // main loop
+  task_t task;
+  while (wait_task(task)) {
+    task();
+  }
+}
+
 task_worker::task_worker(std::string thread_name_,
                          uint32_t    queue_size,
                          bool        start_deferred,
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_discard_queue.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+
+namespace srsran {
+
+pdcp_discard_queue::pdcp_discard_queue(srsran::task_sched_handle task_sched) : timer(task_sched.get_unique_timer()) {}
+
+void pdcp_discard_queue::configure(uint32_t capacity, uint32_t discard_timeout_, discard_callback_t callback_)
+{
+  srsran_assert(capacity > 0 and (capacity & (capacity - 1)) == 0, "Invalid discard queue capacity=%d", capacity);
+  clear();
+  discard_timeout = discard_timeout_;
+  callback        = std::move(callback_);
+  max_capacity    = capacity;
+  // The ring is allocated on the first SDU and grows with the number of SDUs in flight
+  std::vector<entry_t>().swap(entries);
+  mask = 0;
+  if (discard_timeout > 0) {
+    timer.set(discard_timeout, [this](uint32_t tid) { handle_expiry(); });
+  }
+}
+
+void pdcp_discard_queue::start(uint32_t sn)
+{
+  if (discard_timeout == 0) {
+    return;
+  }
+  if (entries.empty()) {
+    resize(std::min(initial_capacity, max_capacity));
+  }
+  uint32_t idx = sn & mask;
+  while (entries[idx].running and entries[idx].sn != sn and entries.size() < max_capacity) {
+    resize(entries.size() * 2);
+    idx = sn & mask;
+  }
+  if (entries[idx].running) {
+    uint32_t old_sn = entries[idx].sn;
+    unlink(idx);
+    if (old_sn != sn) {
+      // The older SDU has been in flight for a whole SN window
+      callback(old_sn);
+    }
+  }
+
+  if (not timer.is_running()) {
+    // Empty queue. Restart the clock with the timer of this SDU
+    clock_base = 0;
+    timer.set(discard_timeout);
+    timer.run();
+  }
+
+  entry_t& e = entries[idx];
+  e.sn       = sn;
+  e.arrival  = now();
+  e.prev     = tail;
+  e.next     = nil;
+  e.running  = true;
+  if (tail != nil) {
+    entries[tail].next = idx;
+  } else {
+    head = idx;
+  }
+  tail = idx;
+  count++;
+}
+
+bool pdcp_discard_queue::stop(uint32_t sn)
+{
+  if (not is_running(sn)) {
+    return false;
+  }
+  unlink(sn & mask);
+  return true;
+}
+
+void pdcp_discard_queue::clear()
+{
+  while (head != nil) {
+    unlink(head);
+  }
+  timer.stop();
+}
+
+bool pdcp_discard_queue::is_running(uint32_t sn) const
+{
+  if (entries.empty()) {
+    return false;
+  }
+  const entry_t& e = entries[sn & mask];
+  return e.running and e.sn == sn;
+}
+
+void pdcp_discard_queue::resize(uint32_t new_capacity)
+{
+  // Relink the SDUs in flight in arrival order. Their SNs are distinct modulo the old capacity, and hence also modulo
+  // the new one
+  std::vector<entry_t> old_entries(new_capacity);
+  old_entries.swap(entries);
+  mask            = new_capacity - 1;
+  uint32_t old_it = head;
+  head            = nil;
+  tail            = nil;
+  while (old_it != nil) {
+    const entry_t& old_e = old_entries[old_it];
+    uint32_t       idx   = old_e.sn & mask;
+    entry_t&       e     = entries[idx];
+    e.sn                 = old_e.sn;
+    e.arrival            = old_e.arrival;
+    e.prev               = tail;
+    e.running            = true;
+    if (tail != nil) {
+      entries[tail].next = idx;
+    } else {
+      head = idx;
+    }
+    tail   = idx;
+    old_it = old_e.next;
+  }
+}
+
+void pdcp_discard_queue::unlink(uint32_t idx)
+{
+  entry_t& e = entries[idx];
+  if (e.prev != nil) {
+    entries[e.prev].next = e.next;
+  } else {
+    head = e.next;
+  }
+  if (e.next != nil) {
+    entries[e.next].prev = e.prev;
+  } else {
+    tail = e.prev;
+  }
+  e.prev    = nil;
+  e.next    = nil;
+  e.running = false;
+  count--;
+}
+
+void pdcp_discard_queue::handle_expiry()
+{
+  // Discard all SDUs whose timeout has been reached in one go
+  uint32_t t_now = now();
+  while (head != nil and t_now - entries[head].arrival >= discard_timeout) {
+    uint32_t sn = entries[head].sn;
+    unlink(head);
+    callback(sn);
+  }
+
+  // Re-arm the timer for the oldest SDU still in flight. Expiry callbacks run before the timer handler advances its
+  // clock, so the new timer is armed one tic earlier than t_now
+  if (head != nil) {
+    clock_base = t_now - 1;
+    timer.set(entries[head].arrival + discard_timeout - t_now + 1);
+    timer.run();
+  }
+}
+
+} // namespace srsran
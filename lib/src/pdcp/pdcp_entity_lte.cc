@@ -100,7 +100,8 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
 
   if (is_drb() and not rlc->rb_is_um(lcid)) {
-    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, maximum_pdcp_sn));
+    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(
+        task_sched, maximum_pdcp_sn, static_cast<uint32_t>(cfg.discard_timer), discard_callback(this)));
     rx_counts_info.reserve(reordering_window);
   }
 
@@ -718,9 +719,8 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
   }
 
   // Copy PDU contents into queue and start discard timer
-  uint32_t         discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
-  discard_callback discard_fnc(this, sn);
-  bool             ret = undelivered_sdus->add_sdu(sn, sdu, discard_timeout, discard_fnc);
+  uint32_t discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
+  bool     ret             = undelivered_sdus->add_sdu(sn, sdu);
   if (ret and discard_timeout > 0) {
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, discard_timeout);
   }
@@ -731,7 +731,7 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
  * Discard functionality
  ***************************************************************************/
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_lte::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_lte::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.info("Discard timer for SN=%d expired", discard_sn);
 
@@ -873,17 +873,16 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle              task_sched,
+                                               uint32_t                               sn_mod,
+                                               uint32_t                               discard_timeout,
+                                               pdcp_discard_queue::discard_callback_t discard_callback) :
+  sn_mod(sn_mod), discard_timers(task_sched)
 {
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
-  }
+  discard_timers.configure(capacity, discard_timeout, std::move(discard_callback));
 }
 
-bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
-                                     const srsran::unique_byte_buffer_t&   sdu,
-                                     uint32_t                              discard_timeout,
-                                     srsran::move_callback<void(uint32_t)> callback)
+bool undelivered_sdus_queue::add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu)
 {
   assert(not has_sdu(sn) && "Cannot add repeated SNs");
 
@@ -921,10 +920,7 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->md.pdcp_sn = sn;
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
-  if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
-  }
+  discard_timers.start(sn);
   sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
   return true;
@@ -937,7 +933,7 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   }
   count--;
   bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
+  discard_timers.stop(sn);
   sdus[sn].sdu.reset();
   // Find next FMS, if necessary
   if (sn == fms) {
@@ -951,19 +947,12 @@ void undelivered_sdus_queue::clear()
   count = 0;
   bytes = 0;
   fms   = 0;
+  discard_timers.clear();
   for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
     sdus[sn].sdu.reset();
   }
 }
 
-size_t undelivered_sdus_queue::nof_discard_timers() const
-{
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
-  });
-}
-
 void undelivered_sdus_queue::update_fms()
 {
   if (empty()) {
@@ -34,7 +34,8 @@ pdcp_entity_nr::pdcp_entity_nr(srsue::rlc_interface_pdcp* rlc_,
   rlc(rlc_),
   rrc(rrc_),
   gw(gw_),
-  reordering_fnc(new pdcp_entity_nr::reordering_callback(this))
+  reordering_fnc(new pdcp_entity_nr::reordering_callback(this)),
+  discard_timers(task_sched_)
 {
   lcid                 = lcid_;
   integrity_direction  = DIRECTION_NONE;
@@ -82,6 +83,11 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   if (rlc_mode == rlc_mode_t::UM) {
     cfg.discard_timer = pdcp_discard_timer_t::infinity;
   }
+
+  // Discard timers of the SDUs in flight, indexed by COUNT. An infinite discard timer disables them
+  uint32_t discard_timeout =
+      cfg.discard_timer == pdcp_discard_timer_t::infinity ? 0 : static_cast<uint32_t>(cfg.discard_timer);
+  discard_timers.configure(window_size, discard_timeout, discard_callback(this));
   return true;
 }
 
@@ -127,11 +133,7 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
 
   // Start discard timer
   if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
-    timer_handler::unique_timer discard_timer = task_sched.get_unique_timer();
-    discard_callback            discard_fnc(this, tx_next);
-    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), discard_fnc);
-    discard_timer.run();
-    discard_timers_map.insert(std::make_pair(tx_next, std::move(discard_timer)));
+    discard_timers.start(tx_next);
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", tx_next, static_cast<uint32_t>(cfg.discard_timer));
   }
 
@@ -328,9 +330,8 @@ void pdcp_entity_nr::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
 {
   logger.debug("Received delivery notification from RLC. Nof SNs=%ld", pdcp_sns.size());
   for (uint32_t sn : pdcp_sns) {
-    // Remove timer from map
     logger.debug("Stopping discard timer for SN=%ld", sn);
-    discard_timers_map.erase(sn);
+    discard_timers.stop(sn);
   }
 }
 
@@ -403,16 +404,12 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 }
 
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_nr::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_nr::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.debug("Discard timer expired for PDU with SN=%d", discard_sn);
 
   // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
   parent->rlc->discard_sdu(parent->lcid, discard_sn);
-
-  // Remove timer from map
-  // NOTE: this will delete the callback. It *must* be the last instruction.
-  parent->discard_timers_map.erase(discard_sn);
 }
 
 void pdcp_entity_nr::get_bearer_state(pdcp_lte_state_t* state)
@@ -43,15 +43,15 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
-  }
-
   nof_channels = _nof_channels;
   for (uint32_t i = 0; i < nof_channels; i++) {
+    // Allocate internal buffers, each channel has its own so they can be processed in parallel
+    buffer_in[i]  = srsran_vec_cf_malloc(buffer_size);
+    buffer_out[i] = srsran_vec_cf_malloc(buffer_size);
+    if (!buffer_out[i] || !buffer_in[i]) {
+      ret = SRSRAN_ERROR;
+    }
+
     // Create fading channel
     if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
         ret == SRSRAN_SUCCESS) {
@@ -73,19 +73,19 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     } else {
       delay[i] = nullptr;
     }
-  }
 
-  // Create AWGN channnel
-  if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
-    awgn = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
-    ret  = srsran_channel_awgn_init(awgn, 1234);
-    srsran_channel_awgn_set_n0(awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB);
-  }
+    // Create AWGN channnel
+    if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
+      awgn[i] = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
+      ret     = srsran_channel_awgn_init(awgn[i], 1234 + i);
+      srsran_channel_awgn_set_n0(awgn[i], args.awgn_signal_power_dBfs - args.awgn_snr_dB);
+    }
 
-  // Create high speed train
-  if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
-    hst = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
-    srsran_channel_hst_init(hst, channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    // Create high speed train, all channels follow the same trajectory
+    if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
+      hst[i] = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
+      srsran_channel_hst_init(hst[i], channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    }
   }
 
   // Create Radio Link Failure simulator
@@ -97,26 +97,23 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
   }
+
+  // Launch the workers, the caller thread acts as worker 0
+  uint32_t nof_threads = SRSRAN_MIN(SRSRAN_MAX(args.nof_threads, 1), SRSRAN_MAX(nof_channels, 1));
+  for (uint32_t w = 1; w < nof_threads; w++) {
+    workers.emplace_back(&channel::worker_thread, this, w);
+  }
 }
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
+  {
+    std::unique_lock<std::mutex> lock(workers_mutex);
+    running = false;
   }
-
-  if (buffer_out) {
-    free(buffer_out);
-  }
-
-  if (awgn) {
-    srsran_channel_awgn_free(awgn);
-    free(awgn);
-  }
-
-  if (hst) {
-    srsran_channel_hst_free(hst);
-    free(hst);
+  cvar_start.notify_all();
+  for (std::thread& w : workers) {
+    w.join();
   }
 
   if (rlf) {
@@ -125,6 +122,14 @@ channel::~channel()
   }
 
   for (uint32_t i = 0; i < nof_channels; i++) {
+    if (buffer_in[i]) {
+      free(buffer_in[i]);
+    }
+
+    if (buffer_out[i]) {
+      free(buffer_out[i]);
+    }
+
     if (fading[i]) {
       srsran_channel_fading_free(fading[i]);
       free(fading[i]);
@@ -134,6 +139,16 @@ channel::~channel()
       srsran_channel_delay_free(delay[i]);
       free(delay[i]);
     }
+
+    if (awgn[i]) {
+      srsran_channel_awgn_free(awgn[i]);
+      free(awgn[i]);
+    }
+
+    if (hst[i]) {
+      srsran_channel_hst_free(hst[i]);
+      free(hst[i]);
+    }
   }
 }
 
@@ -147,66 +162,132 @@ static inline cf_t local_cexpf(float phase)
 }
 }
 
-void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
-                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
-                  uint32_t                  len,
-                  const srsran_timestamp_t& t)
+void channel::run_channel(uint32_t i)
 {
-  // Early return if pointers are not enabled
+  cf_t*                     in   = job_in[i];
+  cf_t*                     out  = job_out[i];
+  uint32_t                  len  = job_len;
+  const srsran_timestamp_t& t    = *job_t;
+  cf_t*                     bin  = buffer_in[i];
+  cf_t*                     bout = buffer_out[i];
+
+  // Skip channel if any buffer is null
   if (in == nullptr || out == nullptr) {
     return;
   }
 
-  // For each channel
-  for (uint32_t i = 0; i < nof_channels; i++) {
-    // Skip iteration if any buffer is null
-    if (in[i] == nullptr || out[i] == nullptr) {
-      continue;
+  // If sampling rate is not set, copy input and skip rest of channel
+  if (current_srate == 0) {
+    if (in != out) {
+      srsran_vec_cf_copy(out, in, len);
     }
+    return;
+  }
+
+  // Copy input buffer
+  srsran_vec_cf_copy(bin, in, len);
+
+  if (hst[i]) {
+    srsran_channel_hst_execute(hst[i], bin, bout, len, &t);
+    srsran_vec_sc_prod_ccc(bout, local_cexpf(hst_init_phase), bin, len);
+  }
+
+  if (awgn[i]) {
+    srsran_channel_awgn_run_c(awgn[i], bin, bout, len);
+    srsran_vec_cf_copy(bin, bout, len);
+  }
 
-    // If sampling rate is not set, copy input and skip rest of channel
-    if (current_srate == 0) {
-      if (in[i] != out[i]) {
-        srsran_vec_cf_copy(out[i], in[i], len);
+  if (fading[i]) {
+    srsran_channel_fading_execute(fading[i], bin, bout, len, t.full_secs + t.frac_secs);
+    srsran_vec_cf_copy(bin, bout, len);
+  }
+
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], bin, bout, len, &t);
+    srsran_vec_cf_copy(bin, bout, len);
+  }
+
+  if (rlf) {
+    srsran_channel_rlf_execute(rlf, bin, bout, len, &t);
+    srsran_vec_cf_copy(bin, bout, len);
+  }
+
+  // Copy output buffer
+  srsran_vec_cf_copy(out, bin, len);
+}
+
+void channel::run_worker(uint32_t worker_idx)
+{
+  uint32_t nof_threads = (uint32_t)workers.size() + 1;
+  for (uint32_t i = worker_idx; i < nof_channels; i += nof_threads) {
+    run_channel(i);
+  }
+}
+
+void channel::worker_thread(uint32_t worker_idx)
+{
+  uint64_t last_job = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(workers_mutex);
+      while (running && job_count == last_job) {
+        cvar_start.wait(lock);
       }
-      continue;
+      if (!running) {
+        return;
+      }
+      last_job = job_count;
     }
 
-    // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
+    run_worker(worker_idx);
 
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+    {
+      std::unique_lock<std::mutex> lock(workers_mutex);
+      nof_pending--;
+      if (nof_pending == 0) {
+        cvar_done.notify_one();
+      }
     }
+  }
+}
 
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
+void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                  uint32_t                  len,
+                  const srsran_timestamp_t& t)
+{
+  // Early return if pointers are not enabled
+  if (in == nullptr || out == nullptr) {
+    return;
+  }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  job_in  = in;
+  job_out = out;
+  job_len = len;
+  job_t   = &t;
+
+  if (workers.empty()) {
+    run_worker(0);
+  } else {
+    {
+      std::unique_lock<std::mutex> lock(workers_mutex);
+      nof_pending = (uint32_t)workers.size();
+      job_count++;
     }
+    cvar_start.notify_all();
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
+    // Process the channels assigned to the caller thread while the workers run
+    run_worker(0);
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    std::unique_lock<std::mutex> lock(workers_mutex);
+    while (nof_pending > 0) {
+      cvar_done.wait(lock);
     }
-
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
   }
 
-  if (hst) {
+  if (hst[0]) {
     // Increment phase to keep it coherent between frames
-    hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
+    hst_init_phase += (2 * M_PI * len * hst[0]->fs_hz / hst[0]->srate_hz);
 
     // Positive Remainder
     while (hst_init_phase > 2 * M_PI) {
@@ -225,8 +306,8 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   if (delay[0]) {
     str << "delay=" << delay[0]->delay_us << "us; ";
   }
-  if (hst) {
-    str << "hst=" << hst->fs_hz << "Hz; ";
+  if (hst[0]) {
+    str << "hst=" << hst[0]->fs_hz << "Hz; ";
   }
   logger.debug("%s", str.str().c_str());
 }
@@ -244,10 +325,10 @@ void channel::set_srate(uint32_t srate)
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
-    }
 
-    if (hst) {
-      srsran_channel_hst_update_srate(hst, srate);
+      if (hst[i]) {
+        srsran_channel_hst_update_srate(hst[i], srate);
+      }
     }
 
     // Update sampling rate
@@ -257,7 +338,9 @@ void channel::set_srate(uint32_t srate)
 
 void channel::set_signal_power_dBfs(float power_dBfs)
 {
-  if (awgn != nullptr) {
-    srsran_channel_awgn_set_n0(awgn, power_dBfs - args.awgn_snr_dB);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (awgn[i] != nullptr) {
+      srsran_channel_awgn_set_n0(awgn[i], power_dBfs - args.awgn_snr_dB);
+    }
   }
 }
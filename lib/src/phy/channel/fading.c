@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -90,6 +91,7 @@ static inline __m128 _sine(const float* table, __m128 arg)
   __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
   __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
   __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
+  indexi32         = _mm_and_si128(indexi32, _mm_set1_epi32(1023)); // Rounding can reach 1024, wrap it around
   _mm_store_si128((__m128i*)idx, indexi32);
 
   for (int i = 0; i < 4; i++) {
@@ -164,23 +166,37 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
 
 static inline void generate_taps(srsran_channel_fading_t* q, float time)
 {
-  // Generate taps
-  for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
-
-    if (i) {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
-
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
-    } else {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+  uint32_t ntaps = nof_taps[q->model];
+  cf_t     a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+
+  // Compute phase for the doppler dispersion of every tap
+  for (uint32_t i = 0; i < ntaps; i++) {
+    a[i] = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+  }
+
+  // Weighted sum of the static tap frequency responses in a single pass, the FFT shift is already applied to the taps
+  uint32_t k = 0;
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t _a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  for (uint32_t i = 0; i < ntaps; i++) {
+    _a[i] = srsran_simd_cf_set1(a[i]);
+  }
+
+  for (; k < q->N - SRSRAN_SIMD_CF_SIZE + 1; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(srsran_simd_cfi_load(&q->h_tap[0][k]), _a[0]);
+    for (uint32_t i = 1; i < ntaps; i++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(srsran_simd_cfi_load(&q->h_tap[i][k]), _a[i]));
     }
+    srsran_simd_cfi_store(&q->h_freq[k], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; k < q->N; k++) {
+    cf_t acc = q->h_tap[0][k] * a[0];
+    for (uint32_t i = 1; i < ntaps; i++) {
+      acc += q->h_tap[i][k] * a[i];
+    }
+    q->h_freq[k] = acc;
   }
   // at this stage, q->h_freq should contain the frequency response
 }
@@ -232,6 +248,13 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
     q->path_delay = q->N / 4;
     q->state_len  = 0;
 
+    // Allocate memory
+    q->temp = srsran_vec_cf_malloc(q->N);
+    if (!q->temp) {
+      fprintf(stderr, "Error: allocating h_freq\n");
+      goto clean_exit;
+    }
+
     // Initialise random number
     srsran_random_t* random = srsran_random_init(seed);
 
@@ -246,10 +269,14 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
 
       // Allocate tap frequency response
       q->h_tap[i] = srsran_vec_cf_malloc(q->N);
+    }
 
-      // Generate tap frequency response
+    // Generate the static tap frequency responses, stored FFT shifted so that the taps are combined in a single pass
+    for (uint32_t i = 0; i < nof_taps[q->model]; i++) {
       generate_tap(
-          excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->h_tap[i], q->N, q->path_delay);
+          excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->temp, q->N, q->path_delay);
+      srsran_vec_cf_copy(q->h_tap[i], &q->temp[q->N / 2], q->N / 2);
+      srsran_vec_cf_copy(&q->h_tap[i][q->N / 2], q->temp, q->N / 2);
     }
 
     // Generate sine Table
@@ -272,13 +299,6 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
       goto clean_exit;
     }
 
-    // Allocate memory
-    q->temp = srsran_vec_cf_malloc(q->N);
-    if (!q->temp) {
-      fprintf(stderr, "Error: allocating h_freq\n");
-      goto clean_exit;
-    }
-
     q->h_freq = srsran_vec_cf_malloc(q->N);
     if (!q->h_freq) {
       fprintf(stderr, "Error: allocating h_freq\n");
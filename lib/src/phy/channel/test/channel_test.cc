@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+
+static uint32_t    nof_channels = 4;
+static uint32_t    nof_threads  = 4;
+static uint32_t    nof_sf       = 20;
+static uint32_t    srate_hz     = 11520000;
+static std::string fading_model = "epa5";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [cpnsm]\n", prog);
+  printf("\t-c Number of channels [Default %d]\n", nof_channels);
+  printf("\t-p Number of threads [Default %d]\n", nof_threads);
+  printf("\t-n Number of subframes [Default %d]\n", nof_sf);
+  printf("\t-s Sampling rate in Hz [Default %d]\n", srate_hz);
+  printf("\t-m Fading model [Default %s]\n", fading_model.c_str());
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "c:p:n:s:m:h")) != -1) {
+    switch (opt) {
+      case 'c':
+        nof_channels = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'p':
+        nof_threads = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        srate_hz = (uint32_t)strtof(optarg, NULL);
+        break;
+      case 'm':
+        fading_model = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Runs the same input through a serial and a multi-threaded emulator, the outputs must be identical
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("CHAN", false);
+
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.awgn_enable             = true;
+  args.awgn_snr_dB             = 20.0f;
+  args.fading_enable           = true;
+  args.fading_model            = fading_model;
+  args.hst_enable              = true;
+  args.delay_enable            = true;
+  args.delay_min_us            = 1;
+  args.delay_max_us            = 10;
+  args.delay_period_s          = 0.1f;
+
+  srsran::channel serial(args, nof_channels, logger);
+  args.nof_threads = nof_threads;
+  srsran::channel parallel(args, nof_channels, logger);
+  serial.set_srate(srate_hz);
+  parallel.set_srate(srate_hz);
+
+  uint32_t           sf_len                       = srate_hz / 1000;
+  srsran_random_t    random                       = srsran_random_init(0);
+  cf_t*              in[SRSRAN_MAX_CHANNELS]      = {};
+  cf_t*              out_ser[SRSRAN_MAX_CHANNELS] = {};
+  cf_t*              out_par[SRSRAN_MAX_CHANNELS] = {};
+  srsran_timestamp_t ts                           = {};
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    in[i]      = srsran_vec_cf_malloc(sf_len);
+    out_ser[i] = srsran_vec_cf_malloc(sf_len);
+    out_par[i] = srsran_vec_cf_malloc(sf_len);
+  }
+
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      srsran_random_uniform_complex_dist_vector(random, in[i], sf_len, -1.0f, 1.0f);
+    }
+    serial.run(in, out_ser, sf_len, ts);
+    parallel.run(in, out_par, sf_len, ts);
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      TESTASSERT(memcmp(out_ser[i], out_par[i], sizeof(cf_t) * sf_len) == 0);
+    }
+    srsran_timestamp_add(&ts, 0, 0.001);
+  }
+
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    free(in[i]);
+    free(out_ser[i]);
+    free(out_par[i]);
+  }
+  srsran_random_free(random);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
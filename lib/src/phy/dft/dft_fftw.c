@@ -35,6 +35,12 @@
 
 #define FFTW_WISDOM_FILE "%s/.srsran_fftwisdom"
 
+// Environment variable that overrides the path of the system wide wisdom file
+#define FFTW_SYSTEM_WISDOM_ENV "SRSRAN_FFTW_WISDOM"
+#ifndef FFTW_SYSTEM_WISDOM_FILE
+#define FFTW_SYSTEM_WISDOM_FILE "/etc/srsran/fftw_wisdom"
+#endif
+
 static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 {
   const char* homedir = NULL;
@@ -53,10 +59,48 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+const char* srsran_dft_system_wisdom_file()
+{
+  const char* path = getenv(FFTW_SYSTEM_WISDOM_ENV);
+  return (path != NULL && path[0] != '\0') ? path : FFTW_SYSTEM_WISDOM_FILE;
+}
+
+int srsran_dft_import_wisdom(const char* path)
+{
+  pthread_mutex_lock(&fft_mutex);
+  int ret = fftwf_import_wisdom_from_filename(path) ? 0 : -1;
+  pthread_mutex_unlock(&fft_mutex);
+  return ret;
+}
+
+int srsran_dft_export_wisdom(const char* path)
+{
+  // Write into a temporal file and rename it, so that a process starting meanwhile never reads a partial file
+  char tmp_path[256];
+  if ((size_t)snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= sizeof(tmp_path)) {
+    return -1;
+  }
+
+  pthread_mutex_lock(&fft_mutex);
+  int ret = fftwf_export_wisdom_to_filename(tmp_path) ? 0 : -1;
+  pthread_mutex_unlock(&fft_mutex);
+
+  if (ret == 0 && rename(tmp_path, path) != 0) {
+    perror("rename()");
+    unlink(tmp_path);
+    ret = -1;
+  }
+  return ret;
+}
+
 // This function is called in the beggining of any executable where it is linked
 __attribute__((constructor)) static void srsran_dft_load()
 {
 #ifdef FFTW_WISDOM_FILE
+  // The system wide wisdom is generated once with srsran_fftw_wisdom, so that the planning is fast on a cold start.
+  // The wisdom of the user file, if any, is merged on top of it
+  srsran_dft_import_wisdom(srsran_dft_system_wisdom_file());
+
   char full_path[256];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
   // lockf needs a file descriptor open for writing, so this must be r+
@@ -237,6 +281,51 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
   return 0;
 }
 
+int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t*            plan,
+                                 const int                     dft_points,
+                                 srsran_dft_dir_t              dir,
+                                 cf_t*                         in_buffer,
+                                 cf_t*                         out_buffer,
+                                 int                           nof_dims,
+                                 const srsran_dft_batch_dim_t* dims)
+{
+  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+
+  if (nof_dims < 1 || nof_dims > SRSRAN_DFT_MAX_BATCH_DIMS) {
+    ERROR("Invalid number of batch dimensions (%d)", nof_dims);
+    return -1;
+  }
+
+  const fftwf_iodim iodim = {dft_points, 1, 1};
+  fftwf_iodim       howmany_dims[SRSRAN_DFT_MAX_BATCH_DIMS];
+  for (int i = 0; i < nof_dims; i++) {
+    howmany_dims[i].n  = dims[i].n;
+    howmany_dims[i].is = dims[i].idist;
+    howmany_dims[i].os = dims[i].odist;
+  }
+
+  pthread_mutex_lock(&fft_mutex);
+  plan->p = fftwf_plan_guru_dft(1, &iodim, nof_dims, howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  pthread_mutex_unlock(&fft_mutex);
+
+  if (!plan->p) {
+    return -1;
+  }
+
+  plan->size      = dft_points;
+  plan->init_size = plan->size;
+  plan->mode      = SRSRAN_DFT_COMPLEX;
+  plan->dir       = dir;
+  plan->forward   = (dir == SRSRAN_DFT_FORWARD) ? true : false;
+  plan->mirror    = false;
+  plan->db        = false;
+  plan->norm      = false;
+  plan->dc        = false;
+  plan->is_guru   = true;
+
+  return 0;
+}
+
 int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir)
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
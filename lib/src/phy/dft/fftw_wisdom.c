@@ -0,0 +1,255 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Generates the FFTW wisdom of the OFDM modulators and DFT precoders of all the LTE and NR numerologies, and writes it
+ * into the system wide wisdom file. Every process linking srsRAN imports that file on load, so the FFTW_MEASURE plans
+ * are created instantly instead of being measured on every cold start.
+ *
+ * The plans are created with the same buffer layouts used by the PHY objects, since FFTW wisdom only applies to
+ * problems with the same size, strides and alignment.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#define MAX_NOF_SIZES 64
+
+static const char* output_file   = NULL;
+static uint32_t    max_nof_ports = SRSRAN_MAX_PORTS;
+static bool        skip_nr       = false;
+
+static const uint32_t lte_nof_prb[] = {6, 15, 25, 50, 75, 100};
+
+// Rx DFT window offsets used by the eNB/gNB (0.5) and the LTE UE (0.0) receivers
+static const float rx_window_offsets[] = {0.0f, 0.5f};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ophN]\n", prog);
+  printf("\t-o output wisdom file [Default %s]\n", srsran_dft_system_wisdom_file());
+  printf("\t-p maximum number of ports of the batched plans [Default %d]\n", max_nof_ports);
+  printf("\t-N skip NR numerologies [Default %s]\n", skip_nr ? "yes" : "no");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ophN")) != -1) {
+    switch (opt) {
+      case 'o':
+        output_file = argv[optind];
+        break;
+      case 'p':
+        max_nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'N':
+        skip_nr = true;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void add_size(uint32_t* sizes, uint32_t* nof_sizes, uint32_t symbol_sz)
+{
+  for (uint32_t i = 0; i < *nof_sizes; i++) {
+    if (sizes[i] == symbol_sz) {
+      return;
+    }
+  }
+  if (*nof_sizes < MAX_NOF_SIZES) {
+    sizes[(*nof_sizes)++] = symbol_sz;
+  }
+}
+
+// Largest number of PRB that fits in a symbol size
+static uint32_t symbol_sz_max_prb(uint32_t symbol_sz)
+{
+  return SRSRAN_MIN(symbol_sz / SRSRAN_NRE, SRSRAN_MAX_PRB_NR);
+}
+
+/*
+ * Plans the OFDM modulator and demodulator of a symbol size. The buffers are laid out like in the eNB DL: the resource
+ * grids of all the ports are contiguous and the time domain buffers are two subframes long.
+ */
+static int plan_ofdm(uint32_t symbol_sz, uint32_t nof_prb, srsran_cp_t cp, bool keep_dc)
+{
+  uint32_t sf_len    = (uint32_t)SRSRAN_SF_LEN(symbol_sz);
+  uint32_t sf_len_re = (uint32_t)SRSRAN_SF_LEN_RE(nof_prb, SRSRAN_CP_NORM);
+  cf_t*    td_buffer = srsran_vec_cf_malloc(2 * sf_len * SRSRAN_MAX_PORTS);
+  cf_t*    fd_buffer = srsran_vec_cf_malloc(sf_len_re * SRSRAN_MAX_PORTS);
+  int      ret       = SRSRAN_ERROR;
+
+  if (td_buffer == NULL || fd_buffer == NULL) {
+    goto clean_exit;
+  }
+
+  // Receivers
+  for (uint32_t i = 0; i < sizeof(rx_window_offsets) / sizeof(float); i++) {
+    srsran_ofdm_t     ofdm = {};
+    srsran_ofdm_cfg_t cfg  = {};
+    cfg.nof_prb            = nof_prb;
+    cfg.symbol_sz          = symbol_sz;
+    cfg.cp                 = cp;
+    cfg.keep_dc            = keep_dc;
+    cfg.rx_window_offset   = rx_window_offsets[i];
+    cfg.in_buffer          = td_buffer;
+    cfg.out_buffer         = fd_buffer;
+    if (srsran_ofdm_rx_init_cfg(&ofdm, &cfg)) {
+      goto clean_exit;
+    }
+    srsran_ofdm_rx_free(&ofdm);
+  }
+
+  // Transmitters, with all the possible batched ports
+  for (uint32_t nof_ports = 1; nof_ports <= max_nof_ports; nof_ports++) {
+    srsran_ofdm_t     ofdm = {};
+    srsran_ofdm_cfg_t cfg  = {};
+    cfg.nof_prb            = nof_prb;
+    cfg.symbol_sz          = symbol_sz;
+    cfg.cp                 = cp;
+    cfg.keep_dc            = keep_dc;
+    cfg.in_buffer          = fd_buffer;
+    cfg.out_buffer         = td_buffer;
+    cfg.nof_ports          = nof_ports;
+    cfg.in_port_stride     = sf_len_re;
+    cfg.out_port_stride    = 2 * sf_len;
+    if (srsran_ofdm_tx_init_cfg(&ofdm, &cfg)) {
+      goto clean_exit;
+    }
+    srsran_ofdm_tx_free(&ofdm);
+  }
+
+  // MBSFN subframes are always extended CP
+  if (SRSRAN_CP_ISEXT(cp) && !keep_dc) {
+    srsran_ofdm_t     ofdm = {};
+    srsran_ofdm_cfg_t cfg  = {};
+    cfg.nof_prb            = nof_prb;
+    cfg.symbol_sz          = symbol_sz;
+    cfg.cp                 = cp;
+    cfg.sf_type            = SRSRAN_SF_MBSFN;
+    cfg.in_buffer          = fd_buffer;
+    cfg.out_buffer         = td_buffer;
+    if (srsran_ofdm_tx_init_cfg(&ofdm, &cfg)) {
+      goto clean_exit;
+    }
+    srsran_ofdm_tx_free(&ofdm);
+
+    cfg.in_buffer  = td_buffer;
+    cfg.out_buffer = fd_buffer;
+    if (srsran_ofdm_rx_init_cfg(&ofdm, &cfg)) {
+      goto clean_exit;
+    }
+    srsran_ofdm_rx_free(&ofdm);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (td_buffer) {
+    free(td_buffer);
+  }
+  if (fd_buffer) {
+    free(fd_buffer);
+  }
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval t[3];
+  uint32_t       nr_sizes[MAX_NOF_SIZES];
+  uint32_t       nof_nr_sizes = 0;
+
+  parse_args(argc, argv);
+  if (output_file == NULL) {
+    output_file = srsran_dft_system_wisdom_file();
+  }
+  max_nof_ports = SRSRAN_MAX(1, SRSRAN_MIN(max_nof_ports, SRSRAN_MAX_PORTS));
+
+  // NR symbol sizes of every carrier bandwidth
+  if (!skip_nr) {
+    for (uint32_t nof_prb = 1; nof_prb <= SRSRAN_MAX_PRB_NR; nof_prb++) {
+      add_size(nr_sizes, &nof_nr_sizes, srsran_min_symbol_sz_rb(nof_prb));
+    }
+  }
+
+  gettimeofday(&t[1], NULL);
+
+  // LTE bandwidths, both with the standard and the reduced sampling rates
+  for (uint32_t std_rates = 0; std_rates < 2; std_rates++) {
+    srsran_use_standard_symbol_size(std_rates != 0);
+    for (uint32_t i = 0; i < sizeof(lte_nof_prb) / sizeof(uint32_t); i++) {
+      uint32_t symbol_sz = (uint32_t)srsran_symbol_sz(lte_nof_prb[i]);
+      printf("Planning LTE %d PRB, symbol size %d...\n", lte_nof_prb[i], symbol_sz);
+      if (plan_ofdm(symbol_sz, lte_nof_prb[i], SRSRAN_CP_NORM, false) ||
+          plan_ofdm(symbol_sz, lte_nof_prb[i], SRSRAN_CP_EXT, false)) {
+        ERROR("Error planning LTE symbol size %d", symbol_sz);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  srsran_use_standard_symbol_size(false);
+
+  for (uint32_t i = 0; i < nof_nr_sizes; i++) {
+    printf("Planning NR symbol size %d...\n", nr_sizes[i]);
+    if (plan_ofdm(nr_sizes[i], symbol_sz_max_prb(nr_sizes[i]), SRSRAN_CP_NORM, true)) {
+      ERROR("Error planning NR symbol size %d", nr_sizes[i]);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // PUSCH/PUCCH transform precoding of every valid allocation
+  srsran_dft_precoding_t precoding = {};
+  if (srsran_dft_precoding_init(&precoding, SRSRAN_MAX_PRB, true)) {
+    ERROR("Error planning DFT precoding");
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_precoding_free(&precoding);
+  if (srsran_dft_precoding_init(&precoding, SRSRAN_MAX_PRB, false)) {
+    ERROR("Error planning DFT precoding");
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_precoding_free(&precoding);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  if (srsran_dft_export_wisdom(output_file)) {
+    ERROR("Error writing wisdom to %s", output_file);
+    return SRSRAN_ERROR;
+  }
+
+  printf("Planned %d LTE bandwidths and %d NR symbol sizes in %.1f s, wisdom written to %s\n",
+         (uint32_t)(2 * sizeof(lte_nof_prb) / sizeof(uint32_t)),
+         nof_nr_sizes,
+         (double)t[0].tv_sec + (double)t[0].tv_usec * 1e-6,
+         output_file);
+
+  return SRSRAN_SUCCESS;
+}
@@ -35,6 +35,24 @@
 /* Uncomment next line for avoiding Guru DFT call */
 //#define AVOID_GURU
 
+/* Initialises the Tx CFR objects from cfr_tx_cfg. The batched path keeps one CFR object per port, as the automatic
+ * threshold modes track the average power of the signal they process.
+ */
+static int ofdm_cfr_init(srsran_ofdm_t* q)
+{
+  if (!q->cfg.cfr_tx_cfg.cfr_enable) {
+    return SRSRAN_SUCCESS;
+  }
+  for (uint32_t p = 0; p < q->cfg.nof_ports; p++) {
+    srsran_cfr_t* cfr = (p == 0) ? &q->tx_cfr : &q->tx_cfr_port[p - 1];
+    if (srsran_cfr_init(cfr, &q->cfg.cfr_tx_cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error while initialising CFR module");
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft_dir_t dir)
 {
   // If the symbol size is not given, calculate in function of the number of resource blocks
@@ -63,11 +81,31 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
 
     // Phase compensation is set when it is calculated
     q->cfg.phase_compensation_hz = 0.0;
+
+    // Default port strides are the maximum subframe length, in time domain or in frequency domain
+    uint32_t sf_len    = (uint32_t)SRSRAN_SF_LEN(cfg->symbol_sz);
+    uint32_t sf_len_re = (uint32_t)SRSRAN_SF_LEN_RE(cfg->nof_prb, cfg->cp);
+    q->cfg.nof_ports   = SRSRAN_MAX(1, q->cfg.nof_ports);
+    if (q->cfg.in_port_stride == 0) {
+      q->cfg.in_port_stride = (dir == SRSRAN_DFT_FORWARD) ? sf_len : sf_len_re;
+    }
+    if (q->cfg.out_port_stride == 0) {
+      q->cfg.out_port_stride = (dir == SRSRAN_DFT_FORWARD) ? sf_len_re : sf_len;
+    }
+    if (q->cfg.nof_ports > 1 && q->cfg.sf_type == SRSRAN_SF_MBSFN) {
+      ERROR("Batched ports are not supported in MBSFN subframes");
+      return SRSRAN_ERROR;
+    }
+    if (q->cfg.nof_ports > SRSRAN_MAX_PORTS) {
+      ERROR("Invalid number of batched ports %d", q->cfg.nof_ports);
+      return SRSRAN_ERROR;
+    }
   }
 
   uint32_t    symbol_sz = q->cfg.symbol_sz;
   srsran_cp_t cp        = q->cfg.cp;
   srsran_sf_t sf_type   = q->cfg.sf_type;
+  uint32_t    nof_ports = q->cfg.nof_ports;
 
   // Set OFDM object attributes
   q->nof_symbols       = SRSRAN_CP_NSYMB(cp);
@@ -83,11 +121,8 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
 
   // in the DL, the DC carrier is empty but still counts when designing the filter BW
   q->cfg.cfr_tx_cfg.dc_sc = (!q->cfg.keep_dc) && (!isnormal(q->cfg.freq_shift_f));
-  if (q->cfg.cfr_tx_cfg.cfr_enable) {
-    if (srsran_cfr_init(&q->tx_cfr, &q->cfg.cfr_tx_cfg) < SRSRAN_SUCCESS) {
-      ERROR("Error while initialising CFR module");
-      return SRSRAN_ERROR;
-    }
+  if (ofdm_cfr_init(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
   }
 
   // Plan MBSFN
@@ -116,7 +151,7 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
 #ifdef AVOID_GURU
     q->tmp = srsran_vec_cf_malloc(symbol_sz);
 #else
-    q->tmp = srsran_vec_cf_malloc(q->sf_sz);
+    q->tmp = srsran_vec_cf_malloc(q->sf_sz * nof_ports);
 #endif /* AVOID_GURU */
     if (!q->tmp) {
       perror("malloc");
@@ -140,6 +175,10 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
 
 #ifdef AVOID_GURU
   srsran_vec_cf_zero(q->tmp, symbol_sz);
+  if (nof_ports > 1) {
+    ERROR("Batched ports require Guru DFT");
+    return SRSRAN_ERROR;
+  }
 #else
   uint32_t nof_prb = q->cfg.nof_prb;
   cf_t* in_buffer = q->cfg.in_buffer;
@@ -158,13 +197,13 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
     }
   }
 
-  // Zero temporal and input buffers always
-  srsran_vec_cf_zero(q->tmp, q->sf_sz);
-
-  if (dir == SRSRAN_DFT_BACKWARD) {
-    srsran_vec_cf_zero(in_buffer, SRSRAN_SF_LEN_RE(nof_prb, cp));
-  } else {
-    srsran_vec_cf_zero(in_buffer, q->sf_sz);
+  // Zero input buffers always
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    if (dir == SRSRAN_DFT_BACKWARD) {
+      srsran_vec_cf_zero(in_buffer + p * q->cfg.in_port_stride, SRSRAN_SF_LEN_RE(nof_prb, cp));
+    } else {
+      srsran_vec_cf_zero(in_buffer + p * q->cfg.in_port_stride, q->sf_sz);
+    }
   }
 
   for (int slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
@@ -204,6 +243,36 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
       }
     }
   }
+
+  // Batched plan over the symbols, slots and ports of a normal subframe
+  if (q->fft_plan_batch.size) {
+    srsran_dft_plan_free(&q->fft_plan_batch);
+  }
+  if (nof_ports > 1) {
+    int                    nof_symbols = SRSRAN_CP_NSYMB(cp);
+    int                    tmp_sz      = nof_symbols * SRSRAN_NOF_SLOTS_PER_SF * symbol_sz;
+    srsran_dft_batch_dim_t dims[3];
+    int                    ret;
+    if (dir == SRSRAN_DFT_FORWARD) {
+      dims[0] = (srsran_dft_batch_dim_t){nof_symbols, symbol_sz + cp2, symbol_sz};
+      dims[1] = (srsran_dft_batch_dim_t){SRSRAN_NOF_SLOTS_PER_SF, q->slot_sz, nof_symbols * symbol_sz};
+      dims[2] = (srsran_dft_batch_dim_t){nof_ports, q->cfg.in_port_stride, tmp_sz};
+      ret     = srsran_dft_plan_guru_batch_c(
+          &q->fft_plan_batch, symbol_sz, dir, in_buffer + cp1 - q->window_offset_n, q->tmp, 3, dims);
+    } else {
+      dims[0] = (srsran_dft_batch_dim_t){nof_symbols, symbol_sz, symbol_sz + cp2};
+      dims[1] = (srsran_dft_batch_dim_t){SRSRAN_NOF_SLOTS_PER_SF, nof_symbols * symbol_sz, q->slot_sz};
+      dims[2] = (srsran_dft_batch_dim_t){nof_ports, tmp_sz, q->cfg.out_port_stride};
+      ret     = srsran_dft_plan_guru_batch_c(&q->fft_plan_batch, symbol_sz, dir, q->tmp, out_buffer + cp1, 3, dims);
+    }
+    if (ret) {
+      ERROR("Creating batched Guru DFT plan (%d ports)", nof_ports);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Zero temporal buffer after planning, as planning may overwrite the plan buffers
+  srsran_vec_cf_zero(q->tmp, q->sf_sz * nof_ports);
 #endif
 
   srsran_dft_plan_set_mirror(&q->fft_plan, true);
@@ -253,6 +322,9 @@ void srsran_ofdm_free_(srsran_ofdm_t* q)
       srsran_dft_plan_free(&q->fft_plan_sf[slot]);
     }
   }
+  if (q->fft_plan_batch.init_size) {
+    srsran_dft_plan_free(&q->fft_plan_batch);
+  }
 #endif
 
   if (q->tmp) {
@@ -265,6 +337,9 @@ void srsran_ofdm_free_(srsran_ofdm_t* q)
     free(q->window_offset_buffer);
   }
   srsran_cfr_free(&q->tx_cfr);
+  for (uint32_t p = 0; p < SRSRAN_MAX_PORTS - 1; p++) {
+    srsran_cfr_free(&q->tx_cfr_port[p]);
+  }
   SRSRAN_MEM_ZERO(q, srsran_ofdm_t, 1);
 }
 
@@ -468,6 +543,42 @@ void srsran_ofdm_rx_slot_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Post-processes the FFT output of a single OFDM symbol: applies the DFT window offset, the FFT shift, the phase
+ * compensation and the normalization. The FFT output buffer is modified in place.
+ */
+static void ofdm_rx_symbol(srsran_ofdm_t* q, cf_t* fft_out, uint32_t symbol_in_sf, cf_t* output)
+{
+  uint32_t nof_re    = q->nof_re;
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  float    norm      = 1.0f / sqrtf(q->fft_plan.size);
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+
+  // Apply frequency domain window offset
+  if (q->window_offset_n) {
+    srsran_vec_prod_ccc(fft_out, q->window_offset_buffer, fft_out, symbol_sz);
+  }
+
+  // Perform FFT shift
+  memcpy(output, fft_out + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
+  memcpy(output + nof_re / 2, &fft_out[dc], sizeof(cf_t) * nof_re / 2);
+
+  // Normalize output
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    // Get phase compensation
+    cf_t phase_compensation = conjf(q->phase_compensation[symbol_in_sf]);
+
+    // Apply normalization
+    if (q->fft_plan.norm) {
+      phase_compensation *= norm;
+    }
+
+    // Apply correction
+    srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
+  } else if (q->fft_plan.norm) {
+    srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
+  }
+}
+
 /* Transforms input samples into output OFDM symbols.
  * Performs FFT on a each symbol and removes CP.
  */
@@ -478,40 +589,15 @@ static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
       q, q->cfg.in_buffer + slot_in_sf * q->slot_sz, q->cfg.out_buffer + slot_in_sf * q->nof_re * q->nof_symbols);
 #else
   uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  cf_t* output = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
-  uint32_t symbol_sz = q->cfg.symbol_sz;
-  float norm = 1.0f / sqrtf(q->fft_plan.size);
-  cf_t* tmp = q->tmp;
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
+  uint32_t nof_re      = q->nof_re;
+  cf_t*    output      = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
+  uint32_t symbol_sz   = q->cfg.symbol_sz;
+  cf_t*    tmp         = q->tmp;
 
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
   for (int i = 0; i < q->nof_symbols; i++) {
-    // Apply frequency domain window offset
-    if (q->window_offset_n) {
-      srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
-    }
-
-    // Perform FFT shift
-    memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
-    memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
-
-    // Normalize output
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
-
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
-
-      // Apply correction
-      srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
-    }
+    ofdm_rx_symbol(q, tmp, slot_in_sf * nof_symbols + i, output);
 
     tmp += symbol_sz;
     output += nof_re;
@@ -548,12 +634,37 @@ void srsran_ofdm_rx_slot_zerocopy(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Transforms the input samples of all the ports into output OFDM symbols with a single batched DFT execution.
+ */
+static void ofdm_rx_sf_batch(srsran_ofdm_t* q)
+{
+  uint32_t nof_symbols_sf = q->nof_symbols * SRSRAN_NOF_SLOTS_PER_SF;
+  cf_t*    tmp            = q->tmp;
+
+  srsran_dft_run_guru_c(&q->fft_plan_batch);
+
+  for (uint32_t p = 0; p < q->cfg.nof_ports; p++) {
+    cf_t* output = q->cfg.out_buffer + p * q->cfg.out_port_stride;
+    for (uint32_t i = 0; i < nof_symbols_sf; i++) {
+      ofdm_rx_symbol(q, tmp, i, output);
+
+      tmp += q->cfg.symbol_sz;
+      output += q->nof_re;
+    }
+  }
+}
+
 void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
 {
   if (isnormal(q->cfg.freq_shift_f)) {
-    srsran_vec_prod_ccc(q->cfg.in_buffer, q->shift_buffer, q->cfg.in_buffer, q->sf_sz);
+    for (uint32_t p = 0; p < q->cfg.nof_ports; p++) {
+      cf_t* in_buffer = q->cfg.in_buffer + p * q->cfg.in_port_stride;
+      srsran_vec_prod_ccc(in_buffer, q->shift_buffer, in_buffer, q->sf_sz);
+    }
   }
-  if (!q->mbsfn_subframe) {
+  if (q->fft_plan_batch.size) {
+    ofdm_rx_sf_batch(q);
+  } else if (!q->mbsfn_subframe) {
     for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_rx_slot(q, n);
     }
@@ -579,18 +690,67 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Maps the subcarriers of an OFDM symbol into the iFFT input, the guard and DC subcarriers are left untouched.
+ */
+static void ofdm_tx_symbol_map(srsran_ofdm_t* q, const cf_t* input, cf_t* tmp)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+
+  srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+  srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+}
+
+/* Post-processes the iFFT output of a single OFDM symbol, placed after its CP: applies the phase compensation, the
+ * normalization and the CFR, then adds the CP. Returns the symbol length including the CP.
+ */
+static uint32_t ofdm_tx_symbol_post(srsran_ofdm_t* q, srsran_cfr_t* cfr, cf_t* output, uint32_t symbol_in_sf)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  float       norm      = 1.0f / sqrtf(symbol_sz);
+  uint32_t    i         = symbol_in_sf % q->nof_symbols;
+  uint32_t    cp_len    = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    // Get phase compensation
+    cf_t phase_compensation = q->phase_compensation[symbol_in_sf];
+
+    // Apply normalization
+    if (q->fft_plan.norm) {
+      phase_compensation *= norm;
+    }
+
+    // Apply correction
+    srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
+  } else if (q->fft_plan.norm) {
+    srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
+  }
+
+  // CFR: Process the time-domain signal without the CP
+  if (q->cfg.cfr_tx_cfg.cfr_enable) {
+    srsran_cfr_process(cfr, output + cp_len, output + cp_len);
+  }
+
+  /* add CP */
+  srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+
+  return symbol_sz + cp_len;
+}
+
 /* Transforms input OFDM symbols into output samples.
  * Performs the FFT on each symbol and adds CP.
  */
 static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
 {
-  uint32_t    symbol_sz = q->cfg.symbol_sz;
-  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t symbol_sz = q->cfg.symbol_sz;
 
   cf_t* input  = q->cfg.in_buffer + slot_in_sf * q->nof_re * q->nof_symbols;
   cf_t* output = q->cfg.out_buffer + slot_in_sf * q->slot_sz;
 
 #ifdef AVOID_GURU
+  srsran_cp_t cp = q->cfg.cp;
   for (int i = 0; i < q->nof_symbols; i++) {
     int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
     memcpy(&q->tmp[q->nof_guards], input, q->nof_re * sizeof(cf_t));
@@ -602,51 +762,51 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
   }
 #else
   uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  float norm = 1.0f / sqrtf(symbol_sz);
-  cf_t* tmp = q->tmp;
+  cf_t*    tmp         = q->tmp;
 
   bzero(tmp, q->slot_sz);
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
 
   for (int i = 0; i < nof_symbols; i++) {
-    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
-    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+    ofdm_tx_symbol_map(q, input, tmp);
 
-    input += nof_re;
+    input += q->nof_re;
     tmp += symbol_sz;
   }
 
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
   for (int i = 0; i < nof_symbols; i++) {
-    int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+    output += ofdm_tx_symbol_post(q, &q->tx_cfr, output, slot_in_sf * nof_symbols + i);
+  }
+#endif
+}
 
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
+/* Transforms the input OFDM symbols of all the ports into output samples with a single batched DFT execution.
+ */
+static void ofdm_tx_sf_batch(srsran_ofdm_t* q)
+{
+  uint32_t nof_symbols_sf = q->nof_symbols * SRSRAN_NOF_SLOTS_PER_SF;
+  cf_t*    tmp            = q->tmp;
 
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
+  for (uint32_t p = 0; p < q->cfg.nof_ports; p++) {
+    cf_t* input = q->cfg.in_buffer + p * q->cfg.in_port_stride;
+    for (uint32_t i = 0; i < nof_symbols_sf; i++) {
+      ofdm_tx_symbol_map(q, input, tmp);
 
-      // Apply correction
-      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
+      input += q->nof_re;
+      tmp += q->cfg.symbol_sz;
     }
+  }
 
-    // CFR: Process the time-domain signal without the CP
-    if (q->cfg.cfr_tx_cfg.cfr_enable) {
-      srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
-    }
+  srsran_dft_run_guru_c(&q->fft_plan_batch);
 
-    /* add CP */
-    srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
-    output += symbol_sz + cp_len;
+  for (uint32_t p = 0; p < q->cfg.nof_ports; p++) {
+    cf_t*         output = q->cfg.out_buffer + p * q->cfg.out_port_stride;
+    srsran_cfr_t* cfr    = (p == 0) ? &q->tx_cfr : &q->tx_cfr_port[p - 1];
+    for (uint32_t i = 0; i < nof_symbols_sf; i++) {
+      output += ofdm_tx_symbol_post(q, cfr, output, i);
+    }
   }
-#endif
 }
 
 void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
@@ -676,7 +836,9 @@ void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable)
 void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
 {
   uint32_t n;
-  if (!q->mbsfn_subframe) {
+  if (q->fft_plan_batch.size) {
+    ofdm_tx_sf_batch(q);
+  } else if (!q->mbsfn_subframe) {
     for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_tx_slot(q, n);
     }
@@ -685,7 +847,10 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
     ofdm_tx_slot(q, 1);
   }
   if (isnormal(q->cfg.freq_shift_f)) {
-    srsran_vec_prod_ccc(q->cfg.out_buffer, q->shift_buffer, q->cfg.out_buffer, q->sf_sz);
+    for (uint32_t p = 0; p < q->cfg.nof_ports; p++) {
+      cf_t* out_buffer = q->cfg.out_buffer + p * q->cfg.out_port_stride;
+      srsran_vec_prod_ccc(out_buffer, q->shift_buffer, out_buffer, q->sf_sz);
+    }
   }
 }
 
@@ -714,11 +879,8 @@ int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
   // in the LTE DL, the DC carrier is empty but still counts when designing the filter BW
   // in the LTE UL, the DC carrier is used
   q->cfg.cfr_tx_cfg.dc_sc = (!q->cfg.keep_dc) && (!isnormal(q->cfg.freq_shift_f));
-  if (q->cfg.cfr_tx_cfg.cfr_enable) {
-    if (srsran_cfr_init(&q->tx_cfr, &q->cfg.cfr_tx_cfg) < SRSRAN_SUCCESS) {
-      ERROR("Error while initialising CFR module");
-      return SRSRAN_ERROR;
-    }
+  if (ofdm_cfr_init(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
   }
 
   return SRSRAN_SUCCESS;
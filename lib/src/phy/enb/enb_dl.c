@@ -34,6 +34,27 @@ static float enb_dl_get_norm_factor(uint32_t nof_prb)
   return 0.05f / sqrtf(nof_prb);
 }
 
+// Returns the distance in samples between the output buffers of consecutive ports if they are evenly spaced, 0 otherwise
+static uint32_t enb_dl_out_port_stride(srsran_enb_dl_t* q)
+{
+  if (q->cell.nof_ports < 2) {
+    return 0;
+  }
+
+  uintptr_t stride = (uintptr_t)q->out_buffer[1] - (uintptr_t)q->out_buffer[0];
+  if ((uintptr_t)q->out_buffer[1] <= (uintptr_t)q->out_buffer[0] || stride % sizeof(cf_t) != 0 ||
+      stride / sizeof(cf_t) < SRSRAN_SF_LEN_PRB(q->cell.nof_prb)) {
+    return 0;
+  }
+  for (uint32_t i = 2; i < q->cell.nof_ports; i++) {
+    if ((uintptr_t)q->out_buffer[i] - (uintptr_t)q->out_buffer[i - 1] != stride) {
+      return 0;
+    }
+  }
+
+  return (uint32_t)(stride / sizeof(cf_t));
+}
+
 int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], uint32_t max_prb)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -43,12 +64,14 @@ int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], u
 
     bzero(q, sizeof(srsran_enb_dl_t));
 
-    for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
-      q->sf_symbols[i] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
-      if (!q->sf_symbols[i]) {
-        perror("malloc");
-        goto clean_exit;
-      }
+    // The resource grids of all the ports are contiguous, so they can be transformed with a single batched plan
+    q->sf_symbols[0] = srsran_vec_cf_malloc(SRSRAN_MAX_PORTS * SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
+    if (!q->sf_symbols[0]) {
+      perror("malloc");
+      goto clean_exit;
+    }
+    for (int i = 1; i < SRSRAN_MAX_PORTS; i++) {
+      q->sf_symbols[i] = q->sf_symbols[0] + i * SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM);
     }
     for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
       q->out_buffer[i] = out_buffer[i];
@@ -133,10 +156,8 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
     srsran_pmch_free(&q->pmch);
     srsran_refsignal_free(&q->csr_signal);
     srsran_refsignal_free(&q->mbsfnr_signal);
-    for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
-      if (q->sf_symbols[i]) {
-        free(q->sf_symbols[i]);
-      }
+    if (q->sf_symbols[0]) {
+      free(q->sf_symbols[0]);
     }
     bzero(q, sizeof(srsran_enb_dl_t));
   }
@@ -156,11 +177,17 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
       ofdm_cfg.nof_prb           = q->cell.nof_prb;
       ofdm_cfg.cp                = cell.cp;
       ofdm_cfg.normalize         = false;
+      uint32_t out_port_stride   = enb_dl_out_port_stride(q);
       for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
         ofdm_cfg.in_buffer  = q->sf_symbols[i];
         ofdm_cfg.out_buffer = q->out_buffer[i];
         ofdm_cfg.sf_type    = SRSRAN_SF_NORM;
         ofdm_cfg.cfr_tx_cfg = q->cfr_config;
+
+        // If the output buffers are evenly spaced, the first iFFT object transforms all the ports at once
+        ofdm_cfg.nof_ports       = (i == 0 && out_port_stride) ? q->cell.nof_ports : 1;
+        ofdm_cfg.in_port_stride  = (uint32_t)(q->sf_symbols[1] - q->sf_symbols[0]);
+        ofdm_cfg.out_port_stride = out_port_stride;
         if (srsran_ofdm_tx_init_cfg(&q->ifft[i], &ofdm_cfg)) {
           ERROR("Error initiating FFT (%d)", i);
           return SRSRAN_ERROR;
@@ -460,7 +487,13 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                              norm_factor,
                              q->ifft[i].cfg.in_buffer,
                              SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
-      srsran_ofdm_tx_sf(&q->ifft[i]);
+    }
+    if (q->ifft[0].cfg.nof_ports > 1) {
+      srsran_ofdm_tx_sf(&q->ifft[0]);
+    } else {
+      for (int i = 0; i < q->cell.nof_ports; i++) {
+        srsran_ofdm_tx_sf(&q->ifft[i]);
+      }
     }
   }
 }
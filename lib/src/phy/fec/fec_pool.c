@@ -0,0 +1,275 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/fec/fec_pool.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct fec_pool_impl_s fec_pool_impl_t;
+
+typedef struct {
+  pthread_t        pthread;
+  uint32_t         worker_idx;
+  sem_t            start;
+  bool             started;
+  fec_pool_impl_t* pool;
+} fec_pool_thread_t;
+
+struct fec_pool_impl_s {
+  uint32_t           nof_threads;
+  fec_pool_thread_t* threads;
+
+  /* Current job: it must be set before posting the start semaphores */
+  srsran_fec_pool_task_t task;
+  void*                  arg;
+  uint32_t               nof_tasks;
+
+  /* Next task to process, protected by mutex */
+  pthread_mutex_t mutex;
+  uint32_t        next_task;
+
+  sem_t finish;
+  bool  quit;
+};
+
+static bool fec_pool_next_task(fec_pool_impl_t* h, uint32_t* task_idx)
+{
+  bool ret = false;
+
+  pthread_mutex_lock(&h->mutex);
+  if (h->next_task < h->nof_tasks) {
+    *task_idx = h->next_task++;
+    ret       = true;
+  }
+  pthread_mutex_unlock(&h->mutex);
+
+  return ret;
+}
+
+static void fec_pool_work(fec_pool_impl_t* h, uint32_t worker_idx)
+{
+  uint32_t task_idx = 0;
+  while (fec_pool_next_task(h, &task_idx)) {
+    h->task(h->arg, worker_idx, task_idx);
+  }
+}
+
+static void* fec_pool_thread(void* arg)
+{
+  fec_pool_thread_t* t = (fec_pool_thread_t*)arg;
+  fec_pool_impl_t*   h = t->pool;
+
+  sem_wait(&t->start);
+  while (!h->quit) {
+    fec_pool_work(h, t->worker_idx);
+
+    /* Post finish semaphore */
+    sem_post(&h->finish);
+
+    /* Wait for next job */
+    sem_wait(&t->start);
+  }
+
+  return NULL;
+}
+
+static int fec_pool_thread_create(fec_pool_thread_t* t, int prio)
+{
+  pthread_attr_t     attr;
+  struct sched_param param;
+  bool               attr_ok = false;
+
+  if (prio >= 0) {
+    pthread_attr_init(&attr);
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO) - prio;
+    attr_ok              = (pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) == 0) &&
+              (pthread_attr_setschedpolicy(&attr, SCHED_FIFO) == 0) &&
+              (pthread_attr_setschedparam(&attr, &param) == 0);
+  }
+
+  if (attr_ok && pthread_create(&t->pthread, &attr, fec_pool_thread, t) == 0) {
+    pthread_attr_destroy(&attr);
+  } else {
+    if (prio >= 0) {
+      INFO("Error creating FEC thread with real-time priority. Trying without attributes.");
+      pthread_attr_destroy(&attr);
+    }
+    if (pthread_create(&t->pthread, NULL, fec_pool_thread, t)) {
+      ERROR("Error creating FEC thread");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Rename thread
+  char thread_name[16] = {};
+  if (snprintf(thread_name, sizeof(thread_name), "FEC%d", t->worker_idx) > 0) {
+    pthread_setname_np(t->pthread, thread_name);
+  }
+
+  t->started = true;
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_fec_pool_init(srsran_fec_pool_t* q, uint32_t nof_threads, int prio)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_fec_pool_t, 1);
+  q->nof_workers = 1;
+
+  if (nof_threads == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  fec_pool_impl_t* h = SRSRAN_MEM_ALLOC(fec_pool_impl_t, 1);
+  if (h == NULL) {
+    ERROR("Error allocating FEC pool");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(h, fec_pool_impl_t, 1);
+  q->ptr = h;
+
+  if (pthread_mutex_init(&h->mutex, NULL)) {
+    ERROR("Error initialising mutex");
+    free(h);
+    q->ptr = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  if (sem_init(&h->finish, 0, 0)) {
+    ERROR("Creating semaphore");
+    pthread_mutex_destroy(&h->mutex);
+    free(h);
+    q->ptr = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  h->threads = SRSRAN_MEM_ALLOC(fec_pool_thread_t, nof_threads);
+  if (h->threads == NULL) {
+    ERROR("Error allocating FEC threads");
+    srsran_fec_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(h->threads, fec_pool_thread_t, nof_threads);
+
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    fec_pool_thread_t* t = &h->threads[i];
+    t->pool              = h;
+    t->worker_idx        = i + 1;
+
+    if (sem_init(&t->start, 0, 0)) {
+      ERROR("Creating semaphore");
+      srsran_fec_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+    h->nof_threads++;
+
+    if (fec_pool_thread_create(t, prio) < SRSRAN_SUCCESS) {
+      srsran_fec_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  q->nof_workers = nof_threads + 1;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_fec_pool_free(srsran_fec_pool_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  fec_pool_impl_t* h = (fec_pool_impl_t*)q->ptr;
+  if (h != NULL) {
+    /* Stop threads */
+    h->quit = true;
+    for (uint32_t i = 0; i < h->nof_threads; i++) {
+      sem_post(&h->threads[i].start);
+    }
+    for (uint32_t i = 0; i < h->nof_threads; i++) {
+      if (h->threads[i].started) {
+        pthread_join(h->threads[i].pthread, NULL);
+      }
+      sem_destroy(&h->threads[i].start);
+    }
+
+    if (h->threads) {
+      free(h->threads);
+    }
+    sem_destroy(&h->finish);
+    pthread_mutex_destroy(&h->mutex);
+    free(h);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_fec_pool_t, 1);
+}
+
+int srsran_fec_pool_run(srsran_fec_pool_t* q, srsran_fec_pool_task_t task, void* arg, uint32_t nof_tasks)
+{
+  if (q == NULL || task == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  fec_pool_impl_t* h = (fec_pool_impl_t*)q->ptr;
+
+  // Run in the calling thread if there are no threads or a single task
+  if (h == NULL || nof_tasks < 2) {
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      task(arg, 0, i);
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  h->task      = task;
+  h->arg       = arg;
+  h->nof_tasks = nof_tasks;
+  h->next_task = 0;
+
+  // Wake up only as many threads as there are tasks left for them
+  uint32_t nof_wake = SRSRAN_MIN(h->nof_threads, nof_tasks - 1);
+  for (uint32_t i = 0; i < nof_wake; i++) {
+    sem_post(&h->threads[i].start);
+  }
+
+  // The calling thread is worker 0
+  fec_pool_work(h, 0);
+
+  // Join
+  for (uint32_t i = 0; i < nof_wake; i++) {
+    if (sem_wait(&h->finish)) {
+      ERROR("Error waiting for FEC thread");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
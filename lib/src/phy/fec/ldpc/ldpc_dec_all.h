@@ -383,6 +383,87 @@ int update_ldpc_soft_bits_c_avx2(void* p, int i_layer, const int8_t (*these_var_
  */
 int extract_ldpc_message_c_avx2(void* p, uint8_t* message, uint16_t liftK);
 
+/*!
+ * Returns the maximum number of codeblocks the batched 8-bit integer-based LDPC decoder (AVX2 version) processes in
+ * parallel for the given lifting size.
+ * \param[in] ls Lifting size.
+ * \return The number of codeblocks per batch, 0 if the lifting size is too large for the batched decoder.
+ */
+uint32_t ldpc_dec_c_avx2_batch_max_nof_cb(uint16_t ls);
+
+/*!
+ * Creates the registers used by the batched 8-bit-based implementation of the LDPC decoder (LS <= \ref
+ * SRSRAN_AVX2_B_SIZE / 2), which decodes several codeblocks with the same base graph and lifting size at once.
+ * \param[in] bgN          Codeword length.
+ * \param[in] bgM          Number of check nodes.
+ * \param[in] ls           Lifting size.
+ * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \return A pointer to the created registers (an ldpc_regs_c_avx2_batch structure).
+ */
+void* create_ldpc_dec_c_avx2_batch(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+
+/*!
+ * Destroys the inner registers of the batched 8-bit integer-based LDPC decoder.
+ * \param[in] p A pointer to the dismantled decoder registers (an ldpc_regs_c_avx2_batch structure).
+ */
+void delete_ldpc_dec_c_avx2_batch(void* p);
+
+/*!
+ * Initializes the inner registers of the batched 8-bit integer-based LDPC decoder before
+ * carrying out the actual decoding.
+ * \param[in,out] p      A pointer to the decoder registers (an ldpc_regs_c_avx2_batch structure).
+ * \param[in]     llrs   The arrays of LLR values from the channel, one per codeblock.
+ * \param[in]     nof_cb The number of codeblocks in the batch.
+ * \param[in]     ls     The lifting size.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_ldpc_dec_c_avx2_batch(void* p, const int8_t* const* llrs, uint32_t nof_cb, uint16_t ls);
+
+/*!
+ * Updates the messages from variable nodes to check nodes (batched 8-bit version).
+ * \param[in,out] p       A pointer to the decoder registers (an ldpc_regs_c_avx2_batch structure).
+ * \param[in]     i_layer The index of the variable-to-check layer to update.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int update_ldpc_var_to_check_c_avx2_batch(void* p, int i_layer);
+
+/*!
+ * Updates the messages from check nodes to variable nodes (batched 8-bit version).
+ * \param[in,out] p        A pointer to the decoder registers (an ldpc_regs_c_avx2_batch structure).
+ * \param[in]     i_layer  The index of the variable-to-check layer to update.
+ * \param[in]     this_pcm A pointer to the row of the parity check matrix (i.e. base
+ *                         graph) corresponding to the selected layer.
+ * \param[in]     these_var_indices
+ *                         Contains the indices of the variable nodes connected
+ *                         to the current layer.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int update_ldpc_check_to_var_c_avx2_batch(void*           p,
+                                          int             i_layer,
+                                          const uint16_t* this_pcm,
+                                          const int8_t (*these_var_indices)[MAX_CNCT]);
+
+/*!
+ * Updates the current estimate of the (soft) bits of the codewords (batched 8-bit version).
+ * \param[in,out] p        A pointer to the decoder registers (an ldpc_regs_c_avx2_batch structure).
+ * \param[in]     i_layer  The index of the variable-to-check layer to update.
+ * \param[in]     these_var_indices
+ *                         Contains the indices of the variable nodes connected
+ *                         to the current layer.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int update_ldpc_soft_bits_c_avx2_batch(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT]);
+
+/*!
+ * Returns the decoded message (hard bits) of one codeblock of the batch from the current soft bits.
+ * \param[in]  p       A pointer to the decoder registers (an ldpc_regs_c_avx2_batch structure).
+ * \param[in]  cb_idx  The index of the codeblock within the batch.
+ * \param[out] message A pointer to the decoded message.
+ * \param[in]  liftK   The length of the decoded message.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int extract_ldpc_message_c_avx2_batch(void* p, uint32_t cb_idx, uint8_t* message, uint16_t liftK);
+
 /*!
  * Creates the registers used by the optimized 8-bit-based implementation of the LDPC decoder (LS > \ref
  * SRSRAN_AVX2_B_SIZE).
@@ -296,6 +296,112 @@ static int init_c_flood(srsran_ldpc_decoder_t* q)
 }
 
 #ifdef LV_HAVE_AVX2
+/*! Computes the number of layers to process for a rate-matched codeword of the given length. */
+static uint8_t batch_nof_layers(const srsran_ldpc_decoder_t* q, uint32_t cdwd_rm_length)
+{
+  /* it must be smaller than the codeword size */
+  if (cdwd_rm_length > q->liftN - 2 * q->ls) {
+    cdwd_rm_length = q->liftN - 2 * q->ls;
+  }
+  /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However, */
+  /* 2 variable nodes are systematically punctured by the encoder. */
+  if (cdwd_rm_length < (q->bgK + 2) * q->ls) {
+    cdwd_rm_length = (q->bgK + 2) * q->ls;
+  }
+  if (cdwd_rm_length % q->ls) {
+    cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;
+  }
+
+  return cdwd_rm_length / q->ls - q->bgK + 2;
+}
+
+/*! Carries out the decoding of up to q->batch_max_nof_cb codewords with 8-bit integer-valued LLRs (AVX2 batched
+ * implementation). Codewords with fewer layers than the longest one see the missing parity bits as erasures, which
+ * does not alter their decoding. */
+static int decode_batch_c_avx2(srsran_ldpc_decoder_t* q,
+                               const int8_t* const*   llrs,
+                               uint8_t* const*        messages,
+                               const uint32_t*        cdwd_rm_length,
+                               srsran_crc_t* const*   crc,
+                               int*                   ret,
+                               uint32_t               nof_cb)
+{
+  bool     finished[SRSRAN_LDPC_DECODER_MAX_BATCH] = {};
+  uint32_t nof_finished                            = 0;
+  uint8_t  n_layers                                = 0;
+
+  for (uint32_t i_cb = 0; i_cb < nof_cb; i_cb++) {
+    n_layers = SRSRAN_MAX(n_layers, batch_nof_layers(q, cdwd_rm_length[i_cb]));
+  }
+
+  if (init_ldpc_dec_c_avx2_batch(q->batch_ptr, llrs, nof_cb, q->ls) != 0) {
+    return -1;
+  }
+
+  for (int i_iteration = 0; i_iteration < q->max_nof_iter && nof_finished < nof_cb; i_iteration++) {
+    for (int i_layer = 0; i_layer < n_layers; i_layer++) {
+      update_ldpc_var_to_check_c_avx2_batch(q->batch_ptr, i_layer);
+
+      uint16_t* this_pcm                   = q->pcm + i_layer * q->bgN;
+      int8_t(*these_var_indices)[MAX_CNCT] = q->var_indices + i_layer;
+
+      update_ldpc_check_to_var_c_avx2_batch(q->batch_ptr, i_layer, this_pcm, these_var_indices);
+
+      update_ldpc_soft_bits_c_avx2_batch(q->batch_ptr, i_layer, these_var_indices);
+    }
+
+    // Early stop of the codewords whose CRC matches; the remaining ones keep iterating
+    for (uint32_t i_cb = 0; i_cb < nof_cb; i_cb++) {
+      if (finished[i_cb] || crc == NULL || crc[i_cb] == NULL) {
+        continue;
+      }
+      extract_ldpc_message_c_avx2_batch(q->batch_ptr, i_cb, messages[i_cb], q->liftK);
+      if (srsran_crc_match(crc[i_cb], messages[i_cb], q->liftK - crc[i_cb]->order)) {
+        ret[i_cb]      = i_iteration + 1;
+        finished[i_cb] = true;
+        nof_finished++;
+      }
+    }
+  }
+
+  for (uint32_t i_cb = 0; i_cb < nof_cb; i_cb++) {
+    if (finished[i_cb]) {
+      continue;
+    }
+
+    // If reached here, and CRC is being checked, it has failed
+    if (crc != NULL && crc[i_cb] != NULL) {
+      ret[i_cb] = 0;
+      continue;
+    }
+
+    // Without CRC, extract message and return the maximum number of iterations
+    extract_ldpc_message_c_avx2_batch(q->batch_ptr, i_cb, messages[i_cb], q->liftK);
+    ret[i_cb] = q->max_nof_iter;
+  }
+
+  return 0;
+}
+
+/*! Creates the batched decoder registers if the lifting size is small enough to fit several codewords in a register.
+ */
+static int init_c_avx2_batch(srsran_ldpc_decoder_t* q)
+{
+  uint32_t batch_max_nof_cb = ldpc_dec_c_avx2_batch_max_nof_cb(q->ls);
+  if (batch_max_nof_cb < 2) {
+    return 0;
+  }
+
+  if ((q->batch_ptr = create_ldpc_dec_c_avx2_batch(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+    ERROR("Create_ldpc_dec failed");
+    return -1;
+  }
+
+  q->batch_max_nof_cb = SRSRAN_MIN(batch_max_nof_cb, SRSRAN_LDPC_DECODER_MAX_BATCH);
+
+  return 0;
+}
+
 /*! Carries out the actual destruction of the memory allocated to the decoder, 8-bit-LLR case (AVX2 implementation). */
 static void free_dec_c_avx2(void* o)
 {
@@ -325,6 +431,11 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx2;
 
+  if (init_c_avx2_batch(q) != 0) {
+    free_dec_c_avx2(q);
+    return -1;
+  }
+
   return 0;
 }
 
@@ -464,6 +575,12 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx512;
 
+  // Small lifting sizes fill more lanes when several codewords share the AVX2 registers
+  if (init_c_avx2_batch(q) != 0) {
+    free_dec_c_avx512(q);
+    return -1;
+  }
+
   return 0;
 }
 
@@ -576,7 +693,9 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   q->liftM = ls * q->bgM;
   q->liftN = ls * q->bgN;
 
-  q->max_nof_iter = (args->max_nof_iter == 0) ? LDPC_DECODER_DEFAULT_MAX_NOF_ITER : args->max_nof_iter;
+  q->max_nof_iter     = (args->max_nof_iter == 0) ? LDPC_DECODER_DEFAULT_MAX_NOF_ITER : args->max_nof_iter;
+  q->batch_ptr        = NULL;
+  q->batch_max_nof_cb = 1;
 
   q->pcm = srsran_vec_u16_malloc(q->bgM * q->bgN);
   if (!q->pcm) {
@@ -651,6 +770,11 @@ void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q)
   if (q->free) {
     q->free(q);
   }
+#ifdef LV_HAVE_AVX2
+  if (q->batch_ptr) {
+    delete_ldpc_dec_c_avx2_batch(q->batch_ptr);
+  }
+#endif // LV_HAVE_AVX2
   bzero(q, sizeof(srsran_ldpc_decoder_t));
 }
 
@@ -683,3 +807,42 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_decode_batch_c(srsran_ldpc_decoder_t* q,
+                                       const int8_t* const*   llrs,
+                                       uint8_t* const*        messages,
+                                       const uint32_t*        cdwd_rm_length,
+                                       srsran_crc_t* const*   crc,
+                                       int*                   ret,
+                                       uint32_t               nof_cb)
+{
+  if (q == NULL || llrs == NULL || messages == NULL || cdwd_rm_length == NULL || ret == NULL) {
+    return -1;
+  }
+
+  uint32_t i_cb = 0;
+
+#ifdef LV_HAVE_AVX2
+  if (q->batch_ptr != NULL) {
+    // Process full batches, a trailing single codeword is cheaper through the single-codeword path
+    while (nof_cb - i_cb > 1) {
+      uint32_t             nof_batch = SRSRAN_MIN(nof_cb - i_cb, q->batch_max_nof_cb);
+      srsran_crc_t* const* batch_crc = (crc != NULL) ? &crc[i_cb] : NULL;
+      if (decode_batch_c_avx2(
+              q, &llrs[i_cb], &messages[i_cb], &cdwd_rm_length[i_cb], batch_crc, &ret[i_cb], nof_batch) != 0) {
+        return -1;
+      }
+      i_cb += nof_batch;
+    }
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i_cb < nof_cb; i_cb++) {
+    ret[i_cb] = q->decode_c(q, llrs[i_cb], messages[i_cb], cdwd_rm_length[i_cb], (crc != NULL) ? crc[i_cb] : NULL);
+    if (ret[i_cb] < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
@@ -45,6 +45,7 @@ int nof_iterations  = MAX_ITERATIONS;
 int test_known_data = 0;
 int test_errors     = 0;
 int nof_repetitions = 1;
+int test_crc        = 0;
 
 srsran_tdec_impl_type_t tdec_type;
 
@@ -54,7 +55,7 @@ srsran_tdec_impl_type_t tdec_type;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [kcinNledts]\n", prog);
+  printf("Usage: %s [kcinNledtsC]\n", prog);
   printf("\t-k Test with known data (ignores frame_length) [Default disabled]\n");
   printf("\t-c nof_cb in parallel [Default %d]\n", nof_cb);
   printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
@@ -62,7 +63,9 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
+  printf("\t-d Decoder implementation type: 0: Auto, 1: Generic, 2: SSE, 3: SSE-window, 4: NEON-window, 5: AVX-window, "
+         "6: SSE8-window, 7: AVX8-window, 8: AVX512-window, 9: AVX512_8-window\n");
+  printf("\t-C Attach a CRC to the data and stop iterating when it checks [Default disabled]\n");
   printf("\t-t test: check errors on exit [Default disabled]\n");
   printf("\t-s seed [Default 0=time]\n");
 }
@@ -70,7 +73,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "kcinNledts")) != -1) {
+  while ((opt = getopt(argc, argv, "kcinNledtsC")) != -1) {
     switch (opt) {
       case 'c':
         nof_cb = (int)strtol(argv[optind], NULL, 10);
@@ -87,6 +90,9 @@ void parse_args(int argc, char** argv)
       case 't':
         test_errors = 1;
         break;
+      case 'C':
+        test_crc = 1;
+        break;
       case 'i':
         nof_iterations = (int)strtol(argv[optind], NULL, 10);
         break;
@@ -126,8 +132,10 @@ int main(int argc, char** argv)
   uint32_t        coded_length;
   struct timeval  tdata[3];
   float           mean_usec;
+  uint32_t        nof_decoded_iter = 0;
   srsran_tdec_t   tdec;
   srsran_tcod_t   tcod;
+  srsran_crc_t    crc;
 
   parse_args(argc, argv);
 
@@ -191,6 +199,11 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  if (srsran_crc_init(&crc, SRSRAN_LTE_CRC24B, 24)) {
+    ERROR("Error initiating CRC");
+    exit(-1);
+  }
+
   if (srsran_tcod_init(&tcod, frame_length)) {
     ERROR("Error initiating Turbo coder");
     exit(-1);
@@ -235,6 +248,9 @@ int main(int argc, char** argv)
           data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
         }
       }
+      if (test_crc && !test_known_data) {
+        srsran_crc_attach(&crc, data_tx, frame_length - 24);
+      }
 
       /* coded BER */
       if (test_known_data) {
@@ -254,6 +270,15 @@ int main(int argc, char** argv)
         llr_s[j] = (int16_t)(100 * llr[j]);
       }
 
+      // 8-bit decoders take a quantized input
+      bool is_8bit = tdec_type == SRSRAN_TDEC_SSE8_WINDOW || tdec_type == SRSRAN_TDEC_AVX8_WINDOW ||
+                     tdec_type == SRSRAN_TDEC_AVX512_8_WINDOW;
+      if (is_8bit) {
+        for (uint32_t j = 0; j < coded_length; j++) {
+          llr_c[j] = (uint8_t)((int8_t)SRSRAN_MAX(-127, SRSRAN_MIN(127, 10 * llr[j])));
+        }
+      }
+
       /* decoder */
       srsran_tdec_new_cb(&tdec, frame_length);
 
@@ -266,8 +291,19 @@ int main(int argc, char** argv)
 
       gettimeofday(&tdata[1], NULL);
       for (int k = 0; k < nof_repetitions; k++) {
-        srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+        if (test_crc) {
+          if (is_8bit) {
+            srsran_tdec_run_all_crc_8bit(&tdec, (int8_t*)llr_c, data_rx_bytes, 1, t, frame_length, &crc, frame_length);
+          } else {
+            srsran_tdec_run_all_crc(&tdec, llr_s, data_rx_bytes, 1, t, frame_length, &crc, frame_length);
+          }
+        } else if (is_8bit) {
+          srsran_tdec_run_all_8bit(&tdec, (int8_t*)llr_c, data_rx_bytes, t, frame_length);
+        } else {
+          srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+        }
       }
+      nof_decoded_iter += srsran_tdec_get_nof_iterations(&tdec);
       gettimeofday(&tdata[2], NULL);
       get_time_interval(tdata);
       mean_usec = (tdata[0].tv_sec * 1e6 + tdata[0].tv_usec) / nof_repetitions;
@@ -288,6 +324,9 @@ int main(int argc, char** argv)
   }
 
   printf("\n");
+  if (test_crc) {
+    printf("Average iterations: %.1f\n", (float)nof_decoded_iter / (snr_points * nof_frames));
+  }
   if (snr_points == 1) {
     if (errors) {
       printf("%d Errors\n", errors / nof_cb);
@@ -58,6 +58,18 @@ static int gnb_ul_alloc_prb(srsran_gnb_ul_t* q, uint32_t new_nof_prb)
       ERROR("Malloc");
       return SRSRAN_ERROR;
     }
+
+    for (uint32_t i = 0; i < SRSRAN_SCH_NR_MAX_NOF_TB_BATCH; i++) {
+      if (q->pusch_llr[i] != NULL) {
+        free(q->pusch_llr[i]);
+      }
+
+      q->pusch_llr[i] = srsran_vec_i8_malloc(SRSRAN_SLOT_LEN_RE_NR(q->max_prb) * SRSRAN_MAX_QM);
+      if (q->pusch_llr[i] == NULL) {
+        ERROR("Malloc");
+        return SRSRAN_ERROR;
+      }
+    }
   }
 
   return SRSRAN_SUCCESS;
@@ -123,6 +135,12 @@ void srsran_gnb_ul_free(srsran_gnb_ul_t* q)
     free(q->sf_symbols[0]);
   }
 
+  for (uint32_t i = 0; i < SRSRAN_SCH_NR_MAX_NOF_TB_BATCH; i++) {
+    if (q->pusch_llr[i] != NULL) {
+      free(q->pusch_llr[i]);
+    }
+  }
+
   SRSRAN_MEM_ZERO(q, srsran_gnb_ul_t, 1);
 }
 
@@ -205,6 +223,74 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_ul_get_pusch_multi(srsran_gnb_ul_t*         q,
+                                  const srsran_slot_cfg_t* slot_cfg,
+                                  srsran_gnb_ul_pusch_t*   pusch,
+                                  uint32_t                 nof_pusch)
+{
+  if (q == NULL || slot_cfg == NULL || (pusch == NULL && nof_pusch > 0)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Transport blocks demodulated and waiting to be decoded, each of them uses one LLR buffer
+  srsran_sch_nr_rx_tb_t rx[SRSRAN_SCH_NR_MAX_NOF_TB_BATCH];
+  uint32_t              nof_rx = 0;
+
+  for (uint32_t i = 0; i < nof_pusch; i++) {
+    const srsran_sch_cfg_nr_t*   cfg   = pusch[i].cfg;
+    const srsran_sch_grant_nr_t* grant = pusch[i].grant;
+    srsran_pusch_res_nr_t*       data  = pusch[i].data;
+    if (cfg == NULL || grant == NULL || data == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+
+    if (srsran_dmrs_sch_estimate(&q->dmrs, slot_cfg, cfg, grant, q->sf_symbols[0], &q->chest_pusch) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    pusch[i].csi = q->dmrs.csi;
+
+    // Check PUSCH DMRS minimum SNR and skip PUSCH decoding if it is below the threshold
+    if (q->dmrs.csi.snr_dB < q->pusch_min_snr_dB) {
+      // Set PUSCH data as not decoded
+      data->tb[0].crc      = false;
+      data->tb[0].avg_iter = NAN;
+      data->uci.valid      = false;
+      continue;
+    }
+
+    // Decode the pending transport blocks if the LLR buffers cannot fit the codewords of this PUSCH
+    if (nof_rx + SRSRAN_MAX_CODEWORDS > SRSRAN_SCH_NR_MAX_NOF_TB_BATCH) {
+      if (srsran_sch_nr_decode_multi(&q->pusch.sch, rx, nof_rx) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      nof_rx = 0;
+    }
+
+    // Assign an LLR buffer to each codeword
+    int8_t*  llr[SRSRAN_MAX_CODEWORDS] = {};
+    uint32_t nof_llr                   = nof_rx;
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+      const srsran_sch_tb_t* sch_tb = &grant->tb[tb];
+      if (sch_tb->enabled && sch_tb->cw_idx < SRSRAN_MAX_CODEWORDS && llr[sch_tb->cw_idx] == NULL) {
+        llr[sch_tb->cw_idx] = q->pusch_llr[nof_llr++];
+      }
+    }
+
+    int n = srsran_pusch_nr_demodulate(&q->pusch, cfg, grant, &q->chest_pusch, q->sf_symbols, llr, data, &rx[nof_rx]);
+    if (n < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    nof_rx += (uint32_t)n;
+  }
+
+  if (nof_rx > 0 && srsran_sch_nr_decode_multi(&q->pusch.sch, rx, nof_rx) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
@@ -350,13 +436,14 @@ uint32_t srsran_gnb_ul_pucch_info(srsran_gnb_ul_t*                     q,
   return len;
 }
 
-uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*             q,
-                                  const srsran_sch_cfg_nr_t*   cfg,
-                                  const srsran_pusch_res_nr_t* res,
-                                  char*                        str,
-                                  uint32_t                     str_len)
+uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*                     q,
+                                  const srsran_sch_cfg_nr_t*           cfg,
+                                  const srsran_pusch_res_nr_t*         res,
+                                  const srsran_csi_trs_measurements_t* csi,
+                                  char*                                str,
+                                  uint32_t                             str_len)
 {
-  if (q == NULL || cfg == NULL || res == NULL) {
+  if (q == NULL || cfg == NULL || res == NULL || csi == NULL) {
     return 0;
   }
 
@@ -365,7 +452,7 @@ uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*             q,
   len += srsran_pusch_nr_rx_info(&q->pusch, cfg, &cfg->grant, res, str, str_len - len);
 
   // Append channel estimator info
-  len += srsran_csi_meas_info_short(&q->dmrs.csi, &str[len], str_len - len);
+  len += srsran_csi_meas_info_short(csi, &str[len], str_len - len);
 
   return len;
 }
@@ -474,7 +474,9 @@ int srsran_prach_gen_seqs(srsran_prach_t* p)
       // Generate actual sequence
       prach_cexp(p->N_zc, u, root);
 
-      p->root_seqs_idx[p->N_roots++] = i;
+      p->root_seqs_idx[p->N_roots] = i;
+      p->root_d_u[p->N_roots]      = 0;
+      p->N_roots++;
 
       // Determine v_max
       if (p->hs) {
@@ -515,6 +517,11 @@ int srsran_prach_gen_seqs(srsran_prach_t* p)
         if (v_max < 0) {
           v_max = 0;
         }
+
+        // A frequency offset of one PRACH subcarrier moves the correlation peak by d_u, search the aliases as well
+        if (N_shift != 0) {
+          p->root_d_u[p->N_roots - 1] = d_u;
+        }
       } else {
         // Normal cell
         if (0 == p->N_cs) {
@@ -544,6 +551,7 @@ int srsran_prach_gen_seqs(srsran_prach_t* p)
     // }
     srsran_vec_cf_copy(p->seqs[i], &root[C_v], p->N_zc - C_v);
     srsran_vec_cf_copy(&p->seqs[i][p->N_zc - C_v], root, C_v);
+    p->seqs_shift[i] = C_v;
 
     v++;
   }
@@ -567,8 +575,16 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     p->prach_bins = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr_spec  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr       = srsran_vec_f_malloc(SRSRAN_PRACH_N_ZC_LONG);
+    p->corr_hs    = srsran_vec_f_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->cross      = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
-    p->corr_freq  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
+
+    // Set up containers for the correlation of all the roots, up to one per preamble
+    p->corr_spec_batch = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    p->corr_batch      = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    if (!p->corr_spec_batch || !p->corr_batch) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
 
     // Set up ZC FFTS
     if (srsran_dft_plan(&p->zc_fft, SRSRAN_PRACH_N_ZC_LONG, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX)) {
@@ -696,6 +712,34 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       p->num_ra_preambles = p->N_roots;
     }
 
+    // Plan the IFFT of the correlation of all the searched roots, executed at once
+    if (p->zc_ifft_batch.p == NULL) {
+      if (srsran_dft_plan_guru_c(&p->zc_ifft_batch,
+                                 p->N_zc,
+                                 SRSRAN_DFT_BACKWARD,
+                                 p->corr_spec_batch,
+                                 p->corr_batch,
+                                 1,
+                                 1,
+                                 p->num_ra_preambles,
+                                 p->N_zc,
+                                 p->N_zc)) {
+        ERROR("Error creating DFT plan");
+        return SRSRAN_ERROR;
+      }
+    } else if (srsran_dft_replan_guru_c(&p->zc_ifft_batch,
+                                        p->N_zc,
+                                        p->corr_spec_batch,
+                                        p->corr_batch,
+                                        1,
+                                        1,
+                                        p->num_ra_preambles,
+                                        p->N_zc,
+                                        p->N_zc)) {
+      ERROR("Error creating DFT plan");
+      return SRSRAN_ERROR;
+    }
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -797,6 +841,11 @@ void srsran_prach_set_detect_factor(srsran_prach_t* p, float ratio)
   p->detect_factor = ratio;
 }
 
+const srsran_prach_preamble_metrics_t* srsran_prach_get_preamble_metrics(const srsran_prach_t* p)
+{
+  return p->metrics;
+}
+
 int srsran_prach_detect(srsran_prach_t* p,
                         uint32_t        freq_offset,
                         cf_t*           signal,
@@ -879,23 +928,33 @@ int srsran_prach_process(srsran_prach_t* p,
 {
   float max_to_cancel = 0;
   cancellation_idx    = -1;
-  int max_idx         = 0;
-  srsran_vec_cf_zero(p->cross, p->N_zc);
-  srsran_vec_cf_zero(p->corr_freq, p->N_zc);
+
+  // Correlate the received bins with all the searched roots and take them to the time domain with a single IFFT
   for (int i = 0; i < p->num_ra_preambles; i++) {
-    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
+    srsran_vec_prod_conj_ccc(
+        p->prach_bins, get_precoded_dft(p, p->root_seqs_idx[i]), &p->corr_spec_batch[i * p->N_zc], p->N_zc);
+  }
+  srsran_dft_run_guru_c(&p->zc_ifft_batch);
 
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+  for (int i = 0; i < p->num_ra_preambles; i++) {
+    cf_t*  corr_spec = &p->corr_spec_batch[i * p->N_zc];
+    float* corr      = p->corr;
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+    srsran_vec_abs_square_cf(&p->corr_batch[i * p->N_zc], p->corr, p->N_zc);
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+    float corr_ave  = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+    float threshold = p->detect_factor * corr_ave;
 
-    float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+    // Restricted set: combine every lag with its aliases at +/- d_u, which hold the preamble energy displaced by a
+    // frequency offset. The two extra lags add, on average, twice the noise power to the threshold.
+    uint32_t d_u = p->root_d_u[i];
+    if (d_u != 0) {
+      for (uint32_t k = 0; k < p->N_zc; k++) {
+        p->corr_hs[k] = p->corr[k] + p->corr[(k + d_u) % p->N_zc] + p->corr[(k + p->N_zc - d_u) % p->N_zc];
+      }
+      corr = p->corr_hs;
+      threshold += 2 * corr_ave;
+    }
 
     uint32_t winsize = 0;
     if (p->N_cs != 0) {
@@ -903,11 +962,15 @@ int srsran_prach_process(srsran_prach_t* p,
     } else {
       winsize = p->N_zc;
     }
-    uint32_t n_wins = p->N_zc / winsize;
+
+    // Every preamble generated from this root has its own window, located at its cyclic shift
+    uint32_t seq_begin = p->root_seqs_idx[i];
+    uint32_t seq_end   = (i + 1 < p->N_roots) ? p->root_seqs_idx[i + 1] : N_SEQS;
+    uint32_t n_wins    = seq_end - seq_begin;
 
     float max_peak = 0;
     for (int j = 0; j < n_wins; j++) {
-      uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
+      uint32_t start = (p->N_zc - p->seqs_shift[seq_begin + j]) % p->N_zc;
       uint32_t end   = start + winsize;
       if (end > p->deadzone) {
         end -= p->deadzone;
@@ -915,39 +978,53 @@ int srsran_prach_process(srsran_prach_t* p,
       start += p->deadzone;
       p->peak_values[j] = 0;
       for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
+        if (corr[k] > p->peak_values[j]) {
+          p->peak_values[j]  = corr[k];
           p->peak_offsets[j] = k - start;
           if (p->peak_values[j] > max_peak) {
             max_peak = p->peak_values[j];
-            max_idx  = k;
           }
         }
       }
+
+      srsran_prach_preamble_metrics_t* metrics = &p->metrics[seq_begin + j];
+      if (p->peak_values[j] / corr_ave > metrics->peak_to_avg) {
+        metrics->peak_to_avg = p->peak_values[j] / corr_ave;
+        metrics->t_offset    = srsran_prach_get_offset_secs(p, j);
+      }
     }
-    if (max_peak > (p->detect_factor * corr_ave)) {
+    if (max_peak > threshold) {
+      bool cross_done = false;
       for (int j = 0; j < n_wins; j++) {
-        if (p->peak_values[j] > p->detect_factor * corr_ave) {
+        if (p->peak_values[j] > threshold) {
+          uint32_t seq_idx = seq_begin + j;
+
+          p->metrics[seq_idx].detected = true;
           if (indices) {
             if (p->successive_cancellation) {
               if (max_peak > max_to_cancel) {
-                cancellation_idx       = (i * n_wins) + j;
+                cancellation_idx       = seq_idx;
                 max_to_cancel          = max_peak;
-                p->prach_cancel.idx    = cancellation_idx;
+                p->prach_cancel.idx    = i;
                 p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
-                srsran_prach_calculate_correction_array(p, p->corr_freq);
+                srsran_prach_calculate_correction_array(p, corr_spec);
               }
-              if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
+              if (srsran_prach_have_stored(seq_idx, indices, *n_indices)) {
                 break;
               }
             }
-            indices[*n_indices] = (i * n_wins) + j;
+            indices[*n_indices] = seq_idx;
           }
           if (peak_to_avg) {
             peak_to_avg[*n_indices] = p->peak_values[j] / corr_ave;
           }
           if (t_offsets) {
             // saves the PRACH offset in seconds to t_offsets, time domain or freq domain base calc
+            if (p->freq_domain_offset_calc && !cross_done) {
+              srsran_vec_prod_conj_ccc(corr_spec, &corr_spec[1], p->cross, p->N_zc - 1);
+              p->cross[p->N_zc - 1] = 0;
+              cross_done            = true;
+            }
             t_offsets[*n_indices] = (p->freq_domain_offset_calc)
                                         ? (srsran_prach_calculate_time_offset_secs(p, p->cross))
                                         : (srsran_prach_get_offset_secs(p, j));
@@ -983,6 +1060,7 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
     }
     int cancellation_idx = -2;
     bzero(&p->prach_cancel, sizeof(srsran_prach_cancellation_t));
+    bzero(p->metrics, sizeof(p->metrics));
 
     // FFT incoming signal
     srsran_dft_run(&p->fft, signal, p->signal_fft);
@@ -1016,14 +1094,17 @@ int srsran_prach_free(srsran_prach_t* p)
   free(p->prach_bins);
   free(p->corr_spec);
   free(p->corr);
+  free(p->corr_hs);
+  free(p->corr_spec_batch);
+  free(p->corr_batch);
   srsran_dft_plan_free(&p->ifft);
   free(p->ifft_in);
   free(p->ifft_out);
   free(p->cross);
-  free(p->corr_freq);
   srsran_dft_plan_free(&p->fft);
   srsran_dft_plan_free(&p->zc_fft);
   srsran_dft_plan_free(&p->zc_ifft);
+  srsran_dft_plan_free(&p->zc_ifft_batch);
 
   if (p->signal_fft) {
     free(p->signal_fft);
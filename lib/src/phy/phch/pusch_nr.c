@@ -783,15 +783,21 @@ int srsran_pusch_nr_encode(srsran_pusch_nr_t*            q,
   return SRSRAN_SUCCESS;
 }
 
-static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
-                                           const srsran_sch_cfg_nr_t* cfg,
-                                           const srsran_sch_tb_t*     tb,
-                                           srsran_pusch_res_nr_t*     res,
-                                           uint16_t                   rnti)
+/**
+ * @brief Demodulates, descrambles and demultiplexes a codeword, and decodes its UCI
+ * @param ulsch_llr Destination of the UL-SCH LLR, set to NULL for using the internal buffers
+ * @return The number of UL-SCH LLR (0 if the TB is disabled) if no error occurs, SRSRAN_ERROR code otherwise
+ */
+static inline int pusch_nr_demodulate_codeword(srsran_pusch_nr_t*         q,
+                                               const srsran_sch_cfg_nr_t* cfg,
+                                               const srsran_sch_tb_t*     tb,
+                                               srsran_pusch_res_nr_t*     res,
+                                               uint16_t                   rnti,
+                                               int8_t*                    ulsch_llr)
 {
   // Early return if TB is not enabled
   if (!tb->enabled) {
-    return SRSRAN_SUCCESS;
+    return 0;
   }
 
   // Check codeword index
@@ -869,7 +875,7 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
     }
 
     // Demultiplex UL-SCH, change sign
-    int8_t* g_ulsch = (int8_t*)q->g_ulsch;
+    int8_t* g_ulsch = (ulsch_llr != NULL) ? ulsch_llr : (int8_t*)q->g_ulsch;
     for (uint32_t i = 0; i < q->G_ulsch; i++) {
       g_ulsch[i] = -llr[q->pos_ulsch[i]];
     }
@@ -907,17 +913,31 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
 
     // Decode CSI part 2
     // ... Not implemented
-
-    // Change LLR pointer
-    llr = g_ulsch;
   } else {
+    // Change sign, in place if no destination is given
+    int8_t* g_ulsch = (ulsch_llr != NULL) ? ulsch_llr : llr;
     for (uint32_t i = 0; i < nof_bits; i++) {
-      llr[i] *= -1;
+      g_ulsch[i] = -llr[i];
     }
   }
 
+  return (int)nof_bits;
+}
+
+static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
+                                           const srsran_sch_cfg_nr_t* cfg,
+                                           const srsran_sch_tb_t*     tb,
+                                           srsran_pusch_res_nr_t*     res,
+                                           uint16_t                   rnti)
+{
+  int nof_bits = pusch_nr_demodulate_codeword(q, cfg, tb, res, rnti, NULL);
+  if (nof_bits < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Decode Ul-SCH
   if (nof_bits != 0) {
+    int8_t* llr = q->uci_mux ? (int8_t*)q->g_ulsch : (int8_t*)q->b[tb->cw_idx];
     if (srsran_ulsch_nr_decode(&q->sch, &cfg->sch_cfg, tb, llr, &res->tb[tb->cw_idx]) < SRSRAN_SUCCESS) {
       ERROR("Error in SCH decoding");
       return SRSRAN_ERROR;
@@ -927,23 +947,15 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
-                           const srsran_sch_cfg_nr_t*   cfg,
-                           const srsran_sch_grant_nr_t* grant,
-                           srsran_chest_dl_res_t*       channel,
-                           cf_t*                        sf_symbols[SRSRAN_MAX_PORTS],
-                           srsran_pusch_res_nr_t*       data)
+/**
+ * @brief Extracts the PUSCH resource elements, equalizes them and demaps the layers into the codeword symbols
+ */
+static int pusch_nr_equalize(srsran_pusch_nr_t*           q,
+                             const srsran_sch_cfg_nr_t*   cfg,
+                             const srsran_sch_grant_nr_t* grant,
+                             srsran_chest_dl_res_t*       channel,
+                             cf_t*                        sf_symbols[SRSRAN_MAX_PORTS])
 {
-  // Check input pointers
-  if (!q || !cfg || !grant || !data || !sf_symbols || !channel) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
-
   // Check number of layers
   if (q->max_layers < grant->nof_layers) {
     ERROR("Error number of layers (%d) exceeds configured maximum (%d)", grant->nof_layers, q->max_layers);
@@ -999,6 +1011,30 @@ int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
     srsran_layerdemap_nr(q->d, nof_cw, q->x, grant->nof_layers, nof_re);
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
+                           const srsran_sch_cfg_nr_t*   cfg,
+                           const srsran_sch_grant_nr_t* grant,
+                           srsran_chest_dl_res_t*       channel,
+                           cf_t*                        sf_symbols[SRSRAN_MAX_PORTS],
+                           srsran_pusch_res_nr_t*       data)
+{
+  // Check input pointers
+  if (!q || !cfg || !grant || !data || !sf_symbols || !channel) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (pusch_nr_equalize(q, cfg, grant, channel, sf_symbols) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
     if (pusch_nr_decode_codeword(q, cfg, &grant->tb[tb], data, grant->rnti) < SRSRAN_SUCCESS) {
@@ -1016,6 +1052,63 @@ int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_pusch_nr_demodulate(srsran_pusch_nr_t*           q,
+                               const srsran_sch_cfg_nr_t*   cfg,
+                               const srsran_sch_grant_nr_t* grant,
+                               srsran_chest_dl_res_t*       channel,
+                               cf_t*                        sf_symbols[SRSRAN_MAX_PORTS],
+                               int8_t*                      ulsch_llr[SRSRAN_MAX_CODEWORDS],
+                               srsran_pusch_res_nr_t*       data,
+                               srsran_sch_nr_rx_tb_t        rx[SRSRAN_MAX_TB])
+{
+  // Check input pointers
+  if (!q || !cfg || !grant || !data || !sf_symbols || !channel || !ulsch_llr || !rx) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (pusch_nr_equalize(q, cfg, grant, channel, sf_symbols) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Demodulate every codeword into its own buffer, the UL-SCH is decoded by the caller
+  uint32_t nof_rx = 0;
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+    const srsran_sch_tb_t* sch_tb = &grant->tb[tb];
+    if (sch_tb->enabled && (sch_tb->cw_idx >= SRSRAN_MAX_CODEWORDS || ulsch_llr[sch_tb->cw_idx] == NULL)) {
+      ERROR("No UL-SCH LLR buffer for TB %d", tb);
+      return SRSRAN_ERROR;
+    }
+
+    int nof_bits = pusch_nr_demodulate_codeword(
+        q, cfg, sch_tb, data, grant->rnti, sch_tb->enabled ? ulsch_llr[sch_tb->cw_idx] : NULL);
+    if (nof_bits < SRSRAN_SUCCESS) {
+      ERROR("Error demodulating TB %d", tb);
+      return SRSRAN_ERROR;
+    }
+
+    if (nof_bits != 0) {
+      rx[nof_rx].sch_cfg = &cfg->sch_cfg;
+      rx[nof_rx].tb      = sch_tb;
+      rx[nof_rx].e_bits  = ulsch_llr[sch_tb->cw_idx];
+      rx[nof_rx].res     = &data->tb[sch_tb->cw_idx];
+      nof_rx++;
+    }
+  }
+
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_us = (uint32_t)t[0].tv_usec;
+  }
+
+  return (int)nof_rx;
+}
+
 static uint32_t pusch_nr_grant_info(const srsran_pusch_nr_t*     q,
                                     const srsran_sch_cfg_nr_t*   cfg,
                                     const srsran_sch_grant_nr_t* grant,
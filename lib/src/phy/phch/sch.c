@@ -202,6 +202,8 @@ void srsran_sch_free(srsran_sch_t* q)
 {
   srsran_rm_turbo_free_tables();
 
+  srsran_sch_set_fec_threads(q, 0, -1);
+
   if (q->cb_in) {
     free(q->cb_in);
   }
@@ -368,111 +370,267 @@ static int encode_tb(srsran_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
-bool decode_tb_cb(srsran_sch_t*           q,
-                  srsran_softbuffer_rx_t* softbuffer,
-                  srsran_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/* Turbo decoder and CRC resources of one FEC thread */
+typedef struct {
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_tb;
+  srsran_crc_t  crc_cb;
+} sch_cb_worker_t;
+
+/* Codeblock decoding job shared by the FEC threads */
+typedef struct {
+  srsran_sch_t*           q;
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t*        cb_segm;
+  uint32_t                Qm;
+  uint32_t                rv;
+  uint32_t                nof_e_bits;
+  void*                   e_bits;
+  uint8_t*                data;
+  uint32_t                pending[SRSRAN_MAX_CODEBLOCKS]; ///< Indexes of the codeblocks to decode
+  uint32_t                cb_noi[SRSRAN_MAX_CODEBLOCKS];
+  bool                    cb_error[SRSRAN_MAX_CODEBLOCKS];
+} sch_decode_job_t;
+
+static int sch_cb_workers_init(srsran_sch_t* q, uint32_t nof_workers)
 {
-  int8_t*  e_bits_b = e_bits;
-  int16_t* e_bits_s = e_bits;
+  sch_cb_worker_t* w = SRSRAN_MEM_ALLOC(sch_cb_worker_t, nof_workers);
+  if (w == NULL) {
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(w, sch_cb_worker_t, nof_workers);
+  q->cb_workers = w;
 
-  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
-    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
-    return false;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    q->nof_cb_workers++;
+    if (srsran_crc_init(&w[i].crc_tb, SRSRAN_LTE_CRC24A, 24)) {
+      ERROR("Error initiating CRC");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_crc_init(&w[i].crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_tdec_init(&w[i].decoder, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating Turbo Decoder");
+      return SRSRAN_ERROR;
+    }
   }
 
-  q->avg_iterations = 0;
+  return SRSRAN_SUCCESS;
+}
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+static void sch_cb_workers_free(srsran_sch_t* q)
+{
+  sch_cb_worker_t* w = (sch_cb_worker_t*)q->cb_workers;
+  if (w) {
+    for (uint32_t i = 0; i < q->nof_cb_workers; i++) {
+      srsran_tdec_free(&w[i].decoder);
+    }
+    free(w);
+  }
+  q->cb_workers     = NULL;
+  q->nof_cb_workers = 0;
+}
 
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
+int srsran_sch_set_fec_threads(srsran_sch_t* q, uint32_t nof_threads, int prio)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
+  srsran_fec_pool_free(&q->fec_pool);
+  sch_cb_workers_free(q);
 
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
-      }
+  if (nof_threads == 0) {
+    return SRSRAN_SUCCESS;
+  }
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      }
+  if (sch_cb_workers_init(q, nof_threads) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating codeblock workers");
+    sch_cb_workers_free(q);
+    return SRSRAN_ERROR;
+  }
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+  if (srsran_fec_pool_init(&q->fec_pool, nof_threads, prio) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating FEC pool");
+    sch_cb_workers_free(q);
+    return SRSRAN_ERROR;
+  }
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+  return SRSRAN_SUCCESS;
+}
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+static void decode_cb(void* arg, uint32_t worker_idx, uint32_t cb_idx)
+{
+  sch_decode_job_t*       job        = (sch_decode_job_t*)arg;
+  srsran_sch_t*           q          = job->q;
+  srsran_softbuffer_rx_t* softbuffer = job->softbuffer;
+  srsran_cbsegm_t*        cb_segm    = job->cb_segm;
+  uint32_t                Qm         = job->Qm;
+  uint8_t*                data       = job->data;
+  int8_t*                 e_bits_b   = job->e_bits;
+  int16_t*                e_bits_s   = job->e_bits;
+
+  // Select the decoder resources of the worker, worker 0 is the calling thread
+  srsran_tdec_t* decoder = &q->decoder;
+  srsran_crc_t*  crc_tb  = &q->crc_tb;
+  srsran_crc_t*  crc_cb  = &q->crc_cb;
+  if (worker_idx > 0) {
+    sch_cb_worker_t* w = &((sch_cb_worker_t*)q->cb_workers)[worker_idx - 1];
+    decoder            = &w->decoder;
+    crc_tb             = &w->crc_tb;
+    crc_cb             = &w->crc_cb;
+  }
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+  uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
 
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+  uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+  uint32_t Gp    = job->nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+  uint32_t rp   = cb_idx * n_e;
+  uint32_t n_e2 = n_e;
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+  if (cb_idx > cb_segm->C - gamma) {
+    n_e2 = n_e + Qm;
+    rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  }
+
+  if (q->llr_is_8bit) {
+    if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, job->rv)) {
+      ERROR("Error in rate matching");
+      job->cb_error[cb_idx] = true;
+      return;
+    }
+  } else {
+    if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, job->rv)) {
+      ERROR("Error in rate matching");
+      job->cb_error[cb_idx] = true;
+      return;
+    }
+  }
+
+  uint32_t      len_crc;
+  srsran_crc_t* crc_ptr;
+
+  if (cb_segm->C > 1) {
+    len_crc = cb_len;
+    crc_ptr = crc_cb;
+  } else {
+    len_crc = cb_segm->tbs + 24;
+    crc_ptr = crc_tb;
+  }
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+  // Run iterations and use CRC for early stopping once the minimum number of iterations is reached. The decoded CB
+  // includes its CRC, which overlaps the next CB in data, so it is decoded apart and only the payload is copied
+  uint8_t cb_data[SRSRAN_TCOD_MAX_LEN_CB / 8];
+  int     crc_ok;
+  if (q->llr_is_8bit) {
+    crc_ok = srsran_tdec_run_all_crc_8bit(decoder,
+                                          (int8_t*)softbuffer->buffer_f[cb_idx],
+                                          cb_data,
+                                          SRSRAN_PDSCH_MIN_TDEC_ITERS,
+                                          q->max_iterations,
+                                          cb_len,
+                                          crc_ptr,
+                                          len_crc);
+  } else {
+    crc_ok = srsran_tdec_run_all_crc(decoder,
+                                     softbuffer->buffer_f[cb_idx],
+                                     cb_data,
+                                     SRSRAN_PDSCH_MIN_TDEC_ITERS,
+                                     q->max_iterations,
+                                     cb_len,
+                                     crc_ptr,
+                                     len_crc);
+  }
+  if (crc_ok < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB %d", cb_idx);
+    job->cb_error[cb_idx] = true;
+    return;
+  }
+  memcpy(&data[cb_idx * rlen / 8], cb_data, rlen / 8 * sizeof(uint8_t));
+
+  bool     early_stop = crc_ok == 1;
+  uint32_t cb_noi     = (uint32_t)srsran_tdec_get_nof_iterations(decoder);
+  if (early_stop) {
+    softbuffer->cb_crc[cb_idx] = true;
+  }
+
+  job->cb_noi[cb_idx] = cb_noi;
+
+  INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+       cb_idx,
+       rp,
+       n_e2,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       rlen,
+       cb_noi,
+       q->max_iterations);
+}
+
+static void decode_tb_cb_task(void* arg, uint32_t worker_idx, uint32_t task_idx)
+{
+  sch_decode_job_t* job = (sch_decode_job_t*)arg;
+
+  decode_cb(arg, worker_idx, job->pending[task_idx]);
+}
 
+bool decode_tb_cb(srsran_sch_t*           q,
+                  srsran_softbuffer_rx_t* softbuffer,
+                  srsran_cbsegm_t*        cb_segm,
+                  uint32_t                Qm,
+                  uint32_t                rv,
+                  uint32_t                nof_e_bits,
+                  void*                   e_bits,
+                  uint8_t*                data)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
+
+  sch_decode_job_t job = {};
+  job.q                = q;
+  job.softbuffer       = softbuffer;
+  job.cb_segm          = cb_segm;
+  job.Qm               = Qm;
+  job.rv               = rv;
+  job.nof_e_bits       = nof_e_bits;
+  job.e_bits           = e_bits;
+  job.data             = data;
+
+  /* Do not process blocks with CRC Ok, copy decoded data from previous transmissions */
+  uint32_t nof_pending = 0;
+  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+    if (softbuffer->cb_crc[cb_idx] == false) {
+      job.pending[nof_pending++] = cb_idx;
     } else {
-      // Copy decoded data from previous transmissions
       uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
       uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
       memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
     }
   }
 
+  // Decode the pending codeblocks, across the FEC threads if they are enabled
+  if (nof_pending > 0) {
+    if (srsran_fec_pool_run(&q->fec_pool, decode_tb_cb_task, &job, nof_pending) < SRSRAN_SUCCESS) {
+      return false;
+    }
+  }
+
+  q->avg_iterations = 0;
+  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+    if (job.cb_error[cb_idx]) {
+      return false;
+    }
+    q->avg_iterations += job.cb_noi[cb_idx];
+  }
+
   softbuffer->tb_crc = true;
   for (int i = 0; i < cb_segm->C && softbuffer->tb_crc; i++) {
     /* If one CB failed return false */
@@ -206,8 +206,9 @@ static inline int sch_nr_init_common(srsran_sch_nr_t* q)
     return SRSRAN_ERROR;
   }
 
+  // Large enough to hold the unpacked messages of a full batch of decoded code blocks
   if (!q->temp_cb) {
-    q->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8);
+    q->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * SRSRAN_MAX(8, SRSRAN_LDPC_DECODER_MAX_BATCH));
     if (!q->temp_cb) {
       return SRSRAN_ERROR;
     }
@@ -280,40 +281,32 @@ int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
-int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
+/**
+ * @brief Decoding resources of a FEC thread
+ */
+typedef struct {
+  srsran_crc_t           crc_tb_24;
+  srsran_crc_t           crc_tb_16;
+  srsran_crc_t           crc_cb;
+  srsran_ldpc_decoder_t* decoder_bg1[MAX_LIFTSIZE + 1];
+  srsran_ldpc_decoder_t* decoder_bg2[MAX_LIFTSIZE + 1];
+  uint8_t*               temp_cb;
+} sch_nr_cb_worker_t;
+
+static int sch_nr_decoders_init(srsran_ldpc_decoder_t**    decoder_bg1,
+                                srsran_ldpc_decoder_t**    decoder_bg2,
+                                srsran_ldpc_decoder_type_t decoder_type,
+                                float                      scaling_factor,
+                                uint32_t                   max_nof_iter)
 {
-  int ret = sch_nr_init_common(q);
-  if (ret < SRSRAN_SUCCESS) {
-    return ret;
-  }
-
-  srsran_ldpc_decoder_type_t decoder_type =
-      args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_FLOOD : SRSRAN_LDPC_DECODER_C;
-
-#ifdef LV_HAVE_AVX512
-  if (!args->disable_simd) {
-    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
-  }
-#else // LV_HAVE_AVX512
-#ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
-    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX2_FLOOD : SRSRAN_LDPC_DECODER_C_AVX2;
-  }
-#endif // LV_HAVE_AVX2
-#endif // LV_HAVE_AVX512
-
-  // If the scaling factor is not provided use a default value that allows decoding all possible combinations of nPRB
-  // and MCS indexes for all possible MCS tables
-  float scaling_factor = isnormal(args->decoder_scaling_factor) ? args->decoder_scaling_factor : 0.8f;
-
   // Iterate over all possible lifting sizes
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
     uint8_t ls_index = get_ls_index(ls);
 
     // Invalid lifting size
     if (ls_index == VOID_LIFTSIZE) {
-      q->decoder_bg1[ls] = NULL;
-      q->decoder_bg2[ls] = NULL;
+      decoder_bg1[ls] = NULL;
+      decoder_bg2[ls] = NULL;
       continue;
     }
 
@@ -322,40 +315,146 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     decoder_args.type                       = decoder_type;
     decoder_args.ls                         = ls;
     decoder_args.scaling_fctr               = scaling_factor;
-    decoder_args.max_nof_iter               = args->max_nof_iter;
+    decoder_args.max_nof_iter               = max_nof_iter;
 
-    q->decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
-    if (!q->decoder_bg1[ls]) {
+    decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
+    if (!decoder_bg1[ls]) {
       ERROR("Error: calloc");
       return SRSRAN_ERROR;
     }
-    SRSRAN_MEM_ZERO(q->decoder_bg1[ls], srsran_ldpc_decoder_t, 1);
+    SRSRAN_MEM_ZERO(decoder_bg1[ls], srsran_ldpc_decoder_t, 1);
 
     decoder_args.bg = BG1;
-    if (srsran_ldpc_decoder_init(q->decoder_bg1[ls], &decoder_args) < SRSRAN_SUCCESS) {
+    if (srsran_ldpc_decoder_init(decoder_bg1[ls], &decoder_args) < SRSRAN_SUCCESS) {
       ERROR("Error: initialising BG1 LDPC decoder for ls=%d", ls);
       return SRSRAN_ERROR;
     }
 
-    q->decoder_bg2[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
-    if (!q->decoder_bg2[ls]) {
+    decoder_bg2[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
+    if (!decoder_bg2[ls]) {
       ERROR("Error: calloc");
       return SRSRAN_ERROR;
     }
-    SRSRAN_MEM_ZERO(q->decoder_bg2[ls], srsran_ldpc_decoder_t, 1);
+    SRSRAN_MEM_ZERO(decoder_bg2[ls], srsran_ldpc_decoder_t, 1);
 
     decoder_args.bg = BG2;
-    if (srsran_ldpc_decoder_init(q->decoder_bg2[ls], &decoder_args) < SRSRAN_SUCCESS) {
+    if (srsran_ldpc_decoder_init(decoder_bg2[ls], &decoder_args) < SRSRAN_SUCCESS) {
       ERROR("Error: initialising BG2 LDPC decoder for ls=%d", ls);
       return SRSRAN_ERROR;
     }
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+static void sch_nr_decoders_free(srsran_ldpc_decoder_t** decoder_bg1, srsran_ldpc_decoder_t** decoder_bg2)
+{
+  for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
+    if (decoder_bg1[ls]) {
+      srsran_ldpc_decoder_free(decoder_bg1[ls]);
+      free(decoder_bg1[ls]);
+      decoder_bg1[ls] = NULL;
+    }
+    if (decoder_bg2[ls]) {
+      srsran_ldpc_decoder_free(decoder_bg2[ls]);
+      free(decoder_bg2[ls]);
+      decoder_bg2[ls] = NULL;
+    }
+  }
+}
+
+static int sch_nr_cb_worker_init(sch_nr_cb_worker_t*        w,
+                                 srsran_ldpc_decoder_type_t decoder_type,
+                                 float                      scaling_factor,
+                                 uint32_t                   max_nof_iter)
+{
+  if (srsran_crc_init(&w->crc_tb_24, SRSRAN_LTE_CRC24A, 24) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_crc_init(&w->crc_cb, SRSRAN_LTE_CRC24B, 24) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_crc_init(&w->crc_tb_16, SRSRAN_LTE_CRC16, 16) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  w->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * SRSRAN_LDPC_DECODER_MAX_BATCH);
+  if (!w->temp_cb) {
+    return SRSRAN_ERROR;
+  }
+
+  return sch_nr_decoders_init(w->decoder_bg1, w->decoder_bg2, decoder_type, scaling_factor, max_nof_iter);
+}
+
+static void sch_nr_cb_worker_free(sch_nr_cb_worker_t* w)
+{
+  if (w->temp_cb) {
+    free(w->temp_cb);
+  }
+  sch_nr_decoders_free(w->decoder_bg1, w->decoder_bg2);
+}
+
+int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
+{
+  int ret = sch_nr_init_common(q);
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  srsran_ldpc_decoder_type_t decoder_type =
+      args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_FLOOD : SRSRAN_LDPC_DECODER_C;
+
+#ifdef LV_HAVE_AVX512
+  if (!args->disable_simd) {
+    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
+  }
+#else // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  if (!args->disable_simd) {
+    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX2_FLOOD : SRSRAN_LDPC_DECODER_C_AVX2;
+  }
+#endif // LV_HAVE_AVX2
+#endif // LV_HAVE_AVX512
+
+  // If the scaling factor is not provided use a default value that allows decoding all possible combinations of nPRB
+  // and MCS indexes for all possible MCS tables
+  float scaling_factor = isnormal(args->decoder_scaling_factor) ? args->decoder_scaling_factor : 0.8f;
+
+  if (sch_nr_decoders_init(q->decoder_bg1, q->decoder_bg2, decoder_type, scaling_factor, args->max_nof_iter) <
+      SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   if (srsran_ldpc_rm_rx_init_c(&q->rx_rm) < SRSRAN_SUCCESS) {
     ERROR("Error: initialising Rx LDPC Rate matching");
     return SRSRAN_ERROR;
   }
 
+  // Decoders for the FEC threads, worker 0 is the calling thread and uses the decoders above
+  if (args->nof_fec_threads > 0) {
+    sch_nr_cb_worker_t* w = SRSRAN_MEM_ALLOC(sch_nr_cb_worker_t, args->nof_fec_threads);
+    if (!w) {
+      ERROR("Error: calloc");
+      return SRSRAN_ERROR;
+    }
+    SRSRAN_MEM_ZERO(w, sch_nr_cb_worker_t, args->nof_fec_threads);
+    q->cb_workers = w;
+
+    for (uint32_t i = 0; i < args->nof_fec_threads; i++) {
+      q->nof_cb_workers++;
+      if (sch_nr_cb_worker_init(&w[i], decoder_type, scaling_factor, args->max_nof_iter) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  if (srsran_fec_pool_init(&q->fec_pool, args->nof_fec_threads, args->fec_prio) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising FEC pool");
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -377,6 +476,18 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     return;
   }
 
+  // Stop the FEC threads before releasing their decoders
+  srsran_fec_pool_free(&q->fec_pool);
+  if (q->cb_workers) {
+    sch_nr_cb_worker_t* w = (sch_nr_cb_worker_t*)q->cb_workers;
+    for (uint32_t i = 0; i < q->nof_cb_workers; i++) {
+      sch_nr_cb_worker_free(&w[i]);
+    }
+    free(w);
+    q->cb_workers     = NULL;
+    q->nof_cb_workers = 0;
+  }
+
   if (q->temp_cb) {
     free(q->temp_cb);
   }
@@ -390,15 +501,8 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
       srsran_ldpc_encoder_free(q->encoder_bg2[ls]);
       free(q->encoder_bg2[ls]);
     }
-    if (q->decoder_bg1[ls]) {
-      srsran_ldpc_decoder_free(q->decoder_bg1[ls]);
-      free(q->decoder_bg1[ls]);
-    }
-    if (q->decoder_bg2[ls]) {
-      srsran_ldpc_decoder_free(q->decoder_bg2[ls]);
-      free(q->decoder_bg2[ls]);
-    }
   }
+  sch_nr_decoders_free(q->decoder_bg1, q->decoder_bg2);
 
   srsran_ldpc_rm_tx_free(&q->tx_rm);
   srsran_ldpc_rm_rx_free_c(&q->rx_rm);
@@ -551,12 +655,232 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
-static int sch_nr_decode(srsran_sch_nr_t*        q,
-                         const srsran_sch_cfg_t* sch_cfg,
-                         const srsran_sch_tb_t*  tb,
-                         int8_t*                 e_bits,
-                         srsran_sch_tb_res_nr_t* res)
+/**
+ * @brief Maximum number of code block batches that can be pending, they are decoded in parallel when FEC threads are
+ * enabled
+ */
+#define SCH_NR_MAX_PENDING_BATCH 16
+
+/**
+ * @brief Reception state of a transport block while its code blocks are being decoded
+ */
+typedef struct {
+  srsran_sch_nr_rx_tb_t*  rx;           ///< Transport block provided by the caller
+  srsran_sch_nr_tb_info_t cfg;          ///< Transport block segmentation
+  srsran_crc_t*           crc_tb;       ///< Transport block CRC
+  uint32_t                cb_ok;        ///< Counter of code blocks that have matched CRC
+  uint32_t                nof_iter_sum; ///< Sum of LDPC iterations of all the decoded code blocks
+} sch_nr_rx_tb_state_t;
+
+/**
+ * @brief Rate dematched code blocks, possibly from different transport blocks, pending to be decoded together by the
+ * same LDPC decoder
+ */
+typedef struct {
+  srsran_ldpc_decoder_t* decoder;                              ///< Decoder shared by all the code blocks
+  uint32_t               count;                                ///< Number of pending code blocks
+  sch_nr_rx_tb_state_t*  tb[SRSRAN_LDPC_DECODER_MAX_BATCH];     ///< Transport block the code block belongs to
+  uint32_t               cb_idx[SRSRAN_LDPC_DECODER_MAX_BATCH]; ///< Code block index within the transport block
+  const int8_t*          llr[SRSRAN_LDPC_DECODER_MAX_BATCH];    ///< Rate dematched LLR
+  uint32_t               n_llr[SRSRAN_LDPC_DECODER_MAX_BATCH];  ///< Number of rate dematched LLR
+  srsran_crc_t*          crc[SRSRAN_LDPC_DECODER_MAX_BATCH];    ///< Early stop CRC
+  int                    ret[SRSRAN_LDPC_DECODER_MAX_BATCH];    ///< Decoder result
+  int                    status;                               ///< Batch decoding status
+} sch_nr_cb_batch_t;
+
+/**
+ * @brief Batches decoded in a single run of the FEC pool
+ */
+typedef struct {
+  srsran_sch_nr_t*   q;
+  sch_nr_cb_batch_t* batch[SCH_NR_MAX_PENDING_BATCH];
+} sch_nr_decode_job_t;
+
+/**
+ * @brief Selects the equivalent CRC generator of a FEC thread, they keep state during checksum calculation
+ */
+static srsran_crc_t* sch_nr_cb_worker_crc(srsran_sch_nr_t* q, sch_nr_cb_worker_t* w, srsran_crc_t* crc)
+{
+  if (crc == &q->crc_cb) {
+    return &w->crc_cb;
+  }
+  if (crc == &q->crc_tb_16) {
+    return &w->crc_tb_16;
+  }
+  return &w->crc_tb_24;
+}
+
+/**
+ * @brief Decodes a batch of code blocks and stores the ones that match the CRC in their softbuffer. It only writes
+ * into code block specific memory, so different batches can be decoded concurrently.
+ */
+static void sch_nr_decode_cb_batch(void* arg, uint32_t worker_idx, uint32_t task_idx)
+{
+  sch_nr_decode_job_t* job   = (sch_nr_decode_job_t*)arg;
+  srsran_sch_nr_t*     q     = job->q;
+  sch_nr_cb_batch_t*   batch = job->batch[task_idx];
+
+  // Select the resources of the worker, worker 0 is the calling thread
+  srsran_ldpc_decoder_t* decoder = batch->decoder;
+  uint8_t*               temp_cb = q->temp_cb;
+  srsran_crc_t*          crc[SRSRAN_LDPC_DECODER_MAX_BATCH];
+  for (uint32_t i = 0; i < batch->count; i++) {
+    crc[i] = batch->crc[i];
+  }
+  if (worker_idx > 0) {
+    sch_nr_cb_worker_t* w = &((sch_nr_cb_worker_t*)q->cb_workers)[worker_idx - 1];
+    decoder               = (decoder->bg == BG1) ? w->decoder_bg1[decoder->ls] : w->decoder_bg2[decoder->ls];
+    temp_cb               = w->temp_cb;
+    for (uint32_t i = 0; i < batch->count; i++) {
+      crc[i] = sch_nr_cb_worker_crc(q, w, batch->crc[i]);
+    }
+  }
+
+  // All the code blocks of the batch share the temporal buffer of the worker
+  uint8_t* message[SRSRAN_LDPC_DECODER_MAX_BATCH];
+  for (uint32_t i = 0; i < batch->count; i++) {
+    message[i] = &temp_cb[i * SRSRAN_LDPC_MAX_LEN_CB];
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  int n = srsran_ldpc_decoder_decode_batch_c(decoder, batch->llr, message, batch->n_llr, crc, batch->ret, batch->count);
+  if (n < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    batch->status = SRSRAN_ERROR;
+    return;
+  }
+
+  for (uint32_t i = 0; i < batch->count; i++) {
+    const srsran_sch_nr_tb_info_t* cfg = &batch->tb[i]->cfg;
+    srsran_softbuffer_rx_t*        sb  = batch->tb[i]->rx->tb->softbuffer.rx;
+    uint32_t                       r   = batch->cb_idx[i];
+
+    // Check if CB is all zeros
+    uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+    sb->cb_crc[r] = (batch->ret[i] != 0);
+
+    // CB Debug trace
+    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+      DEBUG("CB %d/%d:", r, cfg->C);
+      srsran_vec_fprint_hex(stdout, message[i], cb_len);
+    }
+
+    // Pack only if CRC is match
+    if (sb->cb_crc[r]) {
+      srsran_bit_pack_vector(message[i], sb->data[r], cb_len);
+    }
+  }
+
+  batch->status = SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Decodes all the pending batches, across the FEC threads if they are enabled, and updates the state of their
+ * transport blocks
+ */
+static int sch_nr_decode_pending(srsran_sch_nr_t* q, sch_nr_cb_batch_t* pending)
+{
+  sch_nr_decode_job_t job   = {};
+  uint32_t            count = 0;
+  job.q                     = q;
+  for (uint32_t i = 0; i < SCH_NR_MAX_PENDING_BATCH; i++) {
+    if (pending[i].count > 0) {
+      job.batch[count++] = &pending[i];
+    }
+  }
+
+  if (count == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (srsran_fec_pool_run(&q->fec_pool, sch_nr_decode_cb_batch, &job, count) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t b = 0; b < count; b++) {
+    sch_nr_cb_batch_t* batch = job.batch[b];
+    if (batch->status < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t i = 0; i < batch->count; i++) {
+      sch_nr_rx_tb_state_t*          state = batch->tb[i];
+      const srsran_sch_nr_tb_info_t* cfg   = &state->cfg;
+      uint32_t                       r     = batch->cb_idx[i];
+      int                            ret   = batch->ret[i];
+      bool                           crc   = state->rx->tb->softbuffer.rx->cb_crc[r];
+
+      // Compute number of iterations
+      uint32_t n_iter_cb = (ret == 0) ? batch->decoder->max_nof_iter : (uint32_t)ret;
+      state->nof_iter_sum += n_iter_cb;
+
+      SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, n_iter_cb, crc ? "OK" : "KO");
+
+      // Count CRC OK
+      if (crc) {
+        state->cb_ok++;
+      }
+    }
+
+    batch->count   = 0;
+    batch->decoder = NULL;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int sch_nr_enqueue_cb(srsran_sch_nr_t*       q,
+                             sch_nr_cb_batch_t*     pending,
+                             srsran_ldpc_decoder_t* decoder,
+                             sch_nr_rx_tb_state_t*  state,
+                             uint32_t               r,
+                             const int8_t*          llr,
+                             uint32_t               n_llr,
+                             srsran_crc_t*          crc)
+{
+  // Select a batch of the same decoder with room left, otherwise an empty one
+  sch_nr_cb_batch_t* batch = NULL;
+  for (uint32_t i = 0; i < SCH_NR_MAX_PENDING_BATCH && batch == NULL; i++) {
+    if (pending[i].count > 0 && pending[i].decoder == decoder && pending[i].count < decoder->batch_max_nof_cb) {
+      batch = &pending[i];
+    }
+  }
+  for (uint32_t i = 0; i < SCH_NR_MAX_PENDING_BATCH && batch == NULL; i++) {
+    if (pending[i].count == 0) {
+      batch = &pending[i];
+    }
+  }
+
+  // All batches are in use, make room by decoding them
+  if (batch == NULL) {
+    if (sch_nr_decode_pending(q, pending) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    batch = &pending[0];
+  }
+
+  batch->decoder              = decoder;
+  batch->tb[batch->count]     = state;
+  batch->cb_idx[batch->count] = r;
+  batch->llr[batch->count]    = llr;
+  batch->n_llr[batch->count]  = n_llr;
+  batch->crc[batch->count]    = crc;
+  batch->count++;
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Rate dematches all the code blocks of a transport block and queues them for decoding
+ */
+static int sch_nr_decode_prepare(srsran_sch_nr_t* q, sch_nr_cb_batch_t* pending, sch_nr_rx_tb_state_t* state)
 {
+  const srsran_sch_cfg_t* sch_cfg = state->rx->sch_cfg;
+  const srsran_sch_tb_t*  tb      = state->rx->tb;
+  int8_t*                 e_bits  = state->rx->e_bits;
+  srsran_sch_tb_res_nr_t* res     = state->rx->res;
+
   // Pointer protection
   if (!q || !sch_cfg || !tb || !e_bits || !res) {
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -574,42 +898,42 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
-  int8_t*  input_ptr    = e_bits;
-  uint32_t nof_iter_sum = 0;
+  int8_t* input_ptr = e_bits;
 
-  srsran_sch_nr_tb_info_t cfg = {};
-  if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, &cfg) < SRSRAN_SUCCESS) {
+  srsran_sch_nr_tb_info_t* cfg = &state->cfg;
+  if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Select encoder and CRC
-  srsran_ldpc_decoder_t* decoder = (cfg.bg == BG1) ? q->decoder_bg1[cfg.Z] : q->decoder_bg2[cfg.Z];
-  srsran_crc_t*          crc_tb  = (cfg.L_tb == 24) ? &q->crc_tb_24 : &q->crc_tb_16;
+  srsran_ldpc_decoder_t* decoder = (cfg->bg == BG1) ? q->decoder_bg1[cfg->Z] : q->decoder_bg2[cfg->Z];
+  state->crc_tb                  = (cfg->L_tb == 24) ? &q->crc_tb_24 : &q->crc_tb_16;
 
   // Check decoder
   if (decoder == NULL) {
-    ERROR("Error: decoder for lifting size Z=%d not found", cfg.Z);
+    ERROR("Error: decoder for lifting size Z=%d not found", cfg->Z);
     return SRSRAN_ERROR;
   }
 
   // Check CRC for TB
-  if (crc_tb == NULL) {
+  if (state->crc_tb == NULL) {
     ERROR("Error: CRC for TB not found");
     return SRSRAN_ERROR;
   }
 
   // Soft-buffer number of code-block protection
-  if (tb->softbuffer.rx->max_cb < cfg.Cp || tb->softbuffer.rx->max_cb_size < (decoder->liftN - 2 * cfg.Z)) {
+  if (tb->softbuffer.rx->max_cb < cfg->Cp || tb->softbuffer.rx->max_cb_size < (decoder->liftN - 2 * cfg->Z)) {
     return SRSRAN_ERROR;
   }
 
   // Counter of code blocks that have matched CRC
-  uint32_t cb_ok = 0;
-  res->crc       = false;
+  state->cb_ok        = 0;
+  state->nof_iter_sum = 0;
+  res->crc            = false;
 
   // For each code block...
   uint32_t j = 0;
-  for (uint32_t r = 0; r < cfg.C; r++) {
+  for (uint32_t r = 0; r < cfg->C; r++) {
     bool    decoded   = tb->softbuffer.rx->cb_crc[r];
     int8_t* rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
     if (!rm_buffer) {
@@ -618,22 +942,22 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     }
 
     // Skip CB if mask indicates no transmission of the CB
-    if (!cfg.mask[r]) {
+    if (!cfg->mask[r]) {
       if (decoded) {
-        cb_ok++;
+        state->cb_ok++;
       }
       SCH_INFO_RX("RM CB %d: Disabled, CRC %s ... Skipping", r, decoded ? "OK" : "KO");
       continue;
     }
 
     // Select rate matching output sequence number of bits
-    uint32_t E = sch_nr_get_E(&cfg, j);
+    uint32_t E = sch_nr_get_E(cfg, j);
     j++;
 
     // Skip CB if it has a matched CRC
     if (decoded) {
       SCH_INFO_RX("RM CB %d: CRC OK ... Skipping", r);
-      cb_ok++;
+      state->cb_ok++;
       continue;
     }
 
@@ -641,80 +965,67 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
                 r,
                 E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
+                cfg->F,
+                cfg->bg == BG1 ? 1 : 2,
+                cfg->Z,
                 tb->rv,
-                cfg.Qm,
-                cfg.Nref);
+                cfg->Qm,
+                cfg->Nref);
     int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
+        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
     if (n_llr < SRSRAN_SUCCESS) {
       ERROR("Error in LDPC rate mateching");
       return SRSRAN_ERROR;
     }
 
     // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
+    srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+    if (cfg->L_cb) {
       crc = &q->crc_cb;
     }
 
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
+    // Queue the CB, it is decoded together with other CB sharing the same LDPC decoder
+    if (sch_nr_enqueue_cb(q, pending, decoder, state, r, rm_buffer, (uint32_t)n_llr, crc) < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
 
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
-    nof_iter_sum += n_iter_cb;
-
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
-
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
-    }
-
-    // Pack and count CRC OK only if CRC is match
-    if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
-      cb_ok++;
-    }
-
     input_ptr += E;
   }
-  // Set average number of iterations
-  res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Assembles the transport block from its decoded code blocks and checks the transport block CRC
+ */
+static int sch_nr_decode_finish(sch_nr_rx_tb_state_t* state)
+{
+  const srsran_sch_nr_tb_info_t* cfg    = &state->cfg;
+  const srsran_sch_tb_t*         tb     = state->rx->tb;
+  srsran_sch_tb_res_nr_t*        res    = state->rx->res;
+  srsran_crc_t*                  crc_tb = state->crc_tb;
 
   // Set average number of iterations
-  if (cfg.C > 0) {
-    res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
+  if (cfg->C > 0) {
+    res->avg_iter = (float)state->nof_iter_sum / (float)cfg->C;
   } else {
     res->avg_iter = NAN;
   }
 
   // Not all CB are decoded, skip TB union and CRC check
-  if (cb_ok != cfg.C) {
+  if (state->cb_ok != cfg->C) {
     return SRSRAN_SUCCESS;
   }
 
   uint32_t checksum2  = 0;
   uint8_t* output_ptr = res->payload;
 
-  for (uint32_t r = 0; r < cfg.C; r++) {
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
+  for (uint32_t r = 0; r < cfg->C; r++) {
+    uint32_t cb_len = cfg->Kp - cfg->L_cb;
 
     // Subtract TB CRC from the last code block
-    if (r == cfg.C - 1) {
-      cb_len -= cfg.L_tb;
+    if (r == cfg->C - 1) {
+      cb_len -= cfg->L_tb;
     }
 
     // Append CB
@@ -722,16 +1033,16 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     output_ptr += cb_len / 8;
 
     // Compute TB CRC for last block
-    if (cfg.C > 1 && r == cfg.C - 1) {
+    if (cfg->C > 1 && r == cfg->C - 1) {
       uint8_t  tb_crc_unpacked[24] = {};
       uint8_t* tb_crc_unpacked_ptr = tb_crc_unpacked;
-      srsran_bit_unpack_vector(&tb->softbuffer.rx->data[r][cb_len / 8], tb_crc_unpacked, cfg.L_tb);
-      checksum2 = srsran_bit_pack(&tb_crc_unpacked_ptr, cfg.L_tb);
+      srsran_bit_unpack_vector(&tb->softbuffer.rx->data[r][cb_len / 8], tb_crc_unpacked, cfg->L_tb);
+      checksum2 = srsran_bit_pack(&tb_crc_unpacked_ptr, cfg->L_tb);
     }
   }
 
   // Calculate TB CRC from packed data
-  if (cfg.C == 1) {
+  if (cfg->C == 1) {
     SCH_INFO_RX("TB: TBS=%d; CRC=%s", tb->tbs, tb->softbuffer.rx->cb_crc[0] ? "OK" : "KO");
     res->crc = true;
   } else {
@@ -749,6 +1060,59 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
+static int sch_nr_decode_multi(srsran_sch_nr_t* q, srsran_sch_nr_rx_tb_t* tbs, uint32_t nof_tb)
+{
+  if (!q || !tbs) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  sch_nr_rx_tb_state_t state[SRSRAN_SCH_NR_MAX_NOF_TB_BATCH];
+
+  for (uint32_t tb_offset = 0; tb_offset < nof_tb; tb_offset += SRSRAN_SCH_NR_MAX_NOF_TB_BATCH) {
+    uint32_t nof_tb_step = SRSRAN_MIN(nof_tb - tb_offset, SRSRAN_SCH_NR_MAX_NOF_TB_BATCH);
+
+    // Batches of code blocks waiting to be decoded
+    sch_nr_cb_batch_t pending[SCH_NR_MAX_PENDING_BATCH] = {};
+
+    // Rate dematch all code blocks, they are decoded once all batches are in use
+    for (uint32_t i = 0; i < nof_tb_step; i++) {
+      state[i].rx = &tbs[tb_offset + i];
+      int ret     = sch_nr_decode_prepare(q, pending, &state[i]);
+      if (ret < SRSRAN_SUCCESS) {
+        return ret;
+      }
+    }
+
+    // Decode the code blocks left in the pending batches
+    if (sch_nr_decode_pending(q, pending) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t i = 0; i < nof_tb_step; i++) {
+      if (sch_nr_decode_finish(&state[i]) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int sch_nr_decode(srsran_sch_nr_t*        q,
+                         const srsran_sch_cfg_t* sch_cfg,
+                         const srsran_sch_tb_t*  tb,
+                         int8_t*                 e_bits,
+                         srsran_sch_tb_res_nr_t* res)
+{
+  srsran_sch_nr_rx_tb_t rx = {};
+  rx.sch_cfg               = sch_cfg;
+  rx.tb                    = tb;
+  rx.e_bits                = e_bits;
+  rx.res                   = res;
+
+  return sch_nr_decode_multi(q, &rx, 1);
+}
+
 int srsran_dlsch_nr_encode(srsran_sch_nr_t*        q,
                            const srsran_sch_cfg_t* pdsch_cfg,
                            const srsran_sch_tb_t*  tb,
@@ -776,6 +1140,11 @@ int srsran_ulsch_nr_encode(srsran_sch_nr_t*        q,
   return sch_nr_encode(q, pdsch_cfg, tb, data, e_bits);
 }
 
+int srsran_sch_nr_decode_multi(srsran_sch_nr_t* q, srsran_sch_nr_rx_tb_t* tbs, uint32_t nof_tb)
+{
+  return sch_nr_decode_multi(q, tbs, nof_tb);
+}
+
 int srsran_ulsch_nr_decode(srsran_sch_nr_t*        q,
                            const srsran_sch_cfg_t* sch_cfg,
                            const srsran_sch_tb_t*  tb,
@@ -0,0 +1,195 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * \file prach_benchmark.c
+ * \brief Execution time benchmark for LTE PRACH detection.
+ *
+ * Every run transmits one of the 64 preambles, in turn, through an AWGN channel and measures the time spent by
+ * srsran_prach_detect_offset(). The average and worst case detection times are reported along with the number of
+ * searched root sequences, which is the number of correlations transformed by the batched IFFT.
+ *
+ * The simulation setup can be controlled by means of the following arguments.
+ *   - <tt>-N num</tt>: sets the number of runs to \c num.
+ *   - <tt>-n num</tt>: sets the total number of UL PRBs to \c num.
+ *   - <tt>-f num</tt>: sets the PRACH configuration index to \c num.
+ *   - <tt>-z num</tt>: sets the zero correlation zone configuration to \c num.
+ *   - <tt>-H</tt>: uses the restricted set of a high speed cell.
+ *   - <tt>-s val</tt>: sets the SNR to \c val dB.
+ *   - <tt>-v</tt>: prints the metrics of every preamble in the last run.
+ *
+ * Example:
+ * \code{.cpp}
+ * prach_benchmark -n 100 -z 1 -H
+ * \endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#define MAX_LEN 70176
+
+static uint32_t nof_prb         = 100;
+static uint32_t config_idx      = 3;
+static uint32_t zero_corr_zone  = 1;
+static bool     high_speed_flag = false;
+static int      nof_runs        = 1000;
+static float    snr_dB          = 10.0F;
+static bool     is_verbose      = false;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-N Number of runs [Default %d]\n", nof_runs);
+  printf("\t-n Uplink number of PRB [Default %d]\n", nof_prb);
+  printf("\t-f PRACH configuration index [Default %d]\n", config_idx);
+  printf("\t-z Zero correlation zone config [Default %d]\n", zero_corr_zone);
+  printf("\t-H Use the restricted set of a high speed cell [Default %s]\n", high_speed_flag ? "true" : "false");
+  printf("\t-s SNR in dB [Default %.2f]\n", snr_dB);
+  printf("\t-v Print the metrics of every preamble in the last run [Default %s]\n", is_verbose ? "true" : "false");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "N:n:f:z:Hs:v")) != -1) {
+    switch (opt) {
+      case 'N':
+        nof_runs = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'f':
+        config_idx = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'z':
+        zero_corr_zone = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'H':
+        high_speed_flag = true;
+        break;
+      case 's':
+        snr_dB = strtof(optarg, NULL);
+        break;
+      case 'v':
+        is_verbose = true;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran_prach_t     prach;
+  srsran_prach_cfg_t prach_cfg;
+  ZERO_OBJECT(prach_cfg);
+  prach_cfg.config_idx     = config_idx;
+  prach_cfg.hs_flag        = high_speed_flag;
+  prach_cfg.root_seq_idx   = 0;
+  prach_cfg.zero_corr_zone = zero_corr_zone;
+
+  if (srsran_prach_init(&prach, srsran_symbol_sz(nof_prb))) {
+    ERROR("Initializing PRACH");
+    return SRSRAN_ERROR;
+  }
+  if (srsran_prach_set_cfg(&prach, &prach_cfg, nof_prb)) {
+    ERROR("Error initiating PRACH object");
+    srsran_prach_free(&prach);
+    return SRSRAN_ERROR;
+  }
+
+  static cf_t preamble[MAX_LEN];
+  static cf_t signal[MAX_LEN];
+  uint32_t    indices[64]     = {};
+  float       t_offsets[64]   = {};
+  float       peak_to_avg[64] = {};
+  uint32_t    n_indices       = 0;
+  uint32_t    nof_detected    = 0;
+  uint32_t    nof_false       = 0;
+  uint64_t    total_us        = 0;
+  uint64_t    max_us          = 0;
+  float       noise_var       = srsran_convert_dB_to_power(-snr_dB);
+
+  for (int i_run = 0; i_run < nof_runs; i_run++) {
+    uint32_t seq_index = (uint32_t)i_run % 64;
+    srsran_vec_cf_zero(preamble, MAX_LEN);
+    srsran_prach_gen(&prach, seq_index, 0, preamble);
+
+    // Normalise the preamble power and add noise
+    uint32_t prach_len = prach.N_seq;
+    srsran_vec_sc_prod_cfc(preamble, 1.0F / sqrtf(srsran_vec_avg_power_cf(preamble, prach_len)), signal, MAX_LEN);
+    srsran_ch_awgn_c(signal, signal, noise_var, MAX_LEN);
+
+    struct timeval t[3] = {};
+    gettimeofday(&t[1], NULL);
+    srsran_prach_detect_offset(&prach, 0, &signal[prach.N_cp], prach_len, indices, t_offsets, peak_to_avg, &n_indices);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    uint64_t elapsed_us = t[0].tv_usec + t[0].tv_sec * 1000000UL;
+    total_us += elapsed_us;
+    max_us = SRSRAN_MAX(max_us, elapsed_us);
+
+    for (uint32_t i = 0; i < n_indices; i++) {
+      if (indices[i] == seq_index) {
+        nof_detected++;
+      } else {
+        nof_false++;
+      }
+    }
+  }
+
+  printf("PRACH config_idx=%d, %d PRB, N_cs=%d, %s set, %d roots searched\n",
+         config_idx,
+         nof_prb,
+         prach.N_cs,
+         high_speed_flag ? "restricted" : "unrestricted",
+         prach.num_ra_preambles);
+  printf("Detection time: average %.1f us, worst %ld us\n", (double)total_us / nof_runs, (long)max_us);
+  printf("Detected %d out of %d preambles, %d false detections\n", nof_detected, nof_runs, nof_false);
+
+  if (is_verbose) {
+    const srsran_prach_preamble_metrics_t* metrics = srsran_prach_get_preamble_metrics(&prach);
+    for (uint32_t i = 0; i < 64; i++) {
+      printf("  preamble=%2d; peak2avg=%6.1f; offset=%5.1f us; detected=%s\n",
+             i,
+             metrics[i].peak_to_avg,
+             metrics[i].t_offset * 1e6,
+             metrics[i].detected ? "yes" : "no");
+    }
+  }
+
+  srsran_prach_free(&prach);
+
+  return SRSRAN_SUCCESS;
+}
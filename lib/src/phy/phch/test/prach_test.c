@@ -38,6 +38,7 @@ static uint32_t config_idx       = 3;
 static uint32_t root_seq_idx     = 0;
 static uint32_t zero_corr_zone   = 15;
 static uint32_t num_ra_preambles = 0; // use default
+static bool     high_speed_flag  = false;
 
 static void usage(char* prog)
 {
@@ -47,12 +48,13 @@ static void usage(char* prog)
   printf("\t-r Root sequence index [Default 0]\n");
   printf("\t-z Zero correlation zone config [Default 1]\n");
   printf("\t-N Toggle LTE/NR operation, zero for LTE, non-zero for NR [Default %s]\n", is_nr ? "NR" : "LTE");
+  printf("\t-H Use the restricted set of a high speed cell [Default %s]\n", high_speed_flag ? "true" : "false");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nfrzN")) != -1) {
+  while ((opt = getopt(argc, argv, "nfrzNH")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -69,6 +71,9 @@ static void parse_args(int argc, char** argv)
       case 'N':
         is_nr = (uint32_t)strtol(argv[optind], NULL, 10) > 0;
         break;
+      case 'H':
+        high_speed_flag = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -81,8 +86,6 @@ int main(int argc, char** argv)
   parse_args(argc, argv);
   srsran_prach_t prach;
 
-  bool high_speed_flag = false;
-
   cf_t preamble[MAX_LEN];
   memset(preamble, 0, sizeof(cf_t) * MAX_LEN);
 
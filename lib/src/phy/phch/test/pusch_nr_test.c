@@ -95,6 +95,7 @@ int main(int argc, char** argv)
   srsran_pusch_data_nr_t data_tx                          = {};
   srsran_pusch_res_nr_t  data_rx                          = {};
   cf_t*                  sf_symbols[SRSRAN_MAX_LAYERS_NR] = {};
+  int8_t*                ulsch_llr                        = NULL;
 
   // Set default PUSCH configuration
   pusch_cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
@@ -159,6 +160,12 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  ulsch_llr = srsran_vec_i8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+  if (ulsch_llr == NULL) {
+    ERROR("Error malloc");
+    goto clean_exit;
+  }
+
   // Use grant default A time resources with m=0
   if (srsran_ra_ul_nr_pusch_time_resource_default_A(carrier.scs, 0, &pusch_cfg.grant) < SRSRAN_SUCCESS) {
     ERROR("Error loading default grant");
@@ -369,6 +376,29 @@ int main(int argc, char** argv)
         }
       }
 
+      // Demodulate and decode the UL-SCH apart, as the gNb does for all the PUSCH of a slot
+      srsran_softbuffer_rx_reset(&softbuffer_rx);
+      srsran_vec_u8_zero(data_rx.tb[0].payload, pusch_cfg.grant.tb[0].tbs / 8);
+      data_rx.tb[0].crc = false;
+
+      srsran_sch_nr_rx_tb_t rx[SRSRAN_MAX_TB]         = {};
+      int8_t*               llr[SRSRAN_MAX_CODEWORDS] = {ulsch_llr};
+      int                   nof_rx =
+          srsran_pusch_nr_demodulate(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &chest, sf_symbols, llr, &data_rx, rx);
+      if (nof_rx != 1 || srsran_sch_nr_decode_multi(&pusch_rx.sch, rx, (uint32_t)nof_rx) < SRSRAN_SUCCESS) {
+        ERROR("Error demodulating PUSCH");
+        goto clean_exit;
+      }
+
+      if (!data_rx.tb[0].crc ||
+          memcmp(data_tx.payload[0], data_rx.tb[0].payload, pusch_cfg.grant.tb[0].tbs / 8) != 0) {
+        ERROR("Demodulated PUSCH failed to match Tx data; n_prb=%d; mcs=%d; TBS=%d;",
+              n_prb,
+              mcs,
+              pusch_cfg.grant.tb[0].tbs);
+        goto clean_exit;
+      }
+
       if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO) {
         char str[512];
         srsran_pusch_nr_rx_info(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &data_rx, str, (uint32_t)sizeof(str));
@@ -402,6 +432,9 @@ clean_exit:
       free(sf_symbols[i]);
     }
   }
+  if (ulsch_llr) {
+    free(ulsch_llr);
+  }
   srsran_softbuffer_tx_free(&softbuffer_tx);
   srsran_softbuffer_rx_free(&softbuffer_rx);
 
@@ -56,6 +56,8 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+uint32_t     fec_threads   = 0;
+bool         harq_retx     = false;
 
 void usage(char* prog)
 {
@@ -83,6 +85,9 @@ void usage(char* prog)
 
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
+  printf("\t\t-p fec_threads number of FEC threads decoding in parallel [Default %d]\n", fec_threads);
+  printf("\t\t-p harq_retx decode again as a retransmission whose even CBs had CRC OK [Default %s]\n",
+         harq_retx ? "enabled" : "disabled");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
@@ -126,6 +131,10 @@ void parse_extensive_param(char* param, char* arg)
     uci_data_tx.cfg.ack[0].nof_acks = SRSRAN_MIN((uint32_t)strtol(arg, NULL, 10), SRSRAN_UCI_MAX_ACK_BITS);
   } else if (!strcmp(param, "enable_64qam")) {
     enable_64_qam ^= true;
+  } else if (!strcmp(param, "fec_threads")) {
+    fec_threads = (uint32_t)strtol(arg, NULL, 10);
+  } else if (!strcmp(param, "harq_retx")) {
+    harq_retx ^= true;
   } else {
     ext_code = SRSRAN_ERROR;
   }
@@ -243,6 +252,10 @@ int main(int argc, char** argv)
     ERROR("Error creating PUSCH object");
     goto quit;
   }
+  if (srsran_sch_set_fec_threads(&pusch_rx.ul_sch, fec_threads, -1)) {
+    ERROR("Error creating FEC threads");
+    goto quit;
+  }
 
   uint16_t rnti = 62;
   dci.rnti      = rnti;
@@ -343,6 +356,35 @@ int main(int argc, char** argv)
       INFO("Rx Data is Ok");
     }
 
+    if (harq_retx) {
+      // Decode again as a retransmission: the even CBs passed the CRC before and are restored from the softbuffer,
+      // the odd ones are decoded next to them. The restored CBs are taken from the first decoding, which also holds
+      // the TB CRC
+      srsran_cbsegm_t cb_segm = {};
+      if (srsran_cbsegm(&cb_segm, cfg.grant.tb.tbs)) {
+        ERROR("Error computing CB segmentation");
+        exit(-1);
+      }
+      srsran_softbuffer_rx_reset(&softbuffer_rx);
+      for (uint32_t i = 0; i < cb_segm.C; i += 2) {
+        uint32_t cb_len = i < cb_segm.C1 ? cb_segm.K1 : cb_segm.K2;
+        uint32_t rlen   = cb_segm.C == 1 ? cb_len : (cb_len - 24);
+        memcpy(softbuffer_rx.data[i], &data_rx[i * rlen / 8], rlen / 8);
+        softbuffer_rx.cb_crc[i] = true;
+      }
+      memset(data_rx, 0, (size_t)cfg.grant.tb.tbs / 8);
+      memcpy(&cfg.uci_cfg, &uci_data_tx.cfg, sizeof(srsran_uci_cfg_t));
+
+      if (srsran_pusch_decode(&pusch_rx, &ul_sf, &cfg, &chest_res, sf_symbols, &pusch_res)) {
+        printf("Error returned while decoding the retransmission\n");
+        ret = SRSRAN_ERROR;
+      }
+      if (!pusch_res.crc || memcmp(data_rx, data, (size_t)cfg.grant.tb.tbs / 8) != 0) {
+        printf("Unmatched data detected in the retransmission (%d CBs)\n", cb_segm.C);
+        ret = SRSRAN_ERROR;
+      }
+    }
+
     if (uci_data_tx.cfg.ack[0].nof_acks) {
       if (!pusch_res.uci.ack.valid) {
         printf("Invalid UCI ACK bit\n");
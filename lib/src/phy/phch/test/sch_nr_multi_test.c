@@ -0,0 +1,246 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/phch/ra_dl_nr.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include "srsran/phy/phch/sch_nr.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <srsran/phy/utils/random.h>
+
+#define NOF_TB 24
+
+static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
+
+static uint32_t            n_prb           = 2; // Grant PRB, the same for all transport blocks
+static uint32_t            nof_fec_threads = 0; // Number of FEC threads decoding in parallel
+static srsran_sch_cfg_nr_t pdsch_cfg       = {};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [PpvF] \n", prog);
+  printf("\t-P Number of carrier PRB [Default %d]\n", carrier.nof_prb);
+  printf("\t-p Number of grant PRB [Default %d]\n", n_prb);
+  printf("\t-F Number of FEC threads [Default %d]\n", nof_fec_threads);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "PpvF")) != -1) {
+    switch (opt) {
+      case 'P':
+        carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'F':
+        nof_fec_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int             ret       = SRSRAN_ERROR;
+  srsran_sch_nr_t sch_nr_tx = {};
+  srsran_sch_nr_t sch_nr_rx = {};
+  srsran_random_t rand_gen  = srsran_random_init(1234);
+
+  srsran_softbuffer_tx_t softbuffer_tx             = {};
+  srsran_softbuffer_rx_t softbuffer_rx[NOF_TB]     = {};
+  srsran_sch_tb_t        tb[NOF_TB]                = {};
+  srsran_sch_tb_res_nr_t res[NOF_TB]               = {};
+  srsran_sch_nr_rx_tb_t  rx[NOF_TB]                = {};
+  uint8_t*               data_tx[NOF_TB]           = {};
+  uint8_t*               data_rx[NOF_TB]           = {};
+  int8_t*                llr[NOF_TB]               = {};
+  uint8_t*               encoded                   = srsran_vec_u8_malloc(1024 * 1024 * 8);
+  bool                   softbuffer_init[NOF_TB]   = {};
+  bool                   softbuffer_tx_initialised = false;
+
+  // Set default PDSCH configuration
+  pdsch_cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (encoded == NULL) {
+    goto clean_exit;
+  }
+
+  srsran_sch_nr_args_t args   = {};
+  args.disable_simd           = false;
+  args.decoder_use_flooded    = false;
+  args.decoder_scaling_factor = 0.8;
+  args.max_nof_iter           = 20;
+  args.nof_fec_threads        = nof_fec_threads;
+  args.fec_prio               = -1;
+  if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating SCH NR for Tx");
+    goto clean_exit;
+  }
+
+  if (srsran_sch_nr_init_rx(&sch_nr_rx, &args) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating SCH NR for Rx");
+    goto clean_exit;
+  }
+
+  if (srsran_sch_nr_set_carrier(&sch_nr_tx, &carrier)) {
+    ERROR("Error setting SCH NR carrier");
+    goto clean_exit;
+  }
+
+  if (srsran_sch_nr_set_carrier(&sch_nr_rx, &carrier)) {
+    ERROR("Error setting SCH NR carrier");
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_tx_init_guru(&softbuffer_tx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+      SRSRAN_SUCCESS) {
+    ERROR("Error init soft-buffer");
+    goto clean_exit;
+  }
+  softbuffer_tx_initialised = true;
+
+  // Use grant default A time resources with m=0
+  pdsch_cfg.grant.S                                = 1;
+  pdsch_cfg.grant.L                                = 13;
+  pdsch_cfg.grant.k                                = 0;
+  pdsch_cfg.grant.nof_layers                       = carrier.max_mimo_layers;
+  pdsch_cfg.grant.dci_format                       = srsran_dci_format_nr_1_0;
+  pdsch_cfg.grant.nof_dmrs_cdm_groups_without_data = 1;
+  for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
+    pdsch_cfg.grant.prb_idx[n] = (n < n_prb);
+  }
+
+  // Encode one transport block per emulated UE, a few different MCS lead to different lifting sizes
+  for (uint32_t i = 0; i < NOF_TB; i++) {
+    uint32_t mcs = (i * 3) % 10;
+
+    if (srsran_ra_nr_fill_tb(&pdsch_cfg, &pdsch_cfg.grant, mcs, &tb[i]) < SRSRAN_SUCCESS) {
+      ERROR("Error filing tb");
+      goto clean_exit;
+    }
+
+    data_tx[i] = srsran_vec_u8_malloc(tb[i].tbs / 8 + 1);
+    data_rx[i] = srsran_vec_u8_malloc(tb[i].tbs / 8 + 1);
+    llr[i]     = srsran_vec_i8_malloc(tb[i].nof_bits);
+    if (data_tx[i] == NULL || data_rx[i] == NULL || llr[i] == NULL) {
+      goto clean_exit;
+    }
+
+    if (srsran_softbuffer_rx_init_guru(
+            &softbuffer_rx[i], SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
+      ERROR("Error init soft-buffer");
+      goto clean_exit;
+    }
+    softbuffer_init[i] = true;
+
+    for (uint32_t j = 0; j < tb[i].tbs / 8; j++) {
+      data_tx[i][j] = (uint8_t)srsran_random_uniform_int_dist(rand_gen, 0, UINT8_MAX);
+    }
+
+    tb[i].softbuffer.tx = &softbuffer_tx;
+    if (srsran_dlsch_nr_encode(&sch_nr_tx, &pdsch_cfg.sch_cfg, &tb[i], data_tx[i], encoded) < SRSRAN_SUCCESS) {
+      ERROR("Error encoding");
+      goto clean_exit;
+    }
+
+    for (uint32_t j = 0; j < tb[i].nof_bits; j++) {
+      llr[i][j] = encoded[j] ? -10 : +10;
+    }
+
+    tb[i].softbuffer.rx = &softbuffer_rx[i];
+    srsran_softbuffer_rx_reset(tb[i].softbuffer.rx);
+
+    res[i].payload = data_rx[i];
+
+    rx[i].sch_cfg = &pdsch_cfg.sch_cfg;
+    rx[i].tb      = &tb[i];
+    rx[i].e_bits  = llr[i];
+    rx[i].res     = &res[i];
+  }
+
+  // Decode all transport blocks at once
+  if (srsran_sch_nr_decode_multi(&sch_nr_rx, rx, NOF_TB) < SRSRAN_SUCCESS) {
+    ERROR("Error decoding");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < NOF_TB; i++) {
+    if (!res[i].crc) {
+      ERROR("Failed to match CRC; tb=%d; TBS=%d;", i, tb[i].tbs);
+      goto clean_exit;
+    }
+
+    if (memcmp(data_tx[i], data_rx[i], tb[i].tbs / 8) != 0) {
+      ERROR("Failed to match Tx/Rx data; tb=%d; TBS=%d;", i, tb[i].tbs);
+      goto clean_exit;
+    }
+
+    INFO("tb=%d; TBS=%d; PASSED!\n", i, tb[i].tbs);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(rand_gen);
+  srsran_sch_nr_free(&sch_nr_tx);
+  srsran_sch_nr_free(&sch_nr_rx);
+  for (uint32_t i = 0; i < NOF_TB; i++) {
+    if (data_tx[i]) {
+      free(data_tx[i]);
+    }
+    if (data_rx[i]) {
+      free(data_rx[i]);
+    }
+    if (llr[i]) {
+      free(llr[i]);
+    }
+    if (softbuffer_init[i]) {
+      srsran_softbuffer_rx_free(&softbuffer_rx[i]);
+    }
+  }
+  if (encoded) {
+    free(encoded);
+  }
+  if (softbuffer_tx_initialised) {
+    srsran_softbuffer_tx_free(&softbuffer_tx);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+
+  return ret;
+}
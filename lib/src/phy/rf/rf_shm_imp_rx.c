@@ -0,0 +1,286 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int rf_shm_rx_open_fd(rf_shm_rx_t* q, int flags)
+{
+  return q->is_file ? open(q->path, flags) : shm_open(q->path, flags, 0);
+}
+
+static void rf_shm_rx_detach(rf_shm_rx_t* q)
+{
+  if (q->ring) {
+    rf_shm_info(q->id, "Detaching receiver: %s\n", q->path);
+    munmap(q->ring, q->map_size);
+    q->ring     = NULL;
+    q->samples  = NULL;
+    q->map_size = 0;
+  }
+}
+
+/*
+ * Attaches to the segment created by the transmitter. Returns SRSRAN_ERROR_CANT_START if the transmitter has not
+ * created it yet, so that it is retried, and SRSRAN_ERROR if it can not be used
+ */
+static int rf_shm_rx_attach(rf_shm_rx_t* q)
+{
+  int         ret = SRSRAN_ERROR_CANT_START;
+  struct stat st  = {};
+
+  int fd = rf_shm_rx_open_fd(q, O_RDWR);
+  if (fd < 0) {
+    return ret;
+  }
+
+  // The transmitter may not have sized the segment yet
+  if (fstat(fd, &st) < 0 || st.st_size < SHM_RING_HEADER_SIZE) {
+    goto clean_exit;
+  }
+
+  void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+  if (ptr == MAP_FAILED) {
+    goto clean_exit;
+  }
+
+  rf_shm_ring_t* ring = (rf_shm_ring_t*)ptr;
+  if (__atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC) {
+    munmap(ptr, (size_t)st.st_size);
+    goto clean_exit;
+  }
+
+  if (ring->sample_format != (uint32_t)q->sample_format) {
+    fprintf(stderr,
+            "[shm] Error: receiver %s expects %s samples but the transmitter writes %s\n",
+            q->path,
+            q->sample_format == SHM_TYPE_SC16 ? "sc16" : "fc32",
+            ring->sample_format == SHM_TYPE_SC16 ? "sc16" : "fc32");
+    munmap(ptr, (size_t)st.st_size);
+    ret = SRSRAN_ERROR;
+    goto clean_exit;
+  }
+
+  rf_shm_info(q->id, "Attached receiver: %s (%" PRIu64 " samples)\n", q->path, ring->capacity);
+
+  q->ring     = ring;
+  q->samples  = (uint8_t*)ptr + SHM_RING_HEADER_SIZE;
+  q->map_size = (size_t)st.st_size;
+  q->inode    = st.st_ino;
+  ret         = SRSRAN_SUCCESS;
+
+clean_exit:
+  close(fd);
+  return ret;
+}
+
+// A transmitter that crashed does not set the closed flag, the segment is stale if it was replaced or removed
+static bool rf_shm_rx_is_stale(rf_shm_rx_t* q)
+{
+  struct stat st = {};
+  int         fd = rf_shm_rx_open_fd(q, O_RDONLY);
+  if (fd < 0) {
+    return true;
+  }
+  bool ret = (fstat(fd, &st) < 0 || st.st_ino != q->inode);
+  close(fd);
+  return ret;
+}
+
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* port)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_rx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    q->sample_format      = opts.sample_format;
+    q->frequency_mhz      = opts.frequency_mhz;
+    q->fail_on_disconnect = opts.fail_on_disconnect;
+    q->sample_offset      = opts.sample_offset;
+    q->trx_timeout_ms     = opts.trx_timeout_ms;
+    q->log_trx_timeout    = opts.log_trx_timeout;
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    if (rf_shm_get_path(port, opts.dir, q->path, &q->is_file)) {
+      fprintf(stderr, "[shm] Error: invalid receiver port %s\n", port);
+      goto clean_exit;
+    }
+
+    rf_shm_info(q->id, "Connecting receiver: %s\n", q->path);
+
+    // The transmitter may be started later, in that case the receiver attaches on the first reception
+    if (rf_shm_rx_attach(q) == SRSRAN_ERROR) {
+      goto clean_exit;
+    }
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+static void rf_shm_rx_read(rf_shm_rx_t* q, uint64_t idx, cf_t* buffer, uint32_t nsamples)
+{
+  uint8_t* src = q->samples + idx * q->ring->sample_sz;
+
+  if (q->sample_format == SHM_TYPE_SC16) {
+    srsran_vec_convert_if((int16_t*)src, INT16_MAX, (float*)buffer, 2 * nsamples);
+  } else {
+    memcpy(buffer, src, NSAMPLES2NBYTES(nsamples));
+  }
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  int      ret       = SRSRAN_ERROR_TIMEOUT;
+  uint32_t count     = 0;
+  uint32_t nof_waits = 0;
+  uint64_t t_start   = rf_shm_now_ms();
+
+  pthread_mutex_lock(&q->mutex);
+
+  // If the read needs to be delayed
+  if (q->sample_offset > 0) {
+    count = SRSRAN_MIN((uint32_t)q->sample_offset, nsamples);
+    srsran_vec_cf_zero(buffer, count);
+    q->sample_offset -= (int32_t)count;
+  }
+
+  while (count < nsamples && rf_shm_rx_is_running(q)) {
+    // Attach to the transmitter segment
+    if (q->ring == NULL) {
+      int attach_ret = rf_shm_rx_attach(q);
+      if (attach_ret == SRSRAN_ERROR) {
+        ret = SRSRAN_ERROR;
+        break;
+      }
+      if (attach_ret != SRSRAN_SUCCESS) {
+        if (rf_shm_now_ms() - t_start >= q->trx_timeout_ms) {
+          break;
+        }
+        rf_shm_backoff(nof_waits++);
+        continue;
+      }
+    }
+
+    rf_shm_ring_t* ring       = q->ring;
+    uint64_t       read_count = ring->read_count;
+    uint64_t       available  = __atomic_load_n(&ring->write_count, __ATOMIC_ACQUIRE) - read_count;
+
+    // The ring is empty, wait for the transmitter
+    if (available == 0) {
+      if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE)) {
+        // The transmitter was closed and its last samples were read
+        rf_shm_rx_detach(q);
+      } else if (rf_shm_now_ms() - t_start >= q->trx_timeout_ms) {
+        if (rf_shm_rx_is_stale(q)) {
+          rf_shm_rx_detach(q);
+        }
+        break;
+      } else {
+        rf_shm_backoff(nof_waits++);
+      }
+      continue;
+    }
+    nof_waits = 0;
+
+    // If the read needs to be advanced, drop samples
+    if (q->sample_offset < 0) {
+      uint32_t n = (uint32_t)SRSRAN_MIN(available, (uint64_t)-q->sample_offset);
+      q->sample_offset += (int32_t)n;
+      __atomic_store_n(&ring->read_count, read_count + n, __ATOMIC_RELEASE);
+      continue;
+    }
+
+    // Read as many samples as available, in two parts if the ring wraps around
+    uint32_t n     = (uint32_t)SRSRAN_MIN(available, nsamples - count);
+    uint64_t idx   = read_count % ring->capacity;
+    uint32_t first = (uint32_t)SRSRAN_MIN(n, ring->capacity - idx);
+    rf_shm_rx_read(q, idx, &buffer[count], first);
+    if (n > first) {
+      rf_shm_rx_read(q, 0, &buffer[count + first], n - first);
+    }
+    count += n;
+    __atomic_store_n(&ring->read_count, read_count + n, __ATOMIC_RELEASE);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  // Nothing received before the timeout, the caller decides whether to keep waiting
+  if (count == 0 && nsamples > 0 && rf_shm_rx_is_running(q)) {
+    return ret;
+  }
+
+  rf_shm_info(q->id, "   - received %d baseband samples\n", count);
+
+  return (int)count;
+}
+
+bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  rf_shm_info(q->id, "Closing ...\n");
+
+  __atomic_store_n(&q->running, false, __ATOMIC_RELEASE);
+
+  pthread_mutex_lock(&q->mutex);
+  rf_shm_rx_detach(q);
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+}
+
+bool rf_shm_rx_is_running(rf_shm_rx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return __atomic_load_n(&q->running, __ATOMIC_ACQUIRE);
+}
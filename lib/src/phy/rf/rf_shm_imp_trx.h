@@ -0,0 +1,165 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include <pthread.h>
+#include <srsran/config.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+/* Definitions */
+#define VERBOSE (0)
+#define SHM_PORT_PREFIX "shm://"
+#define SHM_NAME_PREFIX "/srsran_"
+#define SHM_RING_MAGIC (0x73524e47) // "sRNG"
+#define SHM_RING_HEADER_SIZE (4096) // Keeps the samples page aligned
+#define SHM_RING_ALIGN_SIZE (2 * 1024 * 1024) // Size granularity of the segments, valid for hugetlbfs too
+#define SHM_RING_DEFAULT_LEN_MS (20)
+#define SHM_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_ID_STRLEN 16
+#define SHM_PATH_STRLEN 256
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+#define NSAMPLES2NBYTES(X) (((uint32_t)(X)) * sizeof(cf_t))
+#define NBYTES2NSAMPLES(X) ((X) / sizeof(cf_t))
+
+typedef enum { SHM_TYPE_FC32 = 0, SHM_TYPE_SC16 } rf_shm_format_t;
+
+/*
+ * Header at the beginning of every shared memory segment, followed by the samples. The ring has a single producer,
+ * the transmitter that creates the segment, and a single consumer, the receiver that attaches to it. Each side only
+ * writes its own counter, so they synchronise with acquire/release atomics and no lock. The counters are the total
+ * number of samples written and read, and they are kept in separate cache lines
+ */
+typedef struct {
+  uint32_t magic;         ///< Written last by the transmitter, once the segment is initialised
+  uint32_t sample_format; ///< rf_shm_format_t of the samples in the ring
+  uint32_t sample_sz;     ///< Size of a sample in bytes
+  uint32_t closed;        ///< Set by the transmitter when it is closed
+  uint64_t capacity;      ///< Ring length in samples
+  uint8_t  reserved0[40];
+  uint64_t write_count; ///< Written by the transmitter only
+  uint8_t  reserved1[56];
+  uint64_t read_count; ///< Written by the receiver only
+  uint8_t  reserved2[56];
+} rf_shm_ring_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  char            path[SHM_PATH_STRLEN];
+  bool            is_file;
+  rf_shm_format_t sample_format;
+  rf_shm_ring_t*  ring;
+  uint8_t*        samples;
+  size_t          map_size;
+  uint64_t        nsamples;
+  bool            running;
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  int32_t         sample_offset;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+} rf_shm_tx_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  char            path[SHM_PATH_STRLEN];
+  bool            is_file;
+  rf_shm_format_t sample_format;
+  rf_shm_ring_t*  ring;
+  uint8_t*        samples;
+  size_t          map_size;
+  ino_t           inode;
+  bool            running;
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  bool            fail_on_disconnect;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+  int32_t         sample_offset;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char*     id;
+  const char*     dir;
+  rf_shm_format_t sample_format;
+  uint32_t        ring_len; ///< Ring length in samples, transmitter only
+  uint32_t        frequency_mhz;
+  bool            fail_on_disconnect;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+  int32_t         sample_offset; ///< offset in samples
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(char* id, const char* format, ...);
+
+/// Builds the path of the segment of a port: a POSIX shared memory name, or a file in dir (e.g. a hugetlbfs mount)
+SRSRAN_API int rf_shm_get_path(const char* port, const char* dir, char path[SHM_PATH_STRLEN], bool* is_file);
+
+/// Waits for the other end of a ring, yielding first and then sleeping for increasing intervals
+SRSRAN_API void rf_shm_backoff(uint32_t count);
+
+/// Milliseconds since an arbitrary point, for the timeouts
+SRSRAN_API uint64_t rf_shm_now_ms();
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, char* port);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* port);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
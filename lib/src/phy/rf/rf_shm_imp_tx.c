@@ -0,0 +1,286 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static void rf_shm_tx_unlink(rf_shm_tx_t* q)
+{
+  if (q->is_file) {
+    unlink(q->path);
+  } else {
+    shm_unlink(q->path);
+  }
+}
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, char* port)
+{
+  int ret = SRSRAN_ERROR;
+  int fd  = -1;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_tx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    q->sample_format   = opts.sample_format;
+    q->frequency_mhz   = opts.frequency_mhz;
+    q->sample_offset   = opts.sample_offset;
+    q->trx_timeout_ms  = opts.trx_timeout_ms;
+    q->log_trx_timeout = opts.log_trx_timeout;
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    if (rf_shm_get_path(port, opts.dir, q->path, &q->is_file)) {
+      fprintf(stderr, "[shm] Error: invalid transmitter port %s\n", port);
+      goto clean_exit;
+    }
+
+    // Round the segment size, so that it can be backed by huge pages, and use all of it for the ring
+    uint32_t sample_sz = (q->sample_format == SHM_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+    size_t   size      = SHM_RING_HEADER_SIZE + (size_t)opts.ring_len * sample_sz;
+    q->map_size        = SRSRAN_CEIL(size, SHM_RING_ALIGN_SIZE) * SHM_RING_ALIGN_SIZE;
+
+    rf_shm_info(q->id, "Creating transmitter: %s (%zu B)\n", q->path, q->map_size);
+
+    // A segment left by a previous instance may still be mapped by a receiver. Unlinking it lets the receiver detect
+    // the restart and attach to the new segment
+    rf_shm_tx_unlink(q);
+    if (q->is_file) {
+      fd = open(q->path, O_CREAT | O_EXCL | O_RDWR, 0666);
+    } else {
+      fd = shm_open(q->path, O_CREAT | O_EXCL | O_RDWR, 0666);
+    }
+    if (fd < 0) {
+      fprintf(stderr, "Error: creating transmitter segment (%s): %s\n", q->path, strerror(errno));
+      goto clean_exit;
+    }
+    if (ftruncate(fd, (off_t)q->map_size) < 0) {
+      fprintf(stderr, "Error: sizing transmitter segment (%s): %s\n", q->path, strerror(errno));
+      goto clean_exit;
+    }
+
+    // Populate the pages now, rather than faulting them in the real-time path
+    void* ptr = mmap(NULL, q->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      fprintf(stderr, "Error: mapping transmitter segment (%s): %s\n", q->path, strerror(errno));
+      q->map_size = 0;
+      goto clean_exit;
+    }
+    q->ring    = (rf_shm_ring_t*)ptr;
+    q->samples = (uint8_t*)ptr + SHM_RING_HEADER_SIZE;
+
+    q->ring->sample_format = (uint32_t)q->sample_format;
+    q->ring->sample_sz     = sample_sz;
+    q->ring->capacity      = (q->map_size - SHM_RING_HEADER_SIZE) / sample_sz;
+    q->ring->write_count   = 0;
+    q->ring->read_count    = 0;
+    q->ring->closed        = 0;
+
+    // Publish the segment, receivers ignore it until the magic word is set
+    __atomic_store_n(&q->ring->magic, SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (fd >= 0) {
+    close(fd);
+  }
+  return ret;
+}
+
+static void rf_shm_tx_write(rf_shm_tx_t* q, uint64_t idx, cf_t* buffer, uint32_t nsamples)
+{
+  uint8_t* dst = q->samples + idx * q->ring->sample_sz;
+
+  if (buffer == NULL) {
+    memset(dst, 0, (size_t)nsamples * q->ring->sample_sz);
+  } else if (q->sample_format == SHM_TYPE_SC16) {
+    srsran_vec_convert_fi((float*)buffer, INT16_MAX, (int16_t*)dst, 2 * nsamples);
+  } else {
+    memcpy(dst, buffer, NSAMPLES2NBYTES(nsamples));
+  }
+}
+
+// Writes samples into the ring, a NULL buffer writes zeros. It waits while the ring is full
+static int _rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  rf_shm_ring_t* ring        = q->ring;
+  uint64_t       write_count = ring->write_count;
+  uint32_t       count       = 0;
+  uint32_t       nof_waits   = 0;
+  uint64_t       t_wait      = 0;
+
+  while (count < nsamples && rf_shm_tx_is_running(q)) {
+    uint64_t space = ring->capacity - (write_count - __atomic_load_n(&ring->read_count, __ATOMIC_ACQUIRE));
+
+    // The ring is full, wait for the receiver
+    if (space == 0) {
+      if (nof_waits == 0) {
+        t_wait = rf_shm_now_ms();
+      } else if (rf_shm_now_ms() - t_wait > q->trx_timeout_ms) {
+        // Like a blocked request-reply transmitter, keep trying until the receiver comes back
+        if (q->log_trx_timeout) {
+          fprintf(stderr, "Error: timeout writing samples to %s after %dms\n", q->path, q->trx_timeout_ms);
+        }
+        t_wait = rf_shm_now_ms();
+      }
+      rf_shm_backoff(nof_waits++);
+      continue;
+    }
+    nof_waits = 0;
+
+    // Write as many samples as fit, in two parts if the ring wraps around
+    uint32_t n     = (uint32_t)SRSRAN_MIN(space, nsamples - count);
+    uint64_t idx   = write_count % ring->capacity;
+    uint32_t first = (uint32_t)SRSRAN_MIN(n, ring->capacity - idx);
+    rf_shm_tx_write(q, idx, buffer ? buffer + count : NULL, first);
+    if (n > first) {
+      rf_shm_tx_write(q, 0, buffer ? buffer + count + first : NULL, n - first);
+    }
+
+    write_count += n;
+    count += n;
+    __atomic_store_n(&ring->write_count, write_count, __ATOMIC_RELEASE);
+  }
+
+  rf_shm_info(q->id, " - sent %d samples\n", count);
+
+  // Increment sample counter
+  q->nsamples += count;
+
+  return (int)count;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  int64_t nsamples = (int64_t)ts - (int64_t)q->nsamples;
+
+  if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
+    _rf_shm_tx_baseband(q, NULL, (uint32_t)nsamples);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  int n;
+
+  pthread_mutex_lock(&q->mutex);
+
+  if (q->sample_offset > 0) {
+    _rf_shm_tx_baseband(q, NULL, (uint32_t)q->sample_offset);
+    q->sample_offset = 0;
+  } else if (q->sample_offset < 0) {
+    n = SRSRAN_MIN(-q->sample_offset, nsamples);
+    buffer += n;
+    nsamples -= n;
+    q->sample_offset += n;
+    if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
+      return n;
+    }
+  }
+
+  n = _rf_shm_tx_baseband(q, buffer, nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return n;
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint64_t ret = q->nsamples;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  rf_shm_info(q->id, " - Tx %d Zeros.\n", nsamples);
+  _rf_shm_tx_baseband(q, NULL, (uint32_t)nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  // Not protected by the mutex, a transmission blocked on a full ring holds it
+  __atomic_store_n(&q->running, false, __ATOMIC_RELEASE);
+
+  pthread_mutex_lock(&q->mutex);
+  if (q->ring) {
+    // The receiver keeps its mapping, reads the remaining samples and then detaches
+    __atomic_store_n(&q->ring->closed, 1, __ATOMIC_RELEASE);
+    munmap(q->ring, q->map_size);
+    q->ring    = NULL;
+    q->samples = NULL;
+    rf_shm_tx_unlink(q);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return __atomic_load_n(&q->running, __ATOMIC_ACQUIRE);
+}
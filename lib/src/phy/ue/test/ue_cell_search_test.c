@@ -0,0 +1,250 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#define CS_FRAME_LEN (10 * SRSRAN_SF_LEN(128))
+
+static int      cell_id    = 1;
+static int      cell_id2   = -1;
+static float    cell2_gain = -6.0f;
+static float    snr_db     = 0.0f;
+static uint32_t offset     = 1234;
+static uint32_t nof_frames = 4;
+
+static cf_t*    signal_buffer = NULL;
+static uint32_t signal_len    = 0;
+static uint32_t signal_idx    = 0;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [cCgsonv]\n", prog);
+  printf("\t-c cell_id [Default %d]\n", cell_id);
+  printf("\t-C second cell_id, -1 for a single cell [Default %d]\n", cell_id2);
+  printf("\t-g second cell gain in dB [Default %.1f]\n", cell2_gain);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_db);
+  printf("\t-o sample offset of the first cell [Default %d]\n", offset);
+  printf("\t-n number of 5 ms half-frames to search [Default %d]\n", nof_frames);
+  printf("\t-v increase verbosity\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "c:C:g:s:o:n:v")) != -1) {
+    switch (opt) {
+      case 'c':
+        cell_id = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'C':
+        cell_id2 = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'g':
+        cell2_gain = strtof(optarg, NULL);
+        break;
+      case 's':
+        snr_db = strtof(optarg, NULL);
+        break;
+      case 'o':
+        offset = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_frames = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Adds a 6 PRB FDD cell with PSS/SSS and random data in all other resource elements, delayed by delay samples */
+static int add_cell(uint32_t id, uint32_t delay, float gain_db, srsran_random_t random_gen)
+{
+  int           ret = SRSRAN_ERROR;
+  srsran_ofdm_t ifft = {};
+  cf_t          pss_signal[SRSRAN_PSS_LEN];
+  float         sss_signal0[SRSRAN_SSS_LEN];
+  float         sss_signal5[SRSRAN_SSS_LEN];
+  float         gain    = srsran_convert_dB_to_amplitude(gain_db);
+  uint32_t      sf_len  = SRSRAN_SF_LEN(128);
+  uint32_t      sf_re   = SRSRAN_SF_LEN_RE(6, SRSRAN_CP_NORM);
+  cf_t*         grid    = srsran_vec_cf_malloc(sf_re);
+  cf_t*         sf_time = srsran_vec_cf_malloc(sf_len);
+
+  if (grid == NULL || sf_time == NULL || srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, grid, sf_time, 6)) {
+    ERROR("Error initiating OFDM modulator");
+    goto clean_exit;
+  }
+
+  srsran_pss_generate(pss_signal, id % SRSRAN_NOF_NID_2);
+  srsran_sss_generate(sss_signal0, sss_signal5, id);
+
+  // Start one frame earlier so that the signal is present from the first sample
+  for (uint32_t sf = 0; sf * sf_len < signal_len + CS_FRAME_LEN; sf++) {
+    uint32_t sf_idx = sf % SRSRAN_NOF_SF_X_FRAME;
+    for (uint32_t i = 0; i < sf_re; i++) {
+      __real__ grid[i] = srsran_random_gauss_dist(random_gen, M_SQRT1_2);
+      __imag__ grid[i] = srsran_random_gauss_dist(random_gen, M_SQRT1_2);
+    }
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss_signal, grid, 6, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sf_idx ? sss_signal5 : sss_signal0, grid, 6, SRSRAN_CP_NORM);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+    for (uint32_t i = 0; i < sf_len; i++) {
+      int64_t n = (int64_t)(sf * sf_len + i) + delay % CS_FRAME_LEN - CS_FRAME_LEN;
+      if (n >= 0 && n < signal_len) {
+        signal_buffer[n] += gain * sf_time[i];
+      }
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ofdm_tx_free(&ifft);
+  if (grid) {
+    free(grid);
+  }
+  if (sf_time) {
+    free(sf_time);
+  }
+  return ret;
+}
+
+static int recv_callback(void* h, void* data, uint32_t nsamples, srsran_timestamp_t* t)
+{
+  cf_t* out = (cf_t*)data;
+  for (uint32_t i = 0; i < nsamples; i++) {
+    out[i]     = signal_buffer[signal_idx];
+    signal_idx = (signal_idx + 1) % signal_len;
+  }
+  return nsamples;
+}
+
+static int check_cells(const char* name, int nof_cells, srsran_ue_cellsearch_result_t found_cells[3], uint32_t max_N_id_2)
+{
+  int expected_cells = cell_id2 >= 0 ? 2 : 1;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    printf("%s: N_id_2=%d cell_id=%3d CP=%s PSR=%.2f mode=%.2f CFO=%.1f Hz%s\n",
+           name,
+           N_id_2,
+           found_cells[N_id_2].cell_id,
+           srsran_cp_string(found_cells[N_id_2].cp),
+           found_cells[N_id_2].psr,
+           found_cells[N_id_2].mode,
+           found_cells[N_id_2].cfo,
+           N_id_2 == max_N_id_2 ? " *" : "");
+  }
+  if (nof_cells != expected_cells) {
+    printf("%s: found %d cells, expected %d\n", name, nof_cells, expected_cells);
+    return SRSRAN_ERROR;
+  }
+  if (found_cells[cell_id % SRSRAN_NOF_NID_2].cell_id != cell_id || max_N_id_2 != cell_id % SRSRAN_NOF_NID_2) {
+    printf("%s: cell_id=%d was not detected as the strongest cell\n", name, cell_id);
+    return SRSRAN_ERROR;
+  }
+  if (cell_id2 >= 0 && found_cells[cell_id2 % SRSRAN_NOF_NID_2].cell_id != cell_id2) {
+    printf("%s: cell_id=%d was not detected\n", name, cell_id2);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                             ret = SRSRAN_ERROR;
+  srsran_ue_cellsearch_detector_t detector;
+  srsran_ue_cellsearch_t          cs;
+  srsran_ue_cellsearch_result_t   found_cells[3];
+  uint32_t                        max_N_id_2 = 0;
+  struct timeval                  t[3];
+  srsran_random_t                 random_gen = srsran_random_init(1234);
+
+  parse_args(argc, argv);
+
+  if (cell_id2 >= 0 && cell_id2 % SRSRAN_NOF_NID_2 == cell_id % SRSRAN_NOF_NID_2) {
+    ERROR("Both cells must have different N_id_2");
+    exit(-1);
+  }
+
+  signal_len    = srsran_ue_cellsearch_detector_nof_samples(nof_frames);
+  signal_buffer = srsran_vec_cf_malloc(signal_len);
+  srsran_vec_cf_zero(signal_buffer, signal_len);
+
+  if (add_cell(cell_id, offset, 0.0f, random_gen)) {
+    exit(-1);
+  }
+  if (cell_id2 >= 0 && add_cell(cell_id2, offset + 3000, cell2_gain, random_gen)) {
+    exit(-1);
+  }
+  float noise_var = srsran_vec_avg_power_cf(signal_buffer, signal_len) * srsran_convert_dB_to_power(-snr_db);
+  srsran_ch_awgn_c(signal_buffer, signal_buffer, noise_var, signal_len);
+
+  // Search directly on the buffer
+  if (srsran_ue_cellsearch_detector_init(&detector, nof_frames, SRSRAN_CS_PSS_DECIMATE)) {
+    ERROR("Error initiating cell search detector");
+    exit(-1);
+  }
+  gettimeofday(&t[1], NULL);
+  int nof_cells = srsran_ue_cellsearch_detect(&detector, signal_buffer, nof_frames, found_cells, &max_N_id_2);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  printf("srsran_ue_cellsearch_detect() took %ld us\n", t[0].tv_sec * 1000000 + t[0].tv_usec);
+  if (check_cells("detect", nof_cells, found_cells, max_N_id_2)) {
+    goto clean_exit;
+  }
+
+  // Search through the receive callback, as done with a radio
+  if (srsran_ue_cellsearch_init(&cs, nof_frames, recv_callback, NULL)) {
+    ERROR("Error initiating cell search");
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_set_nof_valid_frames(&cs, nof_frames);
+  signal_idx = 0;
+  max_N_id_2 = 0;
+  nof_cells  = srsran_ue_cellsearch_scan(&cs, found_cells, &max_N_id_2);
+  srsran_ue_cellsearch_free(&cs);
+  if (check_cells("scan", nof_cells, found_cells, max_N_id_2)) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ue_cellsearch_detector_free(&detector);
+  srsran_random_free(random_gen);
+  free(signal_buffer);
+
+  printf("%s\n", ret ? "Failed" : "Ok");
+  return ret;
+}
@@ -21,6 +21,7 @@
 
 #include "srsran/srsran.h"
 #include <assert.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -33,6 +34,14 @@
 
 #define CELL_SEARCH_BUFFER_MAX_SAMPLES (3 * SRSRAN_SF_LEN_MAX)
 
+#define CS_FFT_SIZE 128
+#define CS_HALF_FRAME_LEN (5 * SRSRAN_SF_LEN(CS_FFT_SIZE))
+#define CS_CORR_WINDOW_LEN (CS_HALF_FRAME_LEN + CS_FFT_SIZE)
+#define CS_REFINE_LEN SRSRAN_SF_LEN(CS_FFT_SIZE)
+#define CS_REFINE_PSS_END (CS_REFINE_LEN * 5 / 8)
+#define CS_REFINE_SEARCH_LEN 32
+#define CS_DEFAULT_PFA 0.01f
+
 int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
                               uint32_t                max_frames,
                               int(recv_callback)(void*, void*, uint32_t, srsran_timestamp_t*),
@@ -64,7 +73,17 @@ int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
       q->sf_buffer[p] = NULL;
     }
     q->sf_buffer[0]    = srsran_vec_cf_malloc(CELL_SEARCH_BUFFER_MAX_SAMPLES);
+    q->capture[0]      = srsran_vec_cf_malloc(srsran_ue_cellsearch_detector_nof_samples(max_frames));
     q->nof_rx_antennas = 1;
+    if (!q->sf_buffer[0] || !q->capture[0]) {
+      perror("malloc");
+      goto clean_exit;
+    }
+
+    if (srsran_ue_cellsearch_detector_init(&q->detector, max_frames, SRSRAN_CS_PSS_DECIMATE)) {
+      ERROR("Error initiating cell search detector");
+      goto clean_exit;
+    }
 
     q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
     if (!q->candidates) {
@@ -125,9 +144,19 @@ int srsran_ue_cellsearch_init_multi(
 
     for (int i = 0; i < nof_rx_antennas; i++) {
       q->sf_buffer[i] = srsran_vec_cf_malloc(CELL_SEARCH_BUFFER_MAX_SAMPLES);
+      q->capture[i]   = srsran_vec_cf_malloc(srsran_ue_cellsearch_detector_nof_samples(max_frames));
+      if (!q->sf_buffer[i] || !q->capture[i]) {
+        perror("malloc");
+        goto clean_exit;
+      }
     }
     q->nof_rx_antennas = nof_rx_antennas;
 
+    if (srsran_ue_cellsearch_detector_init(&q->detector, max_frames, SRSRAN_CS_PSS_DECIMATE)) {
+      ERROR("Error initiating cell search detector");
+      goto clean_exit;
+    }
+
     q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
     if (!q->candidates) {
       perror("malloc");
@@ -159,10 +188,13 @@ clean_exit:
 
 void srsran_ue_cellsearch_free(srsran_ue_cellsearch_t* q)
 {
-  for (int i = 0; i < q->nof_rx_antennas; i++) {
+  for (int i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
     if (q->sf_buffer[i]) {
       free(q->sf_buffer[i]);
     }
+    if (q->capture[i]) {
+      free(q->capture[i]);
+    }
   }
   if (q->candidates) {
     free(q->candidates);
@@ -174,6 +206,7 @@ void srsran_ue_cellsearch_free(srsran_ue_cellsearch_t* q)
     free(q->mode_ntimes);
   }
   srsran_ue_sync_free(&q->ue_sync);
+  srsran_ue_cellsearch_detector_free(&q->detector);
 
   bzero(q, sizeof(srsran_ue_cellsearch_t));
 }
@@ -191,80 +224,81 @@ int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_
 void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
 {
   srsran_ue_sync_cp_en(&q->ue_sync, enable);
+  srsran_sync_cp_en(&q->detector.sfind, enable);
 }
 
 /* Decide the most likely cell based on the mode */
-static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, srsran_ue_cellsearch_result_t* found_cell)
+static void get_cell(srsran_ue_cellsearch_result_t* candidates,
+                     uint32_t*                      mode_ntimes,
+                     uint8_t*                       mode_counted,
+                     uint32_t                       nof_detected_frames,
+                     srsran_ue_cellsearch_result_t* found_cell)
 {
   uint32_t i, j;
 
-  bzero(q->mode_counted, nof_detected_frames);
-  bzero(q->mode_ntimes, sizeof(uint32_t) * nof_detected_frames);
+  bzero(mode_counted, nof_detected_frames);
+  bzero(mode_ntimes, sizeof(uint32_t) * nof_detected_frames);
 
   /* First find mode of CELL IDs */
   for (i = 0; i < nof_detected_frames; i++) {
     uint32_t cnt = 1;
     for (j = i + 1; j < nof_detected_frames; j++) {
-      if (q->candidates[j].cell_id == q->candidates[i].cell_id && !q->mode_counted[j]) {
-        q->mode_counted[j] = 1;
+      if (candidates[j].cell_id == candidates[i].cell_id && !mode_counted[j]) {
+        mode_counted[j] = 1;
         cnt++;
       }
     }
-    q->mode_ntimes[i] = cnt;
+    mode_ntimes[i] = cnt;
   }
   uint32_t max_times = 0, mode_pos = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->mode_ntimes[i] > max_times) {
-      max_times = q->mode_ntimes[i];
+    if (mode_ntimes[i] > max_times) {
+      max_times = mode_ntimes[i];
       mode_pos  = i;
     }
   }
-  found_cell->cell_id = q->candidates[mode_pos].cell_id;
+  found_cell->cell_id = candidates[mode_pos].cell_id;
   /* Now in all these cell IDs, find most frequent CP and duplex mode */
   uint32_t nof_normal = 0;
   uint32_t nof_fdd    = 0;
   found_cell->peak    = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->candidates[i].cell_id == found_cell->cell_id) {
-      if (SRSRAN_CP_ISNORM(q->candidates[i].cp)) {
+    if (candidates[i].cell_id == found_cell->cell_id) {
+      if (SRSRAN_CP_ISNORM(candidates[i].cp)) {
         nof_normal++;
       }
-      if (q->candidates[i].frame_type == SRSRAN_FDD) {
+      if (candidates[i].frame_type == SRSRAN_FDD) {
         nof_fdd++;
       }
     }
     // average absolute peak value
-    found_cell->peak += q->candidates[i].peak;
+    found_cell->peak += candidates[i].peak;
   }
   found_cell->peak /= nof_detected_frames;
 
-  if (nof_normal > q->mode_ntimes[mode_pos] / 2) {
+  if (nof_normal > mode_ntimes[mode_pos] / 2) {
     found_cell->cp = SRSRAN_CP_NORM;
   } else {
     found_cell->cp = SRSRAN_CP_EXT;
   }
-  if (nof_fdd > q->mode_ntimes[mode_pos] / 2) {
+  if (nof_fdd > mode_ntimes[mode_pos] / 2) {
     found_cell->frame_type = SRSRAN_FDD;
   } else {
     found_cell->frame_type = SRSRAN_TDD;
   }
-  found_cell->mode = (float)q->mode_ntimes[mode_pos] / nof_detected_frames;
+  found_cell->mode = (float)mode_ntimes[mode_pos] / nof_detected_frames;
 
   // PSR is already averaged so take the last value
-  found_cell->psr = q->candidates[nof_detected_frames - 1].psr;
+  found_cell->psr = candidates[nof_detected_frames - 1].psr;
 
   // CFO is also already averaged
-  found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
+  found_cell->cfo = candidates[nof_detected_frames - 1].cfo;
 }
 
-/** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
- * Each position in found_cell corresponds to a different N_id_2.
- * Saves in the pointer max_N_id_2 the N_id_2 index of the cell with the highest PSR
- * Returns the number of found cells or a negative number if error
- */
-int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
-                              srsran_ue_cellsearch_result_t found_cells[3],
-                              uint32_t*                     max_N_id_2)
+/* Scans each N_id_2 in turn, receiving new samples through ue_sync for each of them */
+static int scan_sequential(srsran_ue_cellsearch_t*       q,
+                           srsran_ue_cellsearch_result_t found_cells[3],
+                           uint32_t*                     max_N_id_2)
 {
   int      ret                = 0;
   float    max_peak_value     = -1.0;
@@ -288,6 +322,46 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
   return nof_detected_cells;
 }
 
+/** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
+ * Each position in found_cell corresponds to a different N_id_2.
+ * Saves in the pointer max_N_id_2 the N_id_2 index of the cell with the highest PSR
+ * Returns the number of found cells or a negative number if error
+ *
+ * The samples of nof_valid_frames half-frames are received once and the three N_id_2 are searched on them with
+ * srsran_ue_cellsearch_detect(). When AGC is enabled, each N_id_2 is scanned in turn through ue_sync instead.
+ */
+int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
+                              srsran_ue_cellsearch_result_t found_cells[3],
+                              uint32_t*                     max_N_id_2)
+{
+  if (q == NULL || found_cells == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->ue_sync.do_agc) {
+    return scan_sequential(q, found_cells, max_N_id_2);
+  }
+
+  if (!q->ue_sync.sfind.detect_frame_type) {
+    srsran_sync_set_frame_type(&q->detector.sfind, q->ue_sync.sfind.frame_type);
+  }
+
+  uint32_t nof_samples = srsran_ue_cellsearch_detector_nof_samples(q->nof_valid_frames);
+  for (uint32_t n = 0; n < nof_samples; n += CS_HALF_FRAME_LEN) {
+    cf_t* ptr[SRSRAN_MAX_CHANNELS] = {NULL};
+    for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+      ptr[i] = &q->capture[i][n];
+    }
+    if (q->ue_sync.recv_callback(
+            q->ue_sync.stream, ptr, SRSRAN_MIN(CS_HALF_FRAME_LEN, nof_samples - n), &q->ue_sync.last_timestamp) < 0) {
+      ERROR("Error receiving samples for cell search");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return srsran_ue_cellsearch_detect(&q->detector, q->capture[0], q->nof_valid_frames, found_cells, max_N_id_2);
+}
+
 /** Finds a cell for a given N_id_2 and stores ID and CP in the structure pointed by found_cell.
  * Returns 1 if the cell is found, 0 if not or -1 on error
  */
@@ -352,7 +426,7 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
     if (nof_detected_frames > 0) {
       ret = 1; // A cell has been found.
       if (found_cell) {
-        get_cell(q, nof_detected_frames, found_cell);
+        get_cell(q->candidates, q->mode_ntimes, q->mode_counted, nof_detected_frames, found_cell);
       }
     } else {
       ret = 0; // A cell was not found.
@@ -361,3 +435,298 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
 
   return ret;
 }
+
+/* Copies the central corr_len bins of a CS_CORR_WINDOW_LEN spectrum, which low-pass filters and decimates the
+ * corresponding time-domain signal by q->decimate */
+static void detector_decimate(const srsran_ue_cellsearch_detector_t* q, const cf_t* in, cf_t* out)
+{
+  uint32_t half = q->corr_len / 2;
+  srsran_vec_cf_copy(out, in, half);
+  srsran_vec_cf_copy(&out[half], &in[CS_CORR_WINDOW_LEN - (q->corr_len - half)], q->corr_len - half);
+}
+
+int srsran_ue_cellsearch_detector_init(srsran_ue_cellsearch_detector_t* q, uint32_t max_frames, uint32_t decimate)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q != NULL && max_frames > 0 && decimate > 0 && (CS_FFT_SIZE % decimate) == 0 &&
+      (CS_HALF_FRAME_LEN % decimate) == 0) {
+    ret = SRSRAN_ERROR;
+
+    bzero(q, sizeof(srsran_ue_cellsearch_detector_t));
+
+    q->max_frames = max_frames;
+    q->decimate   = decimate;
+    q->corr_len   = CS_CORR_WINDOW_LEN / decimate;
+    q->nof_lags   = CS_HALF_FRAME_LEN / decimate;
+    q->pfa        = CS_DEFAULT_PFA;
+
+    q->input_fft    = srsran_vec_cf_malloc(CS_CORR_WINDOW_LEN);
+    q->input_decim  = srsran_vec_cf_malloc(q->corr_len);
+    q->pss_fft      = srsran_vec_cf_malloc(SRSRAN_NOF_NID_2 * q->corr_len);
+    q->corr_fft     = srsran_vec_cf_malloc(SRSRAN_NOF_NID_2 * q->corr_len);
+    q->corr         = srsran_vec_cf_malloc(SRSRAN_NOF_NID_2 * q->corr_len);
+    q->corr_pwr     = srsran_vec_f_malloc(q->nof_lags);
+    q->corr_acc     = srsran_vec_f_malloc(SRSRAN_NOF_NID_2 * q->nof_lags);
+    q->candidates   = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->mode_ntimes  = calloc(sizeof(uint32_t), max_frames);
+    q->mode_counted = calloc(sizeof(uint8_t), max_frames);
+    if (!q->input_fft || !q->input_decim || !q->pss_fft || !q->corr_fft || !q->corr || !q->corr_pwr || !q->corr_acc ||
+        !q->candidates || !q->mode_ntimes || !q->mode_counted) {
+      perror("malloc");
+      goto clean_exit;
+    }
+
+    if (srsran_dft_plan_c(&q->fft, CS_CORR_WINDOW_LEN, SRSRAN_DFT_FORWARD)) {
+      ERROR("Error creating DFT plan");
+      goto clean_exit;
+    }
+
+    // The correlations with the three PSS are computed with a single IFFT execution
+    if (srsran_dft_plan_guru_c(&q->ifft_batch,
+                               q->corr_len,
+                               SRSRAN_DFT_BACKWARD,
+                               q->corr_fft,
+                               q->corr,
+                               1,
+                               1,
+                               SRSRAN_NOF_NID_2,
+                               q->corr_len,
+                               q->corr_len)) {
+      ERROR("Error creating batched DFT plan");
+      goto clean_exit;
+    }
+
+    // Correlating with the PSS is a product with the conjugate of its spectrum, decimated like the input
+    cf_t pss_freq[SRSRAN_PSS_LEN];
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      cf_t* pss_fft = &q->pss_fft[N_id_2 * q->corr_len];
+
+      srsran_vec_cf_zero(q->input_fft, CS_CORR_WINDOW_LEN);
+      if (srsran_pss_init_N_id_2(pss_freq, q->input_fft, N_id_2, CS_FFT_SIZE, 0)) {
+        ERROR("Error generating PSS for N_id_2=%d", N_id_2);
+        goto clean_exit;
+      }
+      // srsran_pss_init_N_id_2() returns the conjugated time-domain sequence
+      srsran_vec_conj_cc(q->input_fft, q->input_fft, CS_FFT_SIZE);
+      srsran_dft_run_c(&q->fft, q->input_fft, q->input_fft);
+      detector_decimate(q, q->input_fft, pss_fft);
+      srsran_vec_conj_cc(pss_fft, pss_fft, q->corr_len);
+    }
+
+    // The coarse peak is accurate to a few samples, so the full-rate PSS is only searched in a short window around it
+    if (srsran_sync_init(&q->sfind, CS_REFINE_LEN, CS_REFINE_SEARCH_LEN, CS_FFT_SIZE)) {
+      ERROR("Error initiating sync");
+      goto clean_exit;
+    }
+    // Detection is decided on the accumulated correlation, the full-rate search only refines timing, SSS and CP
+    srsran_sync_set_threshold(&q->sfind, 0.0f);
+    srsran_sync_set_em_alpha(&q->sfind, 1);
+    srsran_sync_set_cfo_i_enable(&q->sfind, false);
+    srsran_sync_set_cfo_pss_enable(&q->sfind, true);
+    srsran_sync_set_pss_filt_enable(&q->sfind, true);
+    srsran_sync_set_sss_eq_enable(&q->sfind, false);
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (ret == SRSRAN_ERROR) {
+    srsran_ue_cellsearch_detector_free(q);
+  }
+  return ret;
+}
+
+void srsran_ue_cellsearch_detector_free(srsran_ue_cellsearch_detector_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->input_fft) {
+    free(q->input_fft);
+  }
+  if (q->input_decim) {
+    free(q->input_decim);
+  }
+  if (q->pss_fft) {
+    free(q->pss_fft);
+  }
+  if (q->corr_fft) {
+    free(q->corr_fft);
+  }
+  if (q->corr) {
+    free(q->corr);
+  }
+  if (q->corr_pwr) {
+    free(q->corr_pwr);
+  }
+  if (q->corr_acc) {
+    free(q->corr_acc);
+  }
+  if (q->candidates) {
+    free(q->candidates);
+  }
+  if (q->mode_ntimes) {
+    free(q->mode_ntimes);
+  }
+  if (q->mode_counted) {
+    free(q->mode_counted);
+  }
+  srsran_dft_plan_free(&q->fft);
+  srsran_dft_plan_free(&q->ifft_batch);
+  srsran_sync_free(&q->sfind);
+
+  bzero(q, sizeof(srsran_ue_cellsearch_detector_t));
+}
+
+/* Sets the probability that noise alone is reported as a cell in a call to srsran_ue_cellsearch_detect() */
+void srsran_ue_cellsearch_detector_set_pfa(srsran_ue_cellsearch_detector_t* q, float pfa)
+{
+  q->pfa = pfa;
+}
+
+/* Returns the number of samples that srsran_ue_cellsearch_detect() reads for nof_frames half-frames */
+uint32_t srsran_ue_cellsearch_detector_nof_samples(uint32_t nof_frames)
+{
+  return nof_frames * CS_HALF_FRAME_LEN + CS_FFT_SIZE + CS_REFINE_LEN;
+}
+
+/* Returns the peak-to-average threshold of the correlation power accumulated over nof_frames half-frames.
+ *
+ * For noise, the normalized accumulated power of each lag follows a Gamma(nof_frames, 1/nof_frames) distribution, whose
+ * tail is exp(-n*t) * sum_{i<n} (n*t)^i / i!. The threshold is the value for which any of the searched lags exceeds it
+ * with probability pfa.
+ */
+static float detector_threshold(const srsran_ue_cellsearch_detector_t* q, uint32_t nof_frames)
+{
+  double target = q->pfa / (SRSRAN_NOF_NID_2 * q->nof_lags);
+  double t_min  = 1.0;
+  double t_max  = 100.0;
+  for (uint32_t iter = 0; iter < 32; iter++) {
+    double t    = (t_min + t_max) / 2;
+    double x    = nof_frames * t;
+    double term = exp(-x);
+    double tail = term;
+    for (uint32_t i = 1; i < nof_frames; i++) {
+      term *= x / i;
+      tail += term;
+    }
+    if (tail > target) {
+      t_min = t;
+    } else {
+      t_max = t;
+    }
+  }
+  return (float)t_max;
+}
+
+/* Runs the full-rate PSS/SSS search around the coarse PSS position of every half-frame and decides the cell */
+static int detector_refine(srsran_ue_cellsearch_detector_t* q,
+                           const cf_t*                      input,
+                           uint32_t                         nof_frames,
+                           uint32_t                         N_id_2,
+                           uint32_t                         lag,
+                           float                            par,
+                           srsran_ue_cellsearch_result_t*   found_cell)
+{
+  uint32_t nof_samples         = srsran_ue_cellsearch_detector_nof_samples(nof_frames);
+  uint32_t nof_detected_frames = 0;
+
+  srsran_sync_set_N_id_2(&q->sfind, N_id_2);
+  srsran_sync_reset(&q->sfind);
+  srsran_sync_cfo_reset(&q->sfind, 0.0f);
+
+  for (uint32_t k = 0; k < nof_frames; k++) {
+    // Place the end of the PSS so that the SSS of both FDD and TDD frames falls inside the window
+    int start = (int)(k * CS_HALF_FRAME_LEN + lag * q->decimate + CS_FFT_SIZE) - CS_REFINE_PSS_END;
+    if (start < 0 || start + CS_REFINE_LEN > nof_samples) {
+      continue;
+    }
+    uint32_t find_offset = CS_REFINE_PSS_END - CS_FFT_SIZE - CS_REFINE_SEARCH_LEN / 2;
+    if (srsran_sync_find(&q->sfind, &input[start], find_offset, NULL) != SRSRAN_SYNC_FOUND) {
+      continue;
+    }
+    int cell_id = srsran_sync_get_cell_id(&q->sfind);
+    if (cell_id >= 0) {
+      q->candidates[nof_detected_frames].cell_id    = (uint32_t)cell_id;
+      q->candidates[nof_detected_frames].cp         = srsran_sync_get_cp(&q->sfind);
+      q->candidates[nof_detected_frames].peak       = q->sfind.pss.peak_value;
+      q->candidates[nof_detected_frames].psr        = par;
+      q->candidates[nof_detected_frames].cfo        = 15000 * srsran_sync_get_cfo(&q->sfind);
+      q->candidates[nof_detected_frames].frame_type = q->sfind.frame_type;
+      nof_detected_frames++;
+    }
+  }
+
+  if (nof_detected_frames == 0) {
+    return 0;
+  }
+  get_cell(q->candidates, q->mode_ntimes, q->mode_counted, nof_detected_frames, found_cell);
+  return 1;
+}
+
+/** Finds up to 3 cells, one per each N_id_2, in nof_frames consecutive 5 ms half-frames of input, which must hold
+ * srsran_ue_cellsearch_detector_nof_samples(nof_frames) samples at SRSRAN_CS_SAMP_FREQ.
+ * Results are stored like in srsran_ue_cellsearch_scan(). Returns the number of found cells or a negative number if
+ * error.
+ */
+int srsran_ue_cellsearch_detect(srsran_ue_cellsearch_detector_t* q,
+                                const cf_t*                      input,
+                                uint32_t                         nof_frames,
+                                srsran_ue_cellsearch_result_t    found_cells[3],
+                                uint32_t*                        max_N_id_2)
+{
+  if (q == NULL || input == NULL || found_cells == NULL || nof_frames == 0 || nof_frames > q->max_frames) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Accumulate the correlation power of each N_id_2 over the half-frames
+  srsran_vec_f_zero(q->corr_acc, SRSRAN_NOF_NID_2 * q->nof_lags);
+  for (uint32_t k = 0; k < nof_frames; k++) {
+    srsran_dft_run_c(&q->fft, &input[k * CS_HALF_FRAME_LEN], q->input_fft);
+    detector_decimate(q, q->input_fft, q->input_decim);
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      srsran_vec_prod_ccc(
+          q->input_decim, &q->pss_fft[N_id_2 * q->corr_len], &q->corr_fft[N_id_2 * q->corr_len], q->corr_len);
+    }
+    srsran_dft_run_guru_c(&q->ifft_batch);
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      float* acc = &q->corr_acc[N_id_2 * q->nof_lags];
+      srsran_vec_abs_square_cf(&q->corr[N_id_2 * q->corr_len], q->corr_pwr, q->nof_lags);
+      srsran_vec_sum_fff(acc, q->corr_pwr, acc, q->nof_lags);
+    }
+  }
+
+  int   nof_detected_cells = 0;
+  float max_peak_value     = -1.0;
+  float threshold          = detector_threshold(q, nof_frames);
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    float*   acc = &q->corr_acc[N_id_2 * q->nof_lags];
+    uint32_t lag = srsran_vec_max_fi(acc, q->nof_lags);
+    float    avg = srsran_vec_acc_ff(acc, q->nof_lags) / q->nof_lags;
+    float    par = avg > 0 ? acc[lag] / avg : 0;
+
+    bzero(&found_cells[N_id_2], sizeof(srsran_ue_cellsearch_result_t));
+
+    DEBUG("CELL SEARCH: N_id_2=%d, coarse peak at %d, peak-to-average=%.1f (threshold %.1f)",
+          N_id_2,
+          lag * q->decimate,
+          par,
+          threshold);
+    if (par >= threshold && detector_refine(q, input, nof_frames, N_id_2, lag, par, &found_cells[N_id_2])) {
+      INFO("CELL SEARCH: Found Cell_id: %d CP: %s, PSR=%.3f, CFO=%.1f KHz",
+           found_cells[N_id_2].cell_id,
+           srsran_cp_string(found_cells[N_id_2].cp),
+           found_cells[N_id_2].psr,
+           found_cells[N_id_2].cfo / 1000);
+      nof_detected_cells++;
+    }
+    if (max_N_id_2) {
+      if (found_cells[N_id_2].peak > max_peak_value) {
+        max_peak_value = found_cells[N_id_2].peak;
+        *max_N_id_2    = N_id_2;
+      }
+    }
+  }
+  return nof_detected_cells;
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/radio/rf_mux.h"
+#include "srsran/phy/utils/vector.h"
+#include <cmath>
+
+namespace srsran {
+
+rf_mux::rf_mux(const args_t& args_, srslog::basic_logger& logger_) :
+  logger(logger_), nof_ports(args_.nof_ports), srate_hz(args_.srate_hz)
+{
+  ues.resize(args_.ues.size());
+  for (uint32_t i = 0; i < ues.size(); i++) {
+    const ue_args_t& ue_args = args_.ues[i];
+    ue_t&            ue      = ues[i];
+
+    ue.dl_channel = make_channel(args_.dl_channel, ue_args.delay_us);
+    ue.ul_channel = make_channel(args_.ul_channel, ue_args.delay_us);
+    ue.gain       = srsran_convert_dB_to_amplitude(ue_args.gain_dB);
+    ue.cfo_norm   = ue_args.cfo_hz / (float)srate_hz;
+
+    logger.info(
+        "UE %d: delay=%.2f us; gain=%+.1f dB; cfo=%+.1f Hz", i, ue_args.delay_us, ue_args.gain_dB, ue_args.cfo_hz);
+  }
+}
+
+channel_ptr rf_mux::make_channel(const channel::args_t& channel_args, float delay_us)
+{
+  // Without a delay, the channel is only needed if the template enables any model
+  if (!channel_args.enable && delay_us <= 0.0f) {
+    return nullptr;
+  }
+
+  channel::args_t ch_args = channel_args.enable ? channel_args : channel::args_t{};
+  ch_args.enable          = true;
+  if (delay_us > 0.0f) {
+    // A constant delay is a delay model without variation
+    ch_args.delay_enable = true;
+    ch_args.delay_min_us = delay_us;
+    ch_args.delay_max_us = delay_us;
+  }
+
+  channel_ptr ch = channel_ptr(new channel(ch_args, nof_ports, logger));
+  ch->set_srate(srate_hz);
+  return ch;
+}
+
+void rf_mux::run_dl(uint32_t                  ue_idx,
+                    cf_t*                     enb_dl[SRSRAN_MAX_CHANNELS],
+                    cf_t*                     ue_dl[SRSRAN_MAX_CHANNELS],
+                    uint32_t                  nof_samples,
+                    const srsran_timestamp_t& t)
+{
+  if (ue_idx >= ues.size()) {
+    return;
+  }
+  ue_t& ue = ues[ue_idx];
+
+  if (ue.dl_channel) {
+    ue.dl_channel->run(enb_dl, ue_dl, nof_samples, t);
+  } else {
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      if (ue_dl[p] != enb_dl[p]) {
+        srsran_vec_cf_copy(ue_dl[p], enb_dl[p], nof_samples);
+      }
+    }
+  }
+
+  if (ue.gain != 1.0f) {
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_vec_sc_prod_cfc(ue_dl[p], ue.gain, ue_dl[p], nof_samples);
+    }
+  }
+}
+
+void rf_mux::run_ul(cf_t**                    ue_ul[],
+                    cf_t*                     enb_ul[SRSRAN_MAX_CHANNELS],
+                    uint32_t                  nof_samples,
+                    const srsran_timestamp_t& t)
+{
+  bool first = true;
+
+  for (uint32_t i = 0; i < ues.size(); i++) {
+    if (ue_ul[i] == nullptr) {
+      continue;
+    }
+    ue_t& ue = ues[i];
+
+    if (ue.ul_channel) {
+      ue.ul_channel->run(ue_ul[i], ue_ul[i], nof_samples, t);
+    }
+
+    // Gain and the phase reached by the frequency offset at the end of the previous call, in a single scalar
+    bool scaled = (ue.gain != 1.0f || ue.ul_phase != 0.0f);
+    cf_t scale;
+    __real__ scale = ue.gain * cosf(ue.ul_phase);
+    __imag__ scale = ue.gain * sinf(ue.ul_phase);
+
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      cf_t* x = ue_ul[i][p];
+
+      if (ue.cfo_norm != 0.0f) {
+        srsran_vec_apply_cfo(x, ue.cfo_norm, x, nof_samples);
+      }
+
+      // The first UE initialises the sum, the rest are accumulated on it
+      if (first) {
+        srsran_vec_sc_prod_ccc(x, scale, enb_ul[p], nof_samples);
+      } else {
+        if (scaled) {
+          srsran_vec_sc_prod_ccc(x, scale, x, nof_samples);
+        }
+        srsran_vec_sum_ccc(enb_ul[p], x, enb_ul[p], nof_samples);
+      }
+    }
+
+    // Keep the frequency offset phase continuous between calls
+    if (ue.cfo_norm != 0.0f) {
+      ue.ul_phase = (float)std::fmod((double)ue.ul_phase + 2.0 * M_PI * ue.cfo_norm * nof_samples, 2.0 * M_PI);
+    }
+
+    first = false;
+  }
+
+  // No UE contributed, transmit silence
+  if (first) {
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_vec_cf_zero(enb_ul[p], nof_samples);
+    }
+  }
+}
+
+} // namespace srsran
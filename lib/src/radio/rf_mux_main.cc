@@ -0,0 +1,305 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Connects one srsENB to N srsUE instances over the sample-based RF devices (zmq, shm). The eNB downlink is fanned
+/// out to all UEs and their uplinks are summed into the eNB uplink, each UE with its own delay, gain and frequency
+/// offset. Every stream is opened as its own rx-only or tx-only device, so that samples are forwarded without the
+/// timing gap a transceiver device would insert, and all peers run in lockstep.
+
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/radio/rf_mux.h"
+#include <atomic>
+#include <csignal>
+#include <getopt.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace srsran;
+
+namespace {
+
+struct mux_args_t {
+  std::string devname        = "zmq";
+  std::string enb_dl_args    = "rx_port=tcp://localhost:2000";
+  std::string enb_ul_args    = "tx_port=tcp://*:2001";
+  std::string ue_dl_args     = "tx_port=tcp://*:%d";
+  std::string ue_ul_args     = "rx_port=tcp://localhost:%d";
+  uint32_t    base_port      = 2100;
+  uint32_t    nof_ues        = 1;
+  uint32_t    nof_ports      = 1;
+  double      srate          = 23.04e6;
+  float       max_delay_us   = 0.0f;
+  float       gain_spread_dB = 0.0f;
+  float       max_cfo_hz     = 0.0f;
+  uint32_t    seed           = 0;
+  std::string fading_model   = "none";
+  uint32_t    nof_subframes  = 0;
+} args;
+
+std::atomic<bool> running = {true};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [daAuUbNpsDGFSmnvh]\n", prog);
+  printf("\t-d RF device [Default %s]\n", args.devname.c_str());
+  printf("\t-a eNB downlink (mux rx) arguments [Default %s]\n", args.enb_dl_args.c_str());
+  printf("\t-A eNB uplink (mux tx) arguments [Default %s]\n", args.enb_ul_args.c_str());
+  printf("\t-u UE downlink (mux tx) arguments, %%d is the UE port [Default %s]\n", args.ue_dl_args.c_str());
+  printf("\t-U UE uplink (mux rx) arguments, %%d is the UE port [Default %s]\n", args.ue_ul_args.c_str());
+  printf("\t-b UE base port, UE i uses port b+2i for downlink and b+2i+1 for uplink [Default %d]\n", args.base_port);
+  printf("\t-N number of UEs [Default %d]\n", args.nof_ues);
+  printf("\t-p number of ports [Default %d]\n", args.nof_ports);
+  printf("\t-s sampling rate, also used as base_srate of every device [Default %.0f]\n", args.srate);
+  printf("\t-D maximum UE delay in us, drawn uniformly in [0, D] [Default %.1f]\n", args.max_delay_us);
+  printf("\t-G UE gain spread in dB, drawn uniformly in [-G, 0] [Default %.1f]\n", args.gain_spread_dB);
+  printf("\t-F maximum UE uplink CFO in Hz, drawn uniformly in [-F, F] [Default %.1f]\n", args.max_cfo_hz);
+  printf("\t-S seed for the UE parameters [Default %d]\n", args.seed);
+  printf("\t-m fading model for every UE and direction, e.g. epa5 [Default %s]\n", args.fading_model.c_str());
+  printf("\t-n number of subframes, 0 runs until interrupted [Default %d]\n", args.nof_subframes);
+  printf("\t-v increase verbosity\n");
+  printf("\t-h show this message\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "d:a:A:u:U:b:N:p:s:D:G:F:S:m:n:vh")) != -1) {
+    switch (opt) {
+      case 'd':
+        args.devname = optarg;
+        break;
+      case 'a':
+        args.enb_dl_args = optarg;
+        break;
+      case 'A':
+        args.enb_ul_args = optarg;
+        break;
+      case 'u':
+        args.ue_dl_args = optarg;
+        break;
+      case 'U':
+        args.ue_ul_args = optarg;
+        break;
+      case 'b':
+        args.base_port = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'N':
+        args.nof_ues = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'p':
+        args.nof_ports = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        args.srate = strtod(optarg, NULL);
+        break;
+      case 'D':
+        args.max_delay_us = strtof(optarg, NULL);
+        break;
+      case 'G':
+        args.gain_spread_dB = strtof(optarg, NULL);
+        break;
+      case 'F':
+        args.max_cfo_hz = strtof(optarg, NULL);
+        break;
+      case 'S':
+        args.seed = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'm':
+        args.fading_model = optarg;
+        break;
+      case 'n':
+        args.nof_subframes = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+
+  if (args.nof_ports == 0 || args.nof_ports > SRSRAN_MAX_PORTS || args.nof_ues == 0) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+void sig_int_handler(int signo)
+{
+  // A second signal terminates the process if a peer never delivers the samples of the current subframe
+  signal(SIGINT, SIG_DFL);
+  running = false;
+}
+
+/// Formats the device arguments of a stream and appends the base sampling rate
+std::string make_dev_args(const std::string& fmt, int port)
+{
+  char buf[RF_PARAM_LEN];
+  snprintf(buf, sizeof(buf), fmt.c_str(), port);
+  return std::string(buf) + ",base_srate=" + std::to_string((uint32_t)args.srate);
+}
+
+int open_dev(srsran_rf_t* rf, const std::string& dev_args, bool rx)
+{
+  std::vector<char> tmp(dev_args.begin(), dev_args.end());
+  tmp.push_back('\0');
+
+  if (srsran_rf_open_devname(rf, args.devname.c_str(), tmp.data(), args.nof_ports) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening %s device with args=%s\n", args.devname.c_str(), dev_args.c_str());
+    return SRSRAN_ERROR;
+  }
+  if (rx) {
+    srsran_rf_set_rx_srate(rf, args.srate);
+    srsran_rf_start_rx_stream(rf, false);
+  } else {
+    srsran_rf_set_tx_srate(rf, args.srate);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("MUX", false);
+  logger.set_level(get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO ? srslog::basic_levels::info
+                                                                     : srslog::basic_levels::warning);
+
+  // Draw the propagation conditions of every UE
+  std::mt19937   rng(args.seed);
+  rf_mux::args_t mux_args = {};
+  mux_args.nof_ports      = args.nof_ports;
+  mux_args.srate_hz       = (uint32_t)args.srate;
+  if (args.fading_model != "none") {
+    for (channel::args_t* ch : {&mux_args.dl_channel, &mux_args.ul_channel}) {
+      ch->enable        = true;
+      ch->fading_enable = true;
+      ch->fading_model  = args.fading_model;
+    }
+  }
+  for (uint32_t i = 0; i < args.nof_ues; i++) {
+    rf_mux::ue_args_t ue = {};
+    ue.delay_us          = std::uniform_real_distribution<float>(0.0f, args.max_delay_us)(rng);
+    ue.gain_dB           = std::uniform_real_distribution<float>(-args.gain_spread_dB, 0.0f)(rng);
+    ue.cfo_hz            = std::uniform_real_distribution<float>(-args.max_cfo_hz, args.max_cfo_hz)(rng);
+    mux_args.ues.push_back(ue);
+  }
+  rf_mux mux(mux_args, logger);
+
+  // Open one device per stream and direction
+  srsran_rf_t              enb_dl = {}, enb_ul = {};
+  std::vector<srsran_rf_t> ue_dl(args.nof_ues), ue_ul(args.nof_ues);
+  if (open_dev(&enb_dl, make_dev_args(args.enb_dl_args, 0), true) ||
+      open_dev(&enb_ul, make_dev_args(args.enb_ul_args, 0), false)) {
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < args.nof_ues; i++) {
+    if (open_dev(&ue_dl[i], make_dev_args(args.ue_dl_args, args.base_port + 2 * i), false) ||
+        open_dev(&ue_ul[i], make_dev_args(args.ue_ul_args, args.base_port + 2 * i + 1), true)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // One subframe of samples for every stream
+  uint32_t                                             sf_len = (uint32_t)(args.srate / 1000.0);
+  std::vector<std::array<cf_t*, SRSRAN_MAX_CHANNELS> > ue_ul_buf(args.nof_ues);
+  std::vector<cf_t**>                                  ue_ul_ptr(args.nof_ues);
+  std::array<cf_t*, SRSRAN_MAX_CHANNELS>               dl_buf = {}, ue_dl_buf = {}, ul_buf = {};
+  for (uint32_t p = 0; p < args.nof_ports; p++) {
+    dl_buf[p]    = srsran_vec_cf_malloc(sf_len);
+    ue_dl_buf[p] = srsran_vec_cf_malloc(sf_len);
+    ul_buf[p]    = srsran_vec_cf_malloc(sf_len);
+    for (uint32_t i = 0; i < args.nof_ues; i++) {
+      ue_ul_buf[i][p] = srsran_vec_cf_malloc(sf_len);
+    }
+  }
+  for (uint32_t i = 0; i < args.nof_ues; i++) {
+    ue_ul_ptr[i] = ue_ul_buf[i].data();
+  }
+
+  signal(SIGINT, sig_int_handler);
+  printf("Multiplexing %d UEs at %.2f MHz, press Ctrl+C to stop\n", args.nof_ues, args.srate / 1e6);
+
+  int      ret = SRSRAN_SUCCESS;
+  uint32_t sf  = 0;
+  while (running && (args.nof_subframes == 0 || sf < args.nof_subframes)) {
+    srsran_timestamp_t t = {};
+
+    // Fan out the eNB downlink, the UEs need it to produce the uplink of the next subframes
+    if (srsran_rf_recv_with_time_multi(&enb_dl, (void**)dl_buf.data(), sf_len, true, &t.full_secs, &t.frac_secs) <
+        0) {
+      fprintf(stderr, "Error receiving eNB downlink\n");
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    for (uint32_t i = 0; i < args.nof_ues; i++) {
+      mux.run_dl(i, dl_buf.data(), ue_dl_buf.data(), sf_len, t);
+      if (srsran_rf_send_multi(&ue_dl[i], (void**)ue_dl_buf.data(), sf_len, true, false, false) < 0) {
+        fprintf(stderr, "Error sending downlink to UE %d\n", i);
+        ret = SRSRAN_ERROR;
+      }
+    }
+
+    // Sum the uplink of all UEs
+    for (uint32_t i = 0; i < args.nof_ues; i++) {
+      if (srsran_rf_recv_with_time_multi(&ue_ul[i], (void**)ue_ul_buf[i].data(), sf_len, true, NULL, NULL) < 0) {
+        fprintf(stderr, "Error receiving uplink from UE %d\n", i);
+        ret = SRSRAN_ERROR;
+      }
+    }
+    mux.run_ul(ue_ul_ptr.data(), ul_buf.data(), sf_len, t);
+    if (srsran_rf_send_multi(&enb_ul, (void**)ul_buf.data(), sf_len, true, false, false) < 0) {
+      fprintf(stderr, "Error sending eNB uplink\n");
+      ret = SRSRAN_ERROR;
+    }
+
+    if (ret != SRSRAN_SUCCESS) {
+      break;
+    }
+    sf++;
+  }
+  printf("Multiplexed %d subframes\n", sf);
+
+  srsran_rf_close(&enb_dl);
+  srsran_rf_close(&enb_ul);
+  for (uint32_t i = 0; i < args.nof_ues; i++) {
+    srsran_rf_close(&ue_dl[i]);
+    srsran_rf_close(&ue_ul[i]);
+  }
+  for (uint32_t p = 0; p < args.nof_ports; p++) {
+    free(dl_buf[p]);
+    free(ue_dl_buf[p]);
+    free(ul_buf[p]);
+    for (uint32_t i = 0; i < args.nof_ues; i++) {
+      free(ue_ul_buf[i][p]);
+    }
+  }
+  srslog::flush();
+
+  return ret;
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/radio/rf_mux.h"
+#include <cmath>
+#include <vector>
+
+using namespace srsran;
+
+static const uint32_t srate_hz    = 1920000;
+static const uint32_t nof_samples = 1920;
+static const uint32_t nof_calls   = 3;
+static const float    delay_us    = 12.5f; // 24 samples
+static const uint32_t delay_samps = 24;
+static const float    gain_dB     = -6.0f;
+static const float    cfo_hz      = 1000.0f;
+
+static cf_t make_cf(float re, float im)
+{
+  cf_t ret;
+  __real__ ret = re;
+  __imag__ ret = im;
+  return ret;
+}
+
+static cf_t rand_sample()
+{
+  return make_cf((float)rand() / (float)RAND_MAX - 0.5f, (float)rand() / (float)RAND_MAX - 0.5f);
+}
+
+static float max_error(const std::vector<cf_t>& a, const std::vector<cf_t>& b)
+{
+  float err = 0.0f;
+  for (uint32_t i = 0; i < a.size(); i++) {
+    cf_t d = a[i] - b[i];
+    err    = std::max(err, std::hypot(__real__ d, __imag__ d));
+  }
+  return err;
+}
+
+/// UE 0 has gain and uplink CFO, UE 1 has delay. The uplink sum and the downlink of every UE are compared against a
+/// direct computation over several calls, so that the phase continuity and the delay line are exercised.
+int test_rf_mux()
+{
+  rf_mux::args_t args = {};
+  args.nof_ports      = 1;
+  args.srate_hz       = srate_hz;
+  args.ues.resize(2);
+  args.ues[0].gain_dB  = gain_dB;
+  args.ues[0].cfo_hz   = cfo_hz;
+  args.ues[1].delay_us = delay_us;
+
+  rf_mux mux(args, srslog::fetch_basic_logger("MUX", false));
+  TESTASSERT(mux.nof_ues() == 2);
+
+  uint32_t          total = nof_samples * nof_calls;
+  std::vector<cf_t> ue0(total), ue1(total), dl(total);
+  for (uint32_t i = 0; i < total; i++) {
+    ue0[i] = rand_sample();
+    ue1[i] = rand_sample();
+    dl[i]  = rand_sample();
+  }
+
+  // Expected signals
+  float             gain = std::pow(10.0f, gain_dB / 20.0f);
+  std::vector<cf_t> ul_expected(total), dl0_expected(total), dl1_expected(total);
+  for (uint32_t i = 0; i < total; i++) {
+    double phase      = 2.0 * M_PI * cfo_hz * i / srate_hz;
+    cf_t   delayed_ul = (i >= delay_samps) ? ue1[i - delay_samps] : make_cf(0.0f, 0.0f);
+    cf_t   delayed_dl = (i >= delay_samps) ? dl[i - delay_samps] : make_cf(0.0f, 0.0f);
+    ul_expected[i]    = gain * ue0[i] * make_cf((float)cos(phase), (float)sin(phase)) + delayed_ul;
+    dl0_expected[i]   = gain * dl[i];
+    dl1_expected[i]   = delayed_dl;
+  }
+
+  // Run the multiplexer in chunks
+  cf_t*             ue_buf[2][SRSRAN_MAX_CHANNELS] = {};
+  cf_t*             dl_buf[SRSRAN_MAX_CHANNELS]    = {};
+  cf_t*             out_buf[SRSRAN_MAX_CHANNELS]   = {};
+  std::vector<cf_t> ul_out(total), dl0_out(total), dl1_out(total);
+  for (uint32_t i = 0; i < 2; i++) {
+    ue_buf[i][0] = srsran_vec_cf_malloc(nof_samples);
+  }
+  dl_buf[0]  = srsran_vec_cf_malloc(nof_samples);
+  out_buf[0] = srsran_vec_cf_malloc(nof_samples);
+
+  for (uint32_t n = 0; n < nof_calls; n++) {
+    srsran_timestamp_t t = {};
+    srsran_timestamp_init_uint64(&t, n * nof_samples, srate_hz);
+    uint32_t offset = n * nof_samples;
+
+    memcpy(ue_buf[0][0], &ue0[offset], sizeof(cf_t) * nof_samples);
+    memcpy(ue_buf[1][0], &ue1[offset], sizeof(cf_t) * nof_samples);
+    cf_t** ue_ul[2] = {ue_buf[0], ue_buf[1]};
+    mux.run_ul(ue_ul, out_buf, nof_samples, t);
+    memcpy(&ul_out[offset], out_buf[0], sizeof(cf_t) * nof_samples);
+
+    memcpy(dl_buf[0], &dl[offset], sizeof(cf_t) * nof_samples);
+    mux.run_dl(0, dl_buf, out_buf, nof_samples, t);
+    memcpy(&dl0_out[offset], out_buf[0], sizeof(cf_t) * nof_samples);
+    mux.run_dl(1, dl_buf, out_buf, nof_samples, t);
+    memcpy(&dl1_out[offset], out_buf[0], sizeof(cf_t) * nof_samples);
+  }
+
+  float ul_err  = max_error(ul_out, ul_expected);
+  float dl0_err = max_error(dl0_out, dl0_expected);
+  float dl1_err = max_error(dl1_out, dl1_expected);
+  printf("Max error: UL=%.2e; DL0=%.2e; DL1=%.2e\n", ul_err, dl0_err, dl1_err);
+  TESTASSERT(ul_err < 1e-3f);
+  TESTASSERT(dl0_err < 1e-5f);
+  TESTASSERT(dl1_err < 1e-5f);
+
+  // Excluding every UE produces silence
+  cf_t** no_ue[2] = {};
+  mux.run_ul(no_ue, out_buf, nof_samples, {});
+  TESTASSERT(srsran_vec_avg_power_cf(out_buf[0], nof_samples) == 0.0f);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    free(ue_buf[i][0]);
+  }
+  free(dl_buf[0]);
+  free(out_buf[0]);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_rf_mux() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
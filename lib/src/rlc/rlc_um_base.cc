@@ -259,12 +259,12 @@ void rlc_um_base::rlc_um_base_tx::empty_queue()
   }
 
   // deallocate SDU that is currently processed
-  tx_sdu.reset();
+  tx_sdu.clear();
 }
 
 bool rlc_um_base::rlc_um_base_tx::has_data()
 {
-  return (tx_sdu != nullptr || !tx_sdu_queue.is_empty());
+  return (!tx_sdu.empty() || !tx_sdu_queue.is_empty());
 }
 
 void rlc_um_base::rlc_um_base_tx::set_bsr_callback(bsr_callback_t callback)
@@ -333,7 +333,7 @@ uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t
     std::lock_guard<std::mutex> lock(mutex);
     RlcDebug("MAC opportunity - %d bytes", nof_bytes);
 
-    if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
+    if (tx_sdu.empty() && tx_sdu_queue.is_empty()) {
       RlcInfo("No data available to be sent");
       return 0;
     }
@@ -84,9 +84,9 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::get_buffer_state()
   // Bytes needed for tx SDUs
   uint32_t n_sdus  = tx_sdu_queue.size();
   uint32_t n_bytes = tx_sdu_queue.size_bytes();
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     n_sdus++;
-    n_bytes += tx_sdu->N_bytes;
+    n_bytes += tx_sdu.length();
   }
 
   // Room needed for header extensions? (integer rounding)
@@ -132,7 +132,6 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
   int head_len  = rlc_um_packed_length(&header);
   int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
@@ -142,20 +141,19 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
     return 0;
   }
 
+  // The PDU payload only references the SDU bytes; they are copied once, after the header is known
+  pdu_payload.clear();
+
   // Check for SDU segment
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     uint32_t space = pdu_space - head_len;
-    to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
-    RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    to_move        = space >= tx_sdu.length() ? tx_sdu.length() : space;
+    RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu.length());
+    pdu_payload.append(tx_sdu, 0, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
+    if (to_move == tx_sdu.length()) {
 #ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
+      auto latency_us = tx_sdu.md()->tp.get_latency_us().count();
       mean_pdu_latency_us.push(latency_us);
       RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
                (uint64_t)latency_us,
@@ -163,14 +161,16 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 #else
       RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
 #endif
-      tx_sdu.reset();
+      tx_sdu.clear();
+    } else {
+      tx_sdu.trim_head(to_move);
     }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
   // Pull SDUs from queue
-  while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0) {
+  while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0 && not pdu_payload.full()) {
     RlcDebug("pdu_space=%d, head_len=%d", pdu_space, head_len);
     if (last_li > 0) {
       header.li[header.N_li++] = last_li;
@@ -182,31 +182,31 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
       header.N_li--;
       break;
     }
-    tx_sdu  = tx_sdu_queue.read();
-    to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
-    RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    tx_sdu  = byte_buffer_chain(tx_sdu_queue.read());
+    to_move = (space >= tx_sdu.length()) ? tx_sdu.length() : space;
+    RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu.length());
+    pdu_payload.append(tx_sdu, 0, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
+    if (to_move == tx_sdu.length()) {
 #ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
+      if (not tx_sdu.empty()) {
+        auto latency_us = tx_sdu.md()->tp.get_latency_us().count();
+        mean_pdu_latency_us.push(latency_us);
+        RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
+                 (uint64_t)latency_us,
+                 (long)mean_pdu_latency_us.value());
+      }
 #else
       RlcDebug("Complete SDU scheduled for tx.");
 #endif
-      tx_sdu.reset();
+      tx_sdu.clear();
+    } else {
+      tx_sdu.trim_head(to_move);
     }
     pdu_space -= to_move;
   }
 
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
@@ -214,9 +214,11 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.sn = vt_us;
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
-  // Add header and TX
+  // Add header and gather the SDU segments behind it
   rlc_um_write_data_pdu_header(&header, pdu.get());
   memcpy(payload, pdu->msg, pdu->N_bytes);
+  pdu->N_bytes += pdu_payload.copy_to(payload + pdu->N_bytes, pdu_payload.length());
+  pdu_payload.clear();
 
   RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
 
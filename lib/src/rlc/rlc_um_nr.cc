@@ -92,9 +92,9 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::get_buffer_state()
   // Bytes needed for tx SDUs
   uint32_t n_sdus  = tx_sdu_queue.get_n_sdus();
   uint32_t n_bytes = tx_sdu_queue.size_bytes();
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     n_sdus++;
-    n_bytes += tx_sdu->N_bytes;
+    n_bytes += tx_sdu.length();
   }
 
   // Room needed for header extensions? (integer rounding)
@@ -153,26 +153,26 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
 
   // Select segmentation information and header size
-  if (tx_sdu == nullptr) {
+  if (tx_sdu.empty()) {
     // Read a new SDU
     do {
-      tx_sdu = tx_sdu_queue.read();
-    } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
-    if (tx_sdu == nullptr) {
+      tx_sdu = byte_buffer_chain(tx_sdu_queue.read());
+    } while (tx_sdu.empty() && tx_sdu_queue.size() != 0);
+    if (tx_sdu.empty()) {
       RlcDebug("Cannot build any PDU, tx_sdu_queue has no non-null SDU.");
       return 0;
     }
     next_so = 0;
 
     // Check for full SDU case
-    if (tx_sdu->N_bytes <= pdu_space - head_len_full) {
+    if (tx_sdu.length() <= pdu_space - head_len_full) {
       header.si = rlc_nr_si_field_t::full_sdu;
     } else {
       header.si = rlc_nr_si_field_t::first_segment;
     }
   } else {
     // The SDU is not new; check for last segment
-    if (tx_sdu->N_bytes <= pdu_space - head_len_segment) {
+    if (tx_sdu.length() <= pdu_space - head_len_segment) {
       header.si = rlc_nr_si_field_t::last_segment;
     } else {
       header.si = rlc_nr_si_field_t::neither_first_nor_last_segment;
@@ -189,22 +189,19 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
 
   // Calculate the amount of data to move
   uint32_t space   = pdu_space - head_len;
-  uint32_t to_move = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
+  uint32_t to_move = space >= tx_sdu.length() ? tx_sdu.length() : space;
 
   // Log
-  RlcDebug("adding %s - (%d/%d)", to_string(header.si).c_str(), to_move, tx_sdu->N_bytes);
+  RlcDebug("adding %s - (%d/%d)", to_string(header.si).c_str(), to_move, tx_sdu.length());
 
-  // Move data from SDU to PDU
-  uint8_t* pdu_ptr = pdu->msg;
-  memcpy(pdu_ptr, tx_sdu->msg, to_move);
-  pdu_ptr += to_move;
-  pdu->N_bytes += to_move;
-  tx_sdu->N_bytes -= to_move;
-  tx_sdu->msg += to_move;
+  // Reference the SDU segment; its bytes are copied once, behind the header
+  byte_buffer_chain pdu_payload = tx_sdu.slice(0, to_move);
 
   // Release SDU if emptied
-  if (tx_sdu->N_bytes == 0) {
-    tx_sdu.reset();
+  if (to_move == tx_sdu.length()) {
+    tx_sdu.clear();
+  } else {
+    tx_sdu.trim_head(to_move);
   }
 
   // advance SO offset
@@ -219,6 +216,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   // Add header and TX
   rlc_um_nr_write_data_pdu_header(header, pdu.get());
   memcpy(payload, pdu->msg, pdu->N_bytes);
+  pdu->N_bytes += pdu_payload.copy_to(payload + pdu->N_bytes, pdu_payload.length());
   uint32_t ret = pdu->N_bytes;
 
   // Assert number of bytes
@@ -21,6 +21,7 @@
 
 #include "backend_worker.h"
 #include "srsran/srslog/sink.h"
+#include <algorithm>
 
 using namespace srslog;
 
@@ -99,17 +100,10 @@ void backend_worker::do_work()
   constexpr std::chrono::microseconds sleep_period{100};
 
   while (running_flag) {
-    auto item = queue.try_pop();
-
     // Spin while there are no new entries to process.
-    if (!item.first) {
+    if (!process_batch()) {
       std::this_thread::sleep_for(sleep_period);
-      continue;
     }
-
-    report_queue_on_full_once();
-
-    process_log_entry(std::move(item.second));
   }
 
   // When we reach here, the thread is about to terminate, last chance to
@@ -151,18 +145,77 @@ void backend_worker::process_log_entry(detail::log_entry&& entry)
   }
 }
 
-void backend_worker::process_outstanding_entries()
+bool backend_worker::process_batch()
 {
-  assert(!running_flag && "Cannot process outstanding entries while thread is running");
+  /// Maximum number of entries extracted from the queue of each thread in a batch.
+  constexpr size_t max_entries_per_thread = 256;
 
-  while (true) {
-    auto item = queue.try_pop();
+  report_dropped_entries();
 
-    // Check if the queue is empty.
-    if (!item.first) {
-      break;
+  // A flush command ends the batch of its thread.
+  auto collect = [this](detail::log_entry&& entry) {
+    if (entry.flush_cmd) {
+      flush_cmds.push_back(std::move(entry));
+      return false;
     }
+    batch.push_back(std::move(entry));
+    return true;
+  };
+  size_t nof_entries = queue.pop_batch(collect, max_entries_per_thread);
+  if (nof_entries == 0) {
+    return false;
+  }
+
+  // Flush commands are executed after the batch. Extend the batch with all the entries pending in the queues of the
+  // other threads, so that a flush covers every entry pushed before it by any thread, and not only the ones that fit
+  // in the batch.
+  if (!flush_cmds.empty()) {
+    nof_entries += queue.pop_all([&collect](detail::log_entry&& entry) { collect(std::move(entry)); });
+  }
+
+  report_queue_on_full_once();
+
+  // Entries of each thread are already in order, merge the threads by timestamp.
+  batch_order.clear();
+  for (auto& entry : batch) {
+    batch_order.push_back(&entry);
+  }
+  std::stable_sort(batch_order.begin(), batch_order.end(), [](const detail::log_entry* a, const detail::log_entry* b) {
+    return a->metadata.tp < b->metadata.tp;
+  });
+  for (auto* entry : batch_order) {
+    process_log_entry(std::move(*entry));
+  }
+  batch.clear();
+
+  for (auto& cmd : flush_cmds) {
+    process_log_entry(std::move(cmd));
+  }
+  flush_cmds.clear();
+
+  return true;
+}
+
+void backend_worker::report_dropped_entries()
+{
+  uint64_t nof_drops = get_nof_dropped_entries();
+  if (nof_drops == nof_reported_drops) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_drop_report < std::chrono::seconds(1)) {
+    return;
+  }
+  err_handler(fmt::format("{} log entries were discarded because the backend queue was full",
+                          nof_drops - nof_reported_drops));
+  nof_reported_drops = nof_drops;
+  last_drop_report   = now;
+}
+
+void backend_worker::process_outstanding_entries()
+{
+  assert(!running_flag && "Cannot process outstanding entries while thread is running");
 
-    process_log_entry(std::move(item.second));
+  while (process_batch()) {
   }
 }
@@ -60,6 +60,10 @@ public:
   /// returns false.
   bool is_running() const { return running_flag; }
 
+  /// Returns the number of log entries discarded so far because the queue or
+  /// the argument pool were full.
+  uint64_t get_nof_dropped_entries() const { return queue.get_nof_dropped() + arg_pool.get_nof_alloc_failures(); }
+
   /// Uses the specified error handler to receive error notifications. Calls to
   /// this method when the worker is running will get ignored.
   void set_error_handler(error_handler new_err_handler)
@@ -90,6 +94,14 @@ private:
   /// Processes the log entry.
   void process_log_entry(detail::log_entry&& entry);
 
+  /// Extracts a batch of entries from the queue and processes them in
+  /// timestamp order. Flush commands are executed after the batch, which then
+  /// includes all the entries pushed before them. Returns false when the
+  /// queue was empty.
+  /// NOTE: Entries are still formatted and written to their sink one at a
+  /// time, since sinks like syslog expect a single entry per write.
+  bool process_batch();
+
   /// Processes outstanding entries in the queue until it gets empty.
   void process_outstanding_entries();
 
@@ -98,15 +110,19 @@ private:
   /// Error message is only reported once to avoid spamming.
   void report_queue_on_full_once()
   {
-    if (queue.is_almost_full()) {
+    if (!queue_full_reported && queue.is_almost_full()) {
       err_handler(fmt::format("The backend queue size is about to reach its maximum "
                               "capacity of {} elements, new log entries will get "
                               "discarded.\nConsider increasing the queue capacity.",
                               queue.get_capacity()));
-      err_handler = [](const std::string&) {};
+      queue_full_reported = true;
     }
   }
 
+  /// Reports the number of log entries discarded because the queue or the
+  /// argument pool were full, at most once per second.
+  void report_dropped_entries();
+
   /// Establishes the specified thread priority for the calling thread.
   void set_thread_priority(backend_priority priority) const;
 
@@ -118,6 +134,14 @@ private:
   std::once_flag     start_once_flag;
   std::thread        worker_thread;
   fmt::memory_buffer fmt_buffer;
+
+  /// Entries of the batch being processed and their processing order.
+  std::vector<detail::log_entry>        batch;
+  std::vector<detail::log_entry*>       batch_order;
+  std::vector<detail::log_entry>        flush_cmds;
+  bool                                  queue_full_reported = false;
+  uint64_t                              nof_reported_drops  = 0;
+  std::chrono::steady_clock::time_point last_drop_report;
 };
 
 } // namespace srslog
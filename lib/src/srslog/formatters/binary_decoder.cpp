@@ -0,0 +1,254 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "binary_decoder.h"
+#include "binary_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+
+using namespace srslog;
+
+/// Sequential reader of the raw input bytes.
+class binary_decoder::reader
+{
+public:
+  reader(const char* data, size_t size) : data(data), size(size) {}
+
+  bool empty() const { return pos == size; }
+
+  template <typename T>
+  bool get(T& value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be deserialized");
+    if (size - pos < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  bool get_bytes(const char*& ptr, uint32_t len)
+  {
+    if (size - pos < len) {
+      return false;
+    }
+    ptr = data + pos;
+    pos += len;
+    return true;
+  }
+
+  bool get_string(std::string& str)
+  {
+    uint32_t    len = 0;
+    const char* ptr = nullptr;
+    if (!get(len) || !get_bytes(ptr, len)) {
+      return false;
+    }
+    str.assign(ptr, len);
+    return true;
+  }
+
+  /// Returns true when all the remaining bytes are zero.
+  bool only_zeros_left() const
+  {
+    for (size_t i = pos; i != size; ++i) {
+      if (data[i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t get_pos() const { return pos; }
+
+private:
+  const char* data;
+  size_t      size;
+  size_t      pos = 0;
+};
+
+bool binary_decoder::decode_arg(reader& r)
+{
+  binary_log::arg_type type;
+  if (!r.get(type)) {
+    return false;
+  }
+
+  switch (type) {
+    case binary_log::arg_type::int32: {
+      int v;
+      return r.get(v) && (store.push_back(v), true);
+    }
+    case binary_log::arg_type::uint32: {
+      unsigned v;
+      return r.get(v) && (store.push_back(v), true);
+    }
+    case binary_log::arg_type::int64: {
+      int64_t v;
+      return r.get(v) && (store.push_back(static_cast<long long>(v)), true);
+    }
+    case binary_log::arg_type::uint64: {
+      uint64_t v;
+      return r.get(v) && (store.push_back(static_cast<unsigned long long>(v)), true);
+    }
+    case binary_log::arg_type::boolean: {
+      uint8_t v;
+      return r.get(v) && (store.push_back(v != 0), true);
+    }
+    case binary_log::arg_type::character: {
+      char v;
+      return r.get(v) && (store.push_back(v), true);
+    }
+    case binary_log::arg_type::f64: {
+      double v;
+      return r.get(v) && (store.push_back(v), true);
+    }
+    case binary_log::arg_type::long_f64: {
+      double v;
+      return r.get(v) && (store.push_back(static_cast<long double>(v)), true);
+    }
+    case binary_log::arg_type::string: {
+      std::string v;
+      return r.get_string(v) && (store.push_back(v), true);
+    }
+    case binary_log::arg_type::pointer: {
+      uint64_t v;
+      return r.get(v) && (store.push_back(reinterpret_cast<const void*>(v)), true);
+    }
+  }
+  return false;
+}
+
+bool binary_decoder::decode_entry(reader& r, fmt::memory_buffer& out)
+{
+  int64_t  tp_ns;
+  uint32_t ctx_value;
+  uint8_t  ctx_enabled;
+  char     tag;
+  uint32_t log_name_id;
+  uint32_t fmtstring_id;
+  uint8_t  has_args;
+  uint16_t nof_args;
+  if (!r.get(tp_ns) || !r.get(ctx_value) || !r.get(ctx_enabled) || !r.get(tag) || !r.get(log_name_id) ||
+      !r.get(fmtstring_id) || !r.get(has_args) || !r.get(nof_args)) {
+    return false;
+  }
+  if (log_name_id >= strings.size() || fmtstring_id >= strings.size()) {
+    return false;
+  }
+
+  store.clear();
+  for (uint16_t i = 0; i != nof_args; ++i) {
+    if (!decode_arg(r)) {
+      return false;
+    }
+  }
+
+  uint32_t    hex_len = 0;
+  const char* hex     = nullptr;
+  if (!r.get(hex_len) || !r.get_bytes(hex, hex_len)) {
+    return false;
+  }
+
+  detail::log_entry_metadata md = {
+      std::chrono::high_resolution_clock::time_point(
+          std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(tp_ns))),
+      {ctx_value, ctx_enabled != 0},
+      (fmtstring_id != 0) ? strings[fmtstring_id].c_str() : nullptr,
+      has_args ? &store : nullptr,
+      strings[log_name_id],
+      tag,
+      std::vector<uint8_t>(hex, hex + hex_len)};
+  formatter->format(std::move(md), out);
+  ++nof_entries;
+
+  return true;
+}
+
+detail::error_string binary_decoder::decode(const char*                                     data,
+                                            size_t                                          size,
+                                            fmt::memory_buffer&                             out,
+                                            const std::function<void(fmt::memory_buffer&)>& drain)
+{
+  const size_t drain_threshold = 64 * 1024;
+
+  if (size < binary_log::file_header_size || std::memcmp(data, binary_log::file_magic, sizeof(binary_log::file_magic))) {
+    return "Input is not a binary log";
+  }
+  uint32_t version;
+  std::memcpy(&version, data + sizeof(binary_log::file_magic), sizeof(version));
+  if (version != binary_log::file_version) {
+    return fmt::format("Unsupported binary log version {}", version);
+  }
+
+  reader r(data + binary_log::file_header_size, size - binary_log::file_header_size);
+  strings.assign(1, "");
+  while (!r.empty()) {
+    size_t                  record_pos = r.get_pos() + binary_log::file_header_size;
+    binary_log::record_type type;
+    r.get(type);
+
+    bool ok = false;
+    switch (type) {
+      case binary_log::record_type::string: {
+        uint32_t    id;
+        std::string str;
+        ok = r.get(id) && r.get_string(str) && id == strings.size();
+        if (ok) {
+          strings.push_back(std::move(str));
+        }
+        break;
+      }
+      case binary_log::record_type::entry:
+        ok = decode_entry(r, out);
+        break;
+      case binary_log::record_type::text: {
+        std::string str;
+        ok = r.get_string(str);
+        if (ok) {
+          out.append(str.data(), str.data() + str.size());
+        }
+        break;
+      }
+      default:
+        ok = static_cast<uint8_t>(type) == 0 && r.only_zeros_left();
+        if (ok) {
+          r = reader(nullptr, 0);
+        }
+        break;
+    }
+
+    if (drain && (!ok || out.size() > drain_threshold)) {
+      drain(out);
+      out.clear();
+    }
+    if (!ok) {
+      return fmt::format("Malformed or truncated record at offset {}", record_pos);
+    }
+  }
+
+  if (drain) {
+    drain(out);
+    out.clear();
+  }
+
+  return {};
+}
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#ifndef SRSLOG_BINARY_DECODER_H
+#define SRSLOG_BINARY_DECODER_H
+
+#include "srsran/srslog/detail/support/error_string.h"
+#include "srsran/srslog/bundled/fmt/printf.h"
+#include "srsran/srslog/formatter.h"
+#include <functional>
+
+namespace srslog {
+
+/// Decodes the output of the binary formatter, rendering every log entry with
+/// the provided formatter (e.g. text or JSON).
+class binary_decoder
+{
+public:
+  explicit binary_decoder(std::unique_ptr<log_formatter> f) : formatter(std::move(f)) {}
+
+  /// Decodes a complete binary log, starting with the file header, appending
+  /// the rendered entries into the output buffer. Decoding stops at the first
+  /// malformed or truncated record, returning an error. Trailing zeros, left by
+  /// a memory-mapped file that was not closed properly, are ignored.
+  /// When a drain function is provided, it gets called each time the output
+  /// buffer grows past a threshold and once at the end, clearing the buffer
+  /// afterwards, so that large logs can be decoded with bounded memory.
+  detail::error_string decode(const char*                                     data,
+                              size_t                                          size,
+                              fmt::memory_buffer&                             out,
+                              const std::function<void(fmt::memory_buffer&)>& drain = {});
+
+  /// Returns the number of log entries decoded so far.
+  size_t get_nof_entries() const { return nof_entries; }
+
+private:
+  class reader;
+
+  /// Decodes a log entry record.
+  bool decode_entry(reader& r, fmt::memory_buffer& out);
+
+  /// Decodes a format argument, adding it to the argument store.
+  bool decode_arg(reader& r);
+
+private:
+  std::unique_ptr<log_formatter>                     formatter;
+  std::vector<std::string>                           strings;
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  size_t                                             nof_entries = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_DECODER_H
@@ -0,0 +1,272 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "binary_formatter.h"
+#include "srsran/srslog/bundled/fmt/chrono.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+
+using namespace srslog;
+
+void binary_log::write_file_header(fmt::memory_buffer& buffer)
+{
+  buffer.append(file_magic, file_magic + sizeof(file_magic));
+  auto* p = reinterpret_cast<const char*>(&file_version);
+  buffer.append(p, p + sizeof(file_version));
+}
+
+/// Appends the raw bytes of a trivially copyable value into the buffer.
+template <typename T>
+static void put(fmt::memory_buffer& buffer, T value)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be serialized");
+  auto* p = reinterpret_cast<const char*>(&value);
+  buffer.append(p, p + sizeof(T));
+}
+
+/// Appends a length prefixed string into the buffer.
+static void put_string(fmt::memory_buffer& buffer, fmt::string_view str)
+{
+  put<uint32_t>(buffer, str.size());
+  buffer.append(str.data(), str.data() + str.size());
+}
+
+/// Serializes each format argument according to its type.
+namespace {
+struct arg_serializer {
+  using format_arg = fmt::basic_format_arg<fmt::printf_context>;
+
+  fmt::memory_buffer& buffer;
+
+  void operator()(int v) { put_arg(binary_log::arg_type::int32, v); }
+  void operator()(unsigned v) { put_arg(binary_log::arg_type::uint32, v); }
+  void operator()(long long v) { put_arg(binary_log::arg_type::int64, static_cast<int64_t>(v)); }
+  void operator()(unsigned long long v) { put_arg(binary_log::arg_type::uint64, static_cast<uint64_t>(v)); }
+  void operator()(bool v) { put_arg(binary_log::arg_type::boolean, static_cast<uint8_t>(v)); }
+  void operator()(char v) { put_arg(binary_log::arg_type::character, v); }
+  void operator()(float v) { put_arg(binary_log::arg_type::f64, static_cast<double>(v)); }
+  void operator()(double v) { put_arg(binary_log::arg_type::f64, v); }
+  void operator()(long double v) { put_arg(binary_log::arg_type::long_f64, static_cast<double>(v)); }
+  void operator()(const char* v) { put_str(v ? fmt::string_view(v) : fmt::string_view("(null)")); }
+  void operator()(fmt::string_view v) { put_str(v); }
+  void operator()(const void* v) { put_arg(binary_log::arg_type::pointer, reinterpret_cast<uint64_t>(v)); }
+
+  /// Remaining types (user defined types, 128 bit integers) are rendered to
+  /// text using the generic conversion specifier.
+  template <typename T>
+  void operator()(T)
+  {
+    put_str("?");
+  }
+
+  template <typename T>
+  void put_arg(binary_log::arg_type type, T value)
+  {
+    put(buffer, type);
+    put(buffer, value);
+  }
+
+  void put_str(fmt::string_view str)
+  {
+    put(buffer, binary_log::arg_type::string);
+    put_string(buffer, str);
+  }
+};
+} // namespace
+
+/// Renders a single argument to text with the printf formatting rules.
+static std::string render_arg_to_string(const fmt::basic_format_arg<fmt::printf_context>& arg)
+{
+  fmt::basic_format_args<fmt::printf_context> args(&arg, 1);
+  try {
+    return fmt::vsprintf(fmt::string_view("%s"), args);
+  } catch (...) {
+    return "?";
+  }
+}
+
+std::unique_ptr<log_formatter> binary_formatter::clone() const
+{
+  // Dictionary state belongs to the stream being written, clones start empty.
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
+uint32_t binary_formatter::define_string(fmt::string_view str, fmt::memory_buffer& buffer)
+{
+  auto id = static_cast<uint32_t>(strings.size());
+  strings.emplace_back(str.data(), str.size());
+
+  put(buffer, binary_log::record_type::string);
+  put(buffer, id);
+  put_string(buffer, str);
+
+  return id;
+}
+
+uint32_t binary_formatter::get_fmtstring_id(const char* fmtstring, fmt::memory_buffer& buffer)
+{
+  if (!fmtstring) {
+    return 0;
+  }
+
+  auto it = fmtstring_ids.find(fmtstring);
+  if (it != fmtstring_ids.end()) {
+    return it->second;
+  }
+
+  uint32_t id              = define_string(fmtstring, buffer);
+  fmtstring_ids[fmtstring] = id;
+  return id;
+}
+
+uint32_t binary_formatter::get_log_name_id(const std::string& name, fmt::memory_buffer& buffer)
+{
+  auto it = log_name_ids.find(name);
+  if (it != log_name_ids.end()) {
+    return it->second;
+  }
+
+  uint32_t id        = define_string(name, buffer);
+  log_name_ids[name] = id;
+  return id;
+}
+
+void binary_formatter::format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer)
+{
+  // Dictionary records must precede the entry that references them.
+  uint32_t fmtstring_id = get_fmtstring_id(metadata.fmtstring, buffer);
+  uint32_t log_name_id  = get_log_name_id(metadata.log_name, buffer);
+
+  put(buffer, binary_log::record_type::entry);
+  put<int64_t>(buffer, std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.tp.time_since_epoch()).count());
+  put<uint32_t>(buffer, metadata.context.value);
+  put<uint8_t>(buffer, metadata.context.enabled);
+  put(buffer, metadata.log_tag);
+  put(buffer, log_name_id);
+  put(buffer, fmtstring_id);
+  put<uint8_t>(buffer, metadata.store != nullptr);
+
+  // Reserve the argument count and patch it once all arguments are written.
+  size_t nof_args_offset = buffer.size();
+  put<uint16_t>(buffer, 0);
+  uint16_t nof_args = 0;
+  if (metadata.store) {
+    fmt::basic_format_args<fmt::printf_context> args(*metadata.store);
+    for (auto arg = args.get(0); arg.type() != fmt::detail::type::none_type; arg = args.get(++nof_args)) {
+      if (arg.type() == fmt::detail::type::custom_type || arg.type() == fmt::detail::type::int128_type ||
+          arg.type() == fmt::detail::type::uint128_type) {
+        arg_serializer{buffer}.put_str(render_arg_to_string(arg));
+        continue;
+      }
+      fmt::visit_format_arg(arg_serializer{buffer}, arg);
+    }
+  }
+  std::memcpy(buffer.data() + nof_args_offset, &nof_args, sizeof(nof_args));
+
+  put<uint32_t>(buffer, metadata.hex_dump.size());
+  buffer.append(metadata.hex_dump.data(), metadata.hex_dump.data() + metadata.hex_dump.size());
+}
+
+/// Renders the log metadata as plain text into the input buffer.
+static void format_metadata(const detail::log_entry_metadata& metadata, fmt::memory_buffer& buffer)
+{
+  std::tm current_time = fmt::gmtime(std::chrono::high_resolution_clock::to_time_t(metadata.tp));
+  auto    us_fraction =
+      std::chrono::duration_cast<std::chrono::microseconds>(metadata.tp.time_since_epoch()).count() % 1000000u;
+  fmt::format_to(buffer, "{:%F}T{:%H:%M:%S}.{:06} ", current_time, current_time, us_fraction);
+
+  if (!metadata.log_name.empty()) {
+    fmt::format_to(buffer, "[{: <7}] ", metadata.log_name);
+  }
+  if (metadata.log_tag != '\0') {
+    fmt::format_to(buffer, "[{}] ", metadata.log_tag);
+  }
+  if (metadata.context.enabled) {
+    fmt::format_to(buffer, "[{:5}] ", metadata.context.value);
+  }
+}
+
+void binary_formatter::format_context_begin(const detail::log_entry_metadata& md,
+                                            fmt::string_view                  ctx_name,
+                                            unsigned                          size,
+                                            fmt::memory_buffer&               buffer)
+{
+  put(buffer, binary_log::record_type::text);
+  text_length_offset = buffer.size();
+  put<uint32_t>(buffer, 0);
+
+  format_metadata(md, buffer);
+  fmt::format_to(buffer, "Context dump for \"{}\"\n", ctx_name);
+}
+
+void binary_formatter::format_context_end(const detail::log_entry_metadata& md,
+                                          fmt::string_view                  ctx_name,
+                                          fmt::memory_buffer&               buffer)
+{
+  if (md.fmtstring) {
+    if (md.store) {
+      fmt::basic_format_args<fmt::printf_context> args(*md.store);
+      try {
+        fmt::vprintf(buffer, fmt::to_string_view(md.fmtstring), args);
+      } catch (...) {
+        fmt::format_to(buffer, " -> srsLog error - Invalid format string: \"{}\"", md.fmtstring);
+      }
+      fmt::format_to(buffer, "\n");
+    } else {
+      fmt::format_to(buffer, "{}\n", md.fmtstring);
+    }
+  }
+
+  auto length = static_cast<uint32_t>(buffer.size() - text_length_offset - sizeof(uint32_t));
+  std::memcpy(buffer.data() + text_length_offset, &length, sizeof(length));
+}
+
+void binary_formatter::format_metric_set_begin(fmt::string_view    set_name,
+                                               unsigned            size,
+                                               unsigned            level,
+                                               fmt::memory_buffer& buffer)
+{
+  fmt::format_to(buffer, "{: <{}}> Set: {}\n", ' ', level * 2, set_name);
+}
+
+void binary_formatter::format_list_begin(fmt::string_view    list_name,
+                                         unsigned            size,
+                                         unsigned            level,
+                                         fmt::memory_buffer& buffer)
+{
+  fmt::format_to(buffer, "{: <{}}> List: {}\n", ' ', level * 2, list_name);
+}
+
+void binary_formatter::format_metric(fmt::string_view    metric_name,
+                                     fmt::string_view    metric_value,
+                                     fmt::string_view    metric_units,
+                                     metric_kind         kind,
+                                     unsigned            level,
+                                     fmt::memory_buffer& buffer)
+{
+  fmt::format_to(buffer,
+                 "{: <{}}{}: {}{}{}\n",
+                 ' ',
+                 level * 2,
+                 metric_name,
+                 metric_value,
+                 metric_units.size() == 0 ? "" : " ",
+                 metric_units);
+}
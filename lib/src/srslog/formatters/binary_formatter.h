@@ -0,0 +1,128 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#ifndef SRSLOG_BINARY_FORMATTER_H
+#define SRSLOG_BINARY_FORMATTER_H
+
+#include "srsran/srslog/formatter.h"
+#include <unordered_map>
+
+namespace srslog {
+
+/// Definitions of the binary log format shared by the binary formatter and the
+/// offline decoder. All integers are stored in host byte order.
+///
+/// A binary log starts with a file header followed by a sequence of records.
+/// Every record starts with a one byte record type:
+///   - string: u32 id, u32 length, characters. Defines an entry of the string
+///     dictionary, emitted the first time a format string or log name is seen.
+///   - entry: i64 timestamp in ns, u32 context value, u8 context enabled flag,
+///     char tag, u32 log name id, u32 format string id (0 when absent),
+///     u8 arguments present flag, u16 argument count, arguments, u32 hex dump
+///     length, hex dump bytes.
+///   - text: u32 length, characters. Already formatted text, used for
+///     contexts.
+/// Each argument is stored as a one byte argument type followed by its raw
+/// value, strings are stored as u32 length followed by the characters.
+namespace binary_log {
+
+/// Magic string written at the start of every binary log file.
+constexpr char     file_magic[]     = "SRSLOGB";
+constexpr uint32_t file_version     = 1;
+constexpr size_t   file_header_size = sizeof(file_magic) + sizeof(file_version);
+
+enum class record_type : uint8_t { string = 1, entry, text };
+
+enum class arg_type : uint8_t { int32 = 1, uint32, int64, uint64, boolean, character, f64, long_f64, string, pointer };
+
+/// Writes the file header into the input buffer.
+void write_file_header(fmt::memory_buffer& buffer);
+
+} // namespace binary_log
+
+/// Binary formatter implementation class.
+/// Instead of rendering log entries to text, the format string is replaced by
+/// an id into a string dictionary and the arguments are stored in their raw
+/// binary form, leaving the actual formatting to the offline decoder. Contexts
+/// are rendered to plain text and stored as text records.
+/// NOTE: the formatter is stateful, the decoder needs to process the output
+/// from its beginning to rebuild the dictionary.
+class binary_formatter : public log_formatter
+{
+public:
+  std::unique_ptr<log_formatter> clone() const override;
+
+  void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
+
+private:
+  void format_context_begin(const detail::log_entry_metadata& md,
+                            fmt::string_view                  ctx_name,
+                            unsigned                          size,
+                            fmt::memory_buffer&               buffer) override;
+
+  void format_context_end(const detail::log_entry_metadata& md,
+                          fmt::string_view                  ctx_name,
+                          fmt::memory_buffer&               buffer) override;
+
+  void format_metric_set_begin(fmt::string_view    set_name,
+                               unsigned            size,
+                               unsigned            level,
+                               fmt::memory_buffer& buffer) override;
+
+  void format_metric_set_end(fmt::string_view set_name, unsigned level, fmt::memory_buffer& buffer) override {}
+
+  void
+  format_list_begin(fmt::string_view list_name, unsigned size, unsigned level, fmt::memory_buffer& buffer) override;
+
+  void format_list_end(fmt::string_view list_name, unsigned level, fmt::memory_buffer& buffer) override {}
+
+  void format_metric(fmt::string_view    metric_name,
+                     fmt::string_view    metric_value,
+                     fmt::string_view    metric_units,
+                     metric_kind         kind,
+                     unsigned            level,
+                     fmt::memory_buffer& buffer) override;
+
+  /// Returns the dictionary id of the specified format string, emitting a
+  /// string record into the buffer when it is seen for the first time.
+  uint32_t get_fmtstring_id(const char* fmtstring, fmt::memory_buffer& buffer);
+
+  /// Returns the dictionary id of the specified log name, emitting a string
+  /// record into the buffer when it is seen for the first time.
+  uint32_t get_log_name_id(const std::string& name, fmt::memory_buffer& buffer);
+
+  /// Emits a string record into the buffer and returns its new id.
+  uint32_t define_string(fmt::string_view str, fmt::memory_buffer& buffer);
+
+private:
+  /// Format strings are looked up by address only. Log entries already keep a
+  /// pointer to their format string until the backend formats them, so they
+  /// are expected to be literals. A format string whose contents change at the
+  /// same address keeps its first id and is decoded with its first contents.
+  std::unordered_map<const char*, uint32_t> fmtstring_ids;
+  std::unordered_map<std::string, uint32_t> log_name_ids;
+  std::vector<std::string>                  strings = {""};
+  /// Offset in the buffer of the length field of the text record being built.
+  size_t text_length_offset = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMATTER_H
@@ -60,6 +60,9 @@ public:
   /// Stops the backend worker thread.
   void stop() { worker.stop(); }
 
+  /// Returns the number of log entries discarded so far because the backend was full.
+  uint64_t get_nof_dropped_entries() const { return worker.get_nof_dropped_entries(); }
+
 private:
   detail::work_queue<detail::log_entry> queue;
   detail::dyn_arg_store_pool            arg_pool;
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#ifndef SRSLOG_MMAP_FILE_SINK_H
+#define SRSLOG_MMAP_FILE_SINK_H
+
+#include "file_utils.h"
+#include "srsran/srslog/sink.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace srslog {
+
+/// This sink implementation writes into a memory-mapped file. The file is grown
+/// and mapped in fixed size chunks so that writing an entry is a plain memory
+/// copy and the kernel takes care of writing back the pages. Contents written
+/// before a crash of the application are not lost as they live in the page
+/// cache. On destruction the file is truncated to the amount of written data.
+/// An optional preamble gets written at the start of the file.
+class mmap_file_sink : public sink
+{
+public:
+  mmap_file_sink(std::string                    filename,
+                 size_t                         chunk_size,
+                 std::unique_ptr<log_formatter> f,
+                 std::string                    preamble = "") :
+    sink(std::move(f)),
+    filename(std::move(filename)),
+    chunk_size(round_to_page_size(chunk_size)),
+    preamble(std::move(preamble))
+  {}
+
+  ~mmap_file_sink() override { close(); }
+
+  mmap_file_sink(const mmap_file_sink& other) = delete;
+  mmap_file_sink& operator=(const mmap_file_sink& other) = delete;
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    // Create the file the first time we hit this method.
+    if (!is_file_created) {
+      is_file_created = true;
+      if (auto err_str = create_file()) {
+        return err_str;
+      }
+      if (auto err_str = copy(preamble.data(), preamble.size())) {
+        return err_str;
+      }
+    }
+
+    return copy(buffer.data(), buffer.size());
+  }
+
+  detail::error_string flush() override
+  {
+    if (map == nullptr || ::msync(map, map_pos, MS_ASYNC) == 0) {
+      return {};
+    }
+
+    auto err_str = file_utils::format_error(fmt::format("Error encountered while flushing log file \"{}\"", filename),
+                                            errno);
+    close();
+    return err_str;
+  }
+
+private:
+  static size_t round_to_page_size(size_t size)
+  {
+    auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return std::max<size_t>(page_size, (size + page_size - 1) / page_size * page_size);
+  }
+
+  /// Creates the file and maps its first chunk.
+  detail::error_string create_file()
+  {
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      return file_utils::format_error(fmt::format("Unable to create log file \"{}\"", filename), errno);
+    }
+    return map_chunk(0);
+  }
+
+  /// Grows the file by one chunk and maps it at the specified file offset.
+  detail::error_string map_chunk(size_t offset)
+  {
+    if (map != nullptr) {
+      ::munmap(map, chunk_size);
+      map = nullptr;
+    }
+
+    if (::ftruncate(fd, offset + chunk_size) == 0) {
+      void* ptr = ::mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+      if (ptr != MAP_FAILED) {
+        map        = static_cast<char*>(ptr);
+        map_offset = offset;
+        map_pos    = 0;
+        return {};
+      }
+    }
+
+    auto err_str = file_utils::format_error(fmt::format("Unable to map log file \"{}\"", filename), errno);
+    close();
+    return err_str;
+  }
+
+  /// Copies the input data into the mapped region, mapping new chunks as
+  /// required.
+  detail::error_string copy(const char* data, size_t size)
+  {
+    // Do not bother doing any work when the file was closed on a previous
+    // error.
+    while (map != nullptr && size > 0) {
+      if (map_pos == chunk_size) {
+        if (auto err_str = map_chunk(map_offset + chunk_size)) {
+          return err_str;
+        }
+      }
+      size_t n = std::min(size, chunk_size - map_pos);
+      std::memcpy(map + map_pos, data, n);
+      map_pos += n;
+      data += n;
+      size -= n;
+    }
+    return {};
+  }
+
+  /// Unmaps the file and trims the unused space at its end.
+  void close()
+  {
+    if (map != nullptr) {
+      ::munmap(map, chunk_size);
+      map = nullptr;
+    }
+    if (fd >= 0) {
+      (void)::ftruncate(fd, map_offset + map_pos);
+      ::close(fd);
+      fd = -1;
+    }
+  }
+
+private:
+  const std::string filename;
+  const size_t      chunk_size;
+  const std::string preamble;
+  int               fd              = -1;
+  char*             map             = nullptr;
+  size_t            map_offset      = 0;
+  size_t            map_pos         = 0;
+  bool              is_file_created = false;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_MMAP_FILE_SINK_H
@@ -20,8 +20,10 @@
  */
 
 #include "srsran/srslog/srslog.h"
+#include "formatters/binary_formatter.h"
 #include "formatters/json_formatter.h"
 #include "sinks/file_sink.h"
+#include "sinks/mmap_file_sink.h"
 #include "sinks/syslog_sink.h"
 #include "srslog_instance.h"
 
@@ -105,6 +107,11 @@ std::unique_ptr<log_formatter> srslog::create_json_formatter()
   return std::unique_ptr<log_formatter>(new json_formatter);
 }
 
+std::unique_ptr<log_formatter> srslog::create_binary_formatter()
+{
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
 ///
 /// Sink management function implementations.
 ///
@@ -178,6 +185,28 @@ sink& srslog::fetch_file_sink(const std::string&             path,
   return *s;
 }
 
+sink& srslog::fetch_binary_file_sink(const std::string& path, size_t chunk_size)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  fmt::memory_buffer header;
+  binary_log::write_file_header(header);
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(
+          new mmap_file_sink(path, chunk_size, create_binary_formatter(), fmt::to_string(header))));
+
+  return *s;
+}
+
 sink& srslog::fetch_syslog_sink(const std::string&             preamble_,
                                 syslog_local_type              log_local_,
                                 std::unique_ptr<log_formatter> f)
@@ -253,6 +282,11 @@ void srslog::flush()
   }
 }
 
+uint64_t srslog::get_nof_dropped_log_entries()
+{
+  return srslog_instance::get().get_nof_dropped_entries();
+}
+
 void srslog::set_error_handler(error_handler handler)
 {
   srslog_instance::get().set_error_handler(std::move(handler));
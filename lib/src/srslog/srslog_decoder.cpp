@@ -0,0 +1,114 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+/// Renders the binary logs written by the srslog binary file sink into plain
+/// text or JSON.
+
+#include "formatters/binary_decoder.h"
+#include "srsran/srslog/srslog.h"
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace srslog;
+
+static bool        use_json    = false;
+static std::string output_path = "";
+static std::string input_path  = "";
+
+static void usage(char* prog)
+{
+  fmt::print("Usage: {} [-j] [-o output_file] binary_log_file\n", prog);
+  fmt::print("\t-j render entries as JSON objects instead of plain text\n");
+  fmt::print("\t-o output file [Default stdout]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "jo:h")) != -1) {
+    switch (opt) {
+      case 'j':
+        use_json = true;
+        break;
+      case 'o':
+        output_path = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (optind != argc - 1) {
+    usage(argv[0]);
+    exit(-1);
+  }
+  input_path = argv[optind];
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  int fd = ::open(input_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    fmt::print(stderr, "Unable to open input file \"{}\"\n", input_path);
+    return -1;
+  }
+  struct stat st = {};
+  if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+    fmt::print(stderr, "Unable to read input file \"{}\"\n", input_path);
+    ::close(fd);
+    return -1;
+  }
+  void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    fmt::print(stderr, "Unable to map input file \"{}\"\n", input_path);
+    return -1;
+  }
+
+  std::FILE* output = output_path.empty() ? stdout : std::fopen(output_path.c_str(), "w");
+  if (!output) {
+    fmt::print(stderr, "Unable to create output file \"{}\"\n", output_path);
+    return -1;
+  }
+
+  binary_decoder       decoder(use_json ? create_json_formatter() : create_text_formatter());
+  fmt::memory_buffer   buffer;
+  detail::error_string err =
+      decoder.decode(static_cast<const char*>(data), st.st_size, buffer, [output](fmt::memory_buffer& b) {
+        std::fwrite(b.data(), 1, b.size(), output);
+      });
+
+  if (output != stdout) {
+    std::fclose(output);
+  }
+  ::munmap(data, st.st_size);
+
+  if (err) {
+    fmt::print(stderr, "{} after {} entries\n", err.get_error(), decoder.get_nof_entries());
+    return -1;
+  }
+
+  return 0;
+}
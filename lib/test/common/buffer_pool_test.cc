@@ -0,0 +1,202 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/support/srsran_test.h"
+#include <thread>
+
+struct test_buffer_t {
+  uint32_t value = 0;
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+  char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
+#endif
+};
+
+using test_pool_t = srsran::buffer_pool<test_buffer_t>;
+
+void test_single_thread()
+{
+  const uint32_t capacity = 64;
+  test_pool_t    pool(capacity);
+  TESTASSERT(pool.nof_available_pdus() == capacity);
+
+  // Deplete the pool
+  std::vector<test_buffer_t*> bufs;
+  for (uint32_t i = 0; i < capacity; ++i) {
+    test_buffer_t* b = pool.allocate("test");
+    TESTASSERT(b != nullptr);
+    bufs.push_back(b);
+  }
+  TESTASSERT(pool.nof_available_pdus() == 0);
+  TESTASSERT(pool.allocate("test") == nullptr);
+
+  // Buffers not created by the pool are rejected
+  test_buffer_t foreign;
+  bool ret = pool.deallocate(&foreign);
+  TESTASSERT(not ret);
+
+  for (test_buffer_t* b : bufs) {
+    ret = pool.deallocate(b);
+    TESTASSERT(ret);
+  }
+  TESTASSERT(pool.nof_available_pdus() == capacity);
+
+  // Part of the freed buffers stay in the local cache of this thread
+  test_pool_t::metrics_t m = pool.get_metrics();
+  TESTASSERT(m.capacity == capacity);
+  TESTASSERT(m.thread_caches.size() == 1);
+  TESTASSERT(m.thread_caches[0].id == std::this_thread::get_id());
+  TESTASSERT(m.nof_central_free + m.thread_caches[0].nof_cached == capacity);
+  TESTASSERT(m.thread_caches[0].nof_cached < capacity);
+}
+
+void test_cross_thread()
+{
+  const uint32_t capacity = 256, nof_iters = 100000;
+  test_pool_t    pool(capacity);
+
+  // Producer allocates in one thread and the consumer frees in another, as done by the MAC PDU queue
+  srsran::static_blocking_queue<test_buffer_t*, 64> q;
+  std::thread                                       producer([&]() {
+    for (uint32_t i = 0; i < nof_iters; ++i) {
+      test_buffer_t* b = pool.allocate("producer", true);
+      b->value         = i;
+      q.push_blocking(b);
+    }
+  });
+
+  for (uint32_t i = 0; i < nof_iters; ++i) {
+    test_buffer_t* b = q.pop_blocking();
+    TESTASSERT(b->value == i);
+    bool ret = pool.deallocate(b);
+    TESTASSERT(ret);
+  }
+  producer.join();
+
+  // The cache of the exited producer thread was returned to the pool
+  TESTASSERT(pool.nof_available_pdus() == capacity);
+  TESTASSERT(pool.get_metrics().thread_caches.size() == 1);
+}
+
+void test_reclaim_other_thread_caches()
+{
+  const uint32_t capacity = 128, nof_threads = 8;
+  test_pool_t    pool(capacity);
+
+  // Each thread leaves some free buffers in its local cache, and stays alive so that the cache is not returned
+  std::mutex               mutex;
+  std::condition_variable  cvar;
+  uint32_t                 nof_ready = 0;
+  bool                     done      = false;
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < nof_threads; ++i) {
+    threads.emplace_back([&]() {
+      std::vector<test_buffer_t*> bufs;
+      for (uint32_t j = 0; j < capacity / nof_threads / 2; ++j) {
+        bufs.push_back(pool.allocate("cached"));
+        TESTASSERT(bufs.back() != nullptr);
+      }
+      for (test_buffer_t* b : bufs) {
+        bool ret = pool.deallocate(b);
+        TESTASSERT(ret);
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      nof_ready++;
+      cvar.notify_all();
+      cvar.wait(lock, [&]() { return done; });
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [&]() { return nof_ready == nof_threads; });
+  }
+  test_pool_t::metrics_t m = pool.get_metrics();
+  TESTASSERT(m.thread_caches.size() == nof_threads);
+  TESTASSERT(m.nof_central_free < capacity);
+
+  // All the buffers can still be allocated from another thread
+  std::vector<test_buffer_t*> bufs;
+  for (uint32_t i = 0; i < capacity; ++i) {
+    bufs.push_back(pool.allocate("reclaim"));
+    TESTASSERT(bufs.back() != nullptr);
+  }
+  TESTASSERT(pool.nof_available_pdus() == 0);
+  TESTASSERT(pool.allocate("reclaim") == nullptr);
+  for (test_buffer_t* b : bufs) {
+    bool ret = pool.deallocate(b);
+    TESTASSERT(ret);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  cvar.notify_all();
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  TESTASSERT(pool.nof_available_pdus() == capacity);
+}
+
+void test_thread_outlives_pool()
+{
+  std::unique_ptr<test_pool_t> pool(new test_pool_t(32));
+  std::mutex                   mutex;
+  std::condition_variable      cvar;
+  bool                         pool_used = false, pool_deleted = false;
+
+  std::thread t([&]() {
+    // Leave a buffer in the cache of this thread
+    bool ret = pool->deallocate(pool->allocate());
+    TESTASSERT(ret);
+    std::unique_lock<std::mutex> lock(mutex);
+    pool_used = true;
+    cvar.notify_one();
+    cvar.wait(lock, [&]() { return pool_deleted; });
+
+    // A new pool must not reuse the cache of the deleted one
+    test_pool_t    pool2(32);
+    test_buffer_t* b = pool2.allocate();
+    TESTASSERT(b != nullptr);
+    ret = pool2.deallocate(b);
+    TESTASSERT(ret);
+    TESTASSERT(pool2.nof_available_pdus() == 32);
+  });
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [&]() { return pool_used; });
+    pool.reset();
+    pool_deleted = true;
+  }
+  cvar.notify_one();
+  t.join();
+}
+
+int main()
+{
+  srslog::init();
+  test_single_thread();
+  test_cross_thread();
+  test_reclaim_other_thread_caches();
+  test_thread_outlives_pool();
+  return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/byte_buffer_chain.h"
+#include "srsran/support/srsran_test.h"
+#include <numeric>
+#include <vector>
+
+using namespace srsran;
+
+std::vector<uint8_t> make_bytes(uint32_t len, uint8_t first)
+{
+  std::vector<uint8_t> v(len);
+  std::iota(v.begin(), v.end(), first);
+  return v;
+}
+
+std::vector<uint8_t> gather(const byte_buffer_chain& chain)
+{
+  std::vector<uint8_t> v(chain.length());
+  TESTASSERT(chain.copy_to(v.data(), v.size()) == chain.length());
+  return v;
+}
+
+void test_slab_alloc()
+{
+  byte_buffer_slab_ptr small(byte_buffer_slab::create(100));
+  byte_buffer_slab_ptr large(byte_buffer_slab::create(9000));
+  TESTASSERT(small and large);
+  TESTASSERT(not small->is_adopted() and small->capacity() >= 100);
+  TESTASSERT(not large->is_adopted() and large->capacity() >= 9000);
+  TESTASSERT(byte_buffer_slab::create(byte_buffer_slab::max_size() + 1) == nullptr);
+
+  byte_buffer_slab_ptr copy = small;
+  TESTASSERT(small->is_shared() and copy->is_shared());
+  copy.reset();
+  TESTASSERT(not small->is_shared());
+
+  // An adopted buffer holds the slab header in its headroom
+  unique_byte_buffer_t buf = make_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  buf->N_bytes                = 10;
+  uint8_t*             msg    = buf->msg;
+  uint8_t*             bufend = buf->buffer + sizeof(buf->buffer);
+  byte_buffer_slab_ptr adopted(byte_buffer_slab::adopt(std::move(buf)));
+  TESTASSERT(adopted and adopted->is_adopted());
+  TESTASSERT(adopted->begin() <= msg and adopted->end() == bufend);
+
+  // Without headroom left, the payload is copied to a new slab
+  buf = make_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  buf->msg     = buf->buffer;
+  buf->N_bytes = 10;
+  std::iota(buf->msg, buf->msg + buf->N_bytes, 0);
+  byte_buffer_chain chain(std::move(buf));
+  TESTASSERT(chain.length() == 10 and not chain.segment(0).slab->is_adopted());
+  TESTASSERT(gather(chain) == make_bytes(10, 0));
+}
+
+void test_append()
+{
+  std::vector<uint8_t> payload = make_bytes(3000, 0);
+  byte_buffer_chain    chain;
+  TESTASSERT(chain.append(payload.data(), 1000));
+  TESTASSERT(chain.nof_segments() == 1);
+  // The exclusive tail slab is filled before a new slab is allocated
+  TESTASSERT(chain.append(payload.data() + 1000, 2000));
+  TESTASSERT(chain.length() == 3000);
+  TESTASSERT(gather(chain) == payload);
+
+  // Once the tail slab is shared, its tailroom is not written and a new slab is used instead
+  size_t            nseg = chain.nof_segments();
+  byte_buffer_chain view = chain.slice(0, chain.length());
+  TESTASSERT(chain.append(payload.data(), 10));
+  TESTASSERT(chain.nof_segments() == nseg + 1 and chain.length() == 3010);
+  TESTASSERT(view.length() == 3000 and gather(view) == payload);
+}
+
+void test_zero_copy_segmentation()
+{
+  unique_byte_buffer_t sdu = make_byte_buffer();
+  TESTASSERT(sdu != nullptr);
+  std::vector<uint8_t> payload = make_bytes(1500, 7);
+  sdu->append_bytes(payload.data(), payload.size());
+  sdu->md.pdcp_sn = 5;
+  uint8_t* sdu_ptr = sdu->msg;
+
+  byte_buffer_chain chain(std::move(sdu));
+  TESTASSERT(chain.length() == 1500 and chain.md()->pdcp_sn == 5);
+  TESTASSERT(chain.segment(0).data == sdu_ptr);
+
+  // Segment the SDU into three PDU payloads, which point into the SDU buffer
+  std::vector<uint8_t> reassembled;
+  uint32_t             nof_pdus = 0;
+  while (not chain.empty()) {
+    uint32_t          n   = std::min(600U, chain.length());
+    byte_buffer_chain pdu = chain.slice(0, n);
+    chain.trim_head(n);
+    TESTASSERT(pdu.segment(0).data >= sdu_ptr and pdu.segment(0).data < sdu_ptr + 1500);
+    std::vector<uint8_t> v = gather(pdu);
+    reassembled.insert(reassembled.end(), v.begin(), v.end());
+    nof_pdus++;
+  }
+  TESTASSERT(nof_pdus == 3);
+  TESTASSERT(reassembled == payload);
+
+  // Concatenation of views from several chains
+  byte_buffer_chain a, b, cat;
+  TESTASSERT(a.append(payload.data(), 100));
+  TESTASSERT(b.append(payload.data() + 100, 50));
+  TESTASSERT(cat.append(a, 10, 90));
+  TESTASSERT(cat.append(b));
+  TESTASSERT(cat.nof_segments() == 2 and cat.length() == 140);
+  TESTASSERT(gather(cat) == std::vector<uint8_t>(payload.begin() + 10, payload.begin() + 150));
+}
+
+void test_trim()
+{
+  std::vector<uint8_t> payload = make_bytes(300, 1);
+  byte_buffer_chain    chain;
+  for (uint32_t i = 0; i < 3; ++i) {
+    byte_buffer_chain part;
+    TESTASSERT(part.append(payload.data() + i * 100, 100));
+    TESTASSERT(chain.append(part));
+  }
+  TESTASSERT(chain.nof_segments() == 3);
+  chain.trim_head(150);
+  TESTASSERT(chain.nof_segments() == 2 and chain.length() == 150);
+  TESTASSERT(gather(chain) == std::vector<uint8_t>(payload.begin() + 150, payload.end()));
+  chain.trim_head(150);
+  TESTASSERT(chain.empty() and chain.nof_segments() == 0);
+}
+
+int main()
+{
+  srslog::init();
+  test_slab_alloc();
+  test_append();
+  test_zero_copy_segmentation();
+  test_trim();
+  return 0;
+}
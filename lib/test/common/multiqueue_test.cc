@@ -120,6 +120,76 @@ int test_multiqueue()
   return 0;
 }
 
+int test_multiqueue_latency_histogram()
+{
+  std::cout << "\n===== TEST multiqueue latency histogram: start =====\n";
+
+  multiqueue_handler<int> multiqueue;
+  queue_handle<int>       qid = multiqueue.add_queue();
+  int                     number;
+
+  // latencies are only measured once enabled
+  TESTASSERT(qid.try_push(1));
+  TESTASSERT(multiqueue.wait_pop(&number));
+  TESTASSERT(multiqueue.get_latency_histogram().count == 0);
+
+  multiqueue.enable_latency_histogram(true);
+  TESTASSERT(qid.try_push(2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  TESTASSERT(qid.try_push(3));
+  TESTASSERT(multiqueue.wait_pop(&number) and number == 2);
+  TESTASSERT(multiqueue.wait_pop(&number) and number == 3);
+
+  multiqueue_latency_histogram hist = multiqueue.get_latency_histogram();
+  TESTASSERT(hist.count == 2);
+  TESTASSERT(hist.max_us >= 2000);
+  TESTASSERT(hist.percentile_us(100) >= 2000);
+  TESTASSERT(multiqueue_latency_histogram::bucket_idx(0) == 0);
+  TESTASSERT(multiqueue_latency_histogram::bucket_idx(1) == 1);
+  TESTASSERT(multiqueue_latency_histogram::bucket_idx(1000) == 10);
+
+  // a consumer waiting on an empty multiqueue is woken up by the producer
+  std::thread t([&qid]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    qid.push(4);
+  });
+  TESTASSERT(multiqueue.wait_pop(&number) and number == 4);
+  t.join();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===========================================\n";
+  return 0;
+}
+
+int test_multiqueue_many_ports()
+{
+  std::cout << "\n===== TEST multiqueue many ports: start =====\n";
+
+  // the table of ports grows beyond its initial size
+  const uint32_t                 nof_ports = 3 * MULTIQUEUE_DEFAULT_NOF_PORTS + 1;
+  multiqueue_handler<int>        multiqueue;
+  std::vector<queue_handle<int>> qids;
+  for (uint32_t i = 0; i < nof_ports; ++i) {
+    qids.push_back(multiqueue.add_queue(4));
+    TESTASSERT(qids.back().active());
+    TESTASSERT(qids.back().try_push((int)i).has_value());
+  }
+  TESTASSERT(multiqueue.nof_queues() == nof_ports);
+
+  std::vector<bool> popped(nof_ports, false);
+  int               number;
+  for (uint32_t i = 0; i < nof_ports; ++i) {
+    TESTASSERT(multiqueue.try_pop(&number));
+    TESTASSERT(number >= 0 and number < (int)nof_ports and not popped[number]);
+    popped[number] = true;
+  }
+  TESTASSERT(not multiqueue.try_pop(&number));
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===========================================\n";
+  return 0;
+}
+
 int test_multiqueue_threading()
 {
   std::cout << "\n===== TEST multiqueue threading test: start =====\n";
@@ -410,6 +480,85 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_work_stealing_thread_pool()
+{
+  std::cout << "\n====== TEST work-stealing thread pool test: start ======\n";
+  // Description: check that all tasks run, including the ones pushed from inside workers, that tasks pushed to a
+  //              busy worker are stolen by the others, and that tasks that do not fit in the worker queues are not lost
+
+  uint32_t nof_workers = 4, nof_runs = 10000;
+
+  work_stealing_thread_pool thread_pool(nof_workers);
+
+  struct test_ctxt {
+    work_stealing_thread_pool* pool;
+    std::atomic<uint32_t>      count{0};
+  } ctxt;
+  ctxt.pool = &thread_pool;
+
+  for (uint32_t i = 0; i < nof_runs; ++i) {
+    thread_pool.push_task([&ctxt, i]() {
+      if (i % 2 == 0) {
+        // nested task, pushed to the queue of this worker
+        ctxt.pool->push_task([&ctxt]() { ctxt.count++; });
+      }
+      ctxt.count++;
+    });
+  }
+  while (ctxt.count < nof_runs + nof_runs / 2) {
+    usleep(100);
+  }
+  TESTASSERT(ctxt.count == nof_runs + nof_runs / 2);
+  TESTASSERT(thread_pool.nof_pending_tasks() == 0);
+
+  // Block one worker; the tasks queued behind it are stolen by the other workers
+  std::atomic<bool>     release{false};
+  std::atomic<uint32_t> count{0};
+  thread_pool.push_task([&release]() {
+    while (not release) {
+      usleep(100);
+    }
+  });
+  for (uint32_t i = 0; i < 100; ++i) {
+    thread_pool.push_task([&count]() { count++; });
+  }
+  while (count < 100) {
+    usleep(100);
+  }
+  release = true;
+  thread_pool.stop();
+
+  // Fill the queue of a single blocked worker beyond its capacity. The remaining tasks go to the overflow queue
+  work_stealing_thread_pool single_pool(1);
+  const uint32_t            nof_tasks = 20000;
+  std::atomic<bool>         started{false};
+  release = false;
+  count   = 0;
+  single_pool.push_task([&started, &release]() {
+    started = true;
+    while (not release) {
+      usleep(100);
+    }
+  });
+  while (not started) {
+    usleep(100);
+  }
+  for (uint32_t i = 0; i < nof_tasks; ++i) {
+    single_pool.push_task([&count]() { count++; });
+  }
+  TESTASSERT(single_pool.nof_pending_tasks() == nof_tasks);
+  release = true;
+  while (count < nof_tasks) {
+    usleep(100);
+  }
+  TESTASSERT(count == nof_tasks);
+  single_pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -495,6 +644,8 @@ int test_inplace_task()
 int main()
 {
   TESTASSERT(test_multiqueue() == 0);
+  TESTASSERT(test_multiqueue_latency_histogram() == 0);
+  TESTASSERT(test_multiqueue_many_ports() == 0);
   TESTASSERT(test_multiqueue_threading() == 0);
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
@@ -503,6 +654,7 @@ int main()
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_work_stealing_thread_pool() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
 }
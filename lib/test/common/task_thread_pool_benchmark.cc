@@ -0,0 +1,202 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Compares task_thread_pool and work_stealing_thread_pool under a load similar to the eNB background tasks: several
+/// producer threads (stack, PHY workers) push short tasks every TTI. The latency between push and task start, the time
+/// spent by producers inside push_task and the total run time are reported.
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <getopt.h>
+#include <thread>
+
+using namespace srsran;
+using bench_clock = std::chrono::steady_clock;
+
+namespace {
+
+struct bench_args_t {
+  uint32_t nof_workers      = 4;
+  uint32_t nof_producers    = 4;
+  uint32_t nof_ttis         = 2000;
+  uint32_t tasks_per_tti    = 8;
+  uint32_t task_duration_us = 5;
+  uint32_t tti_duration_us  = 1000;
+} args;
+
+struct bench_result_t {
+  std::vector<uint64_t> wakeup_ns;
+  std::vector<uint64_t> push_ns;
+  uint64_t              total_us = 0;
+};
+
+void busy_wait(std::chrono::microseconds interval)
+{
+  auto end = bench_clock::now() + interval;
+  while (bench_clock::now() < end) {
+  }
+}
+
+uint64_t elapsed_ns(bench_clock::time_point tp)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - tp).count();
+}
+
+template <typename Pool>
+bench_result_t run_benchmark(Pool& pool)
+{
+  uint32_t                            nof_tasks = args.nof_producers * args.nof_ttis * args.tasks_per_tti;
+  std::vector<std::atomic<uint64_t> > wakeup_ns(nof_tasks);
+  std::vector<std::vector<uint64_t> > push_ns(args.nof_producers);
+  std::atomic<uint32_t>               nof_done{0};
+  std::vector<std::thread>            producers;
+  std::chrono::microseconds           task_duration(args.task_duration_us);
+
+  auto t_start = bench_clock::now();
+  for (uint32_t p = 0; p < args.nof_producers; ++p) {
+    producers.emplace_back([&, p]() {
+      push_ns[p].reserve(args.nof_ttis * args.tasks_per_tti);
+      auto tti_start = bench_clock::now();
+      for (uint32_t tti = 0; tti < args.nof_ttis; ++tti) {
+        for (uint32_t i = 0; i < args.tasks_per_tti; ++i) {
+          uint32_t                idx     = (p * args.nof_ttis + tti) * args.tasks_per_tti + i;
+          bench_clock::time_point tp_push = bench_clock::now();
+          std::atomic<uint64_t>*  wakeup  = &wakeup_ns[idx];
+          pool.push_task([tp_push, wakeup, &nof_done, task_duration]() {
+            wakeup->store(elapsed_ns(tp_push), std::memory_order_relaxed);
+            busy_wait(task_duration);
+            nof_done.fetch_add(1, std::memory_order_release);
+          });
+          push_ns[p].push_back(elapsed_ns(tp_push));
+        }
+        tti_start += std::chrono::microseconds(args.tti_duration_us);
+        std::this_thread::sleep_until(tti_start);
+      }
+    });
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  while (nof_done.load(std::memory_order_acquire) < nof_tasks) {
+    std::this_thread::yield();
+  }
+
+  bench_result_t ret;
+  ret.total_us = std::chrono::duration_cast<std::chrono::microseconds>(bench_clock::now() - t_start).count();
+  for (std::atomic<uint64_t>& w : wakeup_ns) {
+    ret.wakeup_ns.push_back(w.load(std::memory_order_relaxed));
+  }
+  for (std::vector<uint64_t>& v : push_ns) {
+    ret.push_ns.insert(ret.push_ns.end(), v.begin(), v.end());
+  }
+  return ret;
+}
+
+void print_percentiles(const char* name, std::vector<uint64_t>& v)
+{
+  std::sort(v.begin(), v.end());
+  fmt::print("  {:<16}|{:8}|{:8}|{:8}|{:8}|{:10}|\n",
+             name,
+             v[v.size() / 2],
+             v[v.size() * 9 / 10],
+             v[v.size() * 99 / 100],
+             v[v.size() * 999 / 1000],
+             v.back());
+}
+
+void print_result(const char* pool_name, bench_result_t& res)
+{
+  fmt::print("{}: total={} us\n", pool_name, res.total_us);
+  fmt::print("  {:<16}|{:>8}|{:>8}|{:>8}|{:>8}|{:>10}|\n", "[ns]", "50th", "90th", "99th", "99.9th", "worst");
+  print_percentiles("push->start", res.wakeup_ns);
+  print_percentiles("push_task()", res.push_ns);
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [wpntdT]\n", prog);
+  printf("\t-w number of pool workers [Default %d]\n", args.nof_workers);
+  printf("\t-p number of producer threads [Default %d]\n", args.nof_producers);
+  printf("\t-n number of TTIs [Default %d]\n", args.nof_ttis);
+  printf("\t-t tasks pushed per producer and TTI [Default %d]\n", args.tasks_per_tti);
+  printf("\t-d task duration in us [Default %d]\n", args.task_duration_us);
+  printf("\t-T TTI duration in us, 0 pushes without pause [Default %d]\n", args.tti_duration_us);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "w:p:n:t:d:T:h")) != -1) {
+    switch (opt) {
+      case 'w':
+        args.nof_workers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'p':
+        args.nof_producers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        args.nof_ttis = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        args.tasks_per_tti = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'd':
+        args.task_duration_us = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'T':
+        args.tti_duration_us = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  fmt::print("{} workers, {} producers, {} TTIs of {} us, {} tasks of {} us per producer and TTI\n\n",
+             args.nof_workers,
+             args.nof_producers,
+             args.nof_ttis,
+             args.tti_duration_us,
+             args.tasks_per_tti,
+             args.task_duration_us);
+
+  {
+    task_thread_pool pool(args.nof_workers);
+    bench_result_t   res = run_benchmark(pool);
+    print_result("task_thread_pool", res);
+  }
+  {
+    work_stealing_thread_pool pool(args.nof_workers);
+    bench_result_t            res = run_benchmark(pool);
+    print_result("work_stealing_thread_pool", res);
+  }
+
+  return 0;
+}
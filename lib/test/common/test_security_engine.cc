@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security_engine.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <random>
+#include <vector>
+
+using namespace srsran;
+
+static std::mt19937 rand_gen(0);
+
+// The reference security_128_eea2() does not support empty messages, see test_empty()
+static const uint32_t test_lens[] = {1, 7, 8, 15, 16, 17, 31, 32, 33, 64, 100, 1500, 1503, 8188};
+
+int test_eea2_single()
+{
+  aes128_security_engine engine;
+  uint8_t                key[16];
+  for (uint8_t& k : key) {
+    k = rand_gen();
+  }
+  engine.set_key(key);
+  TESTASSERT(engine.is_set());
+
+  for (uint32_t len : test_lens) {
+    uint32_t             count     = rand_gen();
+    uint8_t              bearer    = rand_gen() % 32;
+    uint8_t              direction = rand_gen() % 2;
+    std::vector<uint8_t> msg(len + 1), ref(len + 1), out(len + 1);
+    for (uint8_t& b : msg) {
+      b = rand_gen();
+    }
+    security_128_eea2(key, count, bearer, direction, msg.data(), len, ref.data());
+    engine.eea2(count, bearer, direction, msg.data(), len, out.data());
+    TESTASSERT(memcmp(ref.data(), out.data(), len) == 0);
+
+    // In place
+    engine.eea2(count, bearer, direction, msg.data(), len, msg.data());
+    TESTASSERT(memcmp(ref.data(), msg.data(), len) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_eia2_single()
+{
+  aes128_security_engine engine;
+  uint8_t                key[16];
+  for (uint8_t& k : key) {
+    k = rand_gen();
+  }
+  engine.set_key(key);
+
+  for (uint32_t len : test_lens) {
+    uint32_t             count     = rand_gen();
+    uint8_t              bearer    = rand_gen() % 32;
+    uint8_t              direction = rand_gen() % 2;
+    std::vector<uint8_t> msg(len + 1);
+    uint8_t              ref[4], mac[4];
+    for (uint8_t& b : msg) {
+      b = rand_gen();
+    }
+    security_128_eia2(key, count, bearer, direction, msg.data(), len, ref);
+    engine.eia2(count, bearer, direction, msg.data(), len, mac);
+    TESTASSERT(memcmp(ref, mac, 4) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_empty()
+{
+  aes128_security_engine engine;
+  uint8_t                key[16] = {};
+  engine.set_key(key);
+
+  uint8_t msg[1] = {0x5a}, out[1] = {0xa5}, mac[4] = {};
+  uint8_t ref[4];
+  engine.eea2(0, 0, 0, msg, 0, out);
+  TESTASSERT(out[0] == 0xa5);
+  security_128_eia2(key, 0, 0, 0, msg, 0, ref);
+  engine.eia2(0, 0, 0, msg, 0, mac);
+  TESTASSERT(memcmp(ref, mac, 4) == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  printf("AES-NI engine: %s\n", aes128_security_engine::is_accelerated() ? "yes" : "no");
+  TESTASSERT(test_eea2_single() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eia2_single() == SRSRAN_SUCCESS);
+  TESTASSERT(test_empty() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
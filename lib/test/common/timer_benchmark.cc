@@ -0,0 +1,195 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Measures the cost of the timer_handler operations with a large number of active timers, similar to an eNB with many
+/// UEs, where each SDU in flight has a PDCP discard timer running. Every TTI, a number of timers is restarted (new SDUs)
+/// and stopped (acknowledged SDUs) before the timer wheel is stepped. Expired timers are restarted from their callback.
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include <algorithm>
+#include <getopt.h>
+#include <random>
+
+using namespace srsran;
+using bench_clock = std::chrono::steady_clock;
+
+namespace {
+
+struct bench_args_t {
+  uint32_t nof_timers     = 100000;
+  uint32_t nof_ttis       = 10000;
+  uint32_t nof_restarts   = 1000;
+  uint32_t nof_stops      = 500;
+  uint32_t min_duration   = 10;
+  uint32_t max_duration   = 1500;
+  bool     locked_only    = false;
+} args;
+
+struct bench_result_t {
+  std::vector<uint64_t> step_ns;
+  std::vector<uint64_t> restart_ns;
+  std::vector<uint64_t> stop_ns;
+  uint64_t              nof_expired = 0;
+};
+
+uint64_t elapsed_ns(bench_clock::time_point tp)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - tp).count();
+}
+
+bench_result_t run_benchmark(bool thread_safe)
+{
+  timer_handler                           timers(args.nof_timers, thread_safe);
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> dur_dist(args.min_duration, args.max_duration);
+  std::uniform_int_distribution<uint32_t> timer_dist(0, args.nof_timers - 1);
+  bench_result_t                          ret;
+
+  std::vector<unique_timer> tlist(args.nof_timers);
+  for (uint32_t i = 0; i < args.nof_timers; ++i) {
+    tlist[i] = timers.get_unique_timer();
+    tlist[i].set(dur_dist(rgen), [&tlist, &ret](uint32_t tid) {
+      ret.nof_expired++;
+      tlist[tid].run();
+    });
+    tlist[i].run();
+  }
+
+  ret.step_ns.reserve(args.nof_ttis);
+  ret.restart_ns.reserve(args.nof_ttis);
+  ret.stop_ns.reserve(args.nof_ttis);
+  for (uint32_t tti = 0; tti < args.nof_ttis; ++tti) {
+    bench_clock::time_point tp = bench_clock::now();
+    for (uint32_t i = 0; i < args.nof_restarts; ++i) {
+      tlist[timer_dist(rgen)].run();
+    }
+    ret.restart_ns.push_back(elapsed_ns(tp));
+
+    tp = bench_clock::now();
+    for (uint32_t i = 0; i < args.nof_stops; ++i) {
+      uint32_t idx = timer_dist(rgen);
+      tlist[idx].stop();
+      // keep the number of active timers constant
+      tlist[idx].run();
+    }
+    ret.stop_ns.push_back(elapsed_ns(tp));
+
+    tp = bench_clock::now();
+    timers.step_all();
+    ret.step_ns.push_back(elapsed_ns(tp));
+  }
+  TESTASSERT(timers.nof_running_timers() == args.nof_timers);
+  return ret;
+}
+
+void print_percentiles(const char* name, std::vector<uint64_t>& v)
+{
+  std::sort(v.begin(), v.end());
+  fmt::print("  {:<16}|{:8}|{:8}|{:8}|{:8}|{:10}|\n",
+             name,
+             v[v.size() / 2],
+             v[v.size() * 9 / 10],
+             v[v.size() * 99 / 100],
+             v[v.size() * 999 / 1000],
+             v.back());
+}
+
+void print_result(const char* name, bench_result_t& res)
+{
+  fmt::print("{}: {} expiries\n", name, res.nof_expired);
+  fmt::print("  {:<16}|{:>8}|{:>8}|{:>8}|{:>8}|{:>10}|\n", "[ns/TTI]", "50th", "90th", "99th", "99.9th", "worst");
+  print_percentiles("step_all()", res.step_ns);
+  print_percentiles("run()", res.restart_ns);
+  print_percentiles("stop()+run()", res.stop_ns);
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nTrsdDl]\n", prog);
+  printf("\t-n number of active timers [Default %d]\n", args.nof_timers);
+  printf("\t-T number of TTIs [Default %d]\n", args.nof_ttis);
+  printf("\t-r timers restarted per TTI [Default %d]\n", args.nof_restarts);
+  printf("\t-s timers stopped per TTI [Default %d]\n", args.nof_stops);
+  printf("\t-d minimum timer duration [Default %d]\n", args.min_duration);
+  printf("\t-D maximum timer duration [Default %d]\n", args.max_duration);
+  printf("\t-l only run the benchmark with the backend lock [Default %s]\n", args.locked_only ? "true" : "false");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:T:r:s:d:D:lh")) != -1) {
+    switch (opt) {
+      case 'n':
+        args.nof_timers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'T':
+        args.nof_ttis = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'r':
+        args.nof_restarts = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        args.nof_stops = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'd':
+        args.min_duration = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'D':
+        args.max_duration = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'l':
+        args.locked_only = true;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  fmt::print("{} active timers with durations in [{}, {}], {} TTIs, {} restarts and {} stops per TTI\n\n",
+             args.nof_timers,
+             args.min_duration,
+             args.max_duration,
+             args.nof_ttis,
+             args.nof_restarts,
+             args.nof_stops);
+
+  {
+    bench_result_t res = run_benchmark(true);
+    print_result("timer_handler", res);
+  }
+  if (not args.locked_only) {
+    bench_result_t res = run_benchmark(false);
+    print_result("timer_handler (thread_safe=false)", res);
+  }
+
+  return 0;
+}
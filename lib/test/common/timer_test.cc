@@ -448,6 +448,89 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Tests specific to the hierarchical wheel:
+ * - timers with long durations are cascaded to the finer levels and expire at the right tic
+ * - random start/stop/restart sequences match a reference model, also when the backend lock is elided
+ */
+void timers_test8()
+{
+  timer_handler timers;
+  uint32_t      durations[] = {255, 256, 257, 16383, 16384, 16385, 70000, 1048577};
+
+  std::vector<unique_timer> tlist;
+  for (uint32_t dur : durations) {
+    tlist.push_back(timers.get_unique_timer());
+    tlist.back().set(dur);
+    tlist.back().run();
+  }
+  // start the timers at an offset, so that cascading does not happen at an aligned tic
+  timers.step_all();
+  tlist.push_back(timers.get_unique_timer());
+  tlist.back().set(20000);
+  tlist.back().run();
+
+  for (uint32_t t = 1; t <= 1048577; ++t) {
+    for (uint32_t i = 0; i < tlist.size(); ++i) {
+      uint32_t timeout = i < sizeof(durations) / sizeof(durations[0]) ? durations[i] : 20001;
+      if (t == timeout - 1 or t == timeout) {
+        TESTASSERT(tlist[i].is_running() == (t < timeout));
+        TESTASSERT(tlist[i].is_expired() == (t >= timeout));
+      }
+    }
+    timers.step_all();
+  }
+  TESTASSERT(timers.nof_running_timers() == 0);
+
+  // the maximum duration is covered by the upper wheel level
+  tlist[0].set(timer_handler::max_timer_duration());
+  tlist[0].run();
+  TESTASSERT(tlist[0].time_elapsed() == 0 and tlist[0].is_running());
+  tlist[0].stop();
+  TESTASSERT(timers.nof_running_timers() == 0);
+}
+
+void timers_test9(bool thread_safe)
+{
+  const uint32_t nof_timers = 256, nof_tics = 100000;
+  timer_handler  timers(nof_timers, thread_safe);
+  std::mt19937   rgen(nof_timers);
+
+  std::vector<unique_timer> tlist(nof_timers);
+  std::vector<uint32_t>     expected_timeout(nof_timers, 0);
+  std::vector<uint32_t>     expiry_tic(nof_timers, 0);
+  uint32_t                  now = 0;
+  for (uint32_t i = 0; i < nof_timers; ++i) {
+    tlist[i] = timers.get_unique_timer();
+    tlist[i].set(1, [&expiry_tic, &now](uint32_t tid) { expiry_tic[tid] = now; });
+  }
+
+  for (; now < nof_tics; ++now) {
+    // randomly restart or stop a few timers, with durations that span several wheel levels
+    for (uint32_t n = 0; n < 4; ++n) {
+      uint32_t i = rgen() % nof_timers;
+      if (rgen() % 8 == 0) {
+        tlist[i].stop();
+        expected_timeout[i] = 0;
+      } else {
+        uint32_t dur = 1 + rgen() % (1U << (rgen() % 16));
+        tlist[i].set(dur);
+        tlist[i].run();
+        expected_timeout[i] = now + dur;
+      }
+    }
+    timers.step_all();
+    for (uint32_t i = 0; i < nof_timers; ++i) {
+      if (expected_timeout[i] == now + 1) {
+        TESTASSERT(tlist[i].is_expired() and expiry_tic[i] == now);
+        expected_timeout[i] = 0;
+      } else {
+        TESTASSERT(tlist[i].is_running() == (expected_timeout[i] != 0));
+      }
+    }
+  }
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +540,9 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
+  timers_test9(true);
+  timers_test9(false);
   printf("Success\n");
   return 0;
 }
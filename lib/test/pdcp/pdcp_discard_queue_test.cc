@@ -0,0 +1,187 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_discard_queue.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsran;
+
+/*
+ * SDUs arriving in the same TTI are discarded together, once their timeout is reached
+ */
+int test_batch_discard()
+{
+  task_scheduler        task_sched;
+  pdcp_discard_queue    discard_timers(&task_sched);
+  std::vector<uint32_t> discarded;
+  discard_timers.configure(16, 10, [&discarded](uint32_t sn) { discarded.push_back(sn); });
+
+  discard_timers.start(0);
+  discard_timers.start(1);
+  task_sched.tic();
+  task_sched.tic();
+  discard_timers.start(2);
+  TESTASSERT(discard_timers.nof_running() == 3);
+
+  // SN=0 and SN=1 were started at t=0, SN=2 at t=2
+  for (uint32_t i = 0; i < 7; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.empty());
+  task_sched.tic();
+  TESTASSERT(discarded == std::vector<uint32_t>({0, 1}));
+  TESTASSERT(discard_timers.nof_running() == 1 and discard_timers.is_running(2));
+  task_sched.tic();
+  TESTASSERT(discarded.size() == 2);
+  task_sched.tic();
+  TESTASSERT(discarded == std::vector<uint32_t>({0, 1, 2}));
+  TESTASSERT(discard_timers.nof_running() == 0);
+
+  // The clock restarts when the queue gets empty
+  discard_timers.start(3);
+  for (uint32_t i = 0; i < 9; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.size() == 3);
+  task_sched.tic();
+  TESTASSERT(discarded.size() == 4 and discarded.back() == 3);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Stopping the oldest SDU re-arms the bearer timer for the next one, without discarding it early
+ */
+int test_stop_discard()
+{
+  task_scheduler        task_sched;
+  pdcp_discard_queue    discard_timers(&task_sched);
+  std::vector<uint32_t> discarded;
+  discard_timers.configure(16, 10, [&discarded](uint32_t sn) { discarded.push_back(sn); });
+
+  for (uint32_t sn = 0; sn < 5; ++sn) {
+    discard_timers.start(sn);
+    task_sched.tic();
+  }
+  TESTASSERT(discard_timers.stop(0));
+  TESTASSERT(not discard_timers.stop(0));
+  TESTASSERT(discard_timers.stop(3));
+  TESTASSERT(discard_timers.nof_running() == 3);
+
+  // SN=1 was started at t=1 and expires at t=11
+  for (uint32_t t = 5; t < 10; ++t) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.empty());
+  task_sched.tic();
+  TESTASSERT(discarded == std::vector<uint32_t>({1}));
+  task_sched.tic();
+  TESTASSERT(discarded == std::vector<uint32_t>({1, 2}));
+  task_sched.tic();
+  task_sched.tic();
+  TESTASSERT(discarded == std::vector<uint32_t>({1, 2, 4}));
+  TESTASSERT(discard_timers.nof_running() == 0);
+
+  // clear() stops all timers without discarding
+  discard_timers.start(5);
+  discard_timers.start(6);
+  discard_timers.clear();
+  TESTASSERT(discard_timers.nof_running() == 0);
+  for (uint32_t i = 0; i < 20; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.size() == 3);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * A SN that reuses the ring position of an SDU still in flight discards the older SDU
+ */
+int test_ring_wraparound()
+{
+  task_scheduler        task_sched;
+  pdcp_discard_queue    discard_timers(&task_sched);
+  std::vector<uint32_t> discarded;
+  discard_timers.configure(4, 100, [&discarded](uint32_t sn) { discarded.push_back(sn); });
+
+  for (uint32_t sn = 0; sn < 6; ++sn) {
+    discard_timers.start(sn);
+  }
+  TESTASSERT(discarded == std::vector<uint32_t>({0, 1}));
+  TESTASSERT(discard_timers.nof_running() == 4);
+  TESTASSERT(not discard_timers.is_running(0) and discard_timers.is_running(4));
+  TESTASSERT(not discard_timers.stop(0));
+  TESTASSERT(discard_timers.stop(4));
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The ring grows with the SDUs in flight, up to the configured capacity, keeping their arrival order
+ */
+int test_ring_growth()
+{
+  task_scheduler        task_sched;
+  pdcp_discard_queue    discard_timers(&task_sched);
+  std::vector<uint32_t> discarded;
+  discard_timers.configure(1024, 300, [&discarded](uint32_t sn) { discarded.push_back(sn); });
+
+  for (uint32_t sn = 0; sn < 200; ++sn) {
+    discard_timers.start(sn);
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.empty());
+  TESTASSERT(discard_timers.nof_running() == 200);
+  TESTASSERT(discard_timers.stop(100));
+
+  // SN=0 was started at t=0
+  for (uint32_t t = 200; t < 299; ++t) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.empty());
+  for (uint32_t t = 299; t < 500; ++t) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.size() == 199);
+  for (uint32_t i = 0; i < discarded.size(); ++i) {
+    TESTASSERT(discarded[i] == (i < 100 ? i : i + 1));
+  }
+
+  // Reconfiguring with a zero timeout stops and disables the discard timers
+  discard_timers.start(200);
+  discard_timers.configure(1024, 0, [&discarded](uint32_t sn) { discarded.push_back(sn); });
+  discard_timers.start(201);
+  TESTASSERT(discard_timers.nof_running() == 0);
+  for (uint32_t i = 0; i < 400; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(discarded.size() == 199);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_batch_discard() == SRSRAN_SUCCESS);
+  TESTASSERT(test_stop_discard() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ring_wraparound() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ring_growth() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
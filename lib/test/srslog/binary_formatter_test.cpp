@@ -0,0 +1,259 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "file_test_utils.h"
+#include "src/srslog/formatters/binary_decoder.h"
+#include "src/srslog/formatters/binary_formatter.h"
+#include "src/srslog/formatters/json_formatter.h"
+#include "src/srslog/formatters/text_formatter.h"
+#include "src/srslog/sinks/mmap_file_sink.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "test_dummies.h"
+#include "testing_helpers.h"
+#include <fstream>
+#include <iterator>
+
+using namespace srslog;
+
+using arg_store = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
+static constexpr char log_filename[] = "binary_formatter_test.log";
+
+/// Helper to build a log entry.
+static detail::log_entry_metadata
+build_log_entry_metadata(arg_store* store, const char* fmtstring = "Text %d", unsigned us = 50000)
+{
+  using tp_ty = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  tp_ty tp(std::chrono::microseconds{us});
+
+  if (store) {
+    store->push_back(88);
+  }
+
+  return {tp, {10, true}, fmtstring, store, "ABC", 'Z'};
+}
+
+/// Returns a binary log holding the file header.
+static fmt::memory_buffer build_binary_log()
+{
+  fmt::memory_buffer buffer;
+  binary_log::write_file_header(buffer);
+  return buffer;
+}
+
+/// Decodes the input binary log with the specified formatter.
+static std::string decode(const fmt::memory_buffer& log, std::unique_ptr<log_formatter> f)
+{
+  fmt::memory_buffer out;
+  binary_decoder     decoder(std::move(f));
+  if (auto err = decoder.decode(log.data(), log.size(), out)) {
+    return err.get_error();
+  }
+  return fmt::to_string(out);
+}
+
+static bool when_entries_are_decoded_then_output_matches_the_text_formatter()
+{
+  fmt::memory_buffer binary = build_binary_log();
+  fmt::memory_buffer expected;
+  binary_formatter   binary_fmt;
+  text_formatter     text_fmt;
+
+  auto fill_args = [](arg_store& store) {
+    store.push_back(-5);
+    store.push_back(7u);
+    store.push_back(-123456789012LL);
+    store.push_back(123456789012ULL);
+    store.push_back(2.5);
+    store.push_back('c');
+    store.push_back(true);
+    store.push_back("literal");
+    store.push_back(std::string("string"));
+  };
+  const char* fmtstring = "%d %u %lld %llu %.2f %c %d %s %s";
+
+  arg_store store;
+  fill_args(store);
+  binary_fmt.format({{}, {1, false}, fmtstring, &store, "MAC", 'D'}, binary);
+  fill_args(store);
+  text_fmt.format({{}, {1, false}, fmtstring, &store, "MAC", 'D'}, expected);
+
+  // Entry without arguments and a hex dump.
+  auto entry     = build_log_entry_metadata(nullptr, "No arguments");
+  entry.hex_dump = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17};
+  auto copy      = entry;
+  binary_fmt.format(std::move(entry), binary);
+  text_fmt.format(std::move(copy), expected);
+
+  // Entry without name, tag and context.
+  binary_fmt.format({{}, {0, false}, "Plain", nullptr, "", '\0'}, binary);
+  text_fmt.format({{}, {0, false}, "Plain", nullptr, "", '\0'}, expected);
+
+  ASSERT_EQ(decode(binary, std::unique_ptr<log_formatter>(new text_formatter)), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_entries_are_decoded_with_json_formatter_then_output_matches_the_json_formatter()
+{
+  fmt::memory_buffer binary = build_binary_log();
+  fmt::memory_buffer expected;
+  arg_store          store;
+  binary_formatter{}.format(build_log_entry_metadata(&store), binary);
+  store.clear();
+  json_formatter{}.format(build_log_entry_metadata(&store), expected);
+
+  ASSERT_EQ(decode(binary, std::unique_ptr<log_formatter>(new json_formatter)), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_format_string_is_repeated_then_it_is_only_stored_once()
+{
+  fmt::memory_buffer binary = build_binary_log();
+  binary_formatter   binary_fmt;
+  arg_store          store;
+
+  binary_fmt.format(build_log_entry_metadata(&store), binary);
+  size_t first_size = binary.size();
+  store.clear();
+  binary_fmt.format(build_log_entry_metadata(&store), binary);
+  size_t second_size = binary.size() - first_size;
+
+  // The first entry carries the definitions of the format string and log name.
+  ASSERT_EQ(first_size - binary_log::file_header_size - second_size,
+            2 * (1 + 2 * sizeof(uint32_t)) + std::strlen("Text %d") + std::strlen("ABC"));
+
+  return true;
+}
+
+static bool when_format_strings_have_distinct_addresses_then_each_one_is_defined_once()
+{
+  fmt::memory_buffer binary = build_binary_log();
+  binary_formatter   binary_fmt;
+  // Same contents at two addresses.
+  static const char first[]  = "Value %d";
+  static const char second[] = "Value %d";
+
+  arg_store store;
+  binary_fmt.format(build_log_entry_metadata(&store, first), binary);
+  size_t first_size = binary.size();
+  store.clear();
+  binary_fmt.format(build_log_entry_metadata(&store, second), binary);
+  size_t second_size = binary.size() - first_size;
+  store.clear();
+  binary_fmt.format(build_log_entry_metadata(&store, first), binary);
+  size_t third_size = binary.size() - first_size - second_size;
+
+  // The second address defines its own string, the repeated one does not.
+  ASSERT_EQ(second_size - third_size, 1 + 2 * sizeof(uint32_t) + std::strlen("Value %d"));
+
+  std::string expected = "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Value 88\n"
+                         "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Value 88\n"
+                         "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Value 88\n";
+  ASSERT_EQ(decode(binary, std::unique_ptr<log_formatter>(new text_formatter)), expected);
+
+  return true;
+}
+
+namespace {
+DECLARE_METRIC("SNR", snr_t, float, "dB");
+DECLARE_METRIC_SET("RF", rf_set, snr_t);
+using ctx_t = srslog::build_context_type<rf_set>;
+} // namespace
+
+static bool when_context_is_formatted_then_it_is_decoded_as_text()
+{
+  ctx_t ctx("Ctx");
+  ctx.get<rf_set>().write<snr_t>(5.5);
+
+  fmt::memory_buffer binary = build_binary_log();
+  binary_formatter{}.format_ctx(ctx, build_log_entry_metadata(nullptr, nullptr), binary);
+
+  std::string expected = "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Context dump for \"Ctx\"\n"
+                         "  > Set: RF\n"
+                         "    SNR: 5.5 dB\n";
+  ASSERT_EQ(decode(binary, std::unique_ptr<log_formatter>(new text_formatter)), expected);
+
+  return true;
+}
+
+static bool when_binary_log_is_truncated_then_error_is_reported()
+{
+  fmt::memory_buffer binary = build_binary_log();
+  binary_formatter   binary_fmt;
+  arg_store          store;
+  binary_fmt.format(build_log_entry_metadata(&store), binary);
+  store.clear();
+  binary_fmt.format(build_log_entry_metadata(&store), binary);
+
+  fmt::memory_buffer out;
+  binary_decoder     decoder(std::unique_ptr<log_formatter>(new text_formatter));
+  ASSERT_EQ(bool(decoder.decode(binary.data(), binary.size() - 1, out)), true);
+  ASSERT_EQ(decoder.get_nof_entries(), 1);
+
+  // Trailing zeros are the unused space of a memory-mapped file.
+  for (unsigned i = 0; i != 100; ++i) {
+    binary.push_back('\0');
+  }
+  binary_decoder zero_decoder(std::unique_ptr<log_formatter>(new text_formatter));
+  ASSERT_EQ(bool(zero_decoder.decode(binary.data(), binary.size(), out)), false);
+  ASSERT_EQ(zero_decoder.get_nof_entries(), 2);
+
+  return true;
+}
+
+static bool when_data_is_written_to_mmap_sink_then_file_contents_are_valid()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+
+  std::string expected;
+  {
+    // Use a small chunk size to exercise the file growth.
+    mmap_file_sink sink(
+        log_filename, 4096, std::unique_ptr<log_formatter>(new test_dummies::log_formatter_dummy), "Preamble\n");
+    expected = "Preamble\n";
+    for (unsigned i = 0; i != 1000; ++i) {
+      std::string entry = "Test log entry - " + std::to_string(i) + '\n';
+      ASSERT_EQ(bool(sink.write(detail::memory_buffer(entry))), false);
+      expected += entry;
+    }
+    ASSERT_EQ(bool(sink.flush()), false);
+  }
+
+  std::ifstream file(log_filename, std::ios::binary);
+  std::string   contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(contents, expected);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_entries_are_decoded_then_output_matches_the_text_formatter);
+  TEST_FUNCTION(when_entries_are_decoded_with_json_formatter_then_output_matches_the_json_formatter);
+  TEST_FUNCTION(when_format_string_is_repeated_then_it_is_only_stored_once);
+  TEST_FUNCTION(when_format_strings_have_distinct_addresses_then_each_one_is_defined_once);
+  TEST_FUNCTION(when_context_is_formatted_then_it_is_decoded_as_text);
+  TEST_FUNCTION(when_binary_log_is_truncated_then_error_is_reported);
+  TEST_FUNCTION(when_data_is_written_to_mmap_sink_then_file_contents_are_valid);
+
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include "src/srslog/log_backend_impl.h"
 #include "test_dummies.h"
 #include "testing_helpers.h"
+#include <thread>
 
 using namespace srslog;
 
@@ -64,14 +65,21 @@ public:
     return {};
   }
 
-  detail::error_string flush() override { return {}; }
+  detail::error_string flush() override
+  {
+    count_on_flush = count;
+    return {};
+  }
 
   unsigned write_invocation_count() const { return count; }
 
+  unsigned write_invocation_count_on_last_flush() const { return count_on_flush; }
+
   const std::string& received_buffer() const { return str; }
 
 private:
-  unsigned    count = 0;
+  unsigned    count          = 0;
+  unsigned    count_on_flush = 0;
   std::string str;
 };
 
@@ -233,6 +241,165 @@ static bool when_empty_handler_is_used_then_backend_does_not_crash()
   return true;
 }
 
+static bool when_thread_queue_is_full_then_entries_go_to_shared_queue()
+{
+  sink_spy         spy;
+  log_backend_impl backend;
+
+  const unsigned nof_extra_entries = 10;
+  for (unsigned i = 0; i != SRSLOG_THREAD_QUEUE_CAPACITY + SRSLOG_QUEUE_CAPACITY + nof_extra_entries; ++i) {
+    backend.push(build_log_entry(&spy, nullptr));
+  }
+  ASSERT_EQ(backend.get_nof_dropped_entries(), nof_extra_entries);
+
+  // The queue of other threads is not affected.
+  bool        pushed = false;
+  std::thread t([&]() { pushed = backend.push(build_log_entry(&spy, nullptr)); });
+  t.join();
+  ASSERT_EQ(pushed, true);
+
+  backend.set_error_handler([](const std::string&) {});
+  backend.start();
+  backend.stop();
+
+  ASSERT_EQ(spy.write_invocation_count(), SRSLOG_THREAD_QUEUE_CAPACITY + SRSLOG_QUEUE_CAPACITY + 1);
+
+  return true;
+}
+
+static bool when_threads_exit_then_their_queues_are_reused()
+{
+  sink_spy         spy;
+  log_backend_impl backend;
+
+  // More threads than dedicated queues log one after the other.
+  const unsigned nof_threads = SRSLOG_MAX_PRODUCER_THREADS + 1;
+  for (unsigned i = 0; i != nof_threads; ++i) {
+    std::thread t([&]() { backend.push(build_log_entry(&spy, nullptr)); });
+    t.join();
+  }
+
+  // A new thread still gets a queue of its own, which may keep entries of the exited threads, on top of the shared one.
+  const unsigned nof_entries = SRSLOG_THREAD_QUEUE_CAPACITY + SRSLOG_QUEUE_CAPACITY - nof_threads;
+  unsigned       nof_pushed  = 0;
+  std::thread    t([&]() {
+    for (unsigned i = 0; i != nof_entries; ++i) {
+      nof_pushed += backend.push(build_log_entry(&spy, nullptr));
+    }
+  });
+  t.join();
+  ASSERT_EQ(nof_pushed, nof_entries);
+  ASSERT_EQ(backend.get_nof_dropped_entries(), 0);
+
+  backend.set_error_handler([](const std::string&) {});
+  backend.start();
+  backend.stop();
+
+  ASSERT_EQ(spy.write_invocation_count(), nof_threads + nof_entries);
+
+  return true;
+}
+
+static bool when_many_threads_push_entries_then_all_are_sent_to_sink()
+{
+  sink_spy         spy;
+  log_backend_impl backend;
+  backend.start();
+
+  const unsigned           nof_threads = 8, nof_entries = 1000;
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i != nof_threads; ++i) {
+    threads.emplace_back([&]() {
+      for (unsigned j = 0; j != nof_entries; ++j) {
+        // Retry when the queue is full, the backend is slower than the producers.
+        while (!backend.push(build_log_entry(&spy, backend.alloc_arg_store()))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Stop the backend to ensure the entries have been processed.
+  backend.stop();
+
+  ASSERT_EQ(spy.write_invocation_count(), nof_threads * nof_entries);
+
+  return true;
+}
+
+static bool when_entries_of_different_threads_are_pending_then_they_are_processed_in_timestamp_order()
+{
+  test_dummies::sink_dummy s;
+  log_backend_impl         backend;
+
+  std::vector<int> order;
+  auto             push_entry = [&](int ts) {
+    auto entry        = build_log_entry(&s, nullptr);
+    entry.metadata.tp = std::chrono::high_resolution_clock::time_point(std::chrono::microseconds(ts));
+    entry.format_func = [&order, ts](detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) {
+      order.push_back(ts);
+    };
+    backend.push(std::move(entry));
+  };
+
+  // Both threads push before the backend starts, so all entries get extracted in the same batch.
+  std::thread t1([&]() {
+    push_entry(1);
+    push_entry(3);
+  });
+  t1.join();
+  std::thread t2([&]() {
+    push_entry(2);
+    push_entry(4);
+  });
+  t2.join();
+
+  backend.start();
+  backend.stop();
+
+  ASSERT_EQ(order.size(), 4);
+  for (int i = 0; i != 4; ++i) {
+    ASSERT_EQ(order[i], i + 1);
+  }
+
+  return true;
+}
+
+static bool when_flush_is_processed_then_entries_pushed_before_by_other_threads_are_written()
+{
+  sink_spy         spy;
+  log_backend_impl backend;
+
+  // Another thread pushes more entries than the backend extracts from a thread in a single batch.
+  const unsigned nof_entries = 1000;
+  std::thread    t([&]() {
+    for (unsigned i = 0; i != nof_entries; ++i) {
+      backend.push(build_log_entry(&spy, nullptr));
+    }
+  });
+  t.join();
+
+  detail::shared_variable<bool> completion_flag(false);
+  detail::log_entry             cmd;
+  cmd.metadata.store = nullptr;
+  cmd.flush_cmd = std::unique_ptr<detail::flush_backend_cmd>(new detail::flush_backend_cmd{completion_flag, {&spy}});
+  backend.push(std::move(cmd));
+
+  backend.start();
+  while (!completion_flag) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  ASSERT_EQ(spy.write_invocation_count_on_last_flush(), nof_entries);
+
+  backend.stop();
+
+  return true;
+}
+
 int main()
 {
   TEST_FUNCTION(when_backend_is_started_then_is_started_returns_true);
@@ -243,6 +410,11 @@ int main()
   TEST_FUNCTION(when_sink_write_fails_then_error_handler_is_invoked);
   TEST_FUNCTION(when_handler_is_set_after_start_then_handler_is_not_used);
   TEST_FUNCTION(when_empty_handler_is_used_then_backend_does_not_crash);
+  TEST_FUNCTION(when_thread_queue_is_full_then_entries_go_to_shared_queue);
+  TEST_FUNCTION(when_threads_exit_then_their_queues_are_reused);
+  TEST_FUNCTION(when_many_threads_push_entries_then_all_are_sent_to_sink);
+  TEST_FUNCTION(when_entries_of_different_threads_are_pending_then_they_are_processed_in_timestamp_order);
+  TEST_FUNCTION(when_flush_is_processed_then_entries_pushed_before_by_other_threads_are_written);
 
   return 0;
 }
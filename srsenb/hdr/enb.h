@@ -86,6 +86,7 @@ struct log_args_t {
   int         all_hex_limit;
   int         file_max_size;
   std::string filename;
+  std::string file_format;
 };
 
 struct gui_args_t {
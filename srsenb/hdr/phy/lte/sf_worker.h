@@ -22,6 +22,7 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <condition_variable>
 #include <mutex>
 #include <string.h>
 
@@ -38,7 +39,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, int fec_prio, srsran::work_stealing_thread_pool* task_pool_ = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -61,6 +62,11 @@ public:
 private:
   void work_imp() final;
 
+  /// Runs func(cc_idx) for every carrier and returns once all of them finished. If a task pool is set, the carriers
+  /// other than the first one are processed by the pool while the worker thread takes care of the first one
+  template <typename Func>
+  void run_cc_tasks(const Func& func);
+
   /* Common objects */
   srslog::basic_logger& logger;
   phy_common*           phy       = nullptr;
@@ -73,6 +79,12 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // Pool shared by all the workers processing the carriers of a subframe in parallel, if enabled
+  srsran::work_stealing_thread_pool* task_pool = nullptr;
+  std::mutex                         cc_tasks_mutex;
+  std::condition_variable            cc_tasks_cvar;
+  uint32_t                           nof_pending_cc_tasks = 0;
 };
 
 } // namespace lte
@@ -33,6 +33,9 @@ class worker_pool
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
 
+  // Processes the carriers of the subframes in parallel, shared by all the workers
+  std::unique_ptr<srsran::work_stealing_thread_pool> task_pool;
+
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
   uint32_t   get_nof_workers() { return (uint32_t)workers.size(); }
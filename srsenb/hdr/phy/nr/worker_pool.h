@@ -106,6 +106,7 @@ public:
     uint32_t               nof_prach_workers = 0;
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
+    uint32_t               nof_fec_threads   = 0;
     float                  pusch_min_snr_dB  = -10;
     srsran::phy_log_args_t log               = {};
   };
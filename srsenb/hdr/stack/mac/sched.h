@@ -26,13 +26,17 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
 namespace srsenb {
 
 class rrc_interface_mac;
+class sched_trace_writer;
+class sched_trace_rrc_proxy;
 
 class sched : public sched_interface
 {
@@ -94,10 +98,14 @@ public:
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void new_tti_parallel(srsran::tti_point tti_rx);
+  bool has_multi_cc_ues();
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  template <typename Func>
+  int ue_db_access(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
 
   // args
   rrc_interface_mac*               rrc       = nullptr;
@@ -115,6 +123,16 @@ protected:
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
+
+  // Workers that schedule the carriers in parallel, if enabled
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  nof_pending_ccs = 0;
+
+  // Recorder of the scheduler inputs, if enabled
+  std::unique_ptr<sched_trace_writer>    trace;
+  std::unique_ptr<sched_trace_rrc_proxy> trace_rrc;
 };
 
 } // namespace srsenb
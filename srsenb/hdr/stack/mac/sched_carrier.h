@@ -45,6 +45,11 @@ public:
   void                   carrier_cfg(const sched_cell_params_t& sched_params_);
   void                   set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs);
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
+  //! Parallel scheduling, step 1: Schedules the TTI. All UEs must be configured with a single carrier
+  void                   sched_tti_parallel(srsran::tti_point tti_rx);
+  //! Parallel scheduling, step 2: Generates the TTI result. Must be called for all carriers, in enb_cc_idx order,
+  //! after step 1 finished in all of them
+  const cc_sched_result& finish_tti_parallel(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
   int                    pdcch_order_info(dl_sched_po_info_t pdcch_order_info);
 
@@ -54,6 +59,10 @@ public:
   const sf_sched_result* get_sf_result(tti_point tti_rx) const;
 
 private:
+  //! Schedule PHICH, broadcast, RAR, Msg3, PDCCH orders and the user data
+  void sched_tti(sf_sched* tti_sched);
+  //! Generate the DCIs and the scheduling result of the TTI
+  const cc_sched_result& finish_tti(sf_sched* tti_sched);
   //! Compute DL scheduler result for given TTI
   void alloc_dl_users(sf_sched* tti_result);
   //! Compute UL scheduler result for given TTI
@@ -80,6 +80,10 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    /// Threads that schedule the carriers in parallel. 0 (default) keeps the sequential scheduler. The carriers are
+    /// only scheduled in parallel in the TTIs where all UEs are configured with a single carrier
+    uint32_t    nof_cc_workers            = 0;
+    std::string trace_filename; ///< if not empty, the scheduler inputs are recorded to this file
   };
 
   struct cell_cfg_t {
@@ -34,6 +34,9 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DFS nodes visited by a single alloc_dci call, before the DCI allocation is considered failed.
+  /// Only then alloc_dci may fail while a solution exists
+  const static uint32_t MAX_DFS_NODES = 1024;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -43,6 +46,8 @@ public:
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
     pdcch_mask_t total_mask, current_mask;
     prbmask_t    total_pucch_mask;
+    /// Hash of total_mask and total_pucch_mask, updated incrementally at each DFS level
+    uint64_t state_hash = 0;
   };
   using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
 
@@ -67,6 +72,8 @@ public:
   void        get_allocs(alloc_result_t* vec = nullptr, pdcch_mask_t* tot_mask = nullptr, size_t idx = 0) const;
   uint32_t    nof_cces() const { return cc_cfg->nof_cce_table[current_cfix]; }
   size_t      nof_allocs() const { return dci_record_list.size(); }
+  /// Number of DFS nodes visited by the last alloc_dci call
+  uint32_t    get_nof_dfs_nodes() const { return nof_dfs_nodes; }
   std::string result_to_string(bool verbose = false) const;
 
 private:
@@ -76,17 +83,44 @@ private:
     uint32_t     aggr_idx;
     alloc_type_t alloc_type;
     sched_ue*    user;
+
+    /// The UE needs to allocate space in PUCCH for HARQ-ACK
+    bool needs_harq_pucch() const { return alloc_type == alloc_type_t::DL_DATA and not pusch_uci; }
   };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  bool                          is_harq_pucch_prb_valid(int pucch_n_prb) const;
+
+  /// DFS state from which the pending DCI records cannot be allocated, for a given CFI
+  struct dead_dfs_state {
+    uint32_t     generation = 0;
+    uint32_t     cfix       = 0;
+    uint32_t     depth      = 0;
+    uint64_t     hash       = 0;
+    pdcch_mask_t pdcch_mask;
+    prbmask_t    pucch_mask;
+  };
+  const static uint32_t DEAD_STATE_TABLE_SIZE = 256, MAX_DEAD_STATE_PROBES = 8;
+  /// Set of DFS levels (i.e. DCI record indexes)
+  using dfs_depth_mask_t = srsran::bounded_bitset<128>;
 
   // PDCCH allocation algorithm
   bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
   bool get_next_dfs();
+  /// Finds the DFS level to backtrack to after the DCI record at level "failed_depth" failed to be allocated, skipping
+  /// the levels whose DCI positions played no role in the failure. Returns -1 if there is no solution for the CFI
+  int get_backjump_depth(uint32_t failed_depth);
+  /// Registers the DFS level whose DCI blocks the CCE position "ncce" or the PUCCH PRB "pucch_n_prb" at level "depth"
+  void add_conflict(uint32_t depth, uint32_t ncce, uint32_t aggr_idx, int pucch_n_prb);
+  void set_dfs_search_records(const alloc_record& new_record);
+  void mark_dead_state(uint32_t depth, uint64_t hash, const pdcch_mask_t& pdcch_mask, const prbmask_t& pucch_mask);
+  bool is_dead_state(uint32_t depth, uint64_t hash, const pdcch_mask_t& pdcch_mask, const prbmask_t& pucch_mask) const;
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
   srslog::basic_logger&      logger;
   srsran_pucch_cfg_t         pucch_cfg_common = {};
+  /// Number of PUCCH PRBs that can carry the HARQ-ACK of a DL DCI, for each CFI
+  std::array<uint32_t, MAX_CFI> nof_harq_pucch_prbs = {};
 
   // tti vars
   tti_point                 tti_rx;
@@ -94,6 +128,15 @@ private:
   uint32_t                  current_max_cfix = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+
+  // DFS search state of the ongoing alloc_dci call
+  std::vector<uint32_t>         remaining_cces;  ///< CCEs required by the DCI records at depth >= idx
+  std::vector<uint32_t>         remaining_pucch; ///< HARQ-ACK PUCCH PRBs required by the DCI records at depth >= idx
+  std::vector<bool>             full_search;     ///< whether the children of DFS level idx were visited from idx 0
+  std::vector<dfs_depth_mask_t> conflicts;       ///< DFS levels whose DCI positions blocked children of level idx
+  std::vector<dead_dfs_state>   dead_states;     ///< open-addressing table of DFS states that led to no solution
+  uint32_t                      dead_states_gen = 0;
+  uint32_t                      nof_dfs_nodes   = 0;
 };
 
 // Helper methods
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SCHED_TRACE_H
+#define SRSENB_SCHED_TRACE_H
+
+#include "sched_interface.h"
+#include "srsran/interfaces/enb_rrc_interface_mac.h"
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsenb {
+
+class sched;
+
+/// Scheduler input events stored in a scheduler trace, and the sched_trace_record fields they use
+enum class sched_trace_event : uint8_t {
+  sched_args,          ///< sched_args
+  cell_cfg,            ///< cell_cfg
+  reset,               ///< -
+  ue_cfg,              ///< rnti, ue_cfg
+  ue_rem,              ///< rnti
+  phy_config_enabled,  ///< rnti, value={enabled}
+  bearer_ue_cfg,       ///< rnti, value={lc_id}, bearer_cfg
+  bearer_ue_rem,       ///< rnti, value={lc_id}
+  dl_rlc_buffer_state, ///< rnti, value={lc_id, tx_queue, prio_tx_queue}
+  dl_mac_buffer_state, ///< rnti, value={ce_code, nof_cmds}
+  dl_ack_info,         ///< tti, rnti, enb_cc_idx, value={tb_idx, ack}
+  dl_rach_info,        ///< enb_cc_idx, rar_info
+  dl_ri_info,          ///< tti, rnti, enb_cc_idx, value={ri}
+  dl_pmi_info,         ///< tti, rnti, enb_cc_idx, value={pmi}
+  dl_cqi_info,         ///< tti, rnti, enb_cc_idx, value={cqi}
+  dl_sb_cqi_info,      ///< tti, rnti, enb_cc_idx, value={sb_idx, cqi}
+  ul_crc_info,         ///< tti, rnti, enb_cc_idx, value={crc}
+  ul_sr_info,          ///< tti, rnti
+  ul_bsr,              ///< rnti, value={lcg_id, bsr}
+  ul_phr,              ///< rnti, value={phr, ul_nof_prb}. The PHR is stored in two's complement
+  ul_snr_info,         ///< tti, rnti, enb_cc_idx, value={ul_ch_code}, snr
+  ul_buffer_add,       ///< rnti, value={lcid, bytes}
+  set_pdcch_order,     ///< enb_cc_idx, po_info
+  set_dl_tti_mask,     ///< tti_mask
+  dl_sched,            ///< tti={tti_tx_dl}, enb_cc_idx
+  ul_sched,            ///< tti={tti_tx_ul}, enb_cc_idx
+  paging,              ///< tti={tti_tx_dl}, value={payload_len}. Pending paging message reported by the RRC
+  nof_events
+};
+
+const char* to_string(sched_trace_event event);
+
+/// Decoded scheduler trace event. Only the fields used by the event type are meaningful
+struct sched_trace_record {
+  sched_trace_event                        type       = sched_trace_event::reset;
+  uint32_t                                 tti        = 0;
+  uint16_t                                 rnti       = SRSRAN_INVALID_RNTI;
+  uint32_t                                 enb_cc_idx = 0;
+  uint32_t                                 value[3]   = {};
+  float                                    snr        = 0;
+  sched_interface::sched_args_t            sched_args;
+  std::vector<sched_interface::cell_cfg_t> cell_cfg;
+  sched_interface::ue_cfg_t                ue_cfg;
+  mac_lc_ch_cfg_t                          bearer_cfg;
+  sched_interface::dl_sched_rar_info_t     rar_info = {};
+  sched_interface::dl_sched_po_info_t      po_info  = {};
+  std::vector<uint8_t>                     tti_mask;
+};
+
+/**
+ * Records the inputs of the scheduler in a compact binary trace file, in the order they are applied by the scheduler,
+ * so that they can be replayed offline. The scheduler writes each record within the sched_mutex critical section that
+ * applies the input. Each event is stored as a 1-byte type and a 4-byte payload length, followed by
+ * a payload with only the fields used by the event type. Configuration structs are stored in their in-memory
+ * representation, so a trace can only be replayed by a build of the same version and architecture.
+ * Events are buffered in memory and written to the file in blocks. The methods are thread-safe.
+ */
+class sched_trace_writer
+{
+public:
+  explicit sched_trace_writer(const std::string& filename);
+  sched_trace_writer(const sched_trace_writer&) = delete;
+  sched_trace_writer& operator=(const sched_trace_writer&) = delete;
+  ~sched_trace_writer();
+
+  bool is_open() const { return fp != nullptr; }
+  void write(const sched_trace_record& record);
+  void flush();
+
+  /// Helper for the events without configuration fields
+  void write(sched_trace_event type,
+             uint32_t          tti,
+             uint16_t          rnti,
+             uint32_t          enb_cc_idx,
+             uint32_t          v0 = 0,
+             uint32_t          v1 = 0,
+             uint32_t          v2 = 0);
+
+private:
+  const static size_t flush_threshold = 64 * 1024;
+
+  void flush_nolock();
+
+  std::mutex           mutex;
+  FILE*                fp = nullptr;
+  std::vector<uint8_t> buffer;
+};
+
+/// Reads the events of a scheduler trace file. The whole file is loaded into memory on open
+class sched_trace_reader
+{
+public:
+  bool open(const std::string& filename);
+  /// Decodes the next event. Returns false at the end of the trace, or if the trace is corrupted
+  bool read(sched_trace_record& record);
+  void rewind();
+  bool is_corrupted() const { return corrupted; }
+
+private:
+  std::vector<uint8_t> buffer;
+  size_t               offset    = 0;
+  bool                 corrupted = false;
+};
+
+/// RRC interface proxy that records the paging opportunities reported by the RRC to the scheduler
+class sched_trace_rrc_proxy final : public rrc_interface_mac
+{
+public:
+  sched_trace_rrc_proxy(rrc_interface_mac* rrc_, sched_trace_writer* trace_) : rrc(rrc_), trace(trace_) {}
+
+  int  add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override;
+  void upd_user(uint16_t new_rnti, uint16_t old_rnti) override;
+  void set_activity_user(uint16_t rnti) override;
+  void set_radiolink_dl_state(uint16_t rnti, bool crc_res) override;
+  void set_radiolink_ul_state(uint16_t rnti, bool crc_res) override;
+  bool is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len) override;
+  void read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t payload_size) override;
+  uint8_t* read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index) override;
+
+private:
+  rrc_interface_mac*  rrc   = nullptr;
+  sched_trace_writer* trace = nullptr;
+};
+
+/// RRC interface stub used in trace replays, which reports the recorded paging messages to the scheduler
+class sched_trace_rrc_stub final : public rrc_interface_mac
+{
+public:
+  /// Paging events must be added in the order they were recorded, before the replay starts
+  void add_paging(uint32_t tti_tx_dl, uint32_t payload_len);
+
+  int      add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override { return SRSRAN_SUCCESS; }
+  void     upd_user(uint16_t new_rnti, uint16_t old_rnti) override {}
+  void     set_activity_user(uint16_t rnti) override {}
+  void     set_radiolink_dl_state(uint16_t rnti, bool crc_res) override {}
+  void     set_radiolink_ul_state(uint16_t rnti, bool crc_res) override {}
+  bool     is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len) override;
+  void     read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t payload_size) override {}
+  uint8_t* read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index) override { return nullptr; }
+
+private:
+  std::mutex                                 mutex;
+  std::deque<std::pair<uint32_t, uint32_t> > pending_paging;
+};
+
+/**
+ * Forwards a recorded event to the scheduler, calling the respective scheduler API function
+ * @param sched_obj scheduler instance, already initialized with the recorded sched_args
+ * @param record event to replay. sched_args and paging events are not forwarded
+ * @param dl_result result of the scheduler, in case of dl_sched events
+ * @param ul_result result of the scheduler, in case of ul_sched events
+ * @return return value of the scheduler API function
+ */
+int sched_trace_replay_event(sched&                           sched_obj,
+                             const sched_trace_record&        record,
+                             sched_interface::dl_sched_res_t& dl_result,
+                             sched_interface::ul_sched_res_t& ul_result);
+
+} // namespace srsenb
+
+#endif // SRSENB_SCHED_TRACE_H
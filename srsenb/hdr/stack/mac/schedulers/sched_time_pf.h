@@ -25,7 +25,6 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
 
 namespace srsenb {
 
@@ -50,6 +49,8 @@ private:
     ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
     float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
     float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
+    float    dl_inv_avg_pow() const { return dl_nof_samples == 0 ? std::numeric_limits<float>::max() : dl_inv_avg_pow_; }
+    float    ul_inv_avg_pow() const { return ul_nof_samples == 0 ? std::numeric_limits<float>::max() : ul_inv_avg_pow_; }
     uint32_t dl_count() const { return dl_nof_samples; }
     uint32_t ul_count() const { return ul_nof_samples; }
     void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
@@ -60,33 +61,64 @@ private:
     const float    fairness_coeff;
 
     int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
+    float               dl_rate    = 0;
+    float               ul_rate    = 0;
     const dl_harq_proc* dl_retx_h  = nullptr;
     const dl_harq_proc* dl_newtx_h = nullptr;
     const ul_harq_proc* ul_h       = nullptr;
 
   private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+    float inv_avg_pow(float avg_rate) const;
+
+    float    dl_avg_rate_    = 0;
+    float    ul_avg_rate_    = 0;
+    float    dl_inv_avg_pow_ = 0; ///< 1 / dl_avg_rate^fairness_coeff, updated with each new sample
+    float    ul_inv_avg_pow_ = 0;
+    uint32_t dl_nof_samples  = 0;
+    uint32_t ul_nof_samples  = 0;
   };
 
   rnti_map_t<ue_ctxt> ue_history_db;
 
-  struct ue_dl_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-  struct ue_ul_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
+  /// Structure-of-arrays with the PF metric inputs of the UEs that are candidates for allocation in the current TTI.
+  /// The PF priorities are computed for all candidates in a single vectorized pass, and the candidates are then
+  /// popped in priority order, with retxs first. Only the next "sel_size" candidates are ordered at a time.
+  class ue_candidate_list
+  {
+  public:
+    const static uint32_t sel_size = 8;
+
+    ue_candidate_list();
+    void     clear();
+    void     push(ue_ctxt* ue, bool is_retx, float rate, float inv_avg_pow);
+    void     compute_prios();
+    bool     empty() const { return next_idx == ues.size(); }
+    ue_ctxt* pop();
+    /// Pops the next candidate, without ordering the remaining ones
+    ue_ctxt* pop_unordered();
 
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
+  private:
+    bool higher_prio(uint32_t lhs, uint32_t rhs) const
+    {
+      // Ties are broken by insertion order, so that the result does not depend on the selection algorithm
+      if (is_retx[lhs] != is_retx[rhs]) {
+        return is_retx[lhs] > is_retx[rhs];
+      }
+      return prio[lhs] > prio[rhs] or (prio[lhs] == prio[rhs] and lhs < rhs);
+    }
+
+    std::vector<ue_ctxt*> ues;
+    std::vector<uint8_t>  is_retx;
+    std::vector<float>    rate;
+    std::vector<float>    inv_avg_pow;
+    std::vector<float>    prio;
+    std::vector<uint32_t> order;          ///< candidate indexes, ordered by priority up to "nof_ordered"
+    uint32_t              next_idx    = 0; ///< position in "order" of the next candidate to pop
+    uint32_t              nof_ordered = 0;
+  };
 
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  ue_candidate_list dl_queue;
+  ue_candidate_list ul_queue;
 
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
   uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
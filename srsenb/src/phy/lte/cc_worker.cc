@@ -71,9 +71,9 @@ cc_worker::~cc_worker()
     if (signal_buffer_rx[p]) {
       free(signal_buffer_rx[p]);
     }
-    if (signal_buffer_tx[p]) {
-      free(signal_buffer_tx[p]);
-    }
+  }
+  if (signal_buffer_tx[0]) {
+    free(signal_buffer_tx[0]);
   }
 
   // Delete all users
@@ -86,7 +86,7 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, int fec_prio)
 {
   phy                         = phy_;
   cc_idx                      = cc_idx_;
@@ -96,19 +96,25 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
   srsran_cfr_cfg_t cfr_config = phy_->get_cfr_config();
 
   // Init cell here
-  for (uint32_t p = 0; p < phy->get_nof_ports(cc_idx); p++) {
+  uint32_t nof_ports = phy->get_nof_ports(cc_idx);
+  for (uint32_t p = 0; p < nof_ports; p++) {
     signal_buffer_rx[p] = srsran_vec_cf_malloc(2 * sf_len);
     if (!signal_buffer_rx[p]) {
       ERROR("Error allocating memory");
       return;
     }
     srsran_vec_cf_zero(signal_buffer_rx[p], 2 * sf_len);
-    signal_buffer_tx[p] = srsran_vec_cf_malloc(2 * sf_len);
-    if (!signal_buffer_tx[p]) {
-      ERROR("Error allocating memory");
-      return;
-    }
-    srsran_vec_cf_zero(signal_buffer_tx[p], 2 * sf_len);
+  }
+
+  // Tx buffers of all ports are contiguous, so that ENB DL generates all the ports with a single batched iFFT
+  signal_buffer_tx[0] = srsran_vec_cf_malloc(2 * sf_len * nof_ports);
+  if (!signal_buffer_tx[0]) {
+    ERROR("Error allocating memory");
+    return;
+  }
+  srsran_vec_cf_zero(signal_buffer_tx[0], 2 * sf_len * nof_ports);
+  for (uint32_t p = 1; p < nof_ports; p++) {
+    signal_buffer_tx[p] = signal_buffer_tx[0] + p * 2 * sf_len;
   }
   if (srsran_enb_dl_init(&enb_dl, signal_buffer_tx, nof_prb)) {
     ERROR("Error initiating ENB DL (cc=%d)", cc_idx);
@@ -132,6 +138,12 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     return;
   }
 
+  // Decode PUSCH code blocks in parallel, the FEC threads share the priority of the PHY workers
+  if (srsran_sch_set_fec_threads(&enb_ul.pusch.ul_sch, phy->params.nof_fec_threads, fec_prio) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating FEC threads");
+    return;
+  }
+
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
 
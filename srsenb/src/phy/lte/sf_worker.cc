@@ -72,9 +72,10 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+void sf_worker::init(phy_common* phy_, int fec_prio, srsran::work_stealing_thread_pool* task_pool_)
 {
-  phy = phy_;
+  phy       = phy_;
+  task_pool = task_pool_;
 
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
@@ -82,7 +83,7 @@ void sf_worker::init(phy_common* phy_)
     auto q = new cc_worker(logger);
 
     // Initialise
-    q->init(phy, i);
+    q->init(phy, i, fec_prio);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -147,6 +148,43 @@ uint32_t sf_worker::get_nof_rnti()
   return cc_workers[0]->get_nof_rnti();
 }
 
+template <typename Func>
+void sf_worker::run_cc_tasks(const Func& func)
+{
+  if (task_pool == nullptr or cc_workers.size() < 2) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      func(cc);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cc_tasks_mutex);
+    nof_pending_cc_tasks = cc_workers.size() - 1;
+  }
+  for (uint32_t cc = 1; cc < cc_workers.size(); cc++) {
+    task_pool->push_task([this, &func, cc]() {
+      func(cc);
+      std::lock_guard<std::mutex> lock(cc_tasks_mutex);
+      if (--nof_pending_cc_tasks == 0) {
+        cc_tasks_cvar.notify_one();
+      }
+    });
+  }
+  func(0);
+
+  std::unique_lock<std::mutex> lock(cc_tasks_mutex);
+  cc_tasks_cvar.wait(lock, [this]() { return nof_pending_cc_tasks == 0; });
+}
+
+/// The subframe is processed in the following stages, each of them starting when the previous one finished:
+///  1. UL processing of every carrier (FFT, channel estimation, PUCCH and PUSCH decoding). The carriers are independent
+///  2. DL and UL scheduling by the MAC, which needs the UCI and CRCs of all the carriers from stage 1
+///  3. DL processing of every carrier (PDCCH, PDSCH, PHICH encoding and IFFT), which needs the grants from stage 2.
+///     The carriers are independent
+///  4. Combination of the carrier signals into the RF ports and transmission
+/// With the task pool enabled, the carriers of stages 1 and 3 run in parallel, which reduces the processing latency of
+/// the subframe instead of only increasing the number of subframes processed at the same time by different workers.
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
@@ -189,9 +227,7 @@ void sf_worker::work_imp()
   }
 
   // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
-  }
+  run_cc_tasks([this, &ul_sf, &ul_grants](uint32_t cc) { cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]); });
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -225,14 +261,15 @@ void sf_worker::work_imp()
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+  run_cc_tasks([this, &dl_sf, &dl_grants, &ul_grants_tx, &mbsfn_cfg](uint32_t cc) {
     // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
+    srsran_dl_sf_cfg_t cc_dl_sf = dl_sf;
+    cc_dl_sf.cfi                = dl_grants[cc].cfi;
+    cc_dl_sf.cfi                = SRSRAN_MAX(cc_dl_sf.cfi, 1);
+    cc_dl_sf.cfi                = SRSRAN_MIN(cc_dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
-  }
+    cc_workers[cc]->work_dl(cc_dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+  });
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
@@ -19,6 +19,7 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include <thread>
 
 namespace srsenb {
 namespace lte {
@@ -27,17 +28,36 @@ worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
-  // Add workers to workers pool and start threads.
+  if (args.nof_sf_task_threads > 0) {
+    task_pool.reset(new srsran::work_stealing_thread_pool(args.nof_sf_task_threads, false, prio));
+  }
+
+  // Create the workers
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
-    pool.init_worker(i, w.get(), prio);
-    workers.push_back(std::move(w));
+    workers.push_back(std::unique_ptr<lte::sf_worker>(new sf_worker(log)));
+  }
+
+  // Allocating the buffers and planning the DFTs of every worker takes most of the startup time, initialise them in
+  // parallel. The first one is initialised alone, since it generates the tables shared by all the workers
+  if (!workers.empty()) {
+    workers[0]->init(common, prio, task_pool.get());
+  }
+  std::vector<std::thread> init_threads;
+  for (uint32_t i = 1; i < workers.size(); i++) {
+    init_threads.emplace_back([this, i, common, prio]() { workers[i]->init(common, prio, task_pool.get()); });
+  }
+  for (std::thread& t : init_threads) {
+    t.join();
+  }
+
+  // Add workers to workers pool and start threads.
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    pool.init_worker(i, workers[i].get(), prio);
   }
 
   return true;
@@ -61,6 +81,11 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+
+  // The workers wait for their tasks to finish, stop the task pool once they are stopped
+  if (task_pool != nullptr) {
+    task_pool->stop();
+  }
 }
 
 }; // namespace lte
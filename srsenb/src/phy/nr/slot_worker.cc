@@ -89,14 +89,16 @@ bool slot_worker::init(const args_t& args)
   }
 
   // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  srsran_gnb_ul_args_t ul_args      = {};
+  ul_args.pusch.measure_time        = true;
+  ul_args.pusch.measure_evm         = true;
+  ul_args.pusch.max_layers          = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter    = args.pusch_max_its;
+  ul_args.pusch.sch.nof_fec_threads = args.nof_fec_threads;
+  ul_args.pusch.sch.fec_prio        = args.fec_prio;
+  ul_args.pusch.max_prb             = args.nof_max_prb;
+  ul_args.nof_max_prb               = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB          = args.pusch_min_snr_dB;
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -234,14 +236,16 @@ bool slot_worker::work_ul()
     }
   }
 
-  // For each PUSCH...
+  // Prepare every PUSCH, they are decoded together
+  srsran::bounded_vector<stack_interface_phy_nr::pusch_info_t, stack_interface_phy_nr::MAX_GRANTS> pusch_info_list;
+  std::array<srsran_gnb_ul_pusch_t, stack_interface_phy_nr::MAX_GRANTS>                           pusch_list = {};
   for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
-    // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
+    pusch_info_list.emplace_back();
+    stack_interface_phy_nr::pusch_info_t& pusch_info = pusch_info_list.back();
+    pusch_info.uci_cfg                               = pusch.sch.uci;
+    pusch_info.pid                                   = pusch.pid;
+    pusch_info.rnti                                  = pusch.sch.grant.rnti;
+    pusch_info.pdu                                   = srsran::make_byte_buffer();
     if (pusch_info.pdu == nullptr) {
       logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
       return false;
@@ -249,15 +253,26 @@ bool slot_worker::work_ul()
     pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
     pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
 
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
-      logger.error("Error getting PUSCH");
-      return false;
-    }
+    srsran_gnb_ul_pusch_t& gnb_ul_pusch = pusch_list[pusch_info_list.size() - 1];
+    gnb_ul_pusch.cfg                    = &pusch.sch;
+    gnb_ul_pusch.grant                  = &pusch.sch.grant;
+    gnb_ul_pusch.data                   = &pusch_info.pusch_data;
+  }
+
+  // Decode PUSCH, the transport blocks of all the UEs share the LDPC decoder batches
+  if (srsran_gnb_ul_get_pusch_multi(&gnb_ul, &ul_slot_cfg, pusch_list.data(), (uint32_t)pusch_info_list.size()) <
+      SRSRAN_SUCCESS) {
+    logger.error("Error getting PUSCH");
+    return false;
+  }
+
+  // For each PUSCH...
+  for (uint32_t i = 0; i < pusch_info_list.size(); i++) {
+    stack_interface_phy_nr::pusch_t&      pusch      = ul_sched->pusch[i];
+    stack_interface_phy_nr::pusch_info_t& pusch_info = pusch_info_list[i];
 
     // Extract DMRS information
-    pusch_info.csi = gnb_ul.dmrs.csi;
+    pusch_info.csi = pusch_list[i].csi;
 
     // Inform stack
     if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
@@ -268,7 +283,8 @@ bool slot_worker::work_ul()
     // Log PUSCH decoding
     if (logger.info.enabled()) {
       std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+      srsran_gnb_ul_pusch_info(
+          &gnb_ul, &pusch.sch, &pusch_info.pusch_data, &pusch_info.csi, str.data(), (uint32_t)str.size());
 
       if (logger.debug.enabled()) {
         std::array<char, 1024> str_extra = {};
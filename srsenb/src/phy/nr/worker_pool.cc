@@ -72,6 +72,8 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.rf_port                 = cell_list[cell_index].rf_port;
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
+    w_args.nof_fec_threads         = args.nof_fec_threads;
+    w_args.fec_prio                = args.prio;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
 
     if (not w->init(w_args)) {
@@ -98,6 +98,9 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   s1ap_logger.set_hex_dump_max_size(args.log.s1ap_hex_limit);
   stack_logger.set_hex_dump_max_size(args.log.stack_hex_limit);
 
+  // Measure the queueing latency of stack tasks if it is going to be logged
+  task_sched.enable_task_latency_histogram(stack_logger.info.enabled());
+
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
     mac_pcap.open(args.mac_pcap.filename);
@@ -206,6 +209,7 @@ void enb_stack_lte::stop_impl()
     s1ap_pcap.close();
   }
 
+  task_sched.print_task_latency(stack_logger);
   task_sched.stop();
   get_background_workers().stop();
 
@@ -25,6 +25,7 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
 #include "srsran/srslog/srslog.h"
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
@@ -49,15 +50,37 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   rrc       = rrc_;
   sched_cfg = sched_cfg_;
 
+  if (not sched_cfg.trace_filename.empty()) {
+    trace.reset(new sched_trace_writer(sched_cfg.trace_filename));
+    if (trace->is_open()) {
+      // Record the paging opportunities, which are the only scheduler input provided via the RRC interface
+      trace_rrc.reset(new sched_trace_rrc_proxy(rrc, trace.get()));
+      rrc = trace_rrc.get();
+      sched_trace_record record;
+      record.type       = sched_trace_event::sched_args;
+      record.sched_args = sched_cfg;
+      trace->write(record);
+    } else {
+      trace.reset();
+    }
+  }
+
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
+  if (sched_cfg.nof_cc_workers > 0) {
+    cc_workers.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_workers));
+  }
+
   reset();
 }
 
 int sched::reset()
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::reset, 0, SRSRAN_INVALID_RNTI, 0);
+  }
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
@@ -69,6 +92,12 @@ int sched::reset()
 int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    sched_trace_record record;
+    record.type     = sched_trace_event::cell_cfg;
+    record.cell_cfg = cell_cfg;
+    trace->write(record);
+  }
   // Setup derived config params
   sched_cell_params.resize(cell_cfg.size());
   for (uint32_t cc_idx = 0; cc_idx < cell_cfg.size(); ++cc_idx) {
@@ -103,11 +132,22 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 
 int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
 {
+  // The trace record is written in the same critical section that applies the configuration
+  auto trace_ue_cfg = [this, rnti, &ue_cfg]() {
+    if (trace != nullptr) {
+      sched_trace_record record;
+      record.type   = sched_trace_event::ue_cfg;
+      record.rnti   = rnti;
+      record.ue_cfg = ue_cfg;
+      trace->write(record);
+    }
+  };
   {
     // config existing user
     std::lock_guard<std::mutex> lock(sched_mutex);
     auto                        it = ue_db.find(rnti);
     if (it != ue_db.end()) {
+      trace_ue_cfg();
       it->second->set_cfg(ue_cfg);
       return SRSRAN_SUCCESS;
     }
@@ -116,6 +156,7 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   // Add new user case
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace_ue_cfg();
   ue_db.insert(rnti, std::move(ue));
   return SRSRAN_SUCCESS;
 }
@@ -123,6 +164,9 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
 int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ue_rem, 0, rnti, 0);
+  }
   if (ue_db.contains(rnti)) {
     ue_db.erase(rnti);
   } else {
@@ -140,19 +184,36 @@ bool sched::ue_exists(uint16_t rnti)
 
 void sched::phy_config_enabled(uint16_t rnti, bool enabled)
 {
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::phy_config_enabled, 0, rnti, 0, enabled);
+  }
   // TODO: Check if correct use of last_tti
-  ue_db_access_locked(
+  ue_db_access(
       rnti, [this, enabled](sched_ue& ue) { ue.phy_config_enabled(last_tti, enabled); }, __PRETTY_FUNCTION__);
 }
 
 int sched::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg_)
 {
-  return ue_db_access_locked(rnti, [lc_id, cfg_](sched_ue& ue) { ue.set_bearer_cfg(lc_id, cfg_); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    sched_trace_record record;
+    record.type       = sched_trace_event::bearer_ue_cfg;
+    record.rnti       = rnti;
+    record.value[0]   = lc_id;
+    record.bearer_cfg = cfg_;
+    trace->write(record);
+  }
+  return ue_db_access(rnti, [lc_id, cfg_](sched_ue& ue) { ue.set_bearer_cfg(lc_id, cfg_); });
 }
 
 int sched::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
-  return ue_db_access_locked(rnti, [lc_id](sched_ue& ue) { ue.rem_bearer(lc_id); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::bearer_ue_rem, 0, rnti, 0, lc_id);
+  }
+  return ue_db_access(rnti, [lc_id](sched_ue& ue) { ue.rem_bearer(lc_id); });
 }
 
 uint32_t sched::get_dl_buffer(uint16_t rnti)
@@ -176,18 +237,30 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_rlc_buffer_state, 0, rnti, 0, lc_id, tx_queue, prio_tx_queue);
+  }
+  return ue_db_access(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_mac_buffer_state, 0, rnti, 0, ce_code, nof_cmds);
+  }
+  return ue_db_access(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_ack_info, tti_rx, rnti, enb_cc_idx, tb_idx, ack);
+  }
   int ret = -1;
-  ue_db_access_locked(
+  ue_db_access(
       rnti,
       [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
       __PRETTY_FUNCTION__);
@@ -196,31 +269,51 @@ int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ul_crc_info, tti_rx, rnti, enb_cc_idx, crc);
+  }
+  return ue_db_access(
       rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_ri_info, tti, rnti, enb_cc_idx, ri_value);
+  }
+  return ue_db_access(
       rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_pmi_info, tti, rnti, enb_cc_idx, pmi_value);
+  }
+  return ue_db_access(
       rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_cqi_info, tti, rnti, enb_cc_idx, cqi_value);
+  }
+  return ue_db_access(
       rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_sb_cqi_info, tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+  }
+  return ue_db_access(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
     ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
   });
 }
@@ -228,40 +321,79 @@ int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    sched_trace_record record;
+    record.type       = sched_trace_event::dl_rach_info;
+    record.enb_cc_idx = enb_cc_idx;
+    record.rar_info   = rar_info;
+    trace->write(record);
+  }
   return carrier_schedulers[enb_cc_idx]->dl_rach_info(rar_info);
 }
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    sched_trace_record record;
+    record.type       = sched_trace_event::ul_snr_info;
+    record.tti        = tti_rx;
+    record.rnti       = rnti;
+    record.enb_cc_idx = enb_cc_idx;
+    record.value[0]   = ul_ch_code;
+    record.snr        = snr;
+    trace->write(record);
+  }
+  return ue_db_access(rnti, [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ul_bsr, 0, rnti, 0, lcg_id, bsr);
+  }
+  return ue_db_access(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ul_buffer_add, 0, rnti, 0, lcid, bytes);
+  }
+  return ue_db_access(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ul_phr, 0, rnti, 0, (uint32_t)phr, ul_nof_prb);
+  }
+  return ue_db_access(
       rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ul_sr_info, tti, rnti, 0);
+  }
+  return ue_db_access(
       rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
 }
 
 void sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    sched_trace_record record;
+    record.type = sched_trace_event::set_dl_tti_mask;
+    record.tti_mask.assign(tti_mask, tti_mask + nof_sfs);
+    trace->write(record);
+  }
   carrier_schedulers[0]->set_dl_tti_mask(tti_mask, nof_sfs);
 }
 
@@ -304,6 +436,13 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
 int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    sched_trace_record record;
+    record.type       = sched_trace_event::set_pdcch_order;
+    record.enb_cc_idx = enb_cc_idx;
+    record.po_info    = pdcch_order_info;
+    trace->write(record);
+  }
   return carrier_schedulers[enb_cc_idx]->pdcch_order_info(pdcch_order_info);
 }
 
@@ -317,6 +456,9 @@ int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_i
 int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl_sched_res_t& sched_result)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::dl_sched, tti_tx_dl, SRSRAN_INVALID_RNTI, enb_cc_idx);
+  }
   if (not configured) {
     return 0;
   }
@@ -337,6 +479,9 @@ int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl
 int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::ul_sched_res_t& sched_result)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  if (trace != nullptr) {
+    trace->write(sched_trace_event::ul_sched, tti, SRSRAN_INVALID_RNTI, enb_cc_idx);
+  }
   if (not configured) {
     return 0;
   }
@@ -361,6 +506,13 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  if (cc_workers != nullptr and carrier_schedulers.size() > 1 and not has_multi_cc_ues()) {
+    if (not is_generated(tti_rx, 0)) {
+      new_tti_parallel(tti_rx);
+    }
+    return;
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -370,6 +522,59 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Whether any UE is configured with more than one CC. Such UEs are shared by the CCs, so the CCs are then scheduled
+/// sequentially
+bool sched::has_multi_cc_ues()
+{
+  for (auto& u : ue_db) {
+    if (u.second->nof_carriers_configured() > 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Generate scheduling decision for tti_rx of all CCs, with the CCs scheduled in parallel by the cc_workers
+/// NOTE: Only called when all UEs are configured with a single CC, so that each UE is only touched by its own CC. The
+///       UE and result state shared by the CCs is refreshed beforehand, and the CC results are generated once all CCs
+///       finished. The decisions match the ones of the sequential scheduler. sched_mutex is held for the whole TTI
+void sched::new_tti_parallel(tti_point tti_rx)
+{
+  for (auto& user : ue_db) {
+    user.second->new_subframe(tti_rx, 0);
+  }
+  for (tti_point tti : {tti_rx, tti_rx + MSG3_DELAY_MS}) {
+    if (not sched_results.has_sf(tti)) {
+      sched_results.new_tti(tti);
+    }
+  }
+
+  // Schedule the CCs. The calling thread takes care of the first CC
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_ccs = carrier_schedulers.size() - 1;
+  }
+  for (uint32_t cc_idx = 1; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    cc_workers->push_task([this, cc_idx, tti_rx]() {
+      carrier_schedulers[cc_idx]->sched_tti_parallel(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_ccs == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  carrier_schedulers[0]->sched_tti_parallel(tti_rx);
+  {
+    std::unique_lock<std::mutex> lock(cc_workers_mutex);
+    cc_workers_cvar.wait(lock, [this]() { return nof_pending_ccs == 0; });
+  }
+
+  // Generate the CC results
+  for (std::unique_ptr<carrier_sched>& carrier : carrier_schedulers) {
+    carrier->finish_tti_parallel(tti_rx);
+  }
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
@@ -387,7 +592,14 @@ template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  auto                        it = ue_db.find(rnti);
+  return ue_db_access(rnti, std::forward<Func>(f), func_name, log_fail);
+}
+
+// Access to ue_db elements, with sched_mutex already locked by the caller
+template <typename Func>
+int sched::ue_db_access(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
+{
+  auto it = ue_db.find(rnti);
   if (it != ue_db.end()) {
     f(*it->second);
   } else {
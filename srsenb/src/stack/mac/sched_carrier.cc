@@ -395,11 +395,26 @@ void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 
 const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_rx)
 {
-  sf_sched*        tti_sched = get_sf_sched(tti_rx);
-  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
-  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
-  bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
+  sched_tti(tti_sched);
+  return finish_tti(tti_sched);
+}
+
+void sched::carrier_sched::sched_tti_parallel(tti_point tti_rx)
+{
+  sched_tti(get_sf_sched(tti_rx));
+}
+
+const cc_sched_result& sched::carrier_sched::finish_tti_parallel(tti_point tti_rx)
+{
+  return finish_tti(get_sf_sched(tti_rx));
+}
+
+void sched::carrier_sched::sched_tti(sf_sched* tti_sched)
+{
+  tti_point tti_rx    = tti_sched->get_tti_rx();
+  bool      dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
 
   /* Refresh UE internal buffers and subframe vars */
   for (auto& user : *ue_db) {
@@ -440,6 +455,12 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   if ((tti_rx.to_uint() % 2) == 1) {
     alloc_ul_users(tti_sched);
   }
+}
+
+const cc_sched_result& sched::carrier_sched::finish_tti(sf_sched* tti_sched)
+{
+  tti_point        tti_rx    = tti_sched->get_tti_rx();
+  cc_sched_result* cc_result = prev_sched_results->get_cc(tti_rx, enb_cc_idx);
 
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
@@ -33,6 +33,21 @@ bool is_pucch_sr_collision(const srsran_pucch_cfg_t& ue_pucch_cfg, tti_point tti
   return false;
 }
 
+namespace {
+
+/// Mixes a CCE or PRB index into a 64-bit value. The hash of a set of CCEs/PRBs is the XOR of its elements' values
+uint64_t dfs_state_mix(uint64_t x)
+{
+  x = (x + 1) * 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31U);
+}
+
+const uint64_t PUCCH_HASH_OFFSET = 128;
+
+} // namespace
+
 void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
 {
   cc_cfg           = &cell_params_;
@@ -40,6 +55,34 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
   dci_record_list.reserve(16);
   last_dci_dfs.reserve(16);
   temp_dci_dfs.reserve(16);
+  remaining_cces.reserve(17);
+  remaining_pucch.reserve(17);
+  full_search.reserve(17);
+  conflicts.reserve(17);
+  dead_states.resize(DEAD_STATE_TABLE_SIZE);
+
+  // Count the PUCCH PRBs that the HARQ-ACKs of DL DCIs can use, given the CCEs available in each CFI
+  for (uint32_t cfix = 0; cfix < MAX_CFI; ++cfix) {
+    prbmask_t          harq_prbs(cc_cfg->nof_prb());
+    srsran_pucch_cfg_t pucch_cfg = pucch_cfg_common;
+    for (uint32_t ncce = 0; ncce < cc_cfg->nof_cce_table[cfix]; ++ncce) {
+      pucch_cfg.n_pucch = ncce + pucch_cfg.N_pucch_1;
+      int pucch_n_prb   = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg, 0);
+      if (is_harq_pucch_prb_valid(pucch_n_prb)) {
+        harq_prbs.set(pucch_n_prb);
+      }
+    }
+    nof_harq_pucch_prbs[cfix] = harq_prbs.count();
+  }
+}
+
+bool sf_cch_allocator::is_harq_pucch_prb_valid(int pucch_n_prb) const
+{
+  if (pucch_n_prb < 0 or pucch_n_prb >= (int)cc_cfg->nof_prb()) {
+    return false;
+  }
+  int low_rb = pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2 ? pucch_n_prb : cc_cfg->cfg.cell.nof_prb - pucch_n_prb - 1;
+  return cc_cfg->sched_cfg->pucch_harq_max_rb <= 0 or low_rb < cc_cfg->sched_cfg->pucch_harq_max_rb;
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -82,6 +125,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   record.aggr_idx   = aggr_idx;
   record.alloc_type = alloc_type;
   record.pusch_uci  = has_pusch_grant;
+  set_dfs_search_records(record);
 
   if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 0 and cc_cfg->nof_prb() <= 25 and
       current_max_cfix > current_cfix) {
@@ -127,15 +171,22 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
 bool sf_cch_allocator::get_next_dfs()
 {
   do {
+    if (nof_dfs_nodes >= MAX_DFS_NODES) {
+      // Bound the search time in crowded subframes
+      return false;
+    }
     uint32_t start_child_idx = 0;
-    if (last_dci_dfs.empty()) {
+    int      jump_depth      = get_backjump_depth(last_dci_dfs.size());
+    if (jump_depth < 0) {
       // If we reach root, increase CFI
+      last_dci_dfs.clear();
       current_cfix++;
       if (current_cfix > current_max_cfix) {
         return false;
       }
     } else {
-      // Attempt to re-add last tree node, but with a higher node child index
+      // Attempt to re-add the tree node that caused the failure, but with a higher node child index
+      last_dci_dfs.erase(last_dci_dfs.begin() + jump_depth + 1, last_dci_dfs.end());
       start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
       last_dci_dfs.pop_back();
     }
@@ -149,37 +200,143 @@ bool sf_cch_allocator::get_next_dfs()
   return true;
 }
 
-bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+int sf_cch_allocator::get_backjump_depth(uint32_t failed_depth)
 {
-  // Get DCI Location Table
-  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
+  if (failed_depth == 0) {
+    return -1;
   }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
-    return false;
+  if (not full_search[failed_depth]) {
+    // The children of this DFS level were not all visited. Fallback to chronological backtracking
+    return failed_depth - 1;
+  }
+  for (int depth = failed_depth - 1; depth >= 0; --depth) {
+    if (conflicts[failed_depth].test(depth)) {
+      // The backtracked level inherits the conflicts of the failed level
+      conflicts[depth] |= conflicts[failed_depth];
+      conflicts[depth].reset(depth);
+      return depth;
+    }
+  }
+  return -1;
+}
+
+void sf_cch_allocator::add_conflict(uint32_t depth, uint32_t ncce, uint32_t aggr_idx, int pucch_n_prb)
+{
+  for (uint32_t i = 0; i < depth; ++i) {
+    const tree_node& node = last_dci_dfs[i];
+    if (pucch_n_prb >= 0 ? node.pucch_n_prb == pucch_n_prb
+                         : (node.dci_pos.ncce < ncce + (1U << aggr_idx) and
+                            ncce < node.dci_pos.ncce + (1U << node.dci_pos.L))) {
+      conflicts[depth].set(i);
+      return;
+    }
+  }
+}
+
+void sf_cch_allocator::set_dfs_search_records(const alloc_record& new_record)
+{
+  uint32_t nof_records = dci_record_list.size() + 1;
+  remaining_cces.assign(nof_records + 1, 0);
+  remaining_pucch.assign(nof_records + 1, 0);
+  remaining_cces[nof_records - 1]  = 1U << new_record.aggr_idx;
+  remaining_pucch[nof_records - 1] = new_record.needs_harq_pucch() ? 1 : 0;
+  for (uint32_t i = nof_records - 1; i > 0; --i) {
+    const alloc_record& record = dci_record_list[i - 1];
+    remaining_cces[i - 1]      = remaining_cces[i] + (1U << record.aggr_idx);
+    remaining_pucch[i - 1]     = remaining_pucch[i] + (record.needs_harq_pucch() ? 1 : 0);
+  }
+  full_search.assign(nof_records, false);
+  nof_dfs_nodes = 0;
+  conflicts.assign(nof_records, dfs_depth_mask_t(nof_records));
+
+  // The DFS states marked as dead are only valid for the current list of DCI records
+  if (++dead_states_gen == 0) {
+    std::fill(dead_states.begin(), dead_states.end(), dead_dfs_state{});
+    dead_states_gen = 1;
+  }
+}
+
+void sf_cch_allocator::mark_dead_state(uint32_t            depth,
+                                       uint64_t            hash,
+                                       const pdcch_mask_t& pdcch_mask,
+                                       const prbmask_t&    pucch_mask)
+{
+  for (uint32_t i = 0; i < MAX_DEAD_STATE_PROBES; ++i) {
+    dead_dfs_state& entry = dead_states[(hash + i) % DEAD_STATE_TABLE_SIZE];
+    if (entry.generation != dead_states_gen) {
+      entry.generation = dead_states_gen;
+      entry.cfix       = current_cfix;
+      entry.depth      = depth;
+      entry.hash       = hash;
+      entry.pdcch_mask = pdcch_mask;
+      entry.pucch_mask = pucch_mask;
+      return;
+    }
+  }
+  // Table region is full. The state is just not memoized
+}
+
+bool sf_cch_allocator::is_dead_state(uint32_t            depth,
+                                     uint64_t            hash,
+                                     const pdcch_mask_t& pdcch_mask,
+                                     const prbmask_t&    pucch_mask) const
+{
+  for (uint32_t i = 0; i < MAX_DEAD_STATE_PROBES; ++i) {
+    const dead_dfs_state& entry = dead_states[(hash + i) % DEAD_STATE_TABLE_SIZE];
+    if (entry.generation != dead_states_gen) {
+      return false;
+    }
+    if (entry.hash == hash and entry.depth == depth and entry.cfix == current_cfix and
+        entry.pdcch_mask == pdcch_mask and entry.pucch_mask == pucch_mask) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+{
+  uint32_t depth = last_dci_dfs.size();
+  nof_dfs_nodes++;
+  if (start_dci_idx == 0) {
+    full_search[depth] = true;
+    conflicts[depth].reset();
   }
 
   tree_node node;
   node.dci_pos_idx = start_dci_idx;
   node.dci_pos.L   = record.aggr_idx;
   node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
   // get cumulative pdcch & pucch masks
   if (not last_dci_dfs.empty()) {
     node.total_mask       = last_dci_dfs.back().total_mask;
     node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
+    node.state_hash       = last_dci_dfs.back().state_hash;
   } else {
     node.total_mask.resize(nof_cces());
     node.total_pucch_mask.resize(cc_cfg->nof_prb());
   }
 
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
+  // Get DCI Location Table
+  const cce_cfi_position_table* dci_locs  = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
+  const cce_position_list*      pos_list  = dci_locs != nullptr ? &(*dci_locs)[record.aggr_idx] : nullptr;
+  uint32_t                      nof_pos   = pos_list != nullptr ? pos_list->size() : 0;
+  uint32_t                      nof_free  = nof_cces() - node.total_mask.count();
+  uint32_t                      node_cces = 1U << record.aggr_idx;
+
+  // Skip the search if the free CCEs or HARQ-ACK PUCCH PRBs are not enough for this and the remaining DCI records
+  if (nof_free < remaining_cces[depth] or
+      (not cc_cfg->sched_cfg->pucch_mux_enabled and
+       nof_harq_pucch_prbs[current_cfix] < node.total_pucch_mask.count() + remaining_pucch[depth])) {
+    conflicts[depth].fill(0, depth);
+    nof_pos = 0;
+  }
+
+  for (; node.dci_pos_idx < nof_pos; ++node.dci_pos_idx) {
+    node.dci_pos.ncce = (*pos_list)[node.dci_pos_idx];
+    int pucch_n_prb   = -1;
 
-    if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
-      // The UE needs to allocate space in PUCCH for HARQ-ACK
+    if (record.needs_harq_pucch()) {
       pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
 
       if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
@@ -187,15 +344,13 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
         continue;
       }
 
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
+      pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
+      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(pucch_n_prb)) {
         // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
+        add_conflict(depth, node.dci_pos.ncce, 0, pucch_n_prb);
         continue;
       }
-      int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
-                       ? node.pucch_n_prb
-                       : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
-      if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
+      if (not is_harq_pucch_prb_valid(pucch_n_prb)) {
         // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
         logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
                     node.dci_pos.ncce);
@@ -203,22 +358,51 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
       }
     }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    if (node.total_mask.any(node.dci_pos.ncce, node.dci_pos.ncce + node_cces)) {
       // there is a PDCCH collision. Try another CCE position
+      add_conflict(depth, node.dci_pos.ncce, record.aggr_idx, -1);
       continue;
     }
 
+    // Derive the DFS state that results from this CCE position, and skip it if it is known to lead to no solution
+    pdcch_mask_t child_mask = node.total_mask;
+    child_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + node_cces);
+    uint64_t child_hash = node.state_hash;
+    for (uint32_t i = node.dci_pos.ncce; i < node.dci_pos.ncce + node_cces; ++i) {
+      child_hash ^= dfs_state_mix(i);
+    }
+    bool new_pucch_prb = pucch_n_prb >= 0 and not node.total_pucch_mask.test(pucch_n_prb);
+    if (new_pucch_prb) {
+      child_hash ^= dfs_state_mix(PUCCH_HASH_OFFSET + pucch_n_prb);
+    }
+    if (depth + 1 < full_search.size()) {
+      prbmask_t child_pucch_mask = node.total_pucch_mask;
+      if (new_pucch_prb) {
+        child_pucch_mask.set(pucch_n_prb);
+      }
+      if (is_dead_state(depth + 1, child_hash, child_mask, child_pucch_mask)) {
+        conflicts[depth].fill(0, depth);
+        continue;
+      }
+    }
+
     // Allocation successful
-    node.total_mask |= node.current_mask;
-    if (node.pucch_n_prb >= 0) {
-      node.total_pucch_mask.set(node.pucch_n_prb);
+    node.pucch_n_prb = pucch_n_prb;
+    node.current_mask.resize(nof_cces());
+    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + node_cces);
+    node.total_mask = child_mask;
+    if (new_pucch_prb) {
+      node.total_pucch_mask.set(pucch_n_prb);
     }
+    node.state_hash = child_hash;
     last_dci_dfs.push_back(node);
     return true;
   }
 
+  if (full_search[depth]) {
+    // All the children of this DFS node were visited without finding a solution
+    mark_dead_state(depth, node.state_hash, node.total_mask, node.total_pucch_mask);
+  }
   return false;
 }
 
@@ -0,0 +1,600 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsran/srslog/srslog.h"
+#include <cstring>
+#include <type_traits>
+
+namespace srsenb {
+
+namespace {
+
+const char     trace_magic[7] = {'S', 'R', 'S', 'S', 'C', 'H', 'T'};
+const uint8_t  trace_version  = 1;
+const uint32_t header_len     = sizeof(trace_magic) + sizeof(trace_version);
+const uint32_t record_hdr_len = sizeof(uint8_t) + sizeof(uint32_t);
+
+/// Appends the fields of a record to a byte buffer
+class trace_encoder
+{
+public:
+  explicit trace_encoder(std::vector<uint8_t>& buffer_) : buffer(buffer_) {}
+
+  template <typename T>
+  void operator()(const T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored as bytes");
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&v);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+  }
+  template <typename T>
+  void operator()(const std::vector<T>& v)
+  {
+    list(v, [this](const T& e) { (*this)(e); });
+  }
+  template <typename T, typename ElemFunc>
+  void list(const std::vector<T>& v, ElemFunc&& f)
+  {
+    (*this)((uint32_t)v.size());
+    for (const T& e : v) {
+      f(e);
+    }
+  }
+  void operator()(const std::string& s)
+  {
+    (*this)((uint32_t)s.size());
+    buffer.insert(buffer.end(), s.begin(), s.end());
+  }
+
+private:
+  std::vector<uint8_t>& buffer;
+};
+
+/// Extracts the fields of a record from a byte span. Once a read goes past the end of the span, all following reads
+/// are ignored and ok() returns false
+class trace_decoder
+{
+public:
+  trace_decoder(const uint8_t* ptr_, size_t len) : ptr(ptr_), end(ptr_ + len) {}
+
+  template <typename T>
+  void operator()(T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored as bytes");
+    if (not consume(sizeof(T))) {
+      return;
+    }
+    memcpy(&v, ptr - sizeof(T), sizeof(T));
+  }
+  template <typename T>
+  void operator()(std::vector<T>& v)
+  {
+    list(v, [this](T& e) { (*this)(e); });
+  }
+  template <typename T, typename ElemFunc>
+  void list(std::vector<T>& v, ElemFunc&& f)
+  {
+    uint32_t n = 0;
+    (*this)(n);
+    if (n > (size_t)(end - ptr)) {
+      // Every element takes at least one byte
+      success = false;
+      return;
+    }
+    v.resize(n);
+    for (T& e : v) {
+      f(e);
+    }
+  }
+  void operator()(std::string& s)
+  {
+    uint32_t n = 0;
+    (*this)(n);
+    if (not consume(n)) {
+      return;
+    }
+    s.assign(reinterpret_cast<const char*>(ptr - n), n);
+  }
+  bool ok() const { return success and ptr == end; }
+
+private:
+  bool consume(size_t n)
+  {
+    if (not success or n > (size_t)(end - ptr)) {
+      success = false;
+      return false;
+    }
+    ptr += n;
+    return true;
+  }
+
+  const uint8_t* ptr;
+  const uint8_t* end;
+  bool           success = true;
+};
+
+template <typename Args, typename Codec>
+void visit_sched_args(Args& a, Codec& c)
+{
+  c(a.sched_policy);
+  c(a.sched_policy_args);
+  c(a.pdsch_mcs);
+  c(a.pdsch_max_mcs);
+  c(a.pusch_mcs);
+  c(a.pusch_max_mcs);
+  c(a.min_nof_ctrl_symbols);
+  c(a.max_nof_ctrl_symbols);
+  c(a.min_aggr_level);
+  c(a.max_aggr_level);
+  c(a.adaptive_aggr_level);
+  c(a.pucch_mux_enabled);
+  c(a.pucch_harq_max_rb);
+  c(a.target_bler);
+  c(a.max_delta_dl_cqi);
+  c(a.max_delta_ul_snr);
+  c(a.adaptive_dl_mcs_step_size);
+  c(a.adaptive_ul_mcs_step_size);
+  c(a.min_tpc_tti_interval);
+  c(a.ul_snr_avg_alpha);
+  c(a.init_ul_snr_value);
+  c(a.init_dl_cqi);
+  c(a.max_sib_coderate);
+  c(a.pdcch_cqi_offset);
+  c(a.nof_cc_workers);
+}
+
+template <typename Cell, typename Codec>
+void visit_cell_cfg(Cell& cell, Codec& c)
+{
+  c(cell.cell);
+  c(cell.sibs);
+  c(cell.si_window_ms);
+  c(cell.target_pucch_ul_sinr);
+  c(cell.pusch_hopping_cfg);
+  c(cell.target_pusch_ul_sinr);
+  c(cell.min_phr_thres);
+  c(cell.enable_phr_handling);
+  c(cell.enable_64qam);
+  c(cell.prach_config);
+  c(cell.prach_nof_preambles);
+  c(cell.prach_freq_offset);
+  c(cell.prach_rar_window);
+  c(cell.prach_contention_resolution_timer);
+  c(cell.maxharq_msg3tx);
+  c(cell.n1pucch_an);
+  c(cell.delta_pucch_shift);
+  c(cell.nrb_pucch);
+  c(cell.nrb_cqi);
+  c(cell.ncs_an);
+  c(cell.srs_subframe_config);
+  c(cell.srs_subframe_offset);
+  c(cell.srs_bw_config);
+  c(cell.scell_list);
+}
+
+template <typename Ue, typename Codec>
+void visit_ue_cfg(Ue& ue, Codec& c)
+{
+  c(ue.maxharq_tx);
+  c(ue.continuous_pusch);
+  c(ue.uci_offset);
+  c(ue.pucch_cfg);
+  c(ue.ue_bearers);
+  c(ue.supported_cc_list);
+  c(ue.dl_ant_info);
+  c(ue.use_tbs_index_alt);
+  c(ue.measgap_period);
+  c(ue.measgap_offset);
+  c(ue.support_ul64qam);
+}
+
+/// Visits the fields of the record that are used by its event type
+template <typename Record, typename Codec>
+void visit_record(Record& r, Codec& c)
+{
+  switch (r.type) {
+    case sched_trace_event::sched_args:
+      visit_sched_args(r.sched_args, c);
+      break;
+    case sched_trace_event::cell_cfg:
+      c.list(r.cell_cfg, [&c](decltype(r.cell_cfg[0]) cell) { visit_cell_cfg(cell, c); });
+      break;
+    case sched_trace_event::reset:
+      break;
+    case sched_trace_event::ue_cfg:
+      c(r.rnti);
+      visit_ue_cfg(r.ue_cfg, c);
+      break;
+    case sched_trace_event::ue_rem:
+      c(r.rnti);
+      break;
+    case sched_trace_event::ul_sr_info:
+      c(r.tti);
+      c(r.rnti);
+      break;
+    case sched_trace_event::phy_config_enabled:
+    case sched_trace_event::bearer_ue_rem:
+      c(r.rnti);
+      c(r.value[0]);
+      break;
+    case sched_trace_event::bearer_ue_cfg:
+      c(r.rnti);
+      c(r.value[0]);
+      c(r.bearer_cfg);
+      break;
+    case sched_trace_event::dl_rlc_buffer_state:
+      c(r.rnti);
+      c(r.value);
+      break;
+    case sched_trace_event::dl_mac_buffer_state:
+    case sched_trace_event::ul_bsr:
+    case sched_trace_event::ul_phr:
+    case sched_trace_event::ul_buffer_add:
+      c(r.rnti);
+      c(r.value[0]);
+      c(r.value[1]);
+      break;
+    case sched_trace_event::dl_ack_info:
+    case sched_trace_event::dl_sb_cqi_info:
+      c(r.tti);
+      c(r.rnti);
+      c(r.enb_cc_idx);
+      c(r.value[0]);
+      c(r.value[1]);
+      break;
+    case sched_trace_event::dl_ri_info:
+    case sched_trace_event::dl_pmi_info:
+    case sched_trace_event::dl_cqi_info:
+    case sched_trace_event::ul_crc_info:
+      c(r.tti);
+      c(r.rnti);
+      c(r.enb_cc_idx);
+      c(r.value[0]);
+      break;
+    case sched_trace_event::ul_snr_info:
+      c(r.tti);
+      c(r.rnti);
+      c(r.enb_cc_idx);
+      c(r.value[0]);
+      c(r.snr);
+      break;
+    case sched_trace_event::dl_rach_info:
+      c(r.enb_cc_idx);
+      c(r.rar_info);
+      break;
+    case sched_trace_event::set_pdcch_order:
+      c(r.enb_cc_idx);
+      c(r.po_info);
+      break;
+    case sched_trace_event::set_dl_tti_mask:
+      c(r.tti_mask);
+      break;
+    case sched_trace_event::dl_sched:
+    case sched_trace_event::ul_sched:
+      c(r.tti);
+      c(r.enb_cc_idx);
+      break;
+    case sched_trace_event::paging:
+      c(r.tti);
+      c(r.value[0]);
+      break;
+    default:
+      break;
+  }
+}
+
+} // namespace
+
+const char* to_string(sched_trace_event event)
+{
+  static const char* names[] = {"sched_args", "cell_cfg", "reset", "ue_cfg", "ue_rem", "phy_config_enabled",
+                                "bearer_ue_cfg", "bearer_ue_rem", "dl_rlc_buffer_state", "dl_mac_buffer_state",
+                                "dl_ack_info", "dl_rach_info", "dl_ri_info", "dl_pmi_info", "dl_cqi_info",
+                                "dl_sb_cqi_info", "ul_crc_info", "ul_sr_info", "ul_bsr", "ul_phr", "ul_snr_info",
+                                "ul_buffer_add", "set_pdcch_order", "set_dl_tti_mask", "dl_sched", "ul_sched",
+                                "paging"};
+  static_assert(sizeof(names) / sizeof(names[0]) == (size_t)sched_trace_event::nof_events, "Missing event names");
+  return event < sched_trace_event::nof_events ? names[(size_t)event] : "invalid";
+}
+
+/*******************************************************
+ *                  Trace writer
+ *******************************************************/
+
+sched_trace_writer::sched_trace_writer(const std::string& filename)
+{
+  fp = fopen(filename.c_str(), "wb");
+  if (fp == nullptr) {
+    srslog::fetch_basic_logger("MAC").error("Failed to open scheduler trace file %s", filename.c_str());
+    return;
+  }
+  buffer.reserve(flush_threshold + 4096);
+  buffer.insert(buffer.end(), trace_magic, trace_magic + sizeof(trace_magic));
+  buffer.push_back(trace_version);
+}
+
+sched_trace_writer::~sched_trace_writer()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (fp != nullptr) {
+    flush_nolock();
+    fclose(fp);
+    fp = nullptr;
+  }
+}
+
+void sched_trace_writer::write(const sched_trace_record& record)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (fp == nullptr) {
+    return;
+  }
+
+  size_t hdr_pos = buffer.size();
+  buffer.resize(hdr_pos + record_hdr_len);
+  trace_encoder enc(buffer);
+  visit_record(record, enc);
+
+  uint32_t payload_len = buffer.size() - hdr_pos - record_hdr_len;
+  buffer[hdr_pos]      = (uint8_t)record.type;
+  memcpy(&buffer[hdr_pos + 1], &payload_len, sizeof(payload_len));
+
+  if (buffer.size() >= flush_threshold) {
+    flush_nolock();
+  }
+}
+
+void sched_trace_writer::write(sched_trace_event type,
+                               uint32_t          tti,
+                               uint16_t          rnti,
+                               uint32_t          enb_cc_idx,
+                               uint32_t          v0,
+                               uint32_t          v1,
+                               uint32_t          v2)
+{
+  sched_trace_record record;
+  record.type       = type;
+  record.tti        = tti;
+  record.rnti       = rnti;
+  record.enb_cc_idx = enb_cc_idx;
+  record.value[0]   = v0;
+  record.value[1]   = v1;
+  record.value[2]   = v2;
+  write(record);
+}
+
+void sched_trace_writer::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (fp != nullptr) {
+    flush_nolock();
+    fflush(fp);
+  }
+}
+
+void sched_trace_writer::flush_nolock()
+{
+  if (not buffer.empty() and fwrite(buffer.data(), 1, buffer.size(), fp) != buffer.size()) {
+    srslog::fetch_basic_logger("MAC").error("Failed to write %zd bytes to the scheduler trace", buffer.size());
+  }
+  buffer.clear();
+}
+
+/*******************************************************
+ *                  Trace reader
+ *******************************************************/
+
+bool sched_trace_reader::open(const std::string& filename)
+{
+  buffer.clear();
+  offset    = 0;
+  corrupted = false;
+
+  FILE* fp = fopen(filename.c_str(), "rb");
+  if (fp == nullptr) {
+    return false;
+  }
+  uint8_t tmp[4096];
+  size_t  n;
+  while ((n = fread(tmp, 1, sizeof(tmp), fp)) > 0) {
+    buffer.insert(buffer.end(), tmp, tmp + n);
+  }
+  fclose(fp);
+
+  if (buffer.size() < header_len or memcmp(buffer.data(), trace_magic, sizeof(trace_magic)) != 0 or
+      buffer[sizeof(trace_magic)] != trace_version) {
+    buffer.clear();
+    return false;
+  }
+  offset = header_len;
+  return true;
+}
+
+bool sched_trace_reader::read(sched_trace_record& record)
+{
+  if (corrupted or offset + record_hdr_len > buffer.size()) {
+    corrupted |= offset != buffer.size();
+    return false;
+  }
+  uint32_t payload_len;
+  memcpy(&payload_len, &buffer[offset + 1], sizeof(payload_len));
+  if (buffer[offset] >= (uint8_t)sched_trace_event::nof_events or
+      payload_len > buffer.size() - offset - record_hdr_len) {
+    corrupted = true;
+    return false;
+  }
+  record.type = (sched_trace_event)buffer[offset];
+
+  trace_decoder dec(&buffer[offset + record_hdr_len], payload_len);
+  visit_record(record, dec);
+  if (not dec.ok()) {
+    corrupted = true;
+    return false;
+  }
+  offset += record_hdr_len + payload_len;
+  return true;
+}
+
+void sched_trace_reader::rewind()
+{
+  offset    = buffer.empty() ? 0 : header_len;
+  corrupted = false;
+}
+
+/*******************************************************
+ *                  RRC proxy
+ *******************************************************/
+
+int sched_trace_rrc_proxy::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg)
+{
+  return rrc->add_user(rnti, init_ue_cfg);
+}
+
+void sched_trace_rrc_proxy::upd_user(uint16_t new_rnti, uint16_t old_rnti)
+{
+  rrc->upd_user(new_rnti, old_rnti);
+}
+
+void sched_trace_rrc_proxy::set_activity_user(uint16_t rnti)
+{
+  rrc->set_activity_user(rnti);
+}
+
+void sched_trace_rrc_proxy::set_radiolink_dl_state(uint16_t rnti, bool crc_res)
+{
+  rrc->set_radiolink_dl_state(rnti, crc_res);
+}
+
+void sched_trace_rrc_proxy::set_radiolink_ul_state(uint16_t rnti, bool crc_res)
+{
+  rrc->set_radiolink_ul_state(rnti, crc_res);
+}
+
+bool sched_trace_rrc_proxy::is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len)
+{
+  bool ret = rrc->is_paging_opportunity(tti_tx_dl, payload_len);
+  // Only the pending paging messages are stored. No entry means no paging for that TTI
+  if (ret and *payload_len > 0) {
+    trace->write(sched_trace_event::paging, tti_tx_dl, SRSRAN_INVALID_RNTI, 0, *payload_len);
+  }
+  return ret;
+}
+
+void sched_trace_rrc_proxy::read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t payload_size)
+{
+  rrc->read_pdu_pcch(tti_tx_dl, payload, payload_size);
+}
+
+uint8_t* sched_trace_rrc_proxy::read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index)
+{
+  return rrc->read_pdu_bcch_dlsch(enb_cc_idx, sib_index);
+}
+
+/*******************************************************
+ *                  Replay
+ *******************************************************/
+
+void sched_trace_rrc_stub::add_paging(uint32_t tti_tx_dl, uint32_t payload_len)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  pending_paging.emplace_back(tti_tx_dl, payload_len);
+}
+
+bool sched_trace_rrc_stub::is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (pending_paging.empty() or pending_paging.front().first != tti_tx_dl) {
+    return false;
+  }
+  *payload_len = pending_paging.front().second;
+  pending_paging.pop_front();
+  return true;
+}
+
+int sched_trace_replay_event(sched&                           sched_obj,
+                             const sched_trace_record&        r,
+                             sched_interface::dl_sched_res_t& dl_result,
+                             sched_interface::ul_sched_res_t& ul_result)
+{
+  switch (r.type) {
+    case sched_trace_event::cell_cfg:
+      return sched_obj.cell_cfg(r.cell_cfg);
+    case sched_trace_event::reset:
+      return sched_obj.reset();
+    case sched_trace_event::ue_cfg:
+      return sched_obj.ue_cfg(r.rnti, r.ue_cfg);
+    case sched_trace_event::ue_rem:
+      return sched_obj.ue_rem(r.rnti);
+    case sched_trace_event::phy_config_enabled:
+      sched_obj.phy_config_enabled(r.rnti, r.value[0] != 0);
+      return SRSRAN_SUCCESS;
+    case sched_trace_event::bearer_ue_cfg:
+      return sched_obj.bearer_ue_cfg(r.rnti, r.value[0], r.bearer_cfg);
+    case sched_trace_event::bearer_ue_rem:
+      return sched_obj.bearer_ue_rem(r.rnti, r.value[0]);
+    case sched_trace_event::dl_rlc_buffer_state:
+      return sched_obj.dl_rlc_buffer_state(r.rnti, r.value[0], r.value[1], r.value[2]);
+    case sched_trace_event::dl_mac_buffer_state:
+      return sched_obj.dl_mac_buffer_state(r.rnti, r.value[0], r.value[1]);
+    case sched_trace_event::dl_ack_info:
+      return sched_obj.dl_ack_info(r.tti, r.rnti, r.enb_cc_idx, r.value[0], r.value[1] != 0);
+    case sched_trace_event::dl_rach_info:
+      return sched_obj.dl_rach_info(r.enb_cc_idx, r.rar_info);
+    case sched_trace_event::dl_ri_info:
+      return sched_obj.dl_ri_info(r.tti, r.rnti, r.enb_cc_idx, r.value[0]);
+    case sched_trace_event::dl_pmi_info:
+      return sched_obj.dl_pmi_info(r.tti, r.rnti, r.enb_cc_idx, r.value[0]);
+    case sched_trace_event::dl_cqi_info:
+      return sched_obj.dl_cqi_info(r.tti, r.rnti, r.enb_cc_idx, r.value[0]);
+    case sched_trace_event::dl_sb_cqi_info:
+      return sched_obj.dl_sb_cqi_info(r.tti, r.rnti, r.enb_cc_idx, r.value[0], r.value[1]);
+    case sched_trace_event::ul_crc_info:
+      return sched_obj.ul_crc_info(r.tti, r.rnti, r.enb_cc_idx, r.value[0] != 0);
+    case sched_trace_event::ul_sr_info:
+      return sched_obj.ul_sr_info(r.tti, r.rnti);
+    case sched_trace_event::ul_bsr:
+      return sched_obj.ul_bsr(r.rnti, r.value[0], r.value[1]);
+    case sched_trace_event::ul_phr:
+      return sched_obj.ul_phr(r.rnti, (int)r.value[0], r.value[1]);
+    case sched_trace_event::ul_snr_info:
+      return sched_obj.ul_snr_info(r.tti, r.rnti, r.enb_cc_idx, r.snr, r.value[0]);
+    case sched_trace_event::ul_buffer_add:
+      return sched_obj.ul_buffer_add(r.rnti, r.value[0], r.value[1]);
+    case sched_trace_event::set_pdcch_order:
+      return sched_obj.set_pdcch_order(r.enb_cc_idx, r.po_info);
+    case sched_trace_event::set_dl_tti_mask: {
+      std::vector<uint8_t> mask = r.tti_mask;
+      sched_obj.set_dl_tti_mask(mask.data(), mask.size());
+      return SRSRAN_SUCCESS;
+    }
+    case sched_trace_event::dl_sched:
+      return sched_obj.dl_sched(r.tti, r.enb_cc_idx, dl_result);
+    case sched_trace_event::ul_sched:
+      return sched_obj.ul_sched(r.tti, r.enb_cc_idx, ul_result);
+    default:
+      break;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
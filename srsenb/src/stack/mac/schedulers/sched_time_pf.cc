@@ -20,6 +20,9 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include "srsran/phy/utils/vector.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace srsenb {
@@ -32,24 +35,12 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
   if (not sched_args.sched_policy_args.empty()) {
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
-
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
-  }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
+  dl_queue.clear();
+  ul_queue.clear();
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
   // remove deleted users from history
   for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
@@ -65,20 +56,23 @@ void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
     if (it == ue_history_db.end()) {
       it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
     }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+    ue_ctxt& ue = it->second;
+    ue.new_tti(*cc_cfg, *u.second, tti_sched);
+    if (ue.dl_newtx_h != nullptr or ue.dl_retx_h != nullptr) {
+      dl_queue.push(&ue, ue.dl_retx_h != nullptr, ue.dl_rate, ue.dl_inv_avg_pow());
     }
-    if (it->second.ul_h != nullptr) {
+    if (ue.ul_h != nullptr) {
       // Allocate only if UL carrier is enabled
       for (auto& i : u.second->get_ue_cfg().supported_cc_list) {
         if (i.enb_cc_idx == cc_cfg->enb_cc_idx and not i.ul_disabled) {
-          ul_queue.push(&it->second);
+          ul_queue.push(&ue, ue.ul_h->has_pending_retx(), ue.ul_rate, ue.ul_inv_avg_pow());
           break;
         }
       }
     }
   }
+  dl_queue.compute_prios();
+  ul_queue.compute_prios();
 }
 
 /*****************************************************************
@@ -93,9 +87,14 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
   }
 
   while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
+    if (tti_sched->get_dl_mask().all()) {
+      // No DL allocation is possible for the remaining UEs. They are popped without being ordered, as their priority
+      // order is irrelevant
+      dl_queue.pop_unordered()->save_dl_alloc(0, 0.01);
+      continue;
+    }
+    ue_ctxt& ue = *dl_queue.pop();
     ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
   }
 }
 
@@ -132,9 +131,8 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
   }
 
   while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
+    ue_ctxt& ue = *ul_queue.pop();
     ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
   }
 }
 
@@ -183,35 +181,40 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
   dl_retx_h  = nullptr;
   dl_newtx_h = nullptr;
   ul_h       = nullptr;
-  dl_prio    = 0;
+  dl_rate    = 0;
+  ul_rate    = 0;
   ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
   if (ue_cc_idx < 0) {
     // not active
     return;
   }
 
-  // Calculate DL priority
+  // Calculate DL expected rate, used in the PF priority
   dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
   dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
   if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
-    // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    dl_rate = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
   }
 
-  // Calculate UL priority
+  // Calculate UL expected rate, used in the PF priority
   ul_h = get_ul_retx_harq(ue, tti_sched);
   if (ul_h == nullptr) {
     ul_h = get_ul_newtx_harq(ue, tti_sched);
   }
   if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    ul_rate = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
   }
 }
 
+float sched_time_pf::ue_ctxt::inv_avg_pow(float avg_rate) const
+{
+  if (avg_rate == 0) {
+    return std::numeric_limits<float>::max();
+  }
+  return std::min(1.0F / (fairness_coeff == 1 ? avg_rate : std::pow(avg_rate, fairness_coeff)),
+                  std::numeric_limits<float>::max());
+}
+
 void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
 {
   if (dl_nof_samples < 1 / exp_avg_alpha) {
@@ -220,6 +223,7 @@ void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_a
   } else {
     dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
   }
+  dl_inv_avg_pow_ = inv_avg_pow(dl_avg_rate_);
   dl_nof_samples++;
 }
 
@@ -231,21 +235,81 @@ void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_a
   } else {
     ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
   }
+  ul_inv_avg_pow_ = inv_avg_pow(ul_avg_rate_);
   ul_nof_samples++;
 }
 
-bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+/*****************************************************************
+ *                     PF candidate list
+ *****************************************************************/
+
+sched_time_pf::ue_candidate_list::ue_candidate_list()
+{
+  ues.reserve(SRSENB_MAX_UES);
+  is_retx.reserve(SRSENB_MAX_UES);
+  rate.reserve(SRSENB_MAX_UES);
+  inv_avg_pow.reserve(SRSENB_MAX_UES);
+  prio.reserve(SRSENB_MAX_UES);
+  order.reserve(SRSENB_MAX_UES);
+}
+
+void sched_time_pf::ue_candidate_list::clear()
+{
+  ues.clear();
+  is_retx.clear();
+  rate.clear();
+  inv_avg_pow.clear();
+  prio.clear();
+  order.clear();
+  next_idx    = 0;
+  nof_ordered = 0;
+}
+
+void sched_time_pf::ue_candidate_list::push(ue_ctxt* ue, bool is_retx_, float rate_, float inv_avg_pow_)
+{
+  order.push_back(ues.size());
+  ues.push_back(ue);
+  is_retx.push_back(is_retx_ ? 1 : 0);
+  rate.push_back(rate_);
+  inv_avg_pow.push_back(inv_avg_pow_);
+}
+
+void sched_time_pf::ue_candidate_list::compute_prios()
 {
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
+  // PF priority: r / R^fairness_coeff
+  prio.resize(ues.size());
+  srsran_vec_prod_fff(rate.data(), inv_avg_pow.data(), prio.data(), prio.size());
+
+  // A UE without average rate samples has max priority, unless r=0. The products that overflowed are saturated, so
+  // that these UEs tie regardless of their expected rate
+  const float max_prio = std::numeric_limits<float>::max();
+  for (uint32_t i = 0; i < prio.size(); ++i) {
+    if (rate[i] == 0) {
+      prio[i] = 0;
+    } else if (inv_avg_pow[i] == max_prio or prio[i] > max_prio) {
+      prio[i] = max_prio;
+    }
+  }
+}
+
+sched_time_pf::ue_ctxt* sched_time_pf::ue_candidate_list::pop()
+{
+  if (next_idx == nof_ordered) {
+    // Select and order the next group of highest priority candidates
+    auto cmp       = [this](uint32_t lhs, uint32_t rhs) { return higher_prio(lhs, rhs); };
+    auto sel_begin = order.begin() + nof_ordered;
+    auto sel_end   = order.begin() + std::min(nof_ordered + sel_size, (uint32_t)order.size());
+    std::nth_element(sel_begin, sel_end - 1, order.end(), cmp);
+    std::sort(sel_begin, sel_end, cmp);
+    nof_ordered = sel_end - order.begin();
+  }
+  return ues[order[next_idx++]];
 }
 
-bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+sched_time_pf::ue_ctxt* sched_time_pf::ue_candidate_list::pop_unordered()
 {
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
+  nof_ordered = std::max(nof_ordered, next_idx + 1);
+  return ues[order[next_idx++]];
 }
 
 } // namespace srsenb
@@ -24,6 +24,7 @@
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
 #include <chrono>
+#include <numeric>
 
 namespace srsenb {
 
@@ -394,6 +395,59 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+/// Benchmark of the PDCCH CCE allocation in subframes crowded with UE DCIs. Each TTI, DL and UL DCIs are allocated for
+/// random UEs until the PDCCH is full. The failed allocations trigger the search of other CCE positions and CFIs.
+int run_pdcch_benchmark()
+{
+  const uint32_t nof_ues = 64, nof_ttis = 2000, nof_dcis_per_tti = 64;
+  fmt::print("\n====== PDCCH Allocation Benchmark ======\n\n");
+  fmt::print("{} UEs, {} TTIs, {} DCI allocation attempts per TTI\n", nof_ues, nof_ttis, nof_dcis_per_tti);
+  fmt::print("{:>5}|{:>10}|{:>10}|{:>10}|{:>10}|{:>10}|\n", "Nprb", "DCIs/TTI", "avg [us]", "99th [us]", "99.9th", "max [us]");
+
+  for (uint32_t nof_prb : {25u, 50u, 100u}) {
+    sched_interface::sched_args_t    sched_args = {};
+    std::vector<sched_cell_params_t> cell_params(1);
+    TESTASSERT(cell_params[0].set_cfg(0, generate_default_cell_cfg(nof_prb), sched_args));
+    sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+
+    std::vector<std::unique_ptr<sched_ue> > ues;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+    }
+    sf_cch_allocator pdcch;
+    pdcch.init(cell_params[0]);
+
+    std::uniform_int_distribution<uint32_t> ue_dist{0, nof_ues - 1}, aggr_dist{0, 2};
+    std::vector<uint64_t>                   latency_ns;
+    latency_ns.reserve(nof_ttis);
+    uint64_t  nof_allocs = 0;
+    tti_point tti_rx{0};
+    for (uint32_t count = 0; count < nof_ttis; ++count, ++tti_rx) {
+      auto tp = std::chrono::steady_clock::now();
+      pdcch.new_tti(tti_rx);
+      for (uint32_t n = 0; n < nof_dcis_per_tti; ++n) {
+        sched_ue&    ue         = *ues[ue_dist(get_rand_gen())];
+        alloc_type_t alloc_type = (n % 2 == 0) ? alloc_type_t::DL_DATA : alloc_type_t::UL_DATA;
+        nof_allocs += pdcch.alloc_dci(alloc_type, aggr_dist(get_rand_gen()), &ue, false) ? 1 : 0;
+      }
+      latency_ns.push_back(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp).count());
+    }
+
+    std::sort(latency_ns.begin(), latency_ns.end());
+    double avg_ns = std::accumulate(latency_ns.begin(), latency_ns.end(), 0.0) / latency_ns.size();
+    fmt::print("{:>5}|{:>10.1f}|{:>10.1f}|{:>10.1f}|{:>10.1f}|{:>10.1f}|\n",
+               nof_prb,
+               nof_allocs / (double)nof_ttis,
+               avg_ns / 1000,
+               latency_ns[latency_ns.size() * 99 / 100] / 1000.0,
+               latency_ns[latency_ns.size() * 999 / 1000] / 1000.0,
+               latency_ns.back() / 1000.0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -424,6 +478,8 @@ int main(int argc, char* argv[])
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "pdcch") == 0) {
+    TESTASSERT(srsenb::run_pdcch_benchmark() == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
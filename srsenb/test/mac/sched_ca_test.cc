@@ -84,7 +84,8 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 }
 
 struct test_scell_activation_params {
-  uint32_t pcell_idx = 0;
+  uint32_t pcell_idx      = 0;
+  uint32_t nof_cc_workers = 0;
 };
 
 int test_scell_activation(uint32_t sim_number, test_scell_activation_params params)
@@ -111,8 +112,9 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
   std::iter_swap(cc_idxs.begin(), std::find(cc_idxs.begin(), cc_idxs.end(), params.pcell_idx));
 
   /* Setup simulation arguments struct */
-  sim_sched_args sim_args = generate_default_sim_args(nof_prb, nof_ccs);
-  sim_args.start_tti      = start_tti;
+  sim_sched_args sim_args            = generate_default_sim_args(nof_prb, nof_ccs);
+  sim_args.start_tti                 = start_tti;
+  sim_args.sched_args.nof_cc_workers = params.nof_cc_workers;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(1);
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].active                                = true;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx                            = cc_idxs[0];
@@ -241,6 +243,127 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
   return SRSRAN_SUCCESS;
 }
 
+/// Stores the DL and UL data allocations of all TTIs
+class sched_alloc_recorder : public common_sched_tester
+{
+public:
+  int process_results() override
+  {
+    TESTASSERT(common_sched_tester::process_results() == SRSRAN_SUCCESS);
+    for (uint32_t cc = 0; cc < tti_info.dl_sched_result.size(); ++cc) {
+      for (const auto& data : tti_info.dl_sched_result[cc].data) {
+        allocs.push_back({tti_rx.to_uint(),
+                          cc,
+                          data.dci.rnti,
+                          data.tbs[0],
+                          data.dci.type0_alloc.rbg_bitmask,
+                          data.dci.location.ncce});
+      }
+      for (const auto& pusch : tti_info.ul_sched_result[cc].pusch) {
+        allocs.push_back({tti_rx.to_uint(),
+                          cc,
+                          pusch.dci.rnti,
+                          pusch.tbs,
+                          pusch.dci.type2_alloc.riv,
+                          pusch.needs_pdcch ? pusch.dci.location.ncce : 0});
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  std::vector<std::array<uint32_t, 6>> allocs;
+};
+
+/// Scheduling the carriers in parallel yields the same decisions as the sequential scheduler. With "ca_ues" set, the
+/// connected UEs with an even RNTI are reconfigured with both carriers midway, after which the parallel scheduler falls
+/// back to sequential scheduling
+int test_parallel_vs_sequential(uint32_t sim_number, bool ca_ues)
+{
+  uint32_t nof_prb  = srsran::lte_cell_nof_prbs[std::uniform_int_distribution<uint32_t>{0, 5}(get_rand_gen())];
+  uint32_t nof_ccs  = 2;
+  uint32_t nof_ttis = 500;
+  float    P_ul_sr = randf() * 0.5, P_dl = randf() * 0.5;
+  float    ul_sr_exps[] = {1, 4}, dl_data_exps[] = {1, 4};
+
+  sim_sched_args sim_args                  = generate_default_sim_args(nof_prb, nof_ccs);
+  sim_args.default_ue_sim_cfg.ue_cfg       = generate_default_ue_cfg();
+  sim_args.default_ue_sim_cfg.periodic_cqi = true;
+
+  // UEs attach to both carriers, with a single carrier
+  sched_sim_event_generator    generator;
+  std::map<uint16_t, uint32_t> ue_pcells;
+  auto                         generate_ttis = [&](uint32_t nof_new_ttis) {
+    for (uint32_t i = 0; i < nof_new_ttis; ++i) {
+      for (auto& u : generator.current_users) {
+        if (randf() < P_ul_sr) {
+          float exp = ul_sr_exps[0] + randf() * (ul_sr_exps[1] - ul_sr_exps[0]);
+          generator.add_ul_data(u.first, (uint32_t)pow(10, exp));
+        }
+        if (randf() < P_dl) {
+          float exp = dl_data_exps[0] + randf() * (dl_data_exps[1] - dl_data_exps[0]);
+          generator.add_dl_data(u.first, (uint32_t)pow(10, exp));
+        }
+      }
+      uint32_t pcell_idx = generator.current_users.size() % nof_ccs;
+      if (generator.current_users.size() < 8 and
+          srsran_prach_tti_opportunity_config_fdd(
+              sim_args.cell_cfg[pcell_idx].prach_config, generator.tti_counter, -1)) {
+        ue_ctxt_test_cfg ue_sim_cfg                       = sim_args.default_ue_sim_cfg;
+        ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx = pcell_idx;
+        ue_pcells[generator.add_new_default_user(nof_ttis, ue_sim_cfg)->rnti] = pcell_idx;
+      }
+      generator.step_tti();
+    }
+    // drop the events of the TTI that was not generated yet
+    generator.tti_events.resize(generator.tti_counter);
+  };
+
+  // Run the same events with the carriers scheduled sequentially and in parallel. The random generator is reseeded,
+  // so that both runs draw the same values
+  std::array<std::unique_ptr<sched_alloc_recorder>, 2> testers;
+  auto                                                 run_ttis = [&generator, &testers]() {
+    uint64_t run_seed = get_rand_gen()();
+    for (std::unique_ptr<sched_alloc_recorder>& tester : testers) {
+      set_randseed(run_seed);
+      TESTASSERT(tester->test_next_ttis(generator.tti_events) == SRSRAN_SUCCESS);
+    }
+    return SRSRAN_SUCCESS;
+  };
+  for (uint32_t nof_cc_workers = 0; nof_cc_workers < testers.size(); ++nof_cc_workers) {
+    sim_args.sched_args.nof_cc_workers = nof_cc_workers;
+    testers[nof_cc_workers].reset(new sched_alloc_recorder());
+    testers[nof_cc_workers]->sim_cfg(sim_args);
+  }
+  generate_ttis(nof_ttis / 2);
+  TESTASSERT(run_ttis() == SRSRAN_SUCCESS);
+
+  generator.tti_events.resize(generator.tti_counter + 1);
+  if (ca_ues) {
+    // Add the SCell to the UEs that completed the random access
+    for (const auto& u : ue_pcells) {
+      const ue_sim* ue = testers[0]->sched_sim->find_rnti(u.first);
+      if ((u.first / nof_ccs) % 2 != 0 or ue == nullptr or not ue->get_ctxt().conres_rx) {
+        continue;
+      }
+      tti_ev::user_cfg_ev* user = generator.user_reconf(u.first);
+      user->ue_sim_cfg->ue_cfg.supported_cc_list.resize(nof_ccs);
+      for (uint32_t i = 0; i < nof_ccs; ++i) {
+        user->ue_sim_cfg->ue_cfg.supported_cc_list[i].active     = true;
+        user->ue_sim_cfg->ue_cfg.supported_cc_list[i].enb_cc_idx = (u.second + i) % nof_ccs;
+      }
+    }
+  }
+  generate_ttis(nof_ttis - nof_ttis / 2);
+  TESTASSERT(run_ttis() == SRSRAN_SUCCESS);
+
+  TESTASSERT(not testers[0]->allocs.empty());
+  TESTASSERT(testers[0]->allocs == testers[1]->allocs);
+
+  srslog::flush();
+  printf("[TESTER] Sim%d finished successfully\n\n", sim_number);
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup rand seed
@@ -282,6 +405,18 @@ int main()
     TESTASSERT(test_scell_activation(n * 2 + 1, p) == SRSRAN_SUCCESS);
   }
 
+  // Carriers scheduled in parallel
+  for (uint32_t n = 0; n < N_runs; ++n) {
+    printf("[TESTER] Parallel sim run number: %u\n", n);
+
+    test_scell_activation_params p = {};
+    p.pcell_idx                    = n % 2;
+    p.nof_cc_workers               = 1;
+    TESTASSERT(test_scell_activation(N_runs * 2 + n * 2, p) == SRSRAN_SUCCESS);
+
+    TESTASSERT(test_parallel_vs_sequential(N_runs * 2 + n * 2 + 1, n % 2 == 1) == SRSRAN_SUCCESS);
+  }
+
   srslog::flush();
 
   return 0;
@@ -23,6 +23,8 @@
 #include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsran/common/common_lte.h"
 #include "srsran/common/test_common.h"
+#include <map>
+#include <set>
 
 using namespace srsenb;
 const uint32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -251,6 +253,260 @@ int test_6prbs()
   return SRSRAN_SUCCESS;
 }
 
+namespace {
+
+/// Reference PDCCH allocator that explores the DCI positions of a list of DCI records in the same order as
+/// sf_cch_allocator, without bounding its number of nodes. It only skips the DFS nodes whose free CCEs cannot fit the
+/// remaining DCI records, and the DFS states already known to lead to no solution, memoized with their exact masks
+class exhaustive_cch_allocator
+{
+public:
+  struct dci_record {
+    alloc_type_t alloc_type;
+    uint32_t     aggr_idx;
+    sched_ue*    user;
+    bool         pusch_uci;
+  };
+
+  exhaustive_cch_allocator(const sched_cell_params_t& cell_params_, tti_point tti_rx_) :
+    cc_cfg(cell_params_), tti_rx(tti_rx_)
+  {}
+
+  /// Finds the first solution in DFS order for CFIs from start_cfi to the maximum CFI
+  bool search(const std::vector<dci_record>& records_, uint32_t start_cfi)
+  {
+    records = &records_;
+    remaining_cces.assign(records->size() + 1, 0);
+    for (uint32_t i = records->size(); i > 0; --i) {
+      remaining_cces[i - 1] = remaining_cces[i] + (1U << (*records)[i - 1].aggr_idx);
+    }
+    for (cfix = start_cfi - 1; cfix < cc_cfg.sched_cfg->max_nof_ctrl_symbols; ++cfix) {
+      ncce_list.clear();
+      dead_states.clear();
+      if (dfs(0, {}, 0)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  uint32_t get_cfi() const { return cfix + 1; }
+
+  /// CCE position of each DCI record in the solution found
+  const std::vector<uint32_t>& get_ncce_list() const { return ncce_list; }
+
+private:
+  /// Used CCEs (bits 0 to 127) and HARQ-ACK PUCCH PRBs (bits 128 to 255) of a DFS node
+  using dfs_mask_t = std::array<uint64_t, 4>;
+  const static uint32_t PUCCH_MASK_OFFSET = 128;
+
+  static bool test(const dfs_mask_t& mask, uint32_t pos) { return (mask[pos / 64] >> (pos % 64)) & 1U; }
+  static void set(dfs_mask_t& mask, uint32_t pos) { mask[pos / 64] |= 1ULL << (pos % 64); }
+
+  bool dfs(uint32_t depth, const dfs_mask_t& mask, uint32_t nof_used_cces)
+  {
+    if (depth == records->size()) {
+      return true;
+    }
+    if (cc_cfg.nof_cce_table[cfix] < nof_used_cces + remaining_cces[depth] or
+        dead_states.count(std::make_pair(depth, mask)) > 0) {
+      return false;
+    }
+
+    const dci_record&             record = (*records)[depth];
+    const cce_cfi_position_table* dci_locs =
+        record.user->get_locations(cc_cfg.enb_cc_idx, cfix + 1, to_tx_dl(tti_rx).sf_idx());
+    uint32_t node_cces = 1U << record.aggr_idx;
+    for (uint32_t ncce : (*dci_locs)[record.aggr_idx]) {
+      dfs_mask_t child_mask = mask;
+      if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
+        srsran_pucch_cfg_t pucch_cfg = cc_cfg.pucch_cfg_common;
+        pucch_cfg.n_pucch            = ncce + pucch_cfg.N_pucch_1;
+        if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg.n_pucch)) {
+          continue;
+        }
+        int pucch_n_prb = srsran_pucch_n_prb(&cc_cfg.cfg.cell, &pucch_cfg, 0);
+        if (not is_harq_pucch_prb_valid(pucch_n_prb) or
+            (not cc_cfg.sched_cfg->pucch_mux_enabled and test(mask, PUCCH_MASK_OFFSET + pucch_n_prb))) {
+          continue;
+        }
+        set(child_mask, PUCCH_MASK_OFFSET + pucch_n_prb);
+      }
+      bool collision = false;
+      for (uint32_t i = ncce; i < ncce + node_cces; ++i) {
+        collision |= test(mask, i);
+        set(child_mask, i);
+      }
+      if (collision) {
+        continue;
+      }
+
+      ncce_list.push_back(ncce);
+      if (dfs(depth + 1, child_mask, nof_used_cces + node_cces)) {
+        return true;
+      }
+      ncce_list.pop_back();
+    }
+
+    dead_states.emplace(depth, mask);
+    return false;
+  }
+
+  bool is_harq_pucch_prb_valid(int pucch_n_prb) const
+  {
+    if (pucch_n_prb < 0 or pucch_n_prb >= (int)cc_cfg.nof_prb()) {
+      return false;
+    }
+    int low_rb = pucch_n_prb < (int)cc_cfg.nof_prb() / 2 ? pucch_n_prb : cc_cfg.nof_prb() - pucch_n_prb - 1;
+    return cc_cfg.sched_cfg->pucch_harq_max_rb <= 0 or low_rb < cc_cfg.sched_cfg->pucch_harq_max_rb;
+  }
+
+  const sched_cell_params_t&                cc_cfg;
+  tti_point                                 tti_rx;
+  const std::vector<dci_record>*            records = nullptr;
+  uint32_t                                  cfix    = 0;
+  std::vector<uint32_t>                     ncce_list;
+  std::vector<uint32_t>                     remaining_cces;
+  std::set<std::pair<uint32_t, dfs_mask_t>> dead_states;
+};
+
+} // namespace
+
+/// The pruned and memoized DFS of sf_cch_allocator must find the same DCI positions and CFI as an exhaustive DFS,
+/// except when it reaches MAX_DFS_NODES nodes, in which case the allocation may fail
+int test_pdcch_exhaustive_search_equivalence()
+{
+  using rand_uint = std::uniform_int_distribution<uint32_t>;
+  auto& test_log  = srslog::fetch_basic_logger("TEST");
+
+  // The exhaustive search time grows quickly with the number of DCIs, keep it below the 16 DCIs of alloc_result_t
+  const uint32_t nof_runs = 20, nof_ttis = 10, nof_ues = 16, max_nof_dcis = 12, max_nof_tti_failures = 3;
+  uint32_t       nof_allocs = 0, nof_failures = 0, nof_bounded_failures = 0;
+  for (uint32_t run = 0; run < nof_runs; ++run) {
+    uint32_t                         nof_prb = srsran::lte_cell_nof_prbs[rand_uint{0, 5}(get_rand_gen())];
+    std::vector<sched_cell_params_t> cell_params(1);
+    sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+    sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+    sched_interface::sched_args_t    sched_args{};
+    sched_args.pucch_mux_enabled = rand_uint{0, 1}(get_rand_gen()) == 0;
+    sched_args.pucch_harq_max_rb = rand_uint{0, 1}(get_rand_gen()) == 0 ? 0 : rand_uint{1, 4}(get_rand_gen());
+    TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+    std::vector<std::unique_ptr<sched_ue>> ues;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      ues.emplace_back(new sched_ue{(uint16_t)(0x46 + rand_uint{0, 1000}(get_rand_gen())), cell_params, ue_cfg});
+    }
+
+    sf_cch_allocator pdcch;
+    pdcch.init(cell_params[0]);
+    tti_point start_tti{rand_uint{0, 10239}(get_rand_gen())};
+    for (uint32_t tti_counter = 0; tti_counter < nof_ttis; ++tti_counter) {
+      tti_point tti_rx = start_tti + tti_counter;
+      pdcch.new_tti(tti_rx);
+      exhaustive_cch_allocator                          ref_pdcch(cell_params[0], tti_rx);
+      std::vector<exhaustive_cch_allocator::dci_record> records;
+
+      // Crowd the PDCCH with DCIs of random UEs and aggregation levels, until no more DCI records fit
+      uint32_t max_allocs = rand_uint{1, max_nof_dcis}(get_rand_gen()), nof_tti_failures = 0;
+      while (records.size() < max_allocs and nof_tti_failures < max_nof_tti_failures) {
+        exhaustive_cch_allocator::dci_record record;
+        record.alloc_type = rand_uint{0, 1}(get_rand_gen()) == 0 ? alloc_type_t::DL_DATA : alloc_type_t::UL_DATA;
+        record.aggr_idx   = rand_uint{0, 3}(get_rand_gen());
+        record.user       = ues[rand_uint{0, nof_ues - 1}(get_rand_gen())].get();
+        record.pusch_uci  = rand_uint{0, 3}(get_rand_gen()) == 0;
+
+        uint32_t cfi = pdcch.get_cfi();
+        records.push_back(record);
+        bool ref_success = ref_pdcch.search(records, cfi);
+        bool success     = pdcch.alloc_dci(record.alloc_type, record.aggr_idx, record.user, record.pusch_uci);
+        nof_allocs++;
+        if (not success) {
+          records.pop_back();
+          TESTASSERT(pdcch.get_cfi() == cfi);
+          if (ref_success) {
+            // Only the bound on the number of DFS nodes makes the allocation fail while a solution exists
+            TESTASSERT(pdcch.get_nof_dfs_nodes() >= sf_cch_allocator::MAX_DFS_NODES);
+            nof_bounded_failures++;
+          }
+          nof_failures++;
+          nof_tti_failures++;
+          continue;
+        }
+
+        // The solution found is the first one in DFS order
+        TESTASSERT(ref_success);
+        TESTASSERT(pdcch.get_cfi() == ref_pdcch.get_cfi());
+        sf_cch_allocator::alloc_result_t dci_result;
+        pdcch.get_allocs(&dci_result);
+        TESTASSERT(dci_result.size() == records.size());
+        for (uint32_t j = 0; j < dci_result.size(); ++j) {
+          TESTASSERT(dci_result[j]->dci_pos.ncce == ref_pdcch.get_ncce_list()[j]);
+        }
+      }
+    }
+  }
+  test_log.info("PDCCH search equivalence: %d DCIs, %d failed allocations, %d due to the DFS node bound",
+                nof_allocs,
+                nof_failures,
+                nof_bounded_failures);
+  TESTASSERT(nof_failures > 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Crowded subframe where the DFS of sf_cch_allocator reaches MAX_DFS_NODES nodes before finding the solution that
+/// exists with CFI=3, so the last DCI allocation fails
+int test_pdcch_dfs_node_bound()
+{
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(75);
+  sched_interface::sched_args_t    sched_args{};
+  sched_args.pucch_mux_enabled = true;
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::map<uint16_t, std::unique_ptr<sched_ue>> ues;
+  for (uint16_t rnti : {0x3e8, 0x3cf, 0x17e, 0x120, 0x383, 0x303, 0x323}) {
+    ues[rnti].reset(new sched_ue{rnti, cell_params, ue_cfg});
+  }
+  const std::vector<std::tuple<alloc_type_t, uint32_t, uint16_t, bool>> dcis = {
+      {alloc_type_t::DL_DATA, 1, 0x3e8, false},
+      {alloc_type_t::UL_DATA, 0, 0x3cf, false},
+      {alloc_type_t::UL_DATA, 3, 0x17e, false},
+      {alloc_type_t::UL_DATA, 0, 0x3e8, false},
+      {alloc_type_t::DL_DATA, 3, 0x120, true},
+      {alloc_type_t::UL_DATA, 1, 0x383, false},
+      {alloc_type_t::UL_DATA, 2, 0x303, false},
+      {alloc_type_t::UL_DATA, 3, 0x323, false}};
+
+  tti_point        tti_rx{2204};
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[0]);
+  pdcch.new_tti(tti_rx);
+  exhaustive_cch_allocator                          ref_pdcch(cell_params[0], tti_rx);
+  std::vector<exhaustive_cch_allocator::dci_record> records;
+  for (const auto& dci : dcis) {
+    records.push_back({std::get<0>(dci), std::get<1>(dci), ues[std::get<2>(dci)].get(), std::get<3>(dci)});
+  }
+
+  for (uint32_t i = 0; i + 1 < records.size(); ++i) {
+    TESTASSERT(pdcch.alloc_dci(records[i].alloc_type, records[i].aggr_idx, records[i].user, records[i].pusch_uci));
+  }
+  TESTASSERT(pdcch.get_cfi() == 2);
+
+  // TEST: The DFS node bound makes the allocation fail, and the previous allocations are kept
+  const exhaustive_cch_allocator::dci_record& last = records.back();
+  TESTASSERT(not pdcch.alloc_dci(last.alloc_type, last.aggr_idx, last.user, last.pusch_uci));
+  TESTASSERT(pdcch.get_nof_dfs_nodes() >= sf_cch_allocator::MAX_DFS_NODES);
+  TESTASSERT(pdcch.nof_allocs() == records.size() - 1 and pdcch.get_cfi() == 2);
+
+  // TEST: Without the bound, all the DCIs fit with CFI=3
+  TESTASSERT(ref_pdcch.search(records, 2));
+  TESTASSERT(ref_pdcch.get_cfi() == 3);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -265,6 +521,8 @@ int main()
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_exhaustive_search_equivalence() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_dfs_node_bound() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
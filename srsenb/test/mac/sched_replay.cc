@@ -0,0 +1,258 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Replays a scheduler trace, recorded with the scheduler.trace_filename option, at full speed. The scheduling latency
+/// of each TTI and the outcome of the allocations are reported, so that scheduler changes can be benchmarked and
+/// compared against the same real traffic. The HARQ feedback and channel reports are replayed as recorded, so the
+/// allocations of a different scheduler policy will eventually diverge from the feedback (e.g. ACKs for TTIs without
+/// allocation). The respective scheduler warnings are suppressed.
+
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <getopt.h>
+#include <numeric>
+
+using namespace srsenb;
+using bench_clock = std::chrono::steady_clock;
+
+namespace {
+
+struct replay_args_t {
+  std::string trace_filename;
+  std::string sched_policy;
+  std::string sched_policy_args;
+  int         nof_cc_workers = -1;
+  uint32_t    nof_runs       = 1;
+} args;
+
+struct replay_result_t {
+  std::vector<uint64_t> tti_latency_ns;
+  uint64_t              nof_events  = 0;
+  uint64_t              nof_errors  = 0;
+  uint64_t              dl_grants   = 0;
+  uint64_t              dl_bytes    = 0;
+  uint64_t              dl_retx     = 0;
+  uint64_t              ul_grants   = 0;
+  uint64_t              ul_bytes    = 0;
+  uint64_t              ul_retx     = 0;
+  uint64_t              nof_rar     = 0;
+  uint64_t              nof_bc      = 0;
+  uint64_t              nof_po      = 0;
+  uint64_t              dl_sf_count = 0;
+  uint64_t              cfi_sum     = 0;
+};
+
+void save_outcome(const sched_interface::dl_sched_res_t& dl_res, replay_result_t& res)
+{
+  for (const auto& data : dl_res.data) {
+    res.dl_grants++;
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; ++tb) {
+      res.dl_bytes += data.tbs[tb];
+    }
+    res.dl_retx += data.dci.tb[0].rv != 0 ? 1 : 0;
+  }
+  res.nof_rar += dl_res.rar.size();
+  res.nof_bc += dl_res.bc.size();
+  res.nof_po += dl_res.po.size();
+  res.cfi_sum += dl_res.cfi;
+  res.dl_sf_count++;
+}
+
+void save_outcome(const sched_interface::ul_sched_res_t& ul_res, replay_result_t& res)
+{
+  for (const auto& pusch : ul_res.pusch) {
+    res.ul_grants++;
+    res.ul_bytes += pusch.tbs;
+    res.ul_retx += pusch.current_tx_nb > 0 ? 1 : 0;
+  }
+}
+
+int run_replay(sched_trace_reader& reader, replay_result_t& res)
+{
+  reader.rewind();
+  sched_trace_record record;
+  if (not reader.read(record) or record.type != sched_trace_event::sched_args) {
+    fprintf(stderr, "The trace does not start with the scheduler arguments\n");
+    return SRSRAN_ERROR;
+  }
+  sched_interface::sched_args_t sched_args = record.sched_args;
+  if (not args.sched_policy.empty()) {
+    sched_args.sched_policy = args.sched_policy;
+  }
+  if (not args.sched_policy_args.empty()) {
+    sched_args.sched_policy_args = args.sched_policy_args;
+  }
+  if (args.nof_cc_workers >= 0) {
+    sched_args.nof_cc_workers = args.nof_cc_workers;
+  }
+
+  // The paging messages are recorded after the TTI that allocated them
+  sched_trace_rrc_stub rrc;
+  while (reader.read(record)) {
+    if (record.type == sched_trace_event::paging) {
+      rrc.add_paging(record.tti, record.value[0]);
+    }
+  }
+  reader.rewind();
+  reader.read(record);
+
+  sched sched_obj;
+  sched_obj.init(&rrc, sched_args);
+
+  sched_interface::dl_sched_res_t dl_res;
+  sched_interface::ul_sched_res_t ul_res;
+  srsran::tti_point               current_tti;
+  uint64_t                        tti_ns = 0;
+  while (reader.read(record)) {
+    res.nof_events++;
+    bool is_sched = record.type == sched_trace_event::dl_sched or record.type == sched_trace_event::ul_sched;
+    if (not is_sched) {
+      res.nof_errors += sched_trace_replay_event(sched_obj, record, dl_res, ul_res) < 0 ? 1 : 0;
+      continue;
+    }
+
+    // All the dl_sched/ul_sched calls of the same TTI are accounted together
+    srsran::tti_point tti_rx = srsran::tti_point{record.tti} - TX_ENB_DELAY;
+    if (record.type == sched_trace_event::ul_sched) {
+      tti_rx -= FDD_HARQ_DELAY_DL_MS;
+    }
+    if (tti_rx != current_tti and current_tti.is_valid()) {
+      res.tti_latency_ns.push_back(tti_ns);
+      tti_ns = 0;
+    }
+    current_tti = tti_rx;
+
+    auto tp = bench_clock::now();
+    int  ret = sched_trace_replay_event(sched_obj, record, dl_res, ul_res);
+    tti_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - tp).count();
+
+    res.nof_errors += ret < 0 ? 1 : 0;
+    if (record.type == sched_trace_event::dl_sched) {
+      save_outcome(dl_res, res);
+    } else {
+      save_outcome(ul_res, res);
+    }
+  }
+  if (current_tti.is_valid()) {
+    res.tti_latency_ns.push_back(tti_ns);
+  }
+  if (reader.is_corrupted()) {
+    fprintf(stderr, "The trace is corrupted after %" PRIu64 " events\n", res.nof_events);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void print_result(replay_result_t& res)
+{
+  std::vector<uint64_t>& v = res.tti_latency_ns;
+  fmt::print("events={}, api_errors={}, ttis={}\n", res.nof_events, res.nof_errors, v.size());
+  if (v.empty()) {
+    return;
+  }
+  std::sort(v.begin(), v.end());
+  double avg_ns = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+  fmt::print("  {:<16}|{:>8}|{:>8}|{:>8}|{:>8}|{:>10}|\n", "TTI latency [us]", "avg", "50th", "99th", "99.9th", "worst");
+  fmt::print("  {:<16}|{:8.1f}|{:8.1f}|{:8.1f}|{:8.1f}|{:10.1f}|\n",
+             "",
+             avg_ns / 1000,
+             v[v.size() / 2] / 1000.0,
+             v[v.size() * 99 / 100] / 1000.0,
+             v[v.size() * 999 / 1000] / 1000.0,
+             v.back() / 1000.0);
+  fmt::print("  DL: grants={}, retx={}, bytes={}, rar={}, bc={}, po={}, avg_cfi={:.2f}\n",
+             res.dl_grants,
+             res.dl_retx,
+             res.dl_bytes,
+             res.nof_rar,
+             res.nof_bc,
+             res.nof_po,
+             res.dl_sf_count > 0 ? res.cfi_sum / (double)res.dl_sf_count : 0.0);
+  fmt::print("  UL: grants={}, retx={}, bytes={}\n", res.ul_grants, res.ul_retx, res.ul_bytes);
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pawn] trace_file\n", prog);
+  printf("\t-p scheduler policy [Default: recorded]\n");
+  printf("\t-a scheduler policy arguments [Default: recorded]\n");
+  printf("\t-w number of carrier scheduling workers [Default: recorded]\n");
+  printf("\t-n number of replays [Default %d]\n", args.nof_runs);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "p:a:w:n:h")) != -1) {
+    switch (opt) {
+      case 'p':
+        args.sched_policy = optarg;
+        break;
+      case 'a':
+        args.sched_policy_args = optarg;
+        break;
+      case 'w':
+        args.nof_cc_workers = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        args.nof_runs = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (optind >= argc) {
+    usage(argv[0]);
+    exit(-1);
+  }
+  args.trace_filename = argv[optind];
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("MAC").set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  sched_trace_reader reader;
+  if (not reader.open(args.trace_filename)) {
+    fprintf(stderr, "Failed to open scheduler trace %s\n", args.trace_filename.c_str());
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t run = 0; run < args.nof_runs; ++run) {
+    replay_result_t res;
+    if (run_replay(reader, res) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    fmt::print("Run {}: ", run);
+    print_result(res);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsran/common/test_common.h"
+#include <cstdio>
+#include <map>
+
+namespace srsenb {
+
+const char* trace_test_filename = "sched_trace_test.trace";
+
+/// Scheduler decisions compared between the original run and the replay
+struct sched_decision_t {
+  uint32_t tti;
+  bool     is_dl;
+  uint16_t rnti;
+  uint32_t tbs;
+  uint32_t ncce;
+  bool     operator==(const sched_decision_t& other) const
+  {
+    return tti == other.tti and is_dl == other.is_dl and rnti == other.rnti and tbs == other.tbs and
+           ncce == other.ncce;
+  }
+};
+
+void save_decisions(uint32_t                              tti,
+                    const sched_interface::dl_sched_res_t& dl_res,
+                    std::vector<sched_decision_t>&         decisions)
+{
+  for (const auto& data : dl_res.data) {
+    decisions.push_back({tti, true, data.dci.rnti, data.tbs[0], data.dci.location.ncce});
+  }
+  for (const auto& bc : dl_res.bc) {
+    decisions.push_back({tti, true, bc.dci.rnti, bc.tbs, bc.dci.location.ncce});
+  }
+  for (const auto& rar : dl_res.rar) {
+    decisions.push_back({tti, true, rar.dci.rnti, rar.tbs, rar.dci.location.ncce});
+  }
+}
+
+void save_decisions(uint32_t                              tti,
+                    const sched_interface::ul_sched_res_t& ul_res,
+                    std::vector<sched_decision_t>&         decisions)
+{
+  for (const auto& pusch : ul_res.pusch) {
+    decisions.push_back({tti, false, pusch.dci.rnti, pusch.tbs, pusch.dci.location.ncce});
+  }
+}
+
+/// Every event type survives a write/read round trip
+void test_trace_encoding()
+{
+  std::vector<sched_trace_record> records;
+  for (uint32_t i = 0; i < (uint32_t)sched_trace_event::nof_events; ++i) {
+    sched_trace_record r;
+    r.type       = (sched_trace_event)i;
+    r.tti        = 100 + i;
+    r.rnti       = 0x46 + i;
+    r.enb_cc_idx = i % 2;
+    r.value[0]   = 1;
+    r.value[1]   = 2 * i;
+    r.value[2]   = 3 * i;
+    r.snr        = 10.5;
+
+    r.sched_args.sched_policy   = "time_rr";
+    r.sched_args.pdsch_max_mcs  = 20;
+    r.sched_args.nof_cc_workers = 2;
+    r.cell_cfg.push_back(generate_default_cell_cfg(50));
+    r.cell_cfg.push_back(generate_default_cell_cfg(25));
+    r.cell_cfg[1].scell_list.resize(1);
+    r.cell_cfg[1].scell_list[0].enb_cc_idx = 0;
+    r.ue_cfg                                = generate_default_ue_cfg();
+    r.ue_cfg.supported_cc_list.resize(2);
+    r.ue_cfg.supported_cc_list[1].enb_cc_idx = 1;
+    r.bearer_cfg.direction                   = mac_lc_ch_cfg_t::BOTH;
+    r.bearer_cfg.group                       = 2;
+    r.rar_info.temp_crnti                    = 0x50;
+    r.rar_info.msg3_size                     = 7;
+    r.po_info.crnti                          = 0x51;
+    r.tti_mask                               = {1, 0, 1, 1};
+    records.push_back(r);
+  }
+
+  {
+    sched_trace_writer writer(trace_test_filename);
+    TESTASSERT(writer.is_open());
+    for (const auto& r : records) {
+      writer.write(r);
+    }
+  }
+
+  sched_trace_reader reader;
+  TESTASSERT(reader.open(trace_test_filename));
+  sched_trace_record r;
+  for (const sched_trace_record& expected : records) {
+    TESTASSERT(reader.read(r));
+    TESTASSERT(r.type == expected.type);
+    switch (r.type) {
+      case sched_trace_event::sched_args:
+        TESTASSERT(r.sched_args.sched_policy == "time_rr");
+        TESTASSERT(r.sched_args.pdsch_max_mcs == 20 and r.sched_args.nof_cc_workers == 2);
+        break;
+      case sched_trace_event::cell_cfg:
+        TESTASSERT(r.cell_cfg.size() == 2);
+        TESTASSERT(r.cell_cfg[0].cell.nof_prb == 50 and r.cell_cfg[1].cell.nof_prb == 25);
+        TESTASSERT(r.cell_cfg[0].sibs[1].len == expected.cell_cfg[0].sibs[1].len);
+        TESTASSERT(r.cell_cfg[1].scell_list.size() == 1);
+        break;
+      case sched_trace_event::ue_cfg:
+        TESTASSERT(r.rnti == expected.rnti);
+        TESTASSERT(r.ue_cfg.supported_cc_list.size() == 2);
+        TESTASSERT(r.ue_cfg.supported_cc_list[1].enb_cc_idx == 1);
+        TESTASSERT(r.ue_cfg.ue_bearers == expected.ue_cfg.ue_bearers);
+        TESTASSERT(r.ue_cfg.pucch_cfg.I_sr == expected.ue_cfg.pucch_cfg.I_sr);
+        break;
+      case sched_trace_event::bearer_ue_cfg:
+        TESTASSERT(r.rnti == expected.rnti and r.value[0] == expected.value[0]);
+        TESTASSERT(r.bearer_cfg == expected.bearer_cfg);
+        break;
+      case sched_trace_event::dl_rlc_buffer_state:
+        TESTASSERT(r.rnti == expected.rnti);
+        TESTASSERT(std::equal(r.value, r.value + 3, expected.value));
+        break;
+      case sched_trace_event::dl_sb_cqi_info:
+        TESTASSERT(r.tti == expected.tti and r.rnti == expected.rnti and r.enb_cc_idx == expected.enb_cc_idx);
+        TESTASSERT(r.value[0] == expected.value[0] and r.value[1] == expected.value[1]);
+        break;
+      case sched_trace_event::ul_snr_info:
+        TESTASSERT(r.tti == expected.tti and r.rnti == expected.rnti and r.enb_cc_idx == expected.enb_cc_idx);
+        TESTASSERT(r.value[0] == expected.value[0] and r.snr == expected.snr);
+        break;
+      case sched_trace_event::dl_rach_info:
+        TESTASSERT(r.enb_cc_idx == expected.enb_cc_idx);
+        TESTASSERT(r.rar_info.temp_crnti == 0x50 and r.rar_info.msg3_size == 7);
+        break;
+      case sched_trace_event::set_pdcch_order:
+        TESTASSERT(r.po_info.crnti == 0x51);
+        break;
+      case sched_trace_event::set_dl_tti_mask:
+        TESTASSERT(r.tti_mask == expected.tti_mask);
+        break;
+      case sched_trace_event::dl_sched:
+      case sched_trace_event::ul_sched:
+        TESTASSERT(r.tti == expected.tti and r.enb_cc_idx == expected.enb_cc_idx);
+        break;
+      default:
+        break;
+    }
+  }
+  TESTASSERT(not reader.read(r));
+  TESTASSERT(not reader.is_corrupted());
+
+  // A truncated trace is detected
+  FILE* fp = fopen(trace_test_filename, "ab");
+  TESTASSERT(fp != nullptr);
+  uint8_t partial_record[] = {(uint8_t)sched_trace_event::dl_cqi_info, 16, 0, 0, 0, 1, 2};
+  fwrite(partial_record, 1, sizeof(partial_record), fp);
+  fclose(fp);
+  TESTASSERT(reader.open(trace_test_filename));
+  while (reader.read(r)) {
+  }
+  TESTASSERT(reader.is_corrupted());
+
+  remove(trace_test_filename);
+}
+
+/// Replaying a recorded trace reproduces the decisions of the original run
+void test_trace_replay()
+{
+  const uint32_t                nof_ttis = 500;
+  const std::vector<uint16_t>   rntis    = {0x46, 0x47, 0x48};
+  std::vector<sched_decision_t> recorded, replayed;
+
+  // Run the scheduler with the trace enabled
+  {
+    rrc_dummy                     rrc;
+    sched                         sched_obj;
+    sched_interface::sched_args_t sched_args;
+    sched_args.trace_filename = trace_test_filename;
+    sched_obj.init(&rrc, sched_args);
+    TESTASSERT(sched_obj.cell_cfg({generate_default_cell_cfg(25)}) == SRSRAN_SUCCESS);
+    for (uint16_t rnti : rntis) {
+      TESTASSERT(sched_obj.ue_cfg(rnti, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+      sched_obj.phy_config_enabled(rnti, true);
+    }
+
+    std::multimap<uint32_t, uint16_t> pending_acks, pending_crcs;
+    for (uint32_t t = 0; t < nof_ttis; ++t) {
+      tti_point tti_rx{t};
+
+      // Feedback of previous allocations
+      for (auto it = pending_acks.lower_bound(t); it != pending_acks.upper_bound(t); ++it) {
+        bool ack = (t + it->second) % 7 != 0;
+        sched_obj.dl_ack_info(t, it->second, 0, 0, ack);
+      }
+      for (auto it = pending_crcs.lower_bound(t); it != pending_crcs.upper_bound(t); ++it) {
+        bool crc = (t + it->second) % 5 != 0;
+        sched_obj.ul_crc_info(t, it->second, 0, crc);
+      }
+      for (uint32_t i = 0; i < rntis.size(); ++i) {
+        uint16_t rnti = rntis[i];
+        if (t % 20 == i) {
+          sched_obj.dl_rlc_buffer_state(rnti, drb_to_lcid(lte_drb::drb1), 2000 * (i + 1), 0);
+          sched_obj.ul_bsr(rnti, 1, 1000 * (i + 1));
+        }
+        if (t % 10 == i) {
+          sched_obj.dl_cqi_info(t, rnti, 0, 7 + 3 * i);
+          sched_obj.ul_snr_info(t, rnti, 0, 5 + 5 * i, 0);
+        }
+      }
+
+      sched_interface::dl_sched_res_t dl_res;
+      sched_interface::ul_sched_res_t ul_res;
+      TESTASSERT(sched_obj.dl_sched(to_tx_dl(tti_rx).to_uint(), 0, dl_res) == SRSRAN_SUCCESS);
+      TESTASSERT(sched_obj.ul_sched(to_tx_ul(tti_rx).to_uint(), 0, ul_res) == SRSRAN_SUCCESS);
+      save_decisions(t, dl_res, recorded);
+      save_decisions(t, ul_res, recorded);
+      for (const auto& data : dl_res.data) {
+        pending_acks.emplace(to_tx_dl_ack(tti_rx).to_uint(), data.dci.rnti);
+      }
+      for (const auto& pusch : ul_res.pusch) {
+        pending_crcs.emplace(to_tx_ul(tti_rx).to_uint(), pusch.dci.rnti);
+      }
+    }
+  }
+  uint32_t nof_data = std::count_if(
+      recorded.begin(), recorded.end(), [](const sched_decision_t& d) { return d.rnti >= 0x46 and d.rnti <= 0x48; });
+  TESTASSERT(nof_data > nof_ttis / 2);
+
+  // Replay the trace in a new scheduler
+  sched_trace_reader reader;
+  TESTASSERT(reader.open(trace_test_filename));
+  sched_trace_record   r;
+  sched_trace_rrc_stub rrc;
+  TESTASSERT(reader.read(r) and r.type == sched_trace_event::sched_args);
+  while (reader.read(r)) {
+    if (r.type == sched_trace_event::paging) {
+      rrc.add_paging(r.tti, r.value[0]);
+    }
+  }
+  TESTASSERT(not reader.is_corrupted());
+  reader.rewind();
+  TESTASSERT(reader.read(r));
+  sched_interface::sched_args_t sched_args = r.sched_args;
+  sched                         sched_obj;
+  sched_obj.init(&rrc, sched_args);
+  while (reader.read(r)) {
+    sched_interface::dl_sched_res_t dl_res;
+    sched_interface::ul_sched_res_t ul_res;
+    sched_trace_replay_event(sched_obj, r, dl_res, ul_res);
+    if (r.type == sched_trace_event::dl_sched) {
+      save_decisions((tti_point{r.tti} - TX_ENB_DELAY).to_uint(), dl_res, replayed);
+    } else if (r.type == sched_trace_event::ul_sched) {
+      save_decisions((tti_point{r.tti} - TX_ENB_DELAY - FDD_HARQ_DELAY_DL_MS).to_uint(), ul_res, replayed);
+    }
+  }
+  TESTASSERT(not reader.is_corrupted());
+  TESTASSERT(replayed.size() == recorded.size());
+  TESTASSERT(std::equal(recorded.begin(), recorded.end(), replayed.begin()));
+
+  remove(trace_test_filename);
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  srsenb::test_trace_encoding();
+  srsenb::test_trace_replay();
+
+  return SRSRAN_SUCCESS;
+}
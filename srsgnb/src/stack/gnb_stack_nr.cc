@@ -89,6 +89,9 @@ int gnb_stack_nr::init(const gnb_stack_args_t& args_,
   gtpu_logger.set_hex_dump_max_size(args.log.gtpu_hex_limit);
   srslog::fetch_basic_logger("COMN", false).set_hex_dump_max_size(args.log.stack_hex_limit);
 
+  // Measure the queueing latency of stack tasks if it is going to be logged
+  task_sched.enable_task_latency_histogram(stack_logger.info.enabled());
+
   if (x2_ == nullptr) {
     // SA mode
     ngap.reset(new srsenb::ngap(&task_sched, ngap_logger, &srsran::get_rx_io_manager()));
@@ -152,6 +155,7 @@ void gnb_stack_nr::stop_impl()
   pdcp.stop();
   mac.stop();
 
+  task_sched.print_task_latency(stack_logger);
   task_sched.stop();
   srsran::get_background_workers().stop();
 
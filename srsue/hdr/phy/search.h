@@ -22,9 +22,16 @@
 #ifndef SRSUE_SEARCH_H
 #define SRSUE_SEARCH_H
 
+#include "srsran/common/thread_pool.h"
 #include "srsran/radio/radio.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace srsue {
 
@@ -45,14 +52,44 @@ public:
 
   explicit search(srslog::basic_logger& logger) : logger(logger) {}
   ~search();
-  void     init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search_callback* parent, int force_N_id_2_, int force_N_id_1_);
+  void     init(srsran::rf_buffer_t& buffer_,
+                uint32_t             nof_rx_channels,
+                search_callback*     parent,
+                int                  force_N_id_2_,
+                int                  force_N_id_1_,
+                uint32_t             nof_threads_      = 0,
+                uint32_t             cache_timeout_ms_ = 0);
   void     reset();
   float    get_last_cfo();
   void     set_agc_enable(bool enable);
-  ret_code run(srsran_cell_t* cell, std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload);
+  ret_code run(uint32_t earfcn, srsran_cell_t* cell, std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload);
   void     set_cp_en(bool enable);
 
+  /**
+   * Detects the cells of every EARFCN in the list and caches them for the following calls to run(). The caller thread
+   * tunes the radio with the given function and receives the samples of each EARFCN, while the search threads detect
+   * the cells of the previously received ones.
+   */
+  void prescan(const std::vector<uint32_t>& earfcn_list, const std::function<bool(uint32_t)>& tune);
+
 private:
+  struct cache_entry_t {
+    std::array<srsran_ue_cellsearch_result_t, SRSRAN_NOF_NID_2> found_cells = {};
+    int                                                         nof_cells   = 0;
+    uint32_t                                                    max_N_id_2  = 0;
+    std::chrono::steady_clock::time_point                       timestamp;
+  };
+
+  // Each search thread owns a detector and the buffer it works on, which is free again once the detection finishes
+  struct detector_slot_t {
+    srsran_ue_cellsearch_detector_t detector = {};
+    cf_t*                           buffer   = nullptr;
+    bool                            busy     = false;
+  };
+
+  bool get_cached(uint32_t earfcn, cache_entry_t& entry);
+  void set_cached(uint32_t earfcn, const srsran_ue_cellsearch_result_t* found_cells, int nof_cells, uint32_t max_N_id_2);
+
   search_callback*       p = nullptr;
   srslog::basic_logger&  logger;
   srsran::rf_buffer_t    buffer       = {};
@@ -60,6 +97,15 @@ private:
   srsran_ue_mib_sync_t   ue_mib_sync  = {};
   int                    force_N_id_2 = 0;
   int                    force_N_id_1 = 0;
+
+  uint32_t                                       nof_channels = 0;
+  std::chrono::milliseconds                      cache_timeout{0};
+  std::map<uint32_t, cache_entry_t>              cache;
+  std::vector<std::unique_ptr<detector_slot_t> > slots;
+  cf_t*                                          scratch_buffer = nullptr;
+  std::unique_ptr<srsran::task_thread_pool>      thread_pool;
+  std::mutex                                     mutex;
+  std::condition_variable                        cvar;
 };
 
 }; // namespace srsue
@@ -366,6 +366,7 @@ private:
   float    ul_dl_factor            = NAN;
   int      current_earfcn          = 0;
   uint32_t cellsearch_earfcn_index = 0;
+  bool     search_prescan          = false; ///< Detect the cells of the whole EARFCN list in the next cell search
 
   float dl_freq = -1;
   float ul_freq = -1;
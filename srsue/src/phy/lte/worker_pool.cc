@@ -19,6 +19,7 @@
  *
  */
 #include "srsue/hdr/phy/lte/worker_pool.h"
+#include <thread>
 
 namespace srsue {
 namespace lte {
@@ -54,15 +55,35 @@ worker_pool::worker_pool(uint32_t max_workers) :
 
 bool worker_pool::init(phy_common* common, int prio)
 {
-  // Add workers to workers pool and start threads
-  for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
+  uint32_t                           nof_workers = common->args->nof_phy_threads;
+  std::vector<srslog::basic_logger*> loggers;
+  for (uint32_t i = 0; i < nof_workers; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
+    loggers.push_back(&log);
+  }
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
-    pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
-    workers.push_back(std::move(w));
+  // Allocating the buffers and planning the DFTs of every worker takes most of the startup time, create them in
+  // parallel. The first one is created alone, since it generates the tables shared by all the workers
+  workers.resize(nof_workers);
+  auto create_worker = [this, common, &loggers](uint32_t i) {
+    workers[i] = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, *loggers[i]));
+  };
+  if (nof_workers > 0) {
+    create_worker(0);
+  }
+  std::vector<std::thread> create_threads;
+  for (uint32_t i = 1; i < nof_workers; i++) {
+    create_threads.emplace_back(create_worker, i);
+  }
+  for (std::thread& t : create_threads) {
+    t.join();
+  }
+
+  // Add workers to workers pool and start threads
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    pool.init_worker(i, workers[i].get(), prio, common->args->worker_cpu_mask);
   }
 
   return true;
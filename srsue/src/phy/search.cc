@@ -51,21 +51,65 @@ static SRSRAN_AGC_CALLBACK(callback_set_rx_gain)
 
 search::~search()
 {
+  // Stop the search threads before releasing their detectors
+  if (thread_pool) {
+    thread_pool->stop();
+  }
+  for (std::unique_ptr<detector_slot_t>& slot : slots) {
+    srsran_ue_cellsearch_detector_free(&slot->detector);
+    if (slot->buffer) {
+      free(slot->buffer);
+    }
+  }
+  if (scratch_buffer) {
+    free(scratch_buffer);
+  }
   srsran_ue_mib_sync_free(&ue_mib_sync);
   srsran_ue_cellsearch_free(&cs);
 }
 
-void search::init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search_callback* parent, int force_N_id_2_, int force_N_id_1_)
+void search::init(srsran::rf_buffer_t& buffer_,
+                  uint32_t             nof_rx_channels,
+                  search_callback*     parent,
+                  int                  force_N_id_2_,
+                  int                  force_N_id_1_,
+                  uint32_t             nof_threads_,
+                  uint32_t             cache_timeout_ms_)
 {
   p = parent;
 
-  buffer = buffer_;
+  buffer       = buffer_;
+  nof_channels = nof_rx_channels;
 
   if (srsran_ue_cellsearch_init_multi(&cs, 8, radio_recv_callback, nof_rx_channels, parent)) {
     Error("SYNC:  Initiating UE cell search");
   }
   srsran_ue_cellsearch_set_nof_valid_frames(&cs, 4);
 
+  // Detectors for searching several EARFCNs in parallel, the samples of the other antennas are discarded
+  uint32_t nof_samples = srsran_ue_cellsearch_detector_nof_samples(cs.nof_valid_frames);
+  for (uint32_t i = 0; i < nof_threads_; i++) {
+    std::unique_ptr<detector_slot_t> slot(new detector_slot_t);
+    if (srsran_ue_cellsearch_detector_init(&slot->detector, cs.nof_valid_frames, SRSRAN_CS_PSS_DECIMATE)) {
+      Error("SYNC:  Initiating cell search detector");
+      break;
+    }
+    slot->buffer = srsran_vec_cf_malloc(nof_samples);
+    if (slot->buffer == nullptr) {
+      Error("SYNC:  Allocating cell search buffer");
+      srsran_ue_cellsearch_detector_free(&slot->detector);
+      break;
+    }
+    slots.push_back(std::move(slot));
+  }
+  if (not slots.empty()) {
+    if (nof_rx_channels > 1) {
+      scratch_buffer = srsran_vec_cf_malloc(nof_samples);
+    }
+    thread_pool = std::unique_ptr<srsran::task_thread_pool>(new srsran::task_thread_pool(slots.size()));
+  }
+  cache_timeout = std::chrono::milliseconds(cache_timeout_ms_);
+
   if (srsran_ue_mib_sync_init_multi(&ue_mib_sync, radio_recv_callback, nof_rx_channels, parent)) {
     Error("SYNC:  Initiating UE MIB synchronization");
   }
@@ -80,11 +124,143 @@ void search::init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search
 void search::set_cp_en(bool enable)
 {
   srsran_set_detect_cp(&cs, enable);
+  for (std::unique_ptr<detector_slot_t>& slot : slots) {
+    srsran_sync_cp_en(&slot->detector.sfind, enable);
+  }
 }
 
 void search::reset()
 {
   srsran_ue_sync_reset(&ue_mib_sync.ue_sync);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  cache.clear();
+}
+
+bool search::get_cached(uint32_t earfcn, cache_entry_t& entry)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto it = cache.find(earfcn);
+  if (it == cache.end()) {
+    return false;
+  }
+  if (std::chrono::steady_clock::now() - it->second.timestamp > cache_timeout) {
+    cache.erase(it);
+    return false;
+  }
+  entry = it->second;
+  return true;
+}
+
+void search::set_cached(uint32_t                             earfcn,
+                        const srsran_ue_cellsearch_result_t* found_cells,
+                        int                                  nof_cells,
+                        uint32_t                             max_N_id_2)
+{
+  if (cache_timeout.count() == 0) {
+    return;
+  }
+
+  cache_entry_t entry;
+  std::copy(found_cells, found_cells + SRSRAN_NOF_NID_2, entry.found_cells.begin());
+  entry.nof_cells  = nof_cells;
+  entry.max_N_id_2 = max_N_id_2;
+  entry.timestamp  = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  cache[earfcn] = entry;
+}
+
+void search::prescan(const std::vector<uint32_t>& earfcn_list, const std::function<bool(uint32_t)>& tune)
+{
+  if (slots.empty() || cache_timeout.count() == 0) {
+    return;
+  }
+
+  uint32_t nof_frames  = cs.nof_valid_frames;
+  uint32_t nof_samples = srsran_ue_cellsearch_detector_nof_samples(nof_frames);
+  uint32_t chunk_len   = (uint32_t)SRSRAN_CS_SAMP_FREQ / 200; // 5 ms
+
+  // Receives len samples of the first antenna into ptr
+  auto receive = [this](cf_t* ptr, uint32_t len) {
+    cf_t* rx_ptr[SRSRAN_MAX_CHANNELS] = {};
+    rx_ptr[0]                         = ptr;
+    for (uint32_t ch = 1; ch < nof_channels; ch++) {
+      rx_ptr[ch] = scratch_buffer;
+    }
+    srsran::rf_buffer_t rx_buffer(rx_ptr, len);
+    // radio_recv_fnc returns the number of received samples
+    return p->radio_recv_fnc(rx_buffer, nullptr) >= SRSRAN_SUCCESS;
+  };
+
+  Info("SYNC:  Detecting cells in %zd EARFCNs with %zd threads", earfcn_list.size(), slots.size());
+
+  for (uint32_t earfcn : earfcn_list) {
+    // Skip the EARFCNs that still have a valid result
+    cache_entry_t entry;
+    if (get_cached(earfcn, entry)) {
+      continue;
+    }
+
+    // Wait for a detector to be free
+    detector_slot_t* slot = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (slot == nullptr) {
+        for (std::unique_ptr<detector_slot_t>& s : slots) {
+          if (not s->busy) {
+            slot = s.get();
+            break;
+          }
+        }
+        if (slot == nullptr) {
+          cvar.wait(lock);
+        }
+      }
+      slot->busy = true;
+    }
+
+    if (not tune(earfcn)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      slot->busy = false;
+      continue;
+    }
+
+    // Discard the samples received while the radio settles, then receive all the half-frames of this EARFCN
+    bool rx_ok = receive(slot->buffer, chunk_len);
+    for (uint32_t n = 0; n < nof_samples && rx_ok; n += chunk_len) {
+      rx_ok = receive(&slot->buffer[n], SRSRAN_MIN(chunk_len, nof_samples - n));
+    }
+    if (not rx_ok) {
+      Error("SYNC:  Receiving samples for EARFCN=%d", earfcn);
+      std::lock_guard<std::mutex> lock(mutex);
+      slot->busy = false;
+      continue;
+    }
+
+    thread_pool->push_task([this, slot, earfcn, nof_frames]() {
+      srsran_ue_cellsearch_result_t found_cells[SRSRAN_NOF_NID_2] = {};
+      uint32_t                      max_N_id_2                    = 0;
+      int nof_cells = srsran_ue_cellsearch_detect(&slot->detector, slot->buffer, nof_frames, found_cells, &max_N_id_2);
+      if (nof_cells >= 0) {
+        Info("SYNC:  Detected %d cells in EARFCN=%d", nof_cells, earfcn);
+        set_cached(earfcn, found_cells, nof_cells, max_N_id_2);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      slot->busy = false;
+      cvar.notify_all();
+    });
+  }
+
+  // Wait for the last detections
+  std::unique_lock<std::mutex> lock(mutex);
+  for (std::unique_ptr<detector_slot_t>& s : slots) {
+    while (s->busy) {
+      cvar.wait(lock);
+    }
+  }
 }
 
 float search::get_last_cfo()
@@ -106,7 +282,8 @@ void search::set_agc_enable(bool enable)
   }
 }
 
-search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload)
+search::ret_code
+search::run(uint32_t earfcn, srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload)
 {
   srsran_cell_t new_cell = {};
 
@@ -121,11 +298,32 @@ search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BC
   Info("SYNC:  Searching for cell...");
   srsran::console(".");
 
-  if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
+  cache_entry_t cached;
+  if (get_cached(earfcn, cached)) {
+    // Cells were detected recently in this EARFCN, skip the PSS/SSS search
+    Info("SYNC:  Using %d cells detected %ld ms ago in EARFCN=%d",
+         cached.nof_cells,
+         (long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                     cached.timestamp)
+             .count(),
+         earfcn);
+    std::copy(cached.found_cells.begin(), cached.found_cells.end(), found_cells);
+    if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
+      ret           = found_cells[force_N_id_2].mode > 0 ? 1 : 0;
+      max_peak_cell = force_N_id_2;
+    } else {
+      ret           = cached.nof_cells;
+      max_peak_cell = cached.max_N_id_2;
+    }
+  } else if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
     ret           = srsran_ue_cellsearch_scan_N_id_2(&cs, force_N_id_2, &found_cells[force_N_id_2]);
     max_peak_cell = force_N_id_2;
   } else {
     ret = srsran_ue_cellsearch_scan(&cs, found_cells, &max_peak_cell);
+    // A cell may start transmitting at any time, so EARFCNs without cells are searched again
+    if (ret > 0) {
+      set_cached(earfcn, found_cells, ret, max_peak_cell);
+    }
   }
 
   if (ret < 0) {
@@ -91,7 +91,13 @@ void sync::init(srsran::radio_interface_phy* _radio,
   }
 
   // Initialize cell searcher
-  search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
+  search_p.init(sf_buffer,
+                nof_rf_channels,
+                this,
+                worker_com->args->force_N_id_2,
+                worker_com->args->force_N_id_1,
+                worker_com->args->nof_search_threads,
+                worker_com->args->cell_search_cache_ms);
   search_p.set_cp_en(worker_com->args->detect_cp);
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
@@ -254,6 +260,10 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
       Error("Index %d is not a valid EARFCN element.", cellsearch_earfcn_index);
       return ret;
     }
+
+    // When starting the EARFCN list, detect the cells of all its EARFCNs at once. Not possible if the frequency is forced
+    search_prescan = cellsearch_earfcn_index == 0 && worker_com->args->dl_earfcn_list.size() > 1 && dl_freq <= 0 &&
+                     worker_com->args->nof_search_threads > 0 && worker_com->args->cell_search_cache_ms > 0;
   } else {
     current_earfcn = earfcn;
   }
@@ -422,8 +432,20 @@ bool sync::wait_idle()
 
 void sync::run_cell_search_state()
 {
+  if (search_prescan) {
+    search_prescan = false;
+
+    int earfcn = current_earfcn;
+    search_p.prescan(worker_com->args->dl_earfcn_list, [this](uint32_t e) {
+      current_earfcn = (int)e;
+      return set_frequency();
+    });
+    current_earfcn = earfcn;
+    set_frequency();
+  }
+
   srsran_cell_t tmp_cell = cell.get();
-  cell_search_ret        = search_p.run(&tmp_cell, mib);
+  cell_search_ret        = search_p.run((uint32_t)current_earfcn, &tmp_cell, mib);
   if (cell_search_ret == search::CELL_FOUND) {
     cell.set(tmp_cell);
     stack->bch_decoded_ok(SYNC_CC_IDX, mib.data(), mib.size() / 8);
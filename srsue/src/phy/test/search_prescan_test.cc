@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/support/srsran_test.h"
+#include "srsue/hdr/phy/search.h"
+#include <vector>
+
+// Radio that receives noise and, like sync::radio_recv_fnc, returns the number of received samples
+class noise_radio : public srsue::search_callback
+{
+public:
+  noise_radio() : random_gen(srsran_random_init(1234)) {}
+  ~noise_radio() { srsran_random_free(random_gen); }
+
+  int radio_recv_fnc(srsran::rf_buffer_t& data, srsran_timestamp_t* rx_time) override
+  {
+    cf_t* ptr = data.get(0);
+    for (uint32_t i = 0; i < data.get_nof_samples(); i++) {
+      ptr[i] = srsran_random_uniform_complex_dist(random_gen, -0.1f, +0.1f);
+    }
+    nof_rx_samples += data.get_nof_samples();
+    return (int)data.get_nof_samples();
+  }
+  void                         set_ue_sync_opts(srsran_ue_sync_t* q, float cfo) override {}
+  srsran::radio_interface_phy* get_radio() override { return nullptr; }
+  void                         set_rx_gain(float gain) override {}
+
+  uint64_t nof_rx_samples = 0;
+
+private:
+  srsran_random_t random_gen;
+};
+
+// The EARFCNs detected by prescan() are cached, so run() does not receive them again
+static void test_prescan_caches_received_earfcns()
+{
+  noise_radio           radio;
+  srsran::rf_buffer_t   buffer(1);
+  srsue::search         searcher(srslog::fetch_basic_logger("PHY"));
+  std::vector<uint32_t> earfcn_list = {3350, 3400, 6300};
+  std::vector<uint32_t> tuned;
+
+  searcher.init(buffer, 1, &radio, -1, -1, 2, 60000);
+  searcher.prescan(earfcn_list, [&tuned](uint32_t earfcn) {
+    tuned.push_back(earfcn);
+    return true;
+  });
+  TESTASSERT(tuned == earfcn_list);
+  TESTASSERT(radio.nof_rx_samples > 0);
+
+  uint64_t nof_rx_samples = radio.nof_rx_samples;
+  for (uint32_t earfcn : earfcn_list) {
+    srsran_cell_t                               cell        = {};
+    std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN> bch_payload = {};
+    TESTASSERT(searcher.run(earfcn, &cell, bch_payload) == srsue::search::CELL_NOT_FOUND);
+  }
+  TESTASSERT_EQ(nof_rx_samples, radio.nof_rx_samples);
+
+  // A second prescan finds every EARFCN in the cache
+  tuned.clear();
+  searcher.prescan(earfcn_list, [&tuned](uint32_t earfcn) {
+    tuned.push_back(earfcn);
+    return true;
+  });
+  TESTASSERT(tuned.empty());
+  TESTASSERT_EQ(nof_rx_samples, radio.nof_rx_samples);
+}
+
+// A live scan that finds no cells is not cached, the next search receives again
+static void test_live_scan_without_cells_is_not_cached()
+{
+  noise_radio         radio;
+  srsran::rf_buffer_t buffer(1);
+  srsue::search       searcher(srslog::fetch_basic_logger("PHY"));
+
+  searcher.init(buffer, 1, &radio, -1, -1, 0, 60000);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    uint64_t                                    nof_rx_samples = radio.nof_rx_samples;
+    srsran_cell_t                               cell           = {};
+    std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN> bch_payload    = {};
+    TESTASSERT(searcher.run(3350, &cell, bch_payload) == srsue::search::CELL_NOT_FOUND);
+    TESTASSERT(radio.nof_rx_samples > nof_rx_samples);
+  }
+}
+
+int main()
+{
+  srslog::init();
+
+  test_prescan_caches_received_earfcns();
+  test_live_scan_without_cells_is_not_cached();
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}